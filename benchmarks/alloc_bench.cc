@@ -0,0 +1,157 @@
+/**
+ * MapXmlParser::Parse 的堆分配次数
+ *
+ * 替换全局 operator new/delete 统计解析期间的分配次数, 并遍历解析结果统计
+ * 地图实际持有的堆块数(非空 vector 缓冲区/geometry/超出 SSO 的字符串).
+ * 每个元素只分配一次时, extra = allocs - owned 只剩解析器自身的少量临时对象,
+ * 且与地图规模无关.
+ *
+ * usage: alloc_bench [xodr_file] [copies]
+ */
+#include <tinyxml2.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "opendrive-cpp/parser/map_parser.h"
+
+using namespace opendrive;
+
+namespace {
+
+std::atomic<size_t> g_allocs{0};
+std::atomic<size_t> g_frees{0};
+
+size_t Owned(const element::String& str) {
+  static const size_t kInline = element::String().capacity();
+  return !str.empty() && str.capacity() > kInline ? 1 : 0;
+}
+
+template <typename T>
+size_t Owned(const element::Vector<T>& vec) {
+  return vec.capacity() > 0 ? 1 : 0;
+}
+
+size_t Owned(const element::Lane& lane) {
+  size_t n = Owned(lane.link().predecessors()) +
+             Owned(lane.link().successors()) + Owned(lane.widths()) +
+             Owned(lane.borders()) + Owned(lane.road_marks()) +
+             Owned(lane.max_speeds());
+  for (const auto& mark : lane.road_marks()) n += Owned(mark.material());
+  return n;
+}
+
+size_t Owned(const element::Road& road) {
+  size_t n = Owned(road.attribute().name()) + Owned(road.type_info()) +
+             Owned(road.plan_view().geometrys()) +
+             road.plan_view().geometrys().size() +
+             Owned(road.lanes().lane_offsets()) +
+             Owned(road.lanes().lane_sections());
+  for (const auto& type : road.type_info()) n += Owned(type.country());
+  for (const auto& section : road.lanes().lane_sections()) {
+    for (const auto* info : {&section.left(), &section.center(),
+                             &section.right()}) {
+      n += Owned(info->lanes());
+      for (const auto& lane : info->lanes()) n += Owned(lane);
+    }
+  }
+  return n;
+}
+
+size_t Owned(const element::Map& map) {
+  const auto& header = map.header();
+  size_t n = Owned(header.rev_major()) + Owned(header.rev_minor()) +
+             Owned(header.version()) + Owned(header.name()) +
+             Owned(header.date()) + Owned(header.vendor()) +
+             Owned(map.roads()) + Owned(map.junctions());
+  for (const auto& road : map.roads()) n += Owned(road);
+  for (const auto& junction : map.junctions()) {
+    n += Owned(junction.attribute().name()) + Owned(junction.connections());
+    for (const auto& connection : junction.connections()) {
+      n += Owned(connection.lane_links());
+    }
+  }
+  return n;
+}
+
+size_t Elements(const element::Map& map) {
+  size_t n = map.roads().size() + map.junctions().size();
+  for (const auto& road : map.roads()) {
+    n += road.type_info().size() + road.plan_view().geometrys().size() +
+         road.lanes().lane_offsets().size() +
+         road.lanes().lane_sections().size();
+    for (const auto& section : road.lanes().lane_sections()) {
+      for (const auto* info : {&section.left(), &section.center(),
+                               &section.right()}) {
+        for (const auto& lane : info->lanes()) {
+          n += 1 + lane.widths().size() + lane.borders().size() +
+               lane.road_marks().size() + lane.max_speeds().size();
+        }
+      }
+    }
+  }
+  for (const auto& junction : map.junctions()) {
+    n += junction.connections().size();
+    for (const auto& connection : junction.connections()) {
+      n += connection.lane_links().size();
+    }
+  }
+  return n;
+}
+
+}  // namespace
+
+void* operator new(size_t size) {
+  g_allocs.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(size ? size : 1);
+  if (!ptr) throw std::bad_alloc();
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+  if (!ptr) return;
+  g_frees.fetch_add(1, std::memory_order_relaxed);
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept { operator delete(ptr); }
+
+int main(int argc, char* argv[]) {
+  const std::string file =
+      argc > 1 ? argv[1] : "./tests/data/only-unittest.xodr";
+  const size_t copies = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1;
+  std::printf("%-8s %10s %10s %10s %10s %10s %12s\n", "copies", "elements",
+              "allocs", "frees", "owned", "extra", "allocs/elem");
+  for (size_t n : {static_cast<size_t>(1), copies}) {
+    const std::string xml = bench::MakeSyntheticMap(file, n);
+    tinyxml2::XMLDocument doc;
+    if (tinyxml2::XML_SUCCESS != doc.Parse(xml.c_str(), xml.size())) {
+      std::fprintf(stderr, "parse %s failed\n", file.c_str());
+      return 1;
+    }
+    auto ele_map = std::make_shared<element::Map>();
+    parser::MapXmlParser map_parser;
+    const size_t allocs = g_allocs.load();
+    const size_t frees = g_frees.load();
+    auto status = map_parser.Parse(doc.RootElement(), ele_map);
+    const size_t parse_allocs = g_allocs.load() - allocs;
+    const size_t parse_frees = g_frees.load() - frees;
+    if (ErrorCode::OK != status.error_code) {
+      std::fprintf(stderr, "parse failed: %s\n", status.msg.c_str());
+      return 1;
+    }
+    const size_t owned = Owned(*ele_map);
+    const size_t elements = Elements(*ele_map);
+    std::printf("%-8zu %10zu %10zu %10zu %10zu %10ld %12.3f\n", n, elements,
+                parse_allocs, parse_frees, owned,
+                static_cast<long>(parse_allocs) - static_cast<long>(owned),
+                static_cast<double>(parse_allocs) / elements);
+    if (1 == copies) break;
+  }
+  return 0;
+}
@@ -0,0 +1,101 @@
+/**
+ * element::Map 堆分配 vs arena 分配: 构建/析构耗时与峰值 RSS
+ *
+ * 每轮在同一个 DOM 上重新构建地图再释放, 模拟反复 reload.
+ * arena 模式每轮释放地图后调用 Arena::Release() 一次性归还内存.
+ *
+ * usage: arena_bench [xodr_file] [copies] [iterations]
+ *   copies > 1 时以 xodr_file 为种子生成大地图
+ */
+#include <tinyxml2.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "opendrive-cpp/common/arena.h"
+#include "opendrive-cpp/parser/map_parser.h"
+
+using namespace opendrive;
+
+namespace {
+
+struct Cycle {
+  double build_ms = 0;
+  double teardown_ms = 0;
+  size_t arena_bytes = 0;
+};
+
+bool Reload(const tinyxml2::XMLElement* xml_root, common::Arena* arena,
+            Cycle* cycle) {
+  bench::Timer timer;
+  auto ele_map = element::Map::Create(arena);
+  /// 解析器持有地图的引用, 析构计时前先释放
+  auto status = parser::MapXmlParser().Parse(xml_root, ele_map);
+  cycle->build_ms = timer.ElapsedMs();
+  cycle->arena_bytes = arena ? arena->bytes_reserved() : 0;
+  timer.Reset();
+  ele_map.reset();
+  if (arena) {
+    arena->Release();
+  }
+  cycle->teardown_ms = timer.ElapsedMs();
+  return ErrorCode::OK == status.error_code;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const std::string file =
+      argc > 1 ? argv[1] : "./tests/data/only-unittest.xodr";
+  const size_t copies = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200;
+  const size_t iterations = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 10;
+  const std::string xml = bench::MakeSyntheticMap(file, copies);
+  tinyxml2::XMLDocument doc;
+  if (tinyxml2::XML_SUCCESS != doc.Parse(xml.c_str(), xml.size())) {
+    std::fprintf(stderr, "parse %s failed\n", file.c_str());
+    return 1;
+  }
+  std::printf("file: %s x%zu (%.2f MB), iterations: %zu\n", file.c_str(),
+              copies, xml.size() / 1024.0 / 1024.0, iterations);
+  std::printf("%-8s %14s %14s %14s %14s\n", "mode", "build ms",
+              "teardown ms", "arena MB", "peak rss MB");
+  for (bool use_arena : {false, true}) {
+    std::vector<double> build_times;
+    std::vector<double> teardown_times;
+    size_t arena_bytes = 0;
+    common::Arena arena;
+    for (size_t i = 0; i < iterations; i++) {
+      Cycle cycle;
+      if (!Reload(doc.RootElement(), use_arena ? &arena : nullptr, &cycle)) {
+        std::fprintf(stderr, "parse failed: %s\n", file.c_str());
+        return 1;
+      }
+      build_times.emplace_back(cycle.build_ms);
+      teardown_times.emplace_back(cycle.teardown_ms);
+      arena_bytes = cycle.arena_bytes;
+    }
+    /// 峰值 RSS 在子进程中测量, 不受父进程之前的分配影响
+    const auto result = bench::RunInChild([&](double* ms) {
+      common::Arena child_arena;
+      Cycle cycle;
+      bench::Timer timer;
+      for (size_t i = 0; i < iterations; i++) {
+        if (!Reload(doc.RootElement(), use_arena ? &child_arena : nullptr,
+                    &cycle)) {
+          return false;
+        }
+      }
+      *ms = timer.ElapsedMs();
+      return true;
+    });
+    std::printf("%-8s %14.2f %14.2f %14.2f %14.2f\n",
+                use_arena ? "arena" : "heap", bench::Median(build_times),
+                bench::Median(teardown_times), arena_bytes / 1024.0 / 1024.0,
+                result.peak_rss_kb / 1024.0);
+  }
+  return 0;
+}
@@ -0,0 +1,164 @@
+#ifndef OPENDRIVE_CPP_BENCHMARK_UTIL_H_
+#define OPENDRIVE_CPP_BENCHMARK_UTIL_H_
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace opendrive {
+namespace bench {
+
+class Timer {
+ public:
+  Timer() : start_(std::chrono::steady_clock::now()) {}
+  void Reset() { start_ = std::chrono::steady_clock::now(); }
+  double ElapsedMs() const {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start_)
+        .count();
+  }
+
+ private:
+  std::chrono::steady_clock::time_point start_;
+};
+
+inline std::string ReadFile(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  std::stringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+
+inline bool WriteFile(const std::string& path, const std::string& content) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(content.data(), content.size());
+  return out.good();
+}
+
+inline size_t FileSize(const std::string& path) {
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  return in ? static_cast<size_t>(in.tellg()) : 0;
+}
+
+/**
+ * @brief 复制种子地图中的<road>生成大地图, 第k份拷贝的road id加上 k*100000
+ *
+ * @param seed_file 种子 xodr
+ * @param copies 拷贝份数
+ * @return xodr 文本
+ */
+inline std::string MakeSyntheticMap(const std::string& seed_file,
+                                    size_t copies) {
+  const std::string seed = ReadFile(seed_file);
+  const size_t begin = seed.find("<road ");
+  const size_t last = seed.rfind("</road>");
+  if (std::string::npos == begin || std::string::npos == last) return seed;
+  const size_t end = last + std::string("</road>").size();
+  const std::string block = seed.substr(begin, end - begin);
+  std::string out = seed.substr(0, begin);
+  out.reserve(seed.size() + block.size() * copies);
+  for (size_t k = 0; k < copies; k++) {
+    size_t pos = 0;
+    while (true) {
+      const size_t tag = block.find("<road ", pos);
+      if (std::string::npos == tag) {
+        out.append(block, pos, std::string::npos);
+        break;
+      }
+      const size_t tag_end = block.find('>', tag);
+      const size_t id = block.find(" id=\"", tag);
+      if (0 == k || std::string::npos == id || id > tag_end) {
+        out.append(block, pos, tag_end + 1 - pos);
+      } else {
+        const size_t value = id + 5;
+        const size_t value_end = block.find('"', value);
+        const long old_id =
+            std::atol(block.substr(value, value_end - value).c_str());
+        out.append(block, pos, value - pos);
+        out.append(std::to_string(k * 100000 + old_id));
+        out.append(block, value_end, tag_end + 1 - value_end);
+      }
+      pos = tag_end + 1;
+    }
+  }
+  out.append(seed, end, std::string::npos);
+  return out;
+}
+
+/// 将文件页面逐出 page cache(模拟冷启动)
+inline bool DropPageCache(const std::string& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+  ::fdatasync(fd);
+  const int ret = ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  ::close(fd);
+  return 0 == ret;
+}
+
+struct ChildResult {
+  double ms = 0;
+  long peak_rss_kb = 0;
+  bool ok = false;
+};
+
+/**
+ * @brief 在子进程中运行 task, 返回子进程计时与峰值 RSS
+ *
+ * @param task bool(double* ms)
+ */
+template <typename F>
+inline ChildResult RunInChild(const F& task) {
+  ChildResult result;
+  int fds[2];
+  if (0 != ::pipe(fds)) return result;
+  const pid_t pid = ::fork();
+  if (0 == pid) {
+    ::close(fds[0]);
+    double ms = 0;
+    const bool ok = task(&ms);
+    if (!ok) ms = -1;
+    ssize_t n = ::write(fds[1], &ms, sizeof(ms));
+    (void)n;
+    ::close(fds[1]);
+    ::_exit(ok ? 0 : 1);
+  }
+  ::close(fds[1]);
+  double ms = -1;
+  const ssize_t n = ::read(fds[0], &ms, sizeof(ms));
+  ::close(fds[0]);
+  int status = 0;
+  struct rusage usage;
+  ::wait4(pid, &status, 0, &usage);
+  result.ms = ms;
+#ifdef __APPLE__
+  result.peak_rss_kb = usage.ru_maxrss / 1024;  // bytes on macOS
+#else
+  result.peak_rss_kb = usage.ru_maxrss;
+#endif
+  result.ok = n == sizeof(ms) && WIFEXITED(status) &&
+              0 == WEXITSTATUS(status);
+  return result;
+}
+
+inline double Median(std::vector<double> values) {
+  if (values.empty()) return 0;
+  std::sort(values.begin(), values.end());
+  return values.at(values.size() / 2);
+}
+
+}  // namespace bench
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_CPP_BENCHMARK_UTIL_H_
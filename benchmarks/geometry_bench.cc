@@ -0,0 +1,158 @@
+/**
+ * 参考线采样吞吐量(samples/second)
+ *
+ * before: 每个样本查找 geometry 后调用 Geometry::GetPoint
+ * after:  Road::GetReferencePoints 批量采样
+ *
+ * 以及各类 geometry 的 GetPoint 与各指令集 GetPoints 的吞吐量
+ *
+ * usage: geometry_bench [xodr] [step_m] [rounds]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench_util.h"
+#include "opendrive-cpp/opendrive.h"
+
+using namespace opendrive;
+
+namespace {
+
+/// 最后一个起点 <= s 的 geometry
+const element::Geometry::Ptr& FindGeometry(const element::Road& road,
+                                           double s) {
+  const auto& geometrys = road.plan_view().geometrys();
+  size_t index = 0;
+  while (index + 1 < geometrys.size() && geometrys[index + 1]->s() <= s) {
+    index++;
+  }
+  return geometrys[index];
+}
+
+/// 每种 geometry 采样 samples 个点, 重复 rounds 次
+void BenchKernels(size_t samples, size_t rounds) {
+  using PRange = element::GeometryParamPoly3::PRange;
+  const std::vector<std::pair<const char*, element::Geometry::Ptr>>
+      geometrys = {
+          {"line", std::make_shared<element::GeometryLine>(
+                       0, 100, 200, 0.3, 100, GeometryType::kLine)},
+          {"arc", std::make_shared<element::GeometryArc>(
+                      0, 100, 200, 0.3, 100, GeometryType::kArc, 0.01)},
+          {"poly3", std::make_shared<element::GeometryPoly3>(
+                        0, 100, 200, 0.3, 100, GeometryType::kPoly3, 0.1,
+                        0.02, -3e-3, 2e-5)},
+          {"param_poly3",
+           std::make_shared<element::GeometryParamPoly3>(
+               0, 100, 200, 0.3, 100, GeometryType::kParamPoly3, 0, 100, 2,
+               -1, 0, 3, 20, -12, PRange::NORMALIZED)},
+      };
+  std::vector<double> road_s(samples);
+  for (size_t i = 0; i < samples; i++) {
+    road_s[i] = 100.0 * i / samples;
+  }
+  std::vector<element::Point> points(samples);
+  std::printf("\n%-12s %12s", "Msamples/s", "GetPoint");
+  const auto supported = common::SupportedSimdLevel();
+  for (int level = 0; level <= static_cast<int>(supported); level++) {
+    std::printf(" %12s",
+                common::SimdLevelName(static_cast<common::SimdLevel>(level)));
+  }
+  std::printf("\n");
+  double sum = 0;
+  const double total = static_cast<double>(samples) * rounds;
+  for (const auto& item : geometrys) {
+    const auto& geometry = item.second;
+    bench::Timer timer;
+    for (size_t r = 0; r < rounds; r++) {
+      for (size_t i = 0; i < samples; i++) {
+        points[i] = geometry->GetPoint(road_s[i]);
+      }
+      sum += points[r % samples].x();
+    }
+    std::printf("%-12s %12.2f", item.first, total / timer.ElapsedMs() / 1e3);
+    for (int level = 0; level <= static_cast<int>(supported); level++) {
+      common::SetSimdLevel(static_cast<common::SimdLevel>(level));
+      timer.Reset();
+      for (size_t r = 0; r < rounds; r++) {
+        geometry->GetPoints(road_s.data(), samples, points.data());
+        sum += points[r % samples].x();
+      }
+      std::printf(" %12.2f", total / timer.ElapsedMs() / 1e3);
+    }
+    std::printf("\n");
+  }
+  common::SetSimdLevel(supported);
+  if (sum != sum) std::printf("nan\n");
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const std::string file =
+      argc > 1 ? argv[1] : "./tests/data/UC_Simple-X-Junction.xodr";
+  const double step = argc > 2 ? std::atof(argv[2]) : 0.05;
+  const size_t rounds = argc > 3 ? std::atol(argv[3]) : 200;
+
+  Parser parser;
+  auto ele_map = std::make_shared<element::Map>();
+  auto status = parser.ParseMap(file, ele_map);
+  if (ErrorCode::OK != status.error_code) {
+    std::printf("parse %s failed: %s\n", file.c_str(), status.msg.c_str());
+    return 1;
+  }
+  std::vector<std::vector<double>> samples;
+  size_t sample_num = 0;
+  for (const auto& road : ele_map->roads()) {
+    samples.emplace_back();
+    for (double s = 0; s < road.attribute().length(); s += step) {
+      samples.back().emplace_back(s);
+    }
+    sample_num += samples.back().size();
+  }
+  std::vector<element::Point> points;
+  double sum = 0;
+
+  bench::Timer timer;
+  for (size_t r = 0; r < rounds; r++) {
+    for (size_t i = 0; i < samples.size(); i++) {
+      const auto& road = ele_map->roads().at(i);
+      points.resize(samples[i].size());
+      for (size_t j = 0; j < samples[i].size(); j++) {
+        points[j] = FindGeometry(road, samples[i][j])->GetPoint(samples[i][j]);
+      }
+      for (const auto& point : points) {
+        sum += point.x();
+      }
+    }
+  }
+  const double before_ms = timer.ElapsedMs();
+
+  timer.Reset();
+  for (size_t r = 0; r < rounds; r++) {
+    for (size_t i = 0; i < samples.size(); i++) {
+      points.resize(samples[i].size());
+      ele_map->roads().at(i).GetReferencePoints(
+          samples[i].data(), samples[i].size(), points.data());
+      for (const auto& point : points) {
+        sum -= point.x();
+      }
+    }
+  }
+  const double after_ms = timer.ElapsedMs();
+
+  const double total = static_cast<double>(sample_num) * rounds;
+  std::printf("%s: %zu roads, %zu samples x %zu rounds\n", file.c_str(),
+              ele_map->roads().size(), sample_num, rounds);
+  std::printf("per-point GetPoint:  %9.2f ms %8.2f Msamples/s\n", before_ms,
+              total / before_ms / 1e3);
+  std::printf("GetReferencePoints:  %9.2f ms %8.2f Msamples/s\n", after_ms,
+              total / after_ms / 1e3);
+  if (sum > 1e-3 || sum < -1e-3) std::printf("mismatch %g\n", sum);
+
+  BenchKernels(4096, rounds * 20);
+  return 0;
+}
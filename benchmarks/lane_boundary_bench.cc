@@ -0,0 +1,144 @@
+/**
+ * 一个 laneSection 所有车道外边界的吞吐量(boundaries/second)
+ *
+ * naive:  每条车道分别对内侧车道调用 Lane::GetLaneWidth 再加 laneOffset,
+ *         O(车道数^2) 次查找
+ * cursor: LaneSection::GetLaneBoundaries, 每条车道一次查找
+ * table:  同上, 已构建 boundary_table(), 每个样本一次段查找
+ *
+ * usage: lane_boundary_bench [samples] [rounds]
+ */
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "bench_util.h"
+#include "opendrive-cpp/geometry/element.h"
+
+using namespace opendrive;
+
+namespace {
+
+constexpr double kLength = 200;
+
+/// 每条车道 records 条 <width>, 共 records 条 laneOffset
+element::LaneSection MakeSection(size_t lane_num, size_t records) {
+  element::LaneSection section;
+  section.set_start_position(0);
+  section.set_end_position(kLength);
+  for (int side : {1, -1}) {
+    auto* lanes = 1 == side ? section.mutable_left()->mutable_lanes()
+                            : section.mutable_right()->mutable_lanes();
+    for (size_t j = 0; j < lane_num; j++) {
+      element::Lane lane;
+      lane.mutable_attribute()->set_id(side * static_cast<int>(j + 1));
+      for (size_t k = 0; k < records; k++) {
+        element::LaneWidth width;
+        width.set_s(kLength * k / records + 0.1 * j);
+        width.set_a(3 + 0.01 * k);
+        width.set_b(1e-3);
+        width.set_c(-1e-5);
+        lane.mutable_widths()->emplace_back(width);
+      }
+      lanes->emplace_back(lane);
+    }
+  }
+  return section;
+}
+
+double NaiveOffset(const element::LaneOffsets& lane_offsets, double road_s) {
+  for (int i = static_cast<int>(lane_offsets.size()) - 1; i >= 0; i--) {
+    if (road_s >= lane_offsets.at(i).s()) {
+      return lane_offsets.at(i).GetOffsetValue(road_s);
+    }
+  }
+  return 0;
+}
+
+/// lanes 按 |id| 升序, 第 j 条车道的外边界
+double NaiveBoundary(const element::Vector<element::Lane>& lanes, size_t j,
+                     double center, double ds, double sign) {
+  double t = center;
+  for (size_t k = 0; k <= j; k++) {
+    t += sign * lanes[k].GetLaneWidth(ds);
+  }
+  return t;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const size_t samples = argc > 1 ? std::atol(argv[1]) : 2048;
+  const size_t rounds = argc > 2 ? std::atol(argv[2]) : 50;
+  const size_t records = 16;
+  std::vector<double> road_s(samples);
+  /// 避开断点, <width> 记录之间不连续
+  for (size_t i = 0; i < samples; i++) {
+    road_s[i] = kLength * (i + 0.5) / samples;
+  }
+  element::LaneOffsets lane_offsets(records);
+  for (size_t k = 0; k < records; k++) {
+    lane_offsets[k].set_s(kLength * k / records + 0.05);
+    lane_offsets[k].set_a(0.1 * k);
+    lane_offsets[k].set_b(2e-3);
+  }
+
+  std::printf("%-6s %10s %10s %10s %10s %10s %10s\n", "lanes", "naive M/s",
+              "cursor M/s", "table M/s", "segments", "bytes", "max diff");
+  double sum = 0;
+  for (size_t lane_num : {2, 4, 8, 16}) {
+    const auto plain = MakeSection(lane_num, records);
+    auto section = plain;
+    section.BuildBoundaryTable(lane_offsets);
+    const double total =
+        static_cast<double>(samples) * rounds * lane_num * 2;
+    const auto& left = plain.left().lanes();
+    const auto& right = plain.right().lanes();
+
+    bench::Timer timer;
+    for (size_t r = 0; r < rounds; r++) {
+      for (size_t i = 0; i < samples; i++) {
+        const double center = NaiveOffset(lane_offsets, road_s[i]);
+        for (size_t j = 0; j < lane_num; j++) {
+          sum += NaiveBoundary(left, j, center, road_s[i], 1.);
+          sum += NaiveBoundary(right, j, center, road_s[i], -1.);
+        }
+      }
+    }
+    const double naive_ms = timer.ElapsedMs();
+
+    element::LaneBoundaries expect;
+    timer.Reset();
+    for (size_t r = 0; r < rounds; r++) {
+      plain.GetLaneBoundaries(road_s.data(), samples, lane_offsets, &expect);
+      sum += expect.left(r % samples, 0);
+    }
+    const double cursor_ms = timer.ElapsedMs();
+
+    element::LaneBoundaries boundaries;
+    timer.Reset();
+    for (size_t r = 0; r < rounds; r++) {
+      section.GetLaneBoundaries(road_s.data(), samples, lane_offsets,
+                                &boundaries);
+      sum += boundaries.left(r % samples, 0);
+    }
+    const double table_ms = timer.ElapsedMs();
+
+    double diff = 0;
+    for (size_t i = 0; i < samples; i++) {
+      for (size_t j = 0; j < lane_num; j++) {
+        diff = std::fmax(diff, std::fabs(expect.left(i, j) -
+                                         boundaries.left(i, j)));
+        diff = std::fmax(diff, std::fabs(expect.right(i, j) -
+                                         boundaries.right(i, j)));
+      }
+    }
+    std::printf("%-6zu %10.2f %10.2f %10.2f %10zu %10zu %10.3g\n",
+                lane_num * 2, total / naive_ms / 1e3, total / cursor_ms / 1e3,
+                total / table_ms / 1e3, section.boundary_table().segment_num(),
+                section.boundary_table().bytes(), diff);
+  }
+  if (sum != sum) std::printf("nan\n");
+  return 0;
+}
@@ -0,0 +1,89 @@
+/**
+ * Parser::ParseMap vs Parser::ParseLazyMap: 启动耗时与峰值 RSS
+ *
+ * lazy 模式在加载后按比例访问 road(均匀分布), 统计加载 + 访问的总耗时.
+ *
+ * usage: lazy_bench [xodr_file] [copies] [iterations]
+ *   copies > 1 时以 xodr_file 为种子生成大地图
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "opendrive-cpp/lazy_map.h"
+#include "opendrive-cpp/opendrive.h"
+
+using namespace opendrive;
+
+namespace {
+
+bench::ChildResult RunEager(const std::string& file) {
+  return bench::RunInChild([&](double* ms) {
+    Parser parser;
+    auto ele_map = std::make_shared<element::Map>();
+    bench::Timer timer;
+    auto status = parser.ParseMap(file, ele_map);
+    *ms = timer.ElapsedMs();
+    return ErrorCode::OK == status.error_code;
+  });
+}
+
+/// touched: 访问的 road 比例
+bench::ChildResult RunLazy(const std::string& file, double touched) {
+  return bench::RunInChild([&](double* ms) {
+    Parser parser;
+    auto lazy_map = std::make_shared<LazyMap>();
+    bench::Timer timer;
+    auto status = parser.ParseLazyMap(file, lazy_map);
+    if (ErrorCode::OK != status.error_code) return false;
+    const element::Ids ids = lazy_map->road_ids();
+    const size_t n = static_cast<size_t>(ids.size() * touched);
+    for (size_t i = 0; i < n; i++) {
+      if (!lazy_map->GetRoad(ids.at(i * ids.size() / n))) return false;
+    }
+    *ms = timer.ElapsedMs();
+    return true;
+  });
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string file = argc > 1 ? argv[1] : "./tests/data/only-unittest.xodr";
+  const size_t copies = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000;
+  const size_t iterations = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 5;
+  if (copies > 1) {
+    const std::string synthetic = "./lazy_bench_synthetic.xodr";
+    bench::WriteFile(synthetic, bench::MakeSyntheticMap(file, copies));
+    file = synthetic;
+  }
+  std::printf("file: %s (%.2f MB), iterations: %zu\n", file.c_str(),
+              bench::FileSize(file) / 1024.0 / 1024.0, iterations);
+  std::printf("%-8s %8s %12s %14s\n", "mode", "touched", "median ms",
+              "peak rss MB");
+  auto report = [&](const char* mode, double touched, bool lazy) {
+    std::vector<double> times;
+    long peak_rss_kb = 0;
+    for (size_t i = 0; i < iterations; i++) {
+      const auto result = lazy ? RunLazy(file, touched) : RunEager(file);
+      if (!result.ok) {
+        std::fprintf(stderr, "parse failed: %s\n", file.c_str());
+        return false;
+      }
+      times.emplace_back(result.ms);
+      peak_rss_kb = std::max(peak_rss_kb, result.peak_rss_kb);
+    }
+    std::printf("%-8s %7.0f%% %12.2f %14.2f\n", mode, touched * 100,
+                bench::Median(times), peak_rss_kb / 1024.0);
+    return true;
+  };
+  if (!report("eager", 1.0, false)) return 1;
+  for (double touched : {0.0, 0.01, 0.1, 0.5, 1.0}) {
+    if (!report("lazy", touched, true)) return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,89 @@
+/**
+ * Parser::ParseMap(xml_file): tinyxml2 LoadFile(整棵 DOM) vs mmap(在映射
+ * 页面上流式解析, 不复制文件), 对比耗时与子进程峰值 RSS
+ * 最后输出一次带 ParseStats 的解析, 以及开启统计的额外开销
+ *
+ * usage: load_bench [xodr_file] [copies] [iterations]
+ *   copies > 1 时以 xodr_file 为种子生成大地图
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "opendrive-cpp/opendrive.h"
+
+using namespace opendrive;
+
+namespace {
+
+bench::ChildResult RunOnce(const std::string& file, bool use_mmap, bool cold) {
+  if (cold) {
+    bench::DropPageCache(file);
+  }
+  return bench::RunInChild([&](double* ms) {
+    ParseOptions options;
+    options.use_mmap = use_mmap;
+    Parser parser(options);
+    auto ele_map = std::make_shared<element::Map>();
+    bench::Timer timer;
+    auto status = parser.ParseMap(file, ele_map);
+    *ms = timer.ElapsedMs();
+    return ErrorCode::OK == status.error_code;
+  });
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string file = argc > 1 ? argv[1] : "./tests/data/only-unittest.xodr";
+  const size_t copies = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200;
+  const size_t iterations = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 5;
+  if (copies > 1) {
+    const std::string synthetic = "./load_bench_synthetic.xodr";
+    bench::WriteFile(synthetic, bench::MakeSyntheticMap(file, copies));
+    file = synthetic;
+  }
+  std::printf("file: %s (%.2f MB), iterations: %zu\n", file.c_str(),
+              bench::FileSize(file) / 1024.0 / 1024.0, iterations);
+  std::printf("%-11s %-6s %12s %14s\n", "mode", "cache", "median ms",
+              "peak rss MB");
+  for (bool cold : {true, false}) {
+    for (bool use_mmap : {false, true}) {
+      std::vector<double> times;
+      long peak_rss_kb = 0;
+      RunOnce(file, use_mmap, false);  // warm up
+      for (size_t i = 0; i < iterations; i++) {
+        const auto result = RunOnce(file, use_mmap, cold);
+        if (!result.ok) {
+          std::fprintf(stderr, "parse failed: %s\n", file.c_str());
+          return 1;
+        }
+        times.emplace_back(result.ms);
+        peak_rss_kb = std::max(peak_rss_kb, result.peak_rss_kb);
+      }
+      std::printf("%-11s %-6s %12.2f %14.2f\n",
+                  use_mmap ? "mmap-stream" : "LoadFile",
+                  cold ? "cold" : "warm", bench::Median(times),
+                  peak_rss_kb / 1024.0);
+    }
+  }
+  std::vector<double> times[2];
+  ParseStats stats;
+  for (size_t i = 0; i < iterations; i++) {
+    for (bool enabled : {false, true}) {
+      ParseOptions options;
+      options.stats = enabled ? &stats : nullptr;
+      Parser parser(options);
+      auto ele_map = std::make_shared<element::Map>();
+      bench::Timer timer;
+      parser.ParseMap(file, ele_map);
+      times[enabled].emplace_back(timer.ElapsedMs());
+    }
+  }
+  std::printf("\nstats off %.2f ms, on %.2f ms\n%s", bench::Median(times[0]),
+              bench::Median(times[1]), stats.ToString().c_str());
+  return 0;
+}
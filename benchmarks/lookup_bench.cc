@@ -0,0 +1,83 @@
+/**
+ * 分段查找(<geometry>/<width>/<laneOffset>)的吞吐量(lookups/second)
+ *
+ * linear: 原实现, 从尾部向前线性查找, O(n)
+ * binary: GetGeValuePoloy3, O(log n)
+ * cursor: Poloy3Cursor, s 单调变化时均摊 O(1)
+ *
+ * 每种规模按固定步长从头到尾采样一遍, 相当于沿一条长 road 采样
+ *
+ * usage: lookup_bench [rounds]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "bench_util.h"
+#include "opendrive-cpp/common/common.hpp"
+#include "opendrive-cpp/geometry/element.h"
+
+using namespace opendrive;
+
+namespace {
+
+int LinearGe(const std::vector<element::LaneOffset>& items, double target) {
+  if (items.empty() || target < items.at(0).s()) return -1;
+  for (int i = items.size() - 1; i >= 0; i--) {
+    if (target >= items.at(i).s()) return i;
+  }
+  return -1;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const size_t rounds = argc > 1 ? std::atol(argv[1]) : 20;
+  std::printf("%-8s %10s %12s %12s %12s\n", "records", "lookups",
+              "linear M/s", "binary M/s", "cursor M/s");
+  long sum = 0;
+  for (size_t size : {4, 16, 64, 256, 1024, 4096}) {
+    std::vector<element::LaneOffset> items(size);
+    for (size_t i = 0; i < size; i++) {
+      items[i].set_s(10.0 * i);
+    }
+    /// 每个分段 8 个样本
+    std::vector<double> targets;
+    for (double s = 0; s < 10.0 * size; s += 1.25) {
+      targets.emplace_back(s);
+    }
+    const double total = static_cast<double>(targets.size()) * rounds;
+
+    bench::Timer timer;
+    for (size_t r = 0; r < rounds; r++) {
+      for (double target : targets) {
+        sum += LinearGe(items, target);
+      }
+    }
+    const double linear_ms = timer.ElapsedMs();
+
+    timer.Reset();
+    for (size_t r = 0; r < rounds; r++) {
+      for (double target : targets) {
+        sum -= common::GetGeValuePoloy3(items, target);
+      }
+    }
+    const double binary_ms = timer.ElapsedMs();
+
+    timer.Reset();
+    for (size_t r = 0; r < rounds; r++) {
+      auto cursor = common::MakePoloy3Cursor(items);
+      for (double target : targets) {
+        sum += cursor.Ge(target);
+      }
+    }
+    const double cursor_ms = timer.ElapsedMs();
+
+    std::printf("%-8zu %10zu %12.2f %12.2f %12.2f\n", size, targets.size(),
+                total / linear_ms / 1e3, total / binary_ms / 1e3,
+                total / cursor_ms / 1e3);
+  }
+  /// linear 与 binary 相互抵消, 剩下 cursor 的和
+  if (sum < 0) std::printf("mismatch %ld\n", sum);
+  return 0;
+}
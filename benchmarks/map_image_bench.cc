@@ -0,0 +1,135 @@
+/**
+ * 每个进程获取一份可查询地图的开销:
+ *   Parser::ParseMap vs snapshot::LoadMap vs snapshot::MapImage::Attach
+ *
+ * usage: map_image_bench [xodr_file] [copies] [iterations] [image_dir]
+ *   copies > 1 时以 xodr_file 为种子生成大地图
+ *   image_dir 默认为当前目录, 可设置为 /dev/shm
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "opendrive-cpp/opendrive.h"
+#include "opendrive-cpp/snapshot/map_image.h"
+#include "opendrive-cpp/snapshot/snapshot.h"
+
+using namespace opendrive;
+
+namespace {
+
+enum class Mode { kXml, kSnapshot, kImage };
+
+/// 遍历所有 geometry 取点, 保证各方式都真正访问到了数据
+double Touch(const element::Map& ele_map) {
+  double sum = 0;
+  for (const auto& road : ele_map.roads()) {
+    for (const auto& geometry : road.plan_view().geometrys()) {
+      sum += geometry->GetPoint(geometry->s()).x();
+    }
+  }
+  return sum;
+}
+
+double Touch(const snapshot::MapImage& image) {
+  double sum = 0;
+  for (const auto road : image.roads()) {
+    for (const auto geometry : road.geometrys()) {
+      sum += geometry.GetPoint(geometry.s()).x();
+    }
+  }
+  return sum;
+}
+
+bench::ChildResult RunOnce(Mode mode, const std::string& file) {
+  return bench::RunInChild([&](double* ms) {
+    bench::Timer timer;
+    double sum = 0;
+    bool ok = false;
+    if (Mode::kImage == mode) {
+      snapshot::MapImage image;
+      ok = ErrorCode::OK == image.Attach(file).error_code;
+      *ms = timer.ElapsedMs();
+      if (ok) sum = Touch(image);
+    } else {
+      auto ele_map = std::make_shared<element::Map>();
+      Status status;
+      if (Mode::kSnapshot == mode) {
+        status = snapshot::LoadMap(file, ele_map);
+      } else {
+        Parser parser;
+        status = parser.ParseMap(file, ele_map);
+      }
+      *ms = timer.ElapsedMs();
+      ok = ErrorCode::OK == status.error_code;
+      if (ok) sum = Touch(*ele_map);
+    }
+    return ok && sum == sum;
+  });
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string file = argc > 1 ? argv[1] : "./tests/data/only-unittest.xodr";
+  const size_t copies = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200;
+  const size_t iterations = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 5;
+  const std::string image_dir = argc > 4 ? argv[4] : ".";
+  if (copies > 1) {
+    const std::string synthetic = "./map_image_bench_synthetic.xodr";
+    bench::WriteFile(synthetic, bench::MakeSyntheticMap(file, copies));
+    file = synthetic;
+  }
+  const std::string snapshot_file = image_dir + "/map_image_bench.odrsnap";
+  const std::string image_file = image_dir + "/map_image_bench.odrimg";
+  {
+    Parser parser;
+    auto ele_map = std::make_shared<element::Map>();
+    auto status = parser.ParseMap(file, ele_map);
+    if (ErrorCode::OK == status.error_code) {
+      status = snapshot::SaveMap(*ele_map, snapshot_file);
+    }
+    if (ErrorCode::OK == status.error_code) {
+      status = snapshot::SaveMapImage(*ele_map, image_file);
+    }
+    if (ErrorCode::OK != status.error_code) {
+      std::fprintf(stderr, "prepare failed: %s\n", status.msg.c_str());
+      return 1;
+    }
+  }
+  std::printf("iterations: %zu (warm cache)\n", iterations);
+  std::printf("%-10s %12s %12s %14s\n", "mode", "bytes MB", "median ms",
+              "peak rss MB");
+  const std::vector<std::pair<Mode, std::string>> modes = {
+      {Mode::kXml, file},
+      {Mode::kSnapshot, snapshot_file},
+      {Mode::kImage, image_file},
+  };
+  for (const auto& mode : modes) {
+    std::vector<double> times;
+    long peak_rss_kb = 0;
+    RunOnce(mode.first, mode.second);  // warm up
+    for (size_t i = 0; i < iterations; i++) {
+      const auto result = RunOnce(mode.first, mode.second);
+      if (!result.ok) {
+        std::fprintf(stderr, "load failed: %s\n", mode.second.c_str());
+        return 1;
+      }
+      times.emplace_back(result.ms);
+      peak_rss_kb = std::max(peak_rss_kb, result.peak_rss_kb);
+    }
+    const char* name = Mode::kXml == mode.first        ? "xml"
+                       : Mode::kSnapshot == mode.first ? "snapshot"
+                                                       : "image";
+    std::printf("%-10s %12.2f %12.3f %14.2f\n", name,
+                bench::FileSize(mode.second) / 1024.0 / 1024.0,
+                bench::Median(times), peak_rss_kb / 1024.0);
+  }
+  std::remove(snapshot_file.c_str());
+  std::remove(image_file.c_str());
+  return 0;
+}
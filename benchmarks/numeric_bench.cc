@@ -0,0 +1,123 @@
+/**
+ * 数值属性解析吞吐量(attributes/second)
+ *
+ * before: tinyxml2 QueryXXXAttribute(std::string(name).c_str()) (sscanf)
+ * after:  common::XmlQueryXXXAttribute(name) (numeric.h)
+ *
+ * usage: numeric_bench [elements] [rounds]
+ */
+#include <tinyxml2.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "opendrive-cpp/common/common.hpp"
+
+using namespace opendrive;
+
+namespace {
+
+/// <width>/<border> 与 <geometry> 的典型属性
+const char* kPoly3Attributes[] = {"sOffset", "a", "b", "c", "d"};
+const char* kGeometryAttributes[] = {"s", "x", "y", "hdg", "length"};
+
+std::string MakeXml(size_t elements) {
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> coef(-1e-2, 1e-2);
+  std::uniform_real_distribution<double> pos(-1e4, 1e4);
+  std::string xml = "<lanes>";
+  char buffer[512];
+  for (size_t i = 0; i < elements; i++) {
+    std::snprintf(buffer, sizeof(buffer),
+                  "<width sOffset=\"%.16e\" a=\"%.16e\" b=\"%.16e\" "
+                  "c=\"%.16e\" d=\"%.16e\"/>"
+                  "<geometry s=\"%.4f\" x=\"%.15g\" y=\"%.15g\" "
+                  "hdg=\"%.15g\" length=\"%.3f\"/>"
+                  "<lane id=\"%d\"/>",
+                  pos(rng), 3.5 + coef(rng), coef(rng), coef(rng), coef(rng),
+                  pos(rng), pos(rng), pos(rng), coef(rng) * 300,
+                  std::abs(pos(rng)), static_cast<int>(i % 7) - 3);
+    xml += buffer;
+  }
+  xml += "</lanes>";
+  return xml;
+}
+
+template <typename F>
+double Run(const tinyxml2::XMLElement* root, size_t rounds, size_t* count,
+           F query) {
+  double sum = 0;
+  *count = 0;
+  bench::Timer timer;
+  for (size_t r = 0; r < rounds; r++) {
+    for (auto ele = root->FirstChildElement(); ele;
+         ele = ele->NextSiblingElement()) {
+      *count += query(ele, &sum);
+    }
+  }
+  const double ms = timer.ElapsedMs();
+  if (sum != sum) std::printf("nan\n");
+  return ms;
+}
+
+size_t QueryBefore(const tinyxml2::XMLElement* ele, double* sum) {
+  const char* name = ele->Name();
+  double value = 0;
+  int id = 0;
+  if ('l' == name[0]) {
+    ele->QueryIntAttribute(std::string("id").c_str(), &id);
+    *sum += id;
+    return 1;
+  }
+  const auto& names = 'w' == name[0] ? kPoly3Attributes : kGeometryAttributes;
+  for (const char* attribute : names) {
+    ele->QueryDoubleAttribute(std::string(attribute).c_str(), &value);
+    *sum += value;
+  }
+  return 5;
+}
+
+size_t QueryAfter(const tinyxml2::XMLElement* ele, double* sum) {
+  const char* name = ele->Name();
+  double value = 0;
+  int id = 0;
+  if ('l' == name[0]) {
+    common::XmlQueryIntAttribute(ele, "id", &id);
+    *sum += id;
+    return 1;
+  }
+  const auto& names = 'w' == name[0] ? kPoly3Attributes : kGeometryAttributes;
+  for (const char* attribute : names) {
+    common::XmlQueryDoubleAttribute(ele, attribute, &value);
+    *sum += value;
+  }
+  return 5;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const size_t elements =
+      argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+  const size_t rounds = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 5;
+  const std::string xml = MakeXml(elements);
+  tinyxml2::XMLDocument doc;
+  if (tinyxml2::XML_SUCCESS != doc.Parse(xml.c_str(), xml.size())) {
+    std::fprintf(stderr, "parse failed\n");
+    return 1;
+  }
+  const auto root = doc.RootElement();
+  size_t count = 0;
+  std::printf("elements: %zu, rounds: %zu\n", elements, rounds);
+  std::printf("%-8s %12s %16s\n", "mode", "ms", "attributes/s");
+  Run(root, 1, &count, QueryBefore);  // warm up
+  double ms = Run(root, rounds, &count, QueryBefore);
+  std::printf("%-8s %12.2f %16.0f\n", "before", ms, count / ms * 1000);
+  ms = Run(root, rounds, &count, QueryAfter);
+  std::printf("%-8s %12.2f %16.0f\n", "after", ms, count / ms * 1000);
+  return 0;
+}
@@ -0,0 +1,64 @@
+/**
+ * 整张地图折线生成的吞吐量(points/second/core)
+ *
+ * 参考线、车道中心线与车道边界, 分别在不构建/构建车道边界表时,
+ * 以 1, 2, 4, ... 个线程生成. per core 为点数除以各线程耗时之和.
+ *
+ * usage: polyline_bench [xodr] [copies] [step_m] [rounds]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "opendrive-cpp/common/thread_pool.h"
+#include "opendrive-cpp/opendrive.h"
+
+using namespace opendrive;
+
+int main(int argc, char* argv[]) {
+  const std::string file =
+      argc > 1 ? argv[1] : "./tests/data/UC_Simple-X-Junction.xodr";
+  const size_t copies = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 50;
+  const double step = argc > 3 ? std::atof(argv[3]) : 0.2;
+  const size_t rounds = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 5;
+  const std::string xml = bench::MakeSyntheticMap(file, copies);
+
+  std::printf("%-8s %8s %10s %12s %12s %14s\n", "table", "threads", "roads",
+              "points", "wall ms", "Mpoints/s/core");
+  for (bool table : {false, true}) {
+    ParseOptions parse_options;
+    parse_options.lane_boundary_tables = table;
+    auto ele_map = std::make_shared<element::Map>();
+    auto status =
+        Parser(parse_options).ParseMap(xml.data(), xml.size(), ele_map);
+    if (ErrorCode::OK != status.error_code) {
+      std::fprintf(stderr, "parse failed: %s\n", status.msg.c_str());
+      return 1;
+    }
+    const size_t max_threads =
+        std::max<size_t>(4, common::ThreadPool::HardwareConcurrency());
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+      PolylineOptions options;
+      options.step = step;
+      options.thread_num = threads;
+      MapPolylines polylines;
+      double wall_ms = 0;
+      double busy_ms = 0;
+      for (size_t r = 0; r < rounds; r++) {
+        GeneratePolylines(*ele_map, options, &polylines);
+        wall_ms += polylines.wall_ms();
+        busy_ms += polylines.busy_ms();
+      }
+      const double points =
+          static_cast<double>(polylines.points().size()) * rounds;
+      std::printf("%-8s %8zu %10zu %12zu %12.2f %14.2f\n",
+                  table ? "yes" : "no", polylines.thread_num(),
+                  ele_map->roads().size(), polylines.points().size(),
+                  wall_ms / rounds, points / busy_ms / 1e3);
+    }
+  }
+  return 0;
+}
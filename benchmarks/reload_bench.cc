@@ -0,0 +1,94 @@
+/**
+ * Parser::ParseMap vs Parser::ReloadMap: 小范围编辑后重新加载的耗时
+ *
+ * 编辑方式: 在若干 <road> 起始标签中插入一个空格, 内容不变但片段指纹变化.
+ *
+ * usage: reload_bench [xodr_file] [copies] [iterations]
+ *   copies > 1 时以 xodr_file 为种子生成大地图
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "opendrive-cpp/opendrive.h"
+
+using namespace opendrive;
+
+namespace {
+
+/// 均匀地编辑 edits 个 road
+std::string EditRoads(const std::string& xml, size_t edits) {
+  std::vector<size_t> tags;
+  for (size_t pos = xml.find("<road "); std::string::npos != pos;
+       pos = xml.find("<road ", pos + 1)) {
+    tags.emplace_back(pos);
+  }
+  std::string out = xml;
+  edits = std::min(edits, tags.size());
+  /// 从后往前插入, 之前的位置不受影响
+  for (size_t i = edits; i > 0; i--) {
+    out.insert(tags[(i - 1) * tags.size() / edits] + 5, " ");
+  }
+  return out;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string file = argc > 1 ? argv[1] : "./tests/data/only-unittest.xodr";
+  const size_t copies = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000;
+  const size_t iterations = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 5;
+  std::string xml = bench::ReadFile(file);
+  if (copies > 1) {
+    xml = bench::MakeSyntheticMap(file, copies);
+  }
+  Parser parser;
+  auto base_map = std::make_shared<element::Map>();
+  auto status = parser.ReloadMap(xml.data(), xml.size(), base_map);
+  if (ErrorCode::OK != status.error_code) {
+    std::fprintf(stderr, "parse failed: %s\n", status.msg.c_str());
+    return 1;
+  }
+  const size_t road_num = base_map->roads().size();
+  std::printf("roads: %zu (%.2f MB), iterations: %zu\n", road_num,
+              xml.size() / 1024.0 / 1024.0, iterations);
+  std::printf("%-8s %8s %12s %10s\n", "mode", "edited", "median ms",
+              "reparsed");
+  {
+    std::vector<double> times;
+    for (size_t i = 0; i < iterations; i++) {
+      auto ele_map = std::make_shared<element::Map>();
+      bench::Timer timer;
+      status = parser.ParseMap(xml.data(), xml.size(), ele_map);
+      times.emplace_back(timer.ElapsedMs());
+    }
+    std::printf("%-8s %8s %12.2f %10zu\n", "parse", "-", bench::Median(times),
+                road_num);
+  }
+  for (size_t edits : {0, 1, 10, 100}) {
+    if (edits > road_num) break;
+    const std::string edited = EditRoads(xml, edits);
+    std::vector<double> times;
+    size_t reparsed = 0;
+    for (size_t i = 0; i < iterations; i++) {
+      /// 每次从未编辑的版本开始
+      auto ele_map = std::make_shared<element::Map>();
+      status = parser.ReloadMap(xml.data(), xml.size(), ele_map);
+      parser::MapDiff diff;
+      bench::Timer timer;
+      status = parser.ReloadMap(edited.data(), edited.size(), ele_map, &diff);
+      times.emplace_back(timer.ElapsedMs());
+      if (ErrorCode::OK != status.error_code) {
+        std::fprintf(stderr, "reload failed: %s\n", status.msg.c_str());
+        return 1;
+      }
+      reparsed = road_num - diff.reused_roads;
+    }
+    std::printf("%-8s %8zu %12.2f %10zu\n", "reload", edits,
+                bench::Median(times), reparsed);
+  }
+  return 0;
+}
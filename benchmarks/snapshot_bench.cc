@@ -0,0 +1,92 @@
+/**
+ * Parser::ParseMap(xml_file) vs snapshot::LoadMap(snapshot_file)
+ *
+ * usage: snapshot_bench [xodr_file] [copies] [iterations]
+ *   copies > 1 时以 xodr_file 为种子生成大地图
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "opendrive-cpp/opendrive.h"
+#include "opendrive-cpp/snapshot/snapshot.h"
+
+using namespace opendrive;
+
+namespace {
+
+bench::ChildResult RunOnce(const std::string& file, bool use_snapshot,
+                           bool cold) {
+  if (cold) {
+    bench::DropPageCache(file);
+  }
+  return bench::RunInChild([&](double* ms) {
+    auto ele_map = std::make_shared<element::Map>();
+    bench::Timer timer;
+    Status status{ErrorCode::OK, "ok"};
+    if (use_snapshot) {
+      status = snapshot::LoadMap(file, ele_map);
+    } else {
+      Parser parser;
+      status = parser.ParseMap(file, ele_map);
+    }
+    *ms = timer.ElapsedMs();
+    return ErrorCode::OK == status.error_code;
+  });
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string file = argc > 1 ? argv[1] : "./tests/data/only-unittest.xodr";
+  const size_t copies = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200;
+  const size_t iterations = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 5;
+  if (copies > 1) {
+    const std::string synthetic = "./snapshot_bench_synthetic.xodr";
+    bench::WriteFile(synthetic, bench::MakeSyntheticMap(file, copies));
+    file = synthetic;
+  }
+  const std::string snapshot_file = "./snapshot_bench.odrsnap";
+  {
+    Parser parser;
+    auto ele_map = std::make_shared<element::Map>();
+    auto status = parser.ParseMap(file, ele_map);
+    if (ErrorCode::OK == status.error_code) {
+      status = snapshot::SaveMap(*ele_map, snapshot_file);
+    }
+    if (ErrorCode::OK != status.error_code) {
+      std::fprintf(stderr, "prepare failed: %s\n", status.msg.c_str());
+      return 1;
+    }
+  }
+  std::printf("iterations: %zu\n", iterations);
+  std::printf("%-10s %-6s %12s %12s %14s\n", "mode", "cache", "bytes MB",
+              "median ms", "peak rss MB");
+  for (bool cold : {true, false}) {
+    for (bool use_snapshot : {false, true}) {
+      const std::string& input = use_snapshot ? snapshot_file : file;
+      std::vector<double> times;
+      long peak_rss_kb = 0;
+      RunOnce(input, use_snapshot, false);  // warm up
+      for (size_t i = 0; i < iterations; i++) {
+        const auto result = RunOnce(input, use_snapshot, cold);
+        if (!result.ok) {
+          std::fprintf(stderr, "load failed: %s\n", input.c_str());
+          return 1;
+        }
+        times.emplace_back(result.ms);
+        peak_rss_kb = std::max(peak_rss_kb, result.peak_rss_kb);
+      }
+      std::printf("%-10s %-6s %12.2f %12.2f %14.2f\n",
+                  use_snapshot ? "snapshot" : "xml", cold ? "cold" : "warm",
+                  bench::FileSize(input) / 1024.0 / 1024.0,
+                  bench::Median(times), peak_rss_kb / 1024.0);
+    }
+  }
+  std::remove(snapshot_file.c_str());
+  return 0;
+}
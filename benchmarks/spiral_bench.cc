@@ -0,0 +1,198 @@
+/**
+ * 螺旋线求值的精度与吞吐量(samples/second)
+ *
+ * legacy:   原实现, 每个样本调用两次 odrSpiral, 第二次误传 s1
+ * two-call: 原实现修正为 s0 后的结果, 仍然每个样本两次 odrSpiral
+ * GetPoint / GetPoints: 构造时预计算, 每个样本一次 Fresnel 积分
+ *
+ * 以及各指令集 odrSpiralBatch 相对逐个 odrSpiral 的吞吐量与最大差异
+ *
+ * 误差相对于对 heading 的数值积分(Simpson, long double)
+ *
+ * usage: spiral_bench [samples] [rounds]
+ */
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "bench_util.h"
+#include "opendrive-cpp/opendrive.h"
+
+using namespace opendrive;
+
+namespace {
+
+element::Point TwoCallPoint(const element::GeometrySpiral& spiral,
+                            double road_ds, bool legacy) {
+  const double curve_dot = spiral.curve_dot();
+  const double ref_line_ds = road_ds - spiral.s();
+  const double s0 = spiral.curve_start() / curve_dot;
+  const double s1 = s0 + ref_line_ds;
+  double x1;
+  double y1;
+  double t1;
+  odrSpiral(s1, curve_dot, &x1, &y1, &t1);
+  double x0;
+  double y0;
+  double t0;
+  odrSpiral(legacy ? s1 : s0, curve_dot, &x0, &y0, &t0);
+  x1 -= x0;
+  y1 -= y0;
+  t1 -= t0;
+  const double angle = spiral.hdg() - t0;
+  const double cos_a = std::cos(angle);
+  const double sin_a = std::sin(angle);
+  return element::Point{spiral.x() + x1 * cos_a - y1 * sin_a,
+                        spiral.y() + y1 * cos_a + x1 * sin_a, 0,
+                        spiral.hdg() + t1};
+}
+
+element::Point Integrate(const element::GeometrySpiral& spiral, double ds) {
+  const long double k0 = spiral.curve_start();
+  const long double k_dot =
+      (static_cast<long double>(spiral.curve_end()) - k0) / spiral.length();
+  auto heading = [&](long double u) {
+    return spiral.hdg() + u * (k0 + 0.5L * k_dot * u);
+  };
+  const int n = 4096;
+  const long double h = static_cast<long double>(ds) / n;
+  long double x = 0;
+  long double y = 0;
+  for (int i = 0; i <= n; i++) {
+    const long double w = (0 == i || n == i) ? 1 : (i % 2 ? 4 : 2);
+    x += w * std::cos(heading(i * h));
+    y += w * std::sin(heading(i * h));
+  }
+  return element::Point(static_cast<double>(spiral.x() + x * h / 3),
+                        static_cast<double>(spiral.y() + y * h / 3), 0,
+                        static_cast<double>(heading(ds)));
+}
+
+struct Error {
+  double position = 0;
+  double heading = 0;
+  void Add(const element::Point& expect, const element::Point& point) {
+    position = std::max(position, std::hypot(expect.x() - point.x(),
+                                             expect.y() - point.y()));
+    heading = std::max(heading, std::fabs(expect.heading() - point.heading()));
+  }
+};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const size_t samples = argc > 1 ? std::atol(argv[1]) : 4096;
+  const size_t rounds = argc > 2 ? std::atol(argv[2]) : 500;
+
+  /// {length, curve_start, curve_end}
+  const std::vector<std::array<double, 3>> params = {
+      {30, 0, 0.05},
+      {30, 0.05, 0},
+      {80, -0.02, 0.03},
+      {120, 0.01, 0.0125},
+  };
+  std::vector<double> road_s(samples);
+  std::vector<element::Point> points(samples);
+  double sum = 0;
+  std::printf("%-22s %10s %10s %10s %10s %10s\n", "spiral", "legacy",
+              "two-call", "GetPoint", "GetPoints", "speedup");
+  std::printf("%-22s %10s %10s %10s %10s\n", "", "pos err", "pos err",
+              "pos err", "hdg err");
+  for (const auto& param : params) {
+    const element::GeometrySpiral spiral(0, 100, 200, 0.3, param[0],
+                                         GeometryType::kSpiral, param[1],
+                                         param[2]);
+    for (size_t i = 0; i < samples; i++) {
+      road_s[i] = param[0] * i / samples;
+    }
+    Error legacy_error;
+    Error two_call_error;
+    Error error;
+    for (size_t i = 0; i < samples; i += std::max<size_t>(1, samples / 64)) {
+      const auto expect = Integrate(spiral, road_s[i]);
+      legacy_error.Add(expect, TwoCallPoint(spiral, road_s[i], true));
+      two_call_error.Add(expect, TwoCallPoint(spiral, road_s[i], false));
+      error.Add(expect, spiral.GetPoint(road_s[i]));
+    }
+
+    const double total = static_cast<double>(samples) * rounds;
+    std::array<double, 4> ms{};
+    for (size_t k = 0; k < ms.size(); k++) {
+      bench::Timer timer;
+      for (size_t r = 0; r < rounds; r++) {
+        switch (k) {
+          case 0:
+          case 1:
+            for (size_t i = 0; i < samples; i++) {
+              points[i] = TwoCallPoint(spiral, road_s[i], 0 == k);
+            }
+            break;
+          case 2:
+            for (size_t i = 0; i < samples; i++) {
+              points[i] = spiral.GetPoint(road_s[i]);
+            }
+            break;
+          default:
+            spiral.GetPoints(road_s.data(), samples, points.data());
+        }
+        sum += points[r % samples].x();
+      }
+      ms[k] = timer.ElapsedMs();
+    }
+    char name[64];
+    std::snprintf(name, sizeof(name), "%g->%g/%gm", param[1], param[2],
+                  param[0]);
+    std::printf("%-22s %10.3g %10.3g %10.3g %10.3g\n", name,
+                legacy_error.position, two_call_error.position,
+                error.position, error.heading);
+    std::printf("%-22s %10.2f %10.2f %10.2f %10.2f %9.2fx\n", "  Msamples/s",
+                total / ms[0] / 1e3, total / ms[1] / 1e3, total / ms[2] / 1e3,
+                total / ms[3] / 1e3, ms[1] / ms[3]);
+  }
+
+  const double cdot = 0.05 / 30;
+  std::vector<double> x(samples);
+  std::vector<double> y(samples);
+  std::vector<double> t(samples);
+  /// Fresnel 积分自变量覆盖两个区间
+  for (size_t i = 0; i < samples; i++) {
+    road_s[i] = 150.0 * i / samples;
+  }
+  const double total = static_cast<double>(samples) * rounds;
+  bench::Timer timer;
+  for (size_t r = 0; r < rounds; r++) {
+    for (size_t i = 0; i < samples; i++) {
+      odrSpiral(road_s[i], cdot, &x[i], &y[i], &t[i]);
+    }
+    sum += x[r % samples];
+  }
+  const std::vector<double> expect_x = x;
+  const std::vector<double> expect_y = y;
+  std::printf("\n%-22s %10.2f Msamples/s\n", "odrSpiral",
+              total / timer.ElapsedMs() / 1e3);
+  const auto supported = common::SupportedSimdLevel();
+  for (int level = 0; level <= static_cast<int>(supported); level++) {
+    common::SetSimdLevel(static_cast<common::SimdLevel>(level));
+    timer.Reset();
+    for (size_t r = 0; r < rounds; r++) {
+      odrSpiralBatch(road_s.data(), samples, cdot, x.data(), y.data(),
+                     t.data());
+      sum += x[r % samples];
+    }
+    const double ms = timer.ElapsedMs();
+    double error = 0;
+    for (size_t i = 0; i < samples; i++) {
+      error = std::max(error, std::hypot(expect_x[i] - x[i],
+                                         expect_y[i] - y[i]));
+    }
+    std::printf("odrSpiralBatch %-7s %10.2f Msamples/s  max diff %.3g m\n",
+                common::SimdLevelName(static_cast<common::SimdLevel>(level)),
+                total / ms / 1e3, error);
+  }
+  common::SetSimdLevel(supported);
+  if (sum != sum) std::printf("nan\n");
+  return 0;
+}
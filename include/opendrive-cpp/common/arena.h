@@ -0,0 +1,133 @@
+#ifndef OPENDRIVE_CPP_COMMON_ARENA_H_
+#define OPENDRIVE_CPP_COMMON_ARENA_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+namespace opendrive {
+namespace common {
+
+/**
+ * @brief 单调增长的内存池, 只分配不单独释放, Release()/析构时一次性归还
+ *
+ * Allocate 可以多线程并发调用: 每个线程持有自己的当前内存块, 只有换块时加锁.
+ * Release 不能与 Allocate 并发.
+ */
+class Arena {
+ public:
+  static constexpr size_t kDefaultBlockSize = 64 * 1024;
+  static constexpr size_t kMaxBlockSize = 4 * 1024 * 1024;
+  explicit Arena(size_t block_size = kDefaultBlockSize);
+  ~Arena();
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  void* Allocate(size_t bytes, size_t alignment);
+  /// 归还全部内存块, 之前分配的内存全部失效
+  void Release();
+  /// 已向系统申请的字节数
+  size_t bytes_reserved() const noexcept {
+    return bytes_reserved_.load(std::memory_order_relaxed);
+  }
+
+  /// 当前线程的 arena(见 ScopedArena), 没有时为 nullptr
+  static Arena* Current() noexcept;
+
+ private:
+  friend class ScopedArena;
+  struct Block {
+    Block* next;
+    size_t size;
+  };
+  void* AllocateSlow(size_t bytes, size_t alignment);
+  Block* NewBlock(size_t size);
+
+  std::mutex mutex_;
+  Block* blocks_ = nullptr;
+  const size_t block_size_;
+  size_t next_block_size_;
+  /// 每次 Release 后更换, 用于识别线程缓存的块是否属于本 arena
+  std::atomic<uint64_t> id_;
+  std::atomic<size_t> bytes_reserved_{0};
+};
+
+/**
+ * @brief 在作用域内设置当前线程的 arena, 退出时恢复
+ *
+ * 作用域内默认构造的 element 容器都从该 arena 分配.
+ * arena 为 nullptr 时恢复为堆分配.
+ */
+class ScopedArena {
+ public:
+  explicit ScopedArena(Arena* arena) noexcept;
+  ~ScopedArena();
+  ScopedArena(const ScopedArena&) = delete;
+  ScopedArena& operator=(const ScopedArena&) = delete;
+
+ private:
+  Arena* prev_;
+};
+
+/**
+ * @brief 从 Arena 分配的 std 分配器, arena 为 nullptr 时使用 operator new
+ *
+ * 默认构造时绑定 Arena::Current(); 移动/交换时跟随源容器, 拷贝构造时绑定
+ * 当前线程的 arena, 拷贝赋值保持目标容器原有的 arena.
+ */
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  template <typename U>
+  struct rebind {
+    using other = ArenaAllocator<U>;
+  };
+
+  ArenaAllocator() noexcept : arena_(Arena::Current()) {}
+  explicit ArenaAllocator(Arena* arena) noexcept : arena_(arena) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+      : arena_(other.arena()) {}
+
+  T* allocate(size_t n) {
+    if (!arena_) {
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T* ptr, size_t) noexcept {
+    if (!arena_) ::operator delete(ptr);
+  }
+  ArenaAllocator select_on_container_copy_construction() const noexcept {
+    return ArenaAllocator();
+  }
+  Arena* arena() const noexcept { return arena_; }
+
+ private:
+  Arena* arena_;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a,
+                const ArenaAllocator<U>& b) noexcept {
+  return a.arena() == b.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a,
+                const ArenaAllocator<U>& b) noexcept {
+  return a.arena() != b.arena();
+}
+
+}  // namespace common
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_CPP_COMMON_ARENA_H_
@@ -1,12 +1,84 @@
 #ifndef OPENDRIVE_CPP_CHOICES_H_
 #define OPENDRIVE_CPP_CHOICES_H_
 
+#include <cstddef>
 #include <map>
+#include <string>
 
 #include "opendrive-cpp/geometry/enums.h"
 
 namespace opendrive {
 
+/// ASCII 小写, 与 locale 无关
+constexpr char ChoiceToLower(char c) {
+  return ('A' <= c && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+/// 不区分大小写比较, 返回值同 strcmp
+constexpr int ChoiceCompare(const char* a, const char* b) {
+  while (*a && ChoiceToLower(*a) == ChoiceToLower(*b)) {
+    ++a;
+    ++b;
+  }
+  return static_cast<unsigned char>(ChoiceToLower(*a)) -
+         static_cast<unsigned char>(ChoiceToLower(*b));
+}
+
+template <typename T>
+struct Choice {
+  const char* name;
+  T value;
+};
+
+template <typename T, size_t N>
+constexpr bool IsSortedChoices(const Choice<T> (&choices)[N]) {
+  for (size_t i = 1; i < N; i++) {
+    if (ChoiceCompare(choices[i - 1].name, choices[i].name) >= 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief 枚举名称查找表
+ *
+ * 表项按小写名称排序(编译期 static_assert 检查), 不区分大小写二分查找,
+ * 直接比较属性原始字符串, 不分配内存
+ */
+template <typename T>
+class ChoiceTable {
+ public:
+  template <size_t N>
+  constexpr explicit ChoiceTable(const Choice<T> (&choices)[N])
+      : choices_(choices), size_(N) {}
+
+  bool Find(const char* name, T* value) const {
+    size_t low = 0;
+    size_t high = size_;
+    while (low < high) {
+      const size_t mid = low + (high - low) / 2;
+      const int ret = ChoiceCompare(choices_[mid].name, name);
+      if (ret < 0) {
+        low = mid + 1;
+      } else if (ret > 0) {
+        high = mid;
+      } else {
+        *value = choices_[mid].value;
+        return true;
+      }
+    }
+    return false;
+  }
+  const Choice<T>* begin() const noexcept { return choices_; }
+  const Choice<T>* end() const noexcept { return choices_ + size_; }
+  size_t size() const noexcept { return size_; }
+
+ private:
+  const Choice<T>* choices_;
+  size_t size_;
+};
+
 extern const std::map<Boolean, std::string> BOOLEAN_CHOICES;
 
 extern const std::map<GeometryType, std::string> GEOMETRY_TYPE_CHOICES;
@@ -41,6 +113,40 @@ extern const std::map<ContactPointType, std::string> CONTACT_POINT_TYPE_CHOICES;
 
 extern const std::map<Dir, std::string> DIR_CHOICES;
 
+/// 解析用查找表, 与 *_CHOICES 一一对应
+
+extern const ChoiceTable<Boolean> BOOLEAN_TABLE;
+
+extern const ChoiceTable<GeometryType> GEOMETRY_TYPE_TABLE;
+
+extern const ChoiceTable<LaneType> LANE_TYPE_TABLE;
+
+extern const ChoiceTable<RoadMarkType> ROADMARK_TYPE_TABLE;
+
+extern const ChoiceTable<RoadMarkColor> ROAD_MARK_COLOR_TABLE;
+
+extern const ChoiceTable<RoadMarkWeight> ROAD_MARK_WEIGHT_TABLE;
+
+extern const ChoiceTable<RoadMarkLaneChange> ROAD_MARK_LANE_CHANGE_TABLE;
+
+extern const ChoiceTable<RoadRule> ROAD_RULE_TABLE;
+
+extern const ChoiceTable<RoadType> ROAD_TYPE_TABLE;
+
+extern const ChoiceTable<RoadLinkType> ROAD_LINK_TYPE_TABLE;
+
+extern const ChoiceTable<SpeedUnit> SPEEDUNIT_TABLE;
+
+extern const ChoiceTable<LaneDirection> LANE_DIRECTION_TABLE;
+
+extern const ChoiceTable<JunctionType> JUNCTION_TYPE_TABLE;
+
+extern const ChoiceTable<JunctionConnectionType> JUNCTION_CONNECTION_TYPE_TABLE;
+
+extern const ChoiceTable<ContactPointType> CONTACT_POINT_TYPE_TABLE;
+
+extern const ChoiceTable<Dir> DIR_TABLE;
+
 }  // namespace opendrive
 
 #endif  // OPENDRIVE_CPP_CHOICES_H_
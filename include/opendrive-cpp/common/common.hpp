@@ -18,6 +18,8 @@
 #include <unordered_map>
 #include <vector>
 
+#include "opendrive-cpp/common/choices.h"
+#include "opendrive-cpp/common/numeric.h"
 #include "opendrive-cpp/geometry/enums.h"
 
 namespace opendrive {
@@ -74,67 +76,151 @@ static T GetOffsetPoint(const T& point, double lateral_offset) {
  * @param items Poloy3 vector;
  * @param asc 升序/降序
  */
-template <typename T>
-static void VectorSortPoloy3(std::vector<T>* items, bool asc = true) {
+template <typename T, typename A>
+static void VectorSortPoloy3(std::vector<T, A>* items, bool asc = true) {
   std::sort(items->begin(), items->end(), [asc](const T& t1, const T& t2) {
     return asc ? t1.s() < t2.s() : t1.s() > t2.s();
   });
 }
 
+/// Poloy3 元素或其指针的起点 s
+template <typename T>
+static auto GetPoloy3S(const T& item) -> decltype(item.s()) {
+  return item.s();
+}
+
+template <typename T>
+static auto GetPoloy3S(const T& item) -> decltype(item->s()) {
+  return item->s();
+}
+
 /**
- * @brief 获取目标值左边的元素(包括目标值)
+ * @brief 获取目标值左边的元素(包括目标值), 二分查找 O(log n)
  *
- * @tparam T1 element::Poloy3
+ * @tparam T1 element::Poloy3 或其指针
  * @tparam T2 number
  * @param items ascending sequence
  * @param target target value
- * @return sequence index or -1
+ * @return 最后一个 s <= target 的下标, 没有时(包括 target 为 nan)为 -1
  */
-template <typename T1, typename T2>
-static int GetGeValuePoloy3(const std::vector<T1>& items, T2 target) {
-  if (items.empty() || target < items.at(0).s()) return -1;
-  for (int i = items.size() - 1; i >= 0; i--) {
-    if (target >= items.at(i).s()) return i;
-  }
-  return -1;
+template <typename T1, typename A, typename T2>
+static int GetGeValuePoloy3(const std::vector<T1, A>& items, T2 target) {
+  if (items.empty() || !(target >= GetPoloy3S(items.front()))) return -1;
+  const auto it = std::upper_bound(
+      items.begin(), items.end(), target,
+      [](const T2& value, const T1& item) { return value < GetPoloy3S(item); });
+  return static_cast<int>(it - items.begin()) - 1;
 }
 
 /**
- * @brief 获取目标值左边的元素(不包括目标值)
+ * @brief 获取目标值左边的元素(不包括目标值), 二分查找 O(log n)
  *
- * @tparam T1 element::Poloy3
+ * @tparam T1 element::Poloy3 或其指针
  * @tparam T2 number
  * @param items ascending sequence
  * @param target target value
- * @return sequence index or -1
+ * @return 最后一个 s < target 的下标; target 小于第一个 s 时为 -1,
+ * 等于第一个 s(或为 nan)时为 0
  */
-template <typename T1, typename T2>
-static int GetGtValuePoloy3(const std::vector<T1>& items, T2 target) {
-  if (items.empty() || target < items.at(0).s()) return -1;
-  if (target < items.at(0).s()) return -1;
-  for (int i = items.size() - 1; i >= 0; i--) {
-    if (target > items.at(i).s()) return i;
-  }
-  return 0;
+template <typename T1, typename A, typename T2>
+static int GetGtValuePoloy3(const std::vector<T1, A>& items, T2 target) {
+  if (items.empty() || target < GetPoloy3S(items.front())) return -1;
+  const auto it = std::lower_bound(
+      items.begin(), items.end(), target,
+      [](const T1& item, const T2& value) { return GetPoloy3S(item) < value; });
+  return std::max(0, static_cast<int>(it - items.begin()) - 1);
 }
 
-template <typename T1, typename T2>
-static int GetGePtrPoloy3(const std::vector<T1>& items, T2 target) {
-  if (items.empty() || target < items.at(0)->s()) return -1;
-  for (int i = items.size() - 1; i >= 0; i--) {
-    if (target >= items.at(i)->s()) return i;
-  }
-  return -1;
+template <typename T1, typename A, typename T2>
+static int GetGePtrPoloy3(const std::vector<T1, A>& items, T2 target) {
+  return GetGeValuePoloy3(items, target);
+}
+
+template <typename T1, typename A, typename T2>
+static int GetGtPtrPoloy3(const std::vector<T1, A>& items, T2 target) {
+  return GetGtValuePoloy3(items, target);
 }
 
-template <typename T1, typename T2>
-static int GetGtPtrPoloy3(const std::vector<T1>& items, T2 target) {
-  if (items.empty() || target < items.at(0)->s()) return -1;
-  if (target < items.at(0)->s()) return -1;
-  for (int i = items.size() - 1; i >= 0; i--) {
-    if (target > items.at(i)->s()) return i;
+/**
+ * @brief 分段查找游标, 从上一次的下标开始倍增查找
+ *
+ * 结果与 GetGeValuePoloy3/GetGtValuePoloy3 相同. target 单调递增或
+ * 递减(步长小于分段长度)时均摊 O(1), 任意跳转时 O(log n).
+ * 游标保存 items 的指针, 使用期间 items 不能修改.
+ *
+ * @tparam T element::Poloy3 或其指针
+ */
+template <typename T, typename A>
+class Poloy3Cursor {
+ public:
+  explicit Poloy3Cursor(const std::vector<T, A>& items) : items_(&items) {}
+
+  /// 同 GetGeValuePoloy3
+  template <typename T2>
+  int Ge(T2 target) {
+    const auto& items = *items_;
+    if (items.empty() || !(target >= GetPoloy3S(items.front()))) return -1;
+    return Seek([&](size_t i) { return GetPoloy3S(items[i]) <= target; });
+  }
+
+  /// 同 GetGtValuePoloy3
+  template <typename T2>
+  int Gt(T2 target) {
+    const auto& items = *items_;
+    if (items.empty() || target < GetPoloy3S(items.front())) return -1;
+    if (!(GetPoloy3S(items.front()) < target)) return 0;
+    return Seek([&](size_t i) { return GetPoloy3S(items[i]) < target; });
+  }
+
+ private:
+  /**
+   * @brief pred 在 [0, k] 上为 true, 之后为 false, 返回 k
+   *
+   * 调用方保证 pred(0) 为 true
+   */
+  template <typename P>
+  int Seek(const P& pred) {
+    const size_t size = items_->size();
+    /// 循环中保持 pred(lo) 为 true, hi == size 或 pred(hi) 为 false
+    size_t lo = std::min(hint_, size - 1);
+    size_t hi;
+    size_t step = 1;
+    if (pred(lo)) {
+      hi = lo + step;
+      while (hi < size && pred(hi)) {
+        lo = hi;
+        step *= 2;
+        hi = lo + step;
+      }
+      hi = std::min(hi, size);
+    } else {
+      hi = lo;
+      lo = hi - step;
+      while (!pred(lo)) {
+        hi = lo;
+        step *= 2;
+        lo = hi > step ? hi - step : 0;
+      }
+    }
+    while (hi - lo > 1) {
+      const size_t mid = lo + (hi - lo) / 2;
+      if (pred(mid)) {
+        lo = mid;
+      } else {
+        hi = mid;
+      }
+    }
+    hint_ = lo;
+    return static_cast<int>(lo);
   }
-  return 0;
+
+  const std::vector<T, A>* items_;
+  size_t hint_ = 0;
+};
+
+template <typename T, typename A>
+static Poloy3Cursor<T, A> MakePoloy3Cursor(const std::vector<T, A>& items) {
+  return Poloy3Cursor<T, A>(items);
 }
 
 static bool FileExists(const std::string& path) {
@@ -188,16 +274,15 @@ static bool StrEquals(const std::string& a, const std::string& b) {
 }
 
 static tinyxml2::XMLError XmlQueryBoolAttribute(
-    const tinyxml2::XMLElement* xml_node, const std::string& name,
-    bool& value) {
-  tinyxml2::XMLError ret = xml_node->QueryBoolAttribute(name.c_str(), &value);
+    const tinyxml2::XMLElement* xml_node, const char* name, bool& value) {
+  tinyxml2::XMLError ret = xml_node->QueryBoolAttribute(name, &value);
   return ret;
 }
 
+template <typename String>
 static tinyxml2::XMLError XmlQueryStringAttribute(
-    const tinyxml2::XMLElement* xml_node, const std::string& name,
-    std::string* value) {
-  const char* val = xml_node->Attribute(name.c_str());
+    const tinyxml2::XMLElement* xml_node, const char* name, String* value) {
+  const char* val = xml_node->Attribute(name);
   if (nullptr == val) {
     return tinyxml2::XML_NO_ATTRIBUTE;
   }
@@ -205,43 +290,64 @@ static tinyxml2::XMLError XmlQueryStringAttribute(
   return tinyxml2::XML_SUCCESS;
 }
 
+/// 数值属性使用 numeric.h 解析, 与 locale 无关, 不分配内存
+template <typename T, typename F>
+static tinyxml2::XMLError XmlQueryNumericAttribute(
+    const tinyxml2::XMLElement* xml_node, const char* name, T* value,
+    F parse) {
+  const char* val = xml_node->Attribute(name);
+  if (nullptr == val) {
+    return tinyxml2::XML_NO_ATTRIBUTE;
+  }
+  return parse(val, value) ? tinyxml2::XML_SUCCESS
+                           : tinyxml2::XML_WRONG_ATTRIBUTE_TYPE;
+}
+
 static tinyxml2::XMLError XmlQueryIntAttribute(
-    const tinyxml2::XMLElement* xml_node, const std::string& name, int* value) {
-  tinyxml2::XMLError ret = xml_node->QueryIntAttribute(name.c_str(), value);
-  return ret;
+    const tinyxml2::XMLElement* xml_node, const char* name, int* value) {
+  return XmlQueryNumericAttribute(xml_node, name, value, ParseInt);
 }
 
 static tinyxml2::XMLError XmlQueryFloatAttribute(
-    const tinyxml2::XMLElement* xml_node, const std::string& name,
-    float* value) {
-  tinyxml2::XMLError ret = xml_node->QueryFloatAttribute(name.c_str(), value);
-  return ret;
+    const tinyxml2::XMLElement* xml_node, const char* name, float* value) {
+  return XmlQueryNumericAttribute(xml_node, name, value, ParseFloat);
 }
 
 static tinyxml2::XMLError XmlQueryDoubleAttribute(
-    const tinyxml2::XMLElement* xml_node, const std::string& name,
-    double* value) {
-  return xml_node->QueryDoubleAttribute(name.c_str(), value);
+    const tinyxml2::XMLElement* xml_node, const char* name, double* value) {
+  return XmlQueryNumericAttribute(xml_node, name, value, ParseDouble);
 }
 
 template <typename T>
 static tinyxml2::XMLError XmlQueryEnumAttribute(
-    const tinyxml2::XMLElement* xml_node, const std::string& name, T* value,
+    const tinyxml2::XMLElement* xml_node, const char* name, T* value,
     const std::map<T, std::string>& choices) {
-  std::string var;
-  tinyxml2::XMLError ret = XmlQueryStringAttribute(xml_node, name, &var);
-  if (tinyxml2::XMLError::XML_SUCCESS != ret) {
-    return ret;
+  const char* var = xml_node->Attribute(name);
+  if (nullptr == var) {
+    return tinyxml2::XMLError::XML_NO_ATTRIBUTE;
   }
-  ret = tinyxml2::XMLError::XML_ERROR_PARSING_TEXT;
   for (const auto& choice : choices) {
-    if (StrEquals(choice.second, var)) {
+    if (0 == ChoiceCompare(choice.second.c_str(), var)) {
       *value = choice.first;
-      ret = tinyxml2::XMLError::XML_SUCCESS;
-      break;
+      return tinyxml2::XMLError::XML_SUCCESS;
     }
   }
-  return ret;
+  return tinyxml2::XMLError::XML_ERROR_PARSING_TEXT;
+}
+
+/**
+ * @brief 使用 ChoiceTable 解析枚举属性, 不分配内存
+ */
+template <typename T>
+static tinyxml2::XMLError XmlQueryEnumAttribute(
+    const tinyxml2::XMLElement* xml_node, const char* name, T* value,
+    const ChoiceTable<T>& choices) {
+  const char* var = xml_node->Attribute(name);
+  if (nullptr == var) {
+    return tinyxml2::XMLError::XML_NO_ATTRIBUTE;
+  }
+  return choices.Find(var, value) ? tinyxml2::XMLError::XML_SUCCESS
+                                  : tinyxml2::XMLError::XML_ERROR_PARSING_TEXT;
 }
 
 static const tinyxml2::XMLElement* XmlNextSiblingElement(
@@ -249,6 +355,18 @@ static const tinyxml2::XMLElement* XmlNextSiblingElement(
   return element->NextSiblingElement(element->Name());
 }
 
+/**
+ * @brief 统计element及其之后的同名兄弟节点个数, 用于预留容器空间
+ *
+ * @param element 第一个节点, 可为空
+ * @return 节点个数
+ */
+inline size_t XmlSiblingElementCount(const tinyxml2::XMLElement* element) {
+  size_t count = 0;
+  for (; element; element = XmlNextSiblingElement(element)) count++;
+  return count;
+}
+
 }  // namespace common
 }  // namespace opendrive
 
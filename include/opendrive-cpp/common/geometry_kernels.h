@@ -0,0 +1,107 @@
+#ifndef OPENDRIVE_CPP_COMMON_GEOMETRY_KERNELS_H_
+#define OPENDRIVE_CPP_COMMON_GEOMETRY_KERNELS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace opendrive {
+namespace common {
+
+/**
+ * @brief 参考线批量求值使用的指令集
+ *
+ * 默认选择 CPU 与编译选项支持的最高级别. x86_64 上 kSse2 总是可用,
+ * kAvx2 需要以 BUILD_OPENDRIVECPP_SIMD=ON 编译且 CPU 支持 AVX2/FMA.
+ */
+enum class SimdLevel : std::uint8_t { kScalar = 0, kSse2, kAvx2 };
+
+/// 当前 CPU 与编译选项支持的最高级别
+SimdLevel SupportedSimdLevel();
+/// 当前使用的级别
+SimdLevel GetSimdLevel();
+/// 设置使用的级别(测试与基准用), 超过 SupportedSimdLevel 时取后者
+void SetSimdLevel(SimdLevel level);
+const char* SimdLevelName(SimdLevel level);
+
+/// geometry 起点, 与 element::Geometry 的同名成员一致
+struct GeometryOrigin {
+  double s;
+  double x;
+  double y;
+  double hdg;
+  double cos_hdg;
+  double sin_hdg;
+};
+
+/**
+ * @brief 螺旋线相对标准螺旋线(s = 0 处曲率为 0)的预计算参数,
+ * 由 element::GeometrySpiral 构造时计算
+ */
+struct SpiralParams {
+  double curve_start;
+  double curve_dot;
+  /// 起点在标准螺旋线上的弧长 curve_start / curve_dot
+  double spiral_start;
+  /// Fresnel 积分的自变量 = 标准螺旋线弧长 * fresnel_scale
+  double fresnel_scale;
+  /// 起点的 S, C
+  double fresnel_s0;
+  double fresnel_c0;
+  /// (C - C0, S - S0) 到 (x, y) 偏移: 起点旋转, 乘以 a 与曲率方向
+  double rotation[4];
+};
+
+/**
+ * 以下函数对 n 个 road s 计算参考线上的 x, y 与 heading(结构数组).
+ *
+ * 与 element::Geometry*::GetPoint 的差异: 位置不超过 kKernelPositionTolerance,
+ * heading 不超过 kKernelHeadingTolerance(|s|, |x|, |y| < 1e5,
+ * |曲率| >= 1e-6 时). sin/cos/atan 使用无分支的多项式逼近,
+ * 各级别之间的差异同样在该范围内.
+ */
+constexpr double kKernelPositionTolerance = 1e-9;
+constexpr double kKernelHeadingTolerance = 1e-12;
+
+void LinePoints(const GeometryOrigin& origin, const double* road_s, size_t n,
+                double* x, double* y, double* heading);
+void ArcPoints(const GeometryOrigin& origin, double curvature,
+               const double* road_s, size_t n, double* x, double* y,
+               double* heading);
+/// v(u) = coef[0] + coef[1]*u + coef[2]*u^2 + coef[3]*u^3
+void Poly3Points(const GeometryOrigin& origin, const double coef[4],
+                 const double* road_s, size_t n, double* x, double* y,
+                 double* heading);
+/**
+ * @param normalized true: p = min(1, ds / length), false: p = ds
+ */
+void ParamPoly3Points(const GeometryOrigin& origin, const double coef_u[4],
+                      const double coef_v[4], double length, bool normalized,
+                      const double* road_s, size_t n, double* x, double* y,
+                      double* heading);
+/// 位置与 GetPoint 的差异同样不超过 kKernelPositionTolerance
+void SpiralPoints(const GeometryOrigin& origin, const SpiralParams& spiral,
+                  const double* road_s, size_t n, double* x, double* y,
+                  double* heading);
+/**
+ * @brief 曲率变化很小的螺旋线, 不使用 Fresnel 积分
+ *
+ * 以起点曲率的圆弧为基础按 curve_dot 级数展开, 仅有标量实现.
+ * |curve_dot| * ds^2 / 2 <= 0.1 时截断误差小于 2e-16 * |ds|.
+ */
+void NearArcSpiralPoints(const GeometryOrigin& origin, double curve_start,
+                         double curve_dot, const double* road_s, size_t n,
+                         double* x, double* y, double* heading);
+
+/**
+ * @brief Fresnel 积分 S(x), C(x), 与 odrSpiral 使用的定义相同
+ *
+ * 与逐个计算相差不超过 1e-15 + 1e-16 * |x|: sin/cos(pi/2 * x^2) 按 x^2
+ * 的整数部分约简, 后一项来自逐个计算中 pi/2 * x^2 的舍入. x 不能与 s/c
+ * 重叠.
+ */
+void FresnelIntegrals(const double* x, size_t n, double* s, double* c);
+
+}  // namespace common
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_CPP_COMMON_GEOMETRY_KERNELS_H_
@@ -0,0 +1,20 @@
+#ifndef OPENDRIVE_CPP_COMMON_HASH_H_
+#define OPENDRIVE_CPP_COMMON_HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace opendrive {
+namespace common {
+
+/**
+ * @brief 64 位内容指纹(非加密), 用于判断 xml 片段是否变化
+ *
+ * 按 8 字节分组混合, 结果与平台字节序无关. 不会返回 0, 0 留作"未知".
+ */
+uint64_t Fingerprint(const char* data, size_t size);
+
+}  // namespace common
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_CPP_COMMON_HASH_H_
@@ -0,0 +1,64 @@
+#ifndef OPENDRIVE_CPP_COMMON_INFLATE_STREAM_H_
+#define OPENDRIVE_CPP_COMMON_INFLATE_STREAM_H_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace opendrive {
+namespace common {
+
+/**
+ * @brief 输入数据源
+ *
+ * 向 buf 写入至多 size 字节, 返回写入的字节数; 0: 结束; <0: 出错
+ */
+using StreamReader = std::function<long(char* buf, size_t size)>;
+
+/**
+ * @brief 按块解压的输入流
+ *
+ * 根据前几个字节识别 gzip/zlib 数据并用 zlib 逐块解压(支持多个 gzip
+ * member 串联), 未压缩的数据原样透传. 任何时刻只保留一个输入块和调用
+ * 方提供的输出块, 不需要完整的解压副本.
+ * 编译时未启用 zlib 时, 压缩数据返回错误.
+ */
+class InflateStream {
+ public:
+  explicit InflateStream(const StreamReader& reader,
+                         size_t chunk_size = 256 * 1024);
+  ~InflateStream();
+  InflateStream(const InflateStream&) = delete;
+  InflateStream& operator=(const InflateStream&) = delete;
+
+  /// 读取解压后的数据, 返回字节数; 0: 结束; <0: 出错, 见 error()
+  long Read(char* buf, size_t size);
+  const std::string& error() const noexcept { return error_; }
+  bool compressed() const noexcept { return compressed_; }
+
+  /// gzip(1f 8b) 或 zlib 头
+  static bool IsCompressed(const char* data, size_t size);
+  /// 是否启用了 zlib
+  static bool Supported();
+
+ private:
+  bool FillInput();
+  long Fail(const std::string& error);
+  struct Inflater;
+  StreamReader reader_;
+  std::string input_;
+  size_t input_pos_ = 0;
+  size_t input_size_ = 0;
+  std::unique_ptr<Inflater> inflater_;
+  std::string error_;
+  bool started_ = false;
+  bool compressed_ = false;
+  bool input_eof_ = false;
+  bool stream_end_ = false;
+};
+
+}  // namespace common
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_CPP_COMMON_INFLATE_STREAM_H_
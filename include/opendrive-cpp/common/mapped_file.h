@@ -0,0 +1,42 @@
+#ifndef OPENDRIVE_CPP_COMMON_MAPPED_FILE_H_
+#define OPENDRIVE_CPP_COMMON_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace opendrive {
+namespace common {
+
+/**
+ * @brief 只读内存映射文件(mmap)
+ */
+class MappedFile {
+ public:
+  using Ptr = std::shared_ptr<MappedFile>;
+  enum class Advice { kNormal = 0, kSequential, kRandom, kWillNeed };
+  MappedFile() = default;
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  bool Open(const std::string& path);
+  void Close();
+  /// madvise hint, 对整个映射区间生效
+  bool Advise(Advice advice) const;
+  /// 释放[offset, offset + length)已读过的页面
+  void Release(size_t offset, size_t length) const;
+  bool IsOpen() const noexcept { return opened_; }
+  const char* data() const noexcept { return data_; }
+  size_t size() const noexcept { return size_; }
+
+ private:
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  bool opened_ = false;
+};
+
+}  // namespace common
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_CPP_COMMON_MAPPED_FILE_H_
@@ -0,0 +1,25 @@
+#ifndef OPENDRIVE_CPP_COMMON_NUMERIC_H_
+#define OPENDRIVE_CPP_COMMON_NUMERIC_H_
+
+namespace opendrive {
+namespace common {
+
+/**
+ * 属性数值解析, 与 locale 无关, 不分配内存
+ *
+ * 语义与 tinyxml2 (sscanf) 一致: 跳过前导空白, 解析最长的数值前缀,
+ * 至少解析到一位数字即成功.
+ * 浮点数使用 Clinger 快速路径(尾数 <= 2^53 且 |10 的指数| <= 22 时一次
+ * 正确舍入的乘除即为精确结果), 其余情况(长尾数, 大指数, inf/nan,
+ * 十六进制)回退到 strtod, 回退时按当前 locale 的小数点改写输入,
+ * 保证结果与 "C" locale 下的 strtod 相同.
+ */
+bool ParseDouble(const char* str, double* value);
+bool ParseFloat(const char* str, float* value);
+/// 十进制, 溢出时失败; 0x 前缀按十六进制解析
+bool ParseInt(const char* str, int* value);
+
+}  // namespace common
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_CPP_COMMON_NUMERIC_H_
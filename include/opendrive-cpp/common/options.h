@@ -0,0 +1,58 @@
+#ifndef OPENDRIVE_CPP_COMMON_OPTIONS_H_
+#define OPENDRIVE_CPP_COMMON_OPTIONS_H_
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+
+namespace opendrive {
+
+class ParseStats;
+namespace common {
+class TraceSink;
+}  // namespace common
+
+/// 解析进度, 见 ParseOptions::progress
+struct ParseProgress {
+  size_t roads_parsed = 0;
+  /// 流式解析(ParseMapStream/ReloadMap, use_mmap)时总数未知, 为 0
+  size_t roads_total = 0;
+  /// 已读入的 xml 字节数, DOM 解析在加载完成后即等于 bytes_total
+  size_t bytes_consumed = 0;
+  size_t bytes_total = 0;
+};
+using ProgressCallback = std::function<void(const ParseProgress&)>;
+
+struct ParseOptions {
+  /// <road>/<junction> 解析线程数, 1: 串行, 0: hardware concurrency
+  size_t thread_num = 1;
+  /**
+   * ParseMap(xml_file)/ParseMapStream: 使用 mmap + madvise(SEQUENTIAL)
+   * 读取文件. ParseMap 此时改为流式解析, 片段直接在映射页面上解析,
+   * 不复制整个文件也不构建整棵 DOM, 已解析的页面及时释放; 串行解析,
+   * 忽略 thread_num
+   */
+  bool use_mmap = false;
+  /// 非空时 ParseMap 清零后填充各阶段耗时与计数, 见 parse_stats.h
+  ParseStats* stats = nullptr;
+  /// 非空时记录解析各阶段的 trace 事件, 需以 BUILD_OPENDRIVECPP_TRACE=ON
+  /// 编译, 见 trace.h
+  common::TraceSink* trace = nullptr;
+  /**
+   * 非空时报告 road 解析进度, 进度每增加 1% 至少报告一次.
+   * 并行解析时在工作线程中调用, 调用之间互斥, roads_parsed 单调递增
+   */
+  ProgressCallback progress;
+  /// 非空且为 true 时在 road/junction 之间停止解析, 返回 PARSE_CANCELLED
+  const std::atomic<bool>* cancel = nullptr;
+  /**
+   * 解析每条 road 后构建 LaneSection::boundary_table()(分段三次多项式的
+   * 车道边界表). 只对 ParseMap/ParseMaps/ParseMapStream/ReloadMap 生效,
+   * 其他加载方式可以调用 element::Road::BuildLaneBoundaryTables
+   */
+  bool lane_boundary_tables = false;
+};
+
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_CPP_COMMON_OPTIONS_H_
@@ -0,0 +1,158 @@
+#ifndef OPENDRIVE_CPP_COMMON_PARSE_STATS_H_
+#define OPENDRIVE_CPP_COMMON_PARSE_STATS_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "opendrive-cpp/geometry/element.h"
+#include "opendrive-cpp/geometry/enums.h"
+
+namespace opendrive {
+
+/**
+ * @brief 解析各阶段耗时与元素计数
+ *
+ * 通过 ParseOptions::stats 传给 Parser, 每次 ParseMap 开始时清零.
+ * 阶段耗时是各线程耗时之和, 阶段之间有嵌套: kRoad 包含 kPlanView,
+ * kLanes 与 kLaneBoundary, kLanes 包含 kLaneSection. 计数可以在解析线程中
+ * 并发累加.
+ */
+class ParseStats {
+ public:
+  enum class Stage : std::uint8_t {
+    kLoadXml = 0,  // tinyxml2 构建 DOM(流式解析时为片段 DOM)
+    kHeader,
+    kJunction,
+    kRoad,
+    kPlanView,
+    kLanes,
+    kLaneSection,
+    kLaneBoundary,  // ParseOptions::lane_boundary_tables
+    kCount
+  };
+  enum class Counter : std::uint8_t {
+    kJunctions = 0,
+    kConnections,
+    kRoads,
+    kGeometries,
+    kLaneSections,
+    kLanes,
+    kWidths,
+    kBorders,
+    kRoadMarks,
+    kSpeeds,
+    kBoundarySegments,  // LaneBoundaryTable 的段数之和
+    kBoundaryBytes,     // LaneBoundaryTable 占用的字节数之和
+    kCount
+  };
+  static constexpr size_t kStageNum = static_cast<size_t>(Stage::kCount);
+  static constexpr size_t kCounterNum = static_cast<size_t>(Counter::kCount);
+  static constexpr size_t kGeometryTypeNum =
+      static_cast<size_t>(GeometryType::kParamPoly3) + 1;
+
+  ParseStats() { Reset(); }
+  ParseStats(const ParseStats&) = delete;
+  ParseStats& operator=(const ParseStats&) = delete;
+
+  void Reset();
+  double stage_ms(Stage stage) const;
+  /// 阶段执行的次数
+  uint64_t stage_calls(Stage stage) const;
+  uint64_t count(Counter counter) const;
+  uint64_t geometry_count(GeometryType type) const;
+  /// 读入的 xml 字节数(压缩输入为解压后的字节数)
+  size_t bytes_processed() const noexcept { return bytes_processed_; }
+  /// 元素树所在 arena 向系统申请的字节数, 堆分配时为 0
+  size_t arena_bytes() const noexcept { return arena_bytes_; }
+  /**
+   * 解析结束与开始时进程当前 RSS 之差, 即解析后仍驻留的内存增长.
+   * 解析中途释放的临时内存(如 DOM)不计入, 其他线程的分配会计入;
+   * 可能为负, 无法读取 RSS 时为 0
+   */
+  int64_t rss_delta_bytes() const noexcept { return rss_delta_bytes_; }
+  /// 可读的汇总表
+  std::string ToString() const;
+
+  static const char* StageName(Stage stage);
+  static const char* CounterName(Counter counter);
+
+  /// 以下由解析器调用
+  void AddStageTime(Stage stage, uint64_t ns) noexcept;
+  void CountRoad(const element::Road& road) noexcept;
+  void CountJunction(const element::Junction& junction) noexcept;
+  void set_bytes_processed(size_t bytes) noexcept { bytes_processed_ = bytes; }
+  void set_arena_bytes(size_t bytes) noexcept { arena_bytes_ = bytes; }
+  /// 记录解析开始时的 RSS
+  void MarkRssBegin() noexcept;
+  /// 记录相对 MarkRssBegin 的 RSS 变化
+  void UpdateRssDelta() noexcept;
+
+  /// 当前线程的统计对象(见 ScopedParseStats), 没有时为 nullptr
+  static ParseStats* Current() noexcept;
+
+ private:
+  friend class ScopedParseStats;
+  void Add(Counter counter, uint64_t n) noexcept {
+    counters_[static_cast<size_t>(counter)].fetch_add(
+        n, std::memory_order_relaxed);
+  }
+
+  std::array<std::atomic<uint64_t>, kStageNum> stage_ns_;
+  std::array<std::atomic<uint64_t>, kStageNum> stage_calls_;
+  std::array<std::atomic<uint64_t>, kCounterNum> counters_;
+  std::array<std::atomic<uint64_t>, kGeometryTypeNum> geometries_;
+  size_t bytes_processed_ = 0;
+  size_t arena_bytes_ = 0;
+  size_t rss_begin_bytes_ = 0;
+  int64_t rss_delta_bytes_ = 0;
+};
+
+/**
+ * @brief 在作用域内设置当前线程的统计对象, 退出时恢复
+ *
+ * 与 common::ScopedArena 一样, 工作线程需要各自设置
+ */
+class ScopedParseStats {
+ public:
+  explicit ScopedParseStats(ParseStats* stats) noexcept;
+  ~ScopedParseStats();
+  ScopedParseStats(const ScopedParseStats&) = delete;
+  ScopedParseStats& operator=(const ScopedParseStats&) = delete;
+
+ private:
+  ParseStats* prev_;
+};
+
+/// 统计一个阶段的耗时; 未设置统计对象时只读取一次线程局部变量
+class ScopedStageTimer {
+ public:
+  explicit ScopedStageTimer(ParseStats::Stage stage) noexcept
+      : stats_(ParseStats::Current()), stage_(stage) {
+    if (stats_) {
+      begin_ = std::chrono::steady_clock::now();
+    }
+  }
+  ~ScopedStageTimer() {
+    if (stats_) {
+      const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - begin_)
+                          .count();
+      stats_->AddStageTime(stage_, static_cast<uint64_t>(ns));
+    }
+  }
+  ScopedStageTimer(const ScopedStageTimer&) = delete;
+  ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+ private:
+  ParseStats* stats_;
+  ParseStats::Stage stage_;
+  std::chrono::steady_clock::time_point begin_;
+};
+
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_CPP_COMMON_PARSE_STATS_H_
@@ -16,6 +16,8 @@
  */
  
  
+#include <stddef.h>
+
 /**
 * compute the actual "standard" spiral, starting with curvature 0
 * @param s      run-length along spiral
@@ -27,3 +29,26 @@
 
 extern void odrSpiral( double s, double cDot, double *x, double *y, double *t );
 
+/**
+* compute the Fresnel integrals S(x) and C(x), normalized as in odrSpiral
+* @param x      argument
+* @param s      resulting S(x)
+* @param c      resulting C(x)
+*/
+
+extern void odrFresnel( double x, double *s, double *c );
+
+/**
+* compute the "standard" spiral for n run-lengths at once, using the
+* SIMD level selected in opendrive-cpp/common/geometry_kernels.h;
+* results differ from odrSpiral by less than 1e-9 m
+* for |s| <= 1e6 m and |cDot| >= 1e-8 1/m2
+* @param s      n run-lengths along spiral
+* @param n      number of run-lengths
+* @param cDot   first derivative of curvature [1/m2]
+* @param x      n resulting x-coordinates, must not overlap s
+* @param y      n resulting y-coordinates, must not overlap s
+* @param t      n resulting tangent directions, must not overlap s
+*/
+
+extern void odrSpiralBatch( const double *s, size_t n, double cDot, double *x, double *y, double *t );
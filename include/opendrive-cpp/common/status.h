@@ -33,6 +33,10 @@ enum class ErrorCode {
   ADAPTER_ROADTYPE_ERROR,
 
   SAVE_DATA_ERROR,
+  LOAD_DATA_ERROR,
+  PARSE_CANCELLED,
+  /// 参数为空或取值无效
+  INVALID_ARGUMENT,
 };
 
 struct Status {
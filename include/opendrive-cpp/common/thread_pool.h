@@ -0,0 +1,84 @@
+#ifndef OPENDRIVE_CPP_COMMON_THREAD_POOL_H_
+#define OPENDRIVE_CPP_COMMON_THREAD_POOL_H_
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace opendrive {
+namespace common {
+
+class ThreadPool {
+ public:
+  using Ptr = std::shared_ptr<ThreadPool>;
+  /**
+   * @brief 固定大小的线程池
+   *
+   * @param thread_num 工作线程数, 0: std::thread::hardware_concurrency()
+   */
+  explicit ThreadPool(size_t thread_num);
+  ~ThreadPool();
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  size_t size() const noexcept { return workers_.size(); }
+
+  template <typename F>
+  std::future<typename std::result_of<F()>::type> Enqueue(F&& task) {
+    using Result = typename std::result_of<F()>::type;
+    auto packaged = std::make_shared<std::packaged_task<Result()>>(
+        std::forward<F>(task));
+    std::future<Result> future = packaged->get_future();
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      tasks_.emplace([packaged]() { (*packaged)(); });
+    }
+    cond_.notify_one();
+    return future;
+  }
+
+  /**
+   * @brief 将[0, n)切分为若干连续区间, 并行执行 task(begin, end)
+   *
+   * @param n 元素个数
+   * @param task void(size_t begin, size_t end)
+   */
+  template <typename F>
+  void ParallelFor(size_t n, const F& task) {
+    if (0 == n) return;
+    const size_t chunks = std::min(n, workers_.size() * 4);
+    const size_t step = (n + chunks - 1) / chunks;
+    std::vector<std::future<void>> futures;
+    futures.reserve(chunks);
+    for (size_t begin = 0; begin < n; begin += step) {
+      const size_t end = std::min(n, begin + step);
+      futures.emplace_back(Enqueue([&task, begin, end]() { task(begin, end); }));
+    }
+    for (auto& future : futures) {
+      future.get();
+    }
+  }
+
+  static size_t HardwareConcurrency();
+
+ private:
+  void Run();
+  std::vector<std::thread> workers_;
+  std::queue<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool stop_ = false;
+};
+
+}  // namespace common
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_CPP_COMMON_THREAD_POOL_H_
@@ -0,0 +1,120 @@
+#ifndef OPENDRIVE_CPP_COMMON_TRACE_H_
+#define OPENDRIVE_CPP_COMMON_TRACE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace opendrive {
+namespace common {
+
+/**
+ * @brief 记录 begin/end 事件, 输出 Chrome trace-event JSON
+ *
+ * 输出可直接在 chrome://tracing 或 ui.perfetto.dev 中打开. 通过
+ * ParseOptions::trace 传给 Parser; 解析器中的埋点只有以
+ * BUILD_OPENDRIVECPP_TRACE=ON 编译时才存在, 否则不产生任何开销.
+ *
+ * Begin/End 可以多线程并发调用, 每个线程写入自己的缓冲区;
+ * ToJson/Save/Clear 不能与记录并发.
+ */
+class TraceSink {
+ public:
+  TraceSink();
+  TraceSink(const TraceSink&) = delete;
+  TraceSink& operator=(const TraceSink&) = delete;
+
+  /// 解析器埋点是否编译进库
+  static bool Supported() noexcept;
+
+  /**
+   * @param name 事件名, 必须是静态字符串
+   * @param id >= 0 时作为 args.id 输出(如 road id)
+   */
+  void Begin(const char* name, int64_t id = -1);
+  void End(const char* name);
+  size_t event_size() const;
+  void Clear();
+  std::string ToJson() const;
+  bool Save(const std::string& file) const;
+
+  /// 当前线程的 sink(见 ScopedTraceSink), 没有时为 nullptr
+  static TraceSink* Current() noexcept;
+
+ private:
+  struct Event {
+    const char* name;
+    int64_t ts_ns;
+    int64_t id;
+    char phase;
+  };
+  struct Buffer {
+    uint32_t tid;
+    std::vector<Event> events;
+  };
+  void Record(const char* name, char phase, int64_t id);
+  Buffer* LocalBuffer();
+
+  mutable std::mutex mutex_;
+  std::deque<Buffer> buffers_;
+  /// 每次 Clear 后更换, 用于识别线程缓存的缓冲区是否属于本 sink
+  std::atomic<uint64_t> id_;
+  std::chrono::steady_clock::time_point origin_;
+};
+
+/// 在作用域内设置当前线程的 sink, 退出时恢复; 工作线程需要各自设置
+class ScopedTraceSink {
+ public:
+  explicit ScopedTraceSink(TraceSink* sink) noexcept;
+  ~ScopedTraceSink();
+  ScopedTraceSink(const ScopedTraceSink&) = delete;
+  ScopedTraceSink& operator=(const ScopedTraceSink&) = delete;
+
+ private:
+  TraceSink* prev_;
+};
+
+/// 向当前线程的 sink 记录一对 begin/end 事件
+class ScopedTraceEvent {
+ public:
+  explicit ScopedTraceEvent(const char* name, int64_t id = -1)
+      : sink_(TraceSink::Current()), name_(name) {
+    if (sink_) sink_->Begin(name_, id);
+  }
+  ~ScopedTraceEvent() {
+    if (sink_) sink_->End(name_);
+  }
+  ScopedTraceEvent(const ScopedTraceEvent&) = delete;
+  ScopedTraceEvent& operator=(const ScopedTraceEvent&) = delete;
+
+ private:
+  TraceSink* sink_;
+  const char* name_;
+};
+
+}  // namespace common
+}  // namespace opendrive
+
+/// 解析器埋点, 未开启 BUILD_OPENDRIVECPP_TRACE 时参数不求值
+#define OPENDRIVE_TRACE_CONCAT_INNER(a, b) a##b
+#define OPENDRIVE_TRACE_CONCAT(a, b) OPENDRIVE_TRACE_CONCAT_INNER(a, b)
+#ifdef OPENDRIVE_CPP_WITH_TRACE
+#define OPENDRIVE_TRACE_SCOPE(...)                              \
+  ::opendrive::common::ScopedTraceEvent OPENDRIVE_TRACE_CONCAT( \
+      opendrive_trace_event_, __LINE__)(__VA_ARGS__)
+#define OPENDRIVE_TRACE_SINK_SCOPE(sink)                       \
+  ::opendrive::common::ScopedTraceSink OPENDRIVE_TRACE_CONCAT( \
+      opendrive_trace_sink_, __LINE__)(sink)
+#else
+#define OPENDRIVE_TRACE_SCOPE(...) \
+  do {                             \
+  } while (0)
+#define OPENDRIVE_TRACE_SINK_SCOPE(sink) static_cast<void>(sink)
+#endif
+
+#endif  // OPENDRIVE_CPP_COMMON_TRACE_H_
@@ -6,13 +6,17 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
 #include <limits>
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "opendrive-cpp/common/arena.h"
 #include "opendrive-cpp/common/common.hpp"
+#include "opendrive-cpp/common/geometry_kernels.h"
 #include "opendrive-cpp/common/macros.h"
 #include "opendrive-cpp/common/spiral/odrSpiral.h"
 #include "opendrive-cpp/geometry/enums.h"
@@ -20,11 +24,79 @@
 namespace opendrive {
 namespace element {
 
+/**
+ * @brief element 容器, 在 common::ScopedArena 作用域内构造时从该 arena 分配
+ *
+ * 与 std::vector<T> 相互隐式转换(复制元素), 使用 std::vector 接收
+ * 访问器返回值或调用 set_xxx 的代码不需要修改.
+ */
+template <typename T>
+class Vector : public std::vector<T, common::ArenaAllocator<T>> {
+  using Base = std::vector<T, common::ArenaAllocator<T>>;
+
+ public:
+  using Base::Base;
+  Vector() = default;
+  Vector(const Base& other) : Base(other) {}
+  Vector(Base&& other) noexcept : Base(std::move(other)) {}
+  Vector(const std::vector<T>& other) : Base(other.begin(), other.end()) {}
+  operator std::vector<T>() const {
+    return std::vector<T>(this->begin(), this->end());
+  }
+};
+
+/// element 字符串, 分配方式同 Vector, 与 std::string 相互隐式转换
+class String : public std::basic_string<char, std::char_traits<char>,
+                                        common::ArenaAllocator<char>> {
+  using Base = std::basic_string<char, std::char_traits<char>,
+                                 common::ArenaAllocator<char>>;
+
+ public:
+  using Base::Base;
+  String() = default;
+  String(const Base& other) : Base(other) {}
+  String(Base&& other) noexcept : Base(std::move(other)) {}
+  String(const std::string& other) : Base(other.data(), other.size()) {}
+  operator std::string() const { return std::string(data(), size()); }
+
+  /// 与 std::string/字符串字面量比较时精确匹配, 避免与 std 的模板重载歧义
+  friend bool operator==(const String& lhs, const String& rhs) {
+    return 0 == lhs.compare(rhs);
+  }
+  friend bool operator==(const String& lhs, const std::string& rhs) {
+    return 0 == lhs.compare(0, lhs.size(), rhs.data(), rhs.size());
+  }
+  friend bool operator==(const std::string& lhs, const String& rhs) {
+    return rhs == lhs;
+  }
+  friend bool operator==(const String& lhs, const char* rhs) {
+    return 0 == lhs.compare(rhs);
+  }
+  friend bool operator==(const char* lhs, const String& rhs) {
+    return rhs == lhs;
+  }
+  friend bool operator!=(const String& lhs, const String& rhs) {
+    return !(lhs == rhs);
+  }
+  friend bool operator!=(const String& lhs, const std::string& rhs) {
+    return !(lhs == rhs);
+  }
+  friend bool operator!=(const std::string& lhs, const String& rhs) {
+    return !(rhs == lhs);
+  }
+  friend bool operator!=(const String& lhs, const char* rhs) {
+    return !(lhs == rhs);
+  }
+  friend bool operator!=(const char* lhs, const String& rhs) {
+    return !(rhs == lhs);
+  }
+};
+
 using Id = int;
 using Idx = Id;
-using Ids = std::vector<Id>;
-using IdStr = std::string;
-using Name = std::string;
+using Ids = Vector<Id>;
+using IdStr = String;
+using Name = String;
 
 class Point {
   REGISTER_MEMBER_BASIC_TYPE(double, x, 0);
@@ -39,13 +111,45 @@ class Point {
       : x_(x), y_(y), z_(z), heading_(heading) {}
 };
 
+/// 平面上与坐标轴对齐的包围盒, 默认为空
+class Box {
+  REGISTER_MEMBER_BASIC_TYPE(double, min_x,
+                             std::numeric_limits<double>::infinity());
+  REGISTER_MEMBER_BASIC_TYPE(double, min_y,
+                             std::numeric_limits<double>::infinity());
+  REGISTER_MEMBER_BASIC_TYPE(double, max_x,
+                             -std::numeric_limits<double>::infinity());
+  REGISTER_MEMBER_BASIC_TYPE(double, max_y,
+                             -std::numeric_limits<double>::infinity());
+
+ public:
+  Box() = default;
+  Box(double min_x, double min_y, double max_x, double max_y)
+      : min_x_(min_x), min_y_(min_y), max_x_(max_x), max_y_(max_y) {}
+  bool empty() const noexcept { return min_x_ > max_x_ || min_y_ > max_y_; }
+  /// 边界相接也算相交
+  bool Intersects(const Box& other) const noexcept {
+    return !empty() && !other.empty() && min_x_ <= other.max_x_ &&
+           other.min_x_ <= max_x_ && min_y_ <= other.max_y_ &&
+           other.min_y_ <= max_y_;
+  }
+  /// 扩大到包含以 (x, y) 为中心, 半宽为 radius 的正方形
+  void Extend(double x, double y, double radius) noexcept {
+    min_x_ = std::min(min_x_, x - radius);
+    min_y_ = std::min(min_y_, y - radius);
+    max_x_ = std::max(max_x_, x + radius);
+    max_y_ = std::max(max_y_, y + radius);
+  }
+};
+using Boxes = Vector<Box>;
+
 class Header {
-  REGISTER_MEMBER_COMPLEX_TYPE(std::string, rev_major);
-  REGISTER_MEMBER_COMPLEX_TYPE(std::string, rev_minor);
-  REGISTER_MEMBER_COMPLEX_TYPE(std::string, version);
-  REGISTER_MEMBER_COMPLEX_TYPE(std::string, name);
-  REGISTER_MEMBER_COMPLEX_TYPE(std::string, date);
-  REGISTER_MEMBER_COMPLEX_TYPE(std::string, vendor);
+  REGISTER_MEMBER_COMPLEX_TYPE(String, rev_major);
+  REGISTER_MEMBER_COMPLEX_TYPE(String, rev_minor);
+  REGISTER_MEMBER_COMPLEX_TYPE(String, version);
+  REGISTER_MEMBER_COMPLEX_TYPE(String, name);
+  REGISTER_MEMBER_COMPLEX_TYPE(String, date);
+  REGISTER_MEMBER_COMPLEX_TYPE(String, vendor);
   REGISTER_MEMBER_BASIC_TYPE(double, north, 0);
   REGISTER_MEMBER_BASIC_TYPE(double, south, 0);
   REGISTER_MEMBER_BASIC_TYPE(double, west, 0);
@@ -68,8 +172,8 @@ class Geometry {
  public:
   using Ptr = std::shared_ptr<Geometry>;
   using ConstPtr = std::shared_ptr<Geometry const>;
-  using Ptrs = std::vector<Ptr>;
-  using ConstPtrs = std::vector<ConstPtr>;
+  using Ptrs = Vector<Ptr>;
+  using ConstPtrs = Vector<ConstPtr>;
   Geometry(double _s, double _x, double _y, double _hdg, double _length,
            GeometryType _type)
       : s_(_s),
@@ -82,6 +186,51 @@ class Geometry {
         cos_hdg_(std::cos(_hdg)) {}
   virtual ~Geometry() = default;
   virtual Point GetPoint(double ref_line_ds) const = 0;
+  /**
+   * @brief 批量计算参考线上的点, 一次虚函数调用处理 n 个样本
+   *
+   * @param road_s n 个 road s 坐标
+   * @param out n 个结果
+   */
+  virtual void GetPoints(const double* road_s, size_t n, Point* out) const {
+    for (size_t i = 0; i < n; i++) {
+      out[i] = GetPoint(road_s[i]);
+    }
+  }
+
+ protected:
+  common::GeometryOrigin origin() const {
+    return common::GeometryOrigin{s(), x(), y(), hdg(), cos_hdg(), sin_hdg()};
+  }
+  /**
+   * @brief 分块调用结构数组形式的 kernel(见 geometry_kernels.h), 再写入 Point
+   *
+   * @param kernel void(const double* road_s, size_t n, double* x, double* y,
+   * double* heading)
+   */
+  template <typename F>
+  static void GetPointsBlocked(const double* road_s, size_t n, Point* out,
+                               const F& kernel) {
+    constexpr size_t kBlock = 64;
+    double xs[kBlock];
+    double ys[kBlock];
+    double headings[kBlock];
+    for (size_t begin = 0; begin < n; begin += kBlock) {
+      const size_t size = std::min(kBlock, n - begin);
+      kernel(road_s + begin, size, xs, ys, headings);
+      for (size_t i = 0; i < size; i++) {
+        out[begin + i] = Point{xs[i], ys[i], 0, headings[i]};
+      }
+    }
+  }
+  /// 按具体类型调用 GetPoint, 循环内没有虚函数分派
+  template <typename T>
+  static void GetPointsOf(const T& geometry, const double* road_s, size_t n,
+                          Point* out) {
+    for (size_t i = 0; i < n; i++) {
+      out[i] = geometry.T::GetPoint(road_s[i]);
+    }
+  }
 };
 
 class GeometryLine final : public Geometry {
@@ -95,6 +244,15 @@ class GeometryLine final : public Geometry {
     const double yd = y() + (sin_hdg() * ref_line_ds);
     return Point{xd, yd, 0, hdg()};
   }
+  virtual void GetPoints(const double* road_s, size_t n,
+                         Point* out) const override {
+    GetPointsBlocked(road_s, n, out,
+                     [this](const double* s, size_t size, double* xs,
+                            double* ys, double* headings) {
+                       common::LinePoints(origin(), s, size, xs, ys,
+                                          headings);
+                     });
+  }
 };
 
 class GeometryArc final : public Geometry {
@@ -117,8 +275,29 @@ class GeometryArc final : public Geometry {
     const double tangent = hdg() + ref_line_ds * curvature_;
     return Point{xd, yd, 0, tangent};
   }
+  virtual void GetPoints(const double* road_s, size_t n,
+                         Point* out) const override {
+    GetPointsBlocked(road_s, n, out,
+                     [this](const double* s, size_t size, double* xs,
+                            double* ys, double* headings) {
+                       common::ArcPoints(origin(), curvature_, s, size, xs,
+                                         ys, headings);
+                     });
+  }
 };
 
+/**
+ * @brief 螺旋线(clothoid), 曲率从 curve_start 线性变化到 curve_end
+ *
+ * 按整段与起点曲率圆弧的 heading 偏差 |curve_dot| * length^2 / 2 选择
+ * 算法(见 kMaxArcPhase):
+ * - 超过 kMaxArcPhase: 起点在标准螺旋线(s = 0 处曲率为 0)上的位置与
+ *   旋转在构造时计算, 每个样本只计算一次 Fresnel 积分, GetPoints 使用
+ *   批量 kernel;
+ * - 不超过 kMaxArcPhase(degenerate()): 曲率几乎不变, 此时 Fresnel 积分
+ *   失去精度, 按起点曲率圆弧的级数展开计算(NearArcSpiralPoints);
+ *   curve_dot 为 0(或 length 为 0)时按曲率 curve_start 的圆弧/直线计算.
+ */
 class GeometrySpiral final : public Geometry {
   REGISTER_MEMBER_BASIC_TYPE(double, curve_start, 0);
   REGISTER_MEMBER_BASIC_TYPE(double, curve_end, 0);
@@ -130,33 +309,121 @@ class GeometrySpiral final : public Geometry {
       : Geometry(s, x, y, hdg, length, type),
         curve_start_(curve_start),
         curve_end_(curve_end),
-        curve_dot_((curve_end - curve_start) / (length)) {}
+        curve_dot_((curve_end - curve_start) / (length)) {
+    Precompute();
+  }
 
   virtual Point GetPoint(double road_ds) const override {
     const double ref_line_ds = road_ds - s();
-    const double s1 = curve_start_ / curve_dot_ + ref_line_ds;
-    double x1;
-    double y1;
-    double t1;
-    odrSpiral(s1, curve_dot_, &x1, &y1, &t1);
-
-    const double s0 = curve_start_ / curve_dot_;
-    double x0;
-    double y0;
-    double t0;
-    odrSpiral(s1, curve_dot_, &x0, &y0, &t0);
-
-    x1 -= x0;
-    y1 -= y0;
-    t1 -= t0;
-    const double angle = hdg() - t0;
-    const double cos_a = std::cos(angle);
-    const double sin_a = std::sin(angle);
-    const double xd = x() + x1 * cos_a - y1 * sin_a;
-    const double yd = y() + y1 * cos_a + x1 * sin_a;
-    const double tangent = hdg() + t1;
+    if (degenerate_) {
+      if (near_arc()) {
+        double xd;
+        double yd;
+        double tangent;
+        common::NearArcSpiralPoints(origin(), curve_start_, curve_dot_,
+                                    &road_ds, 1, &xd, &yd, &tangent);
+        return Point{xd, yd, 0, tangent};
+      }
+      if (0 == curve_start_) {
+        return Point{x() + cos_hdg() * ref_line_ds,
+                     y() + sin_hdg() * ref_line_ds, 0, hdg()};
+      }
+      const double tangent = hdg() + ref_line_ds * curve_start_;
+      return Point{x() + (std::sin(tangent) - sin_hdg()) / curve_start_,
+                   y() + (cos_hdg() - std::cos(tangent)) / curve_start_, 0,
+                   tangent};
+    }
+    double fresnel_s;
+    double fresnel_c;
+    odrFresnel((spiral_.spiral_start + ref_line_ds) * spiral_.fresnel_scale,
+               &fresnel_s, &fresnel_c);
+    fresnel_s -= spiral_.fresnel_s0;
+    fresnel_c -= spiral_.fresnel_c0;
+    const double xd =
+        x() + fresnel_c * spiral_.rotation[0] + fresnel_s * spiral_.rotation[1];
+    const double yd =
+        y() + fresnel_c * spiral_.rotation[2] + fresnel_s * spiral_.rotation[3];
+    /// t(s1) - t(s0) 展开, 避免 s0 较大时两个大数相减
+    const double tangent =
+        hdg() + ref_line_ds * (curve_start_ + 0.5 * curve_dot_ * ref_line_ds);
     return Point{xd, yd, 0, tangent};
   }
+  virtual void GetPoints(const double* road_s, size_t n,
+                         Point* out) const override {
+    if (!degenerate_) {
+      GetPointsBlocked(road_s, n, out,
+                       [this](const double* s, size_t size, double* xs,
+                              double* ys, double* headings) {
+                         common::SpiralPoints(origin(), spiral_, s, size, xs,
+                                              ys, headings);
+                       });
+    } else if (near_arc()) {
+      GetPointsBlocked(road_s, n, out,
+                       [this](const double* s, size_t size, double* xs,
+                              double* ys, double* headings) {
+                         common::NearArcSpiralPoints(origin(), curve_start_,
+                                                     curve_dot_, s, size, xs,
+                                                     ys, headings);
+                       });
+    } else if (0 == curve_start_) {
+      GetPointsBlocked(road_s, n, out,
+                       [this](const double* s, size_t size, double* xs,
+                              double* ys, double* headings) {
+                         common::LinePoints(origin(), s, size, xs, ys,
+                                            headings);
+                       });
+    } else {
+      GetPointsBlocked(road_s, n, out,
+                       [this](const double* s, size_t size, double* xs,
+                              double* ys, double* headings) {
+                         common::ArcPoints(origin(), curve_start_, s, size, xs,
+                                           ys, headings);
+                       });
+    }
+  }
+  /// true: 不使用 Fresnel 积分, 按圆弧/直线或圆弧的级数展开计算
+  bool degenerate() const noexcept { return degenerate_; }
+
+ private:
+  /**
+   * 与起点曲率圆弧的 heading 偏差 |curve_dot| * length^2 / 2 不超过该值
+   * (rad)时按圆弧展开计算. Fresnel 积分的位置误差约为
+   * 1e-16 * |curve_start / curve_dot|, 超过该值时后者不大于
+   * |curve_start| * length^2 / (2 * kMaxArcPhase)
+   */
+  static constexpr double kMaxArcPhase = 0.02;
+
+  /// curve_dot 为 0 或非有限值(length 为 0)时为圆弧/直线
+  bool near_arc() const { return std::isnormal(curve_dot_); }
+
+  void Precompute() {
+    const double phase = 0.5 * std::fabs(curve_dot_) * length() * length();
+    degenerate_ = !(phase > kMaxArcPhase);
+    if (degenerate_) {
+      return;
+    }
+    /// 标准螺旋线: x + iy = a * (C(s / a) + i * sign * S(s / a)),
+    /// a = sqrt(pi / |curve_dot|), t = curve_dot * s^2 / 2
+    const double a = std::sqrt(M_PI / std::fabs(curve_dot_));
+    const double sign = curve_dot_ < 0 ? -1. : 1.;
+    spiral_.curve_start = curve_start_;
+    spiral_.curve_dot = curve_dot_;
+    spiral_.spiral_start = curve_start_ / curve_dot_;
+    spiral_.fresnel_scale = 1. / a;
+    odrFresnel(spiral_.spiral_start * spiral_.fresnel_scale,
+               &spiral_.fresnel_s0, &spiral_.fresnel_c0);
+    const double t0 =
+        0.5 * curve_dot_ * spiral_.spiral_start * spiral_.spiral_start;
+    const double cos_a = std::cos(hdg() - t0);
+    const double sin_a = std::sin(hdg() - t0);
+    spiral_.rotation[0] = a * cos_a;
+    spiral_.rotation[1] = -sign * a * sin_a;
+    spiral_.rotation[2] = a * sin_a;
+    spiral_.rotation[3] = sign * a * cos_a;
+  }
+
+  bool degenerate_ = false;
+  common::SpiralParams spiral_{};
 };
 
 class GeometryPoly3 final : public Geometry {
@@ -183,6 +450,16 @@ class GeometryPoly3 final : public Geometry {
     const double tangent = hdg() + theta;
     return Point{xd, yd, 0, tangent};
   }
+  virtual void GetPoints(const double* road_s, size_t n,
+                         Point* out) const override {
+    const double coef[4] = {a_, b_, c_, d_};
+    GetPointsBlocked(road_s, n, out,
+                     [this, &coef](const double* s, size_t size, double* xs,
+                                   double* ys, double* headings) {
+                       common::Poly3Points(origin(), coef, s, size, xs, ys,
+                                           headings);
+                     });
+  }
 };
 
 class GeometryParamPoly3 final : public Geometry {
@@ -237,8 +514,29 @@ class GeometryParamPoly3 final : public Geometry {
     const double tangent = hdg() + theta;
     return Point{xd, yd, 0, tangent};
   }
+  virtual void GetPoints(const double* road_s, size_t n,
+                         Point* out) const override {
+    const double coef_u[4] = {au_, bu_, cu_, du_};
+    const double coef_v[4] = {av_, bv_, cv_, dv_};
+    const bool normalized = PRange::NORMALIZED == p_range_;
+    GetPointsBlocked(
+        road_s, n, out,
+        [this, &coef_u, &coef_v, normalized](const double* s, size_t size,
+                                             double* xs, double* ys,
+                                             double* headings) {
+          common::ParamPoly3Points(origin(), coef_u, coef_v, length(),
+                                   normalized, s, size, xs, ys, headings);
+        });
+  }
 };
 
+/// 在当前线程的 arena 中创建 geometry(控制块与对象一起分配)
+template <typename T, typename... Args>
+std::shared_ptr<T> AllocateGeometry(Args&&... args) {
+  return std::allocate_shared<T>(common::ArenaAllocator<T>(),
+                                 std::forward<Args>(args)...);
+}
+
 class LaneAttribute {
   REGISTER_MEMBER_BASIC_TYPE(Id, id, std::numeric_limits<Id>::max());
   REGISTER_MEMBER_COMPLEX_TYPE(LaneType, type);
@@ -276,7 +574,7 @@ class RoadMark {
   REGISTER_MEMBER_COMPLEX_TYPE(RoadMarkLaneChange, lane_change);
   REGISTER_MEMBER_BASIC_TYPE(double, width, 0);
   REGISTER_MEMBER_BASIC_TYPE(double, height, 0);
-  REGISTER_MEMBER_COMPLEX_TYPE(std::string, material);
+  REGISTER_MEMBER_COMPLEX_TYPE(String, material);
 
  public:
   RoadMark()
@@ -289,13 +587,13 @@ class RoadMark {
         height_(0),
         material_("standard") {}
 };
-using RoadMarks = std::vector<RoadMark>;
+using RoadMarks = Vector<RoadMark>;
 
 class LaneWidth : public OffsetPoly3 {};
-using LaneWidths = std::vector<LaneWidth>;
+using LaneWidths = Vector<LaneWidth>;
 
 class LaneBorder : public OffsetPoly3 {};
-using LaneBorders = std::vector<LaneBorder>;
+using LaneBorders = Vector<LaneBorder>;
 
 class LaneLink {
   REGISTER_MEMBER_COMPLEX_TYPE(Ids, predecessors);
@@ -304,7 +602,7 @@ class LaneLink {
  public:
   LaneLink() {}
 };
-using LaneLinks = std::vector<LaneLink>;
+using LaneLinks = Vector<LaneLink>;
 
 class LaneSpeed {
   REGISTER_MEMBER_BASIC_TYPE(double, s, 0);
@@ -314,7 +612,7 @@ class LaneSpeed {
  public:
   LaneSpeed() : s_(0), max_(0), unit_(SpeedUnit::kMs) {}
 };
-using LaneSpeeds = std::vector<LaneSpeed>;
+using LaneSpeeds = Vector<LaneSpeed>;
 
 class Lane {
   REGISTER_MEMBER_COMPLEX_TYPE(LaneAttribute, attribute);
@@ -340,7 +638,7 @@ class Lane {
       if (border_index < 0) {
         return 0.;
       }
-      auto border = widths_.at(border_index);
+      auto border = borders_.at(border_index);
       return border.GetOffsetValue(road_ds);
     } else {
       /// width
@@ -356,14 +654,145 @@ class Lane {
 };
 
 class LanesInfo {
-  REGISTER_MEMBER_COMPLEX_TYPE(std::vector<Lane>, lanes);
+  REGISTER_MEMBER_COMPLEX_TYPE(Vector<Lane>, lanes);
 
  public:
   LanesInfo() {}
 };
 
 class LaneOffset : public OffsetPoly3 {};
-using LaneOffsets = std::vector<LaneOffset>;
+using LaneOffsets = Vector<LaneOffset>;
+
+/**
+ * @brief LaneSection::GetLaneBoundaries 的结果, 各样本处车道外边界的 t
+ *
+ * t 相对参考线, 包含 laneOffset, 左侧为正, 右侧为负. 车道下标 j 与
+ * LaneSection::left()/right().lanes() 的下标一致; 车道的内边界为相邻
+ * 内侧车道的外边界, 最内侧车道为 center(i).
+ */
+class LaneBoundaries {
+ public:
+  LaneBoundaries() = default;
+  /// 样本数
+  size_t size() const noexcept { return road_s_.size(); }
+  size_t left_num() const noexcept { return left_num_; }
+  size_t right_num() const noexcept { return right_num_; }
+  double road_s(size_t i) const { return road_s_[i]; }
+  /// 中心车道(laneOffset)的 t
+  double center(size_t i) const { return center_[i]; }
+  double left(size_t i, size_t j) const { return left_[i * left_num_ + j]; }
+  double right(size_t i, size_t j) const {
+    return right_[i * right_num_ + j];
+  }
+
+ private:
+  friend class LaneSection;
+  void Resize(size_t n, size_t left_num, size_t right_num) {
+    left_num_ = left_num;
+    right_num_ = right_num;
+    road_s_.resize(n);
+    center_.resize(n);
+    left_.resize(n * left_num);
+    right_.resize(n * right_num);
+  }
+
+  size_t left_num_ = 0;
+  size_t right_num_ = 0;
+  std::vector<double> road_s_;
+  std::vector<double> center_;
+  std::vector<double> left_;
+  std::vector<double> right_;
+};
+
+/**
+ * @brief LaneSection 所有车道边界的分段三次多项式表(可选, 解析后构建)
+ *
+ * 断点为 section 起点, 与 (起点, 终点) 内的 laneOffset 及各车道
+ * <width>/<border> 起点的并集, 所有边界共用, 终点之后沿用最后一段.
+ * 每段每条边界存储 t(u) = a + b*u + c*u^2 + d*u^3, u = road_s - 段起点,
+ * 由 laneOffset 与内侧车道宽度的系数平移后相加得到. 查询为一次段查找
+ * 加一次 Horner 求值, 与内侧车道数无关.
+ *
+ * 边界下标: 0 为中心车道, 1 + j 为 left().lanes()[j],
+ * 1 + left_num() + j 为 right().lanes()[j].
+ */
+class LaneBoundaryTable {
+ public:
+  LaneBoundaryTable() = default;
+  bool empty() const noexcept { return starts_.empty(); }
+  size_t segment_num() const noexcept { return starts_.size(); }
+  size_t boundary_num() const noexcept { return 1 + left_num_ + right_num_; }
+  size_t left_num() const noexcept { return left_num_; }
+  size_t right_num() const noexcept { return right_num_; }
+  /// 各段起点的 road s, 升序
+  const Vector<double>& starts() const noexcept { return starts_; }
+  /// 占用的堆(或 arena)字节数
+  size_t bytes() const noexcept {
+    return (starts_.capacity() + coefs_.capacity()) * sizeof(double);
+  }
+
+  /**
+   * @brief road_s 所在的段, section 起点之前为 0
+   *
+   * @param hint 上一次的结果, road_s 单调变化时通常不需要二分查找
+   */
+  size_t Segment(double road_s, size_t hint = 0) const {
+    const size_t num = starts_.size();
+    for (size_t i = hint; i < num && i <= hint + 1; i++) {
+      if ((0 == i || road_s >= starts_[i]) &&
+          (i + 1 == num || road_s < starts_[i + 1])) {
+        return i;
+      }
+    }
+    const auto it = std::upper_bound(starts_.begin(), starts_.end(), road_s);
+    return it == starts_.begin() ? 0 : it - starts_.begin() - 1;
+  }
+  /// 第 segment 段的系数, 每条边界 {a, b, c, d}
+  const double* coefs(size_t segment) const {
+    return coefs_.data() + segment * boundary_num() * 4;
+  }
+  /// 段内的自变量 u, section 起点之前按起点计算
+  double SegmentOffset(size_t segment, double road_s) const {
+    return std::max(road_s, starts_[0]) - starts_[segment];
+  }
+  static double Horner(const double* coef, double u) {
+    return ((coef[3] * u + coef[2]) * u + coef[1]) * u + coef[0];
+  }
+
+  double center(double road_s) const { return Evaluate(0, road_s); }
+  double left(size_t j, double road_s) const {
+    return Evaluate(1 + j, road_s);
+  }
+  double right(size_t j, double road_s) const {
+    return Evaluate(1 + left_num_ + j, road_s);
+  }
+
+ private:
+  friend class LaneSection;
+  double Evaluate(size_t boundary, double road_s) const {
+    const size_t segment = Segment(road_s);
+    return Horner(coefs(segment) + boundary * 4,
+                  SegmentOffset(segment, road_s));
+  }
+  /// coef += sign * poly(x + h), 即把 poly 平移到新的原点
+  static void AddShifted(const OffsetPoly3& poly, double h, double sign,
+                         double* coef) {
+    const double a = poly.a();
+    const double b = poly.b();
+    const double c = poly.c();
+    const double d = poly.d();
+    coef[0] += sign * (a + h * (b + h * (c + h * d)));
+    coef[1] += sign * (b + h * (2 * c + 3 * h * d));
+    coef[2] += sign * (c + 3 * h * d);
+    coef[3] += sign * d;
+  }
+
+  size_t left_num_ = 0;
+  size_t right_num_ = 0;
+  Vector<double> starts_;
+  /// [segment][boundary][4]
+  Vector<double> coefs_;
+};
 
 class LaneSection {
   REGISTER_MEMBER_BASIC_TYPE(Id, id, -1);
@@ -375,8 +804,238 @@ class LaneSection {
 
  public:
   LaneSection() : id_(-1), start_position_(0), end_position_(0) {}
+
+  /**
+   * @brief 计算 road_s 处所有车道外边界的 t, 每条车道查找一次
+   *
+   * 中心车道取 lane_offsets 在 road_s 处的值(之前没有记录时为 0), 再按
+   * |id| 由内向外累加: 有 <width> 的车道加上 Lane::GetLaneWidth 的宽度,
+   * 只有 <border> 的车道外边界为中心车道加上 border 值, 两者都没有时
+   * 宽度为 0.
+   *
+   * @param lane_offsets 所属 road 的 Lanes::lane_offsets
+   */
+  void GetLaneBoundaries(double road_s, const LaneOffsets& lane_offsets,
+                         LaneBoundaries* out) const {
+    GetLaneBoundaries(&road_s, 1, lane_offsets, out);
+  }
+  /**
+   * @brief 批量计算, 每条车道的 width/border 与 laneOffset 各用一个
+   * common::Poloy3Cursor 查找
+   *
+   * @param road_s n 个升序(或降序)的 road s; 乱序时结果仍然正确,
+   * 只是需要额外查找
+   *
+   * 已构建 boundary_table() 时改为查表, 每个样本一次段查找; 两者只在
+   * 不连续的 <width> 断点处(表取新记录)与 section 起点之前(表按起点
+   * 计算 laneOffset)不同.
+   */
+  void GetLaneBoundaries(const double* road_s, size_t n,
+                         const LaneOffsets& lane_offsets,
+                         LaneBoundaries* out) const {
+    out->Resize(n, left_.lanes().size(), right_.lanes().size());
+    if (!boundary_table_.empty()) {
+      BoundariesFromTable(road_s, n, out);
+      return;
+    }
+    auto offset_cursor = common::MakePoloy3Cursor(lane_offsets);
+    for (size_t i = 0; i < n; i++) {
+      const int index = offset_cursor.Ge(road_s[i]);
+      out->road_s_[i] = road_s[i];
+      out->center_[i] =
+          index < 0 ? 0. : lane_offsets[index].GetOffsetValue(road_s[i]);
+    }
+    AccumulateBoundaries(left_.lanes(), road_s, n, out->center_.data(), 1.,
+                         out->left_.data());
+    AccumulateBoundaries(right_.lanes(), road_s, n, out->center_.data(), -1.,
+                         out->right_.data());
+  }
+
+  const LaneBoundaryTable& boundary_table() const noexcept {
+    return boundary_table_;
+  }
+  /**
+   * @brief 构建 boundary_table(), 与 GetLaneBoundaries 的累加规则相同
+   *
+   * 解析时由 ParseOptions::lane_boundary_tables 开启; 修改车道或
+   * laneOffset 后需要重新构建. 表从当前线程的 arena 分配.
+   *
+   * @param lane_offsets 所属 road 的 Lanes::lane_offsets
+   */
+  void BuildBoundaryTable(const LaneOffsets& lane_offsets) {
+    const double start = start_position_;
+    /// section 之外的记录不产生断点, 表的大小只与本 section 有关
+    auto inside = [this](double road_s) {
+      return road_s > start_position_ && road_s < end_position_;
+    };
+    Vector<double> starts;
+    starts.emplace_back(start);
+    for (const auto& lane_offset : lane_offsets) {
+      if (inside(lane_offset.s())) starts.emplace_back(lane_offset.s());
+    }
+    for (const auto* info : {&left_, &right_}) {
+      for (const auto& lane : info->lanes()) {
+        for (const auto& width : lane.widths()) {
+          if (inside(start + width.s())) starts.emplace_back(start + width.s());
+        }
+        if (!lane.widths().empty()) continue;
+        for (const auto& border : lane.borders()) {
+          if (inside(start + border.s())) {
+            starts.emplace_back(start + border.s());
+          }
+        }
+      }
+    }
+    std::sort(starts.begin(), starts.end());
+    starts.erase(std::unique(starts.begin(), starts.end()), starts.end());
+    starts.shrink_to_fit();
+
+    const auto& left_lanes = left_.lanes();
+    const auto& right_lanes = right_.lanes();
+    const std::vector<size_t> left_order = LaneOrder(left_lanes);
+    const std::vector<size_t> right_order = LaneOrder(right_lanes);
+    auto& table = boundary_table_;
+    table.left_num_ = left_lanes.size();
+    table.right_num_ = right_lanes.size();
+    const size_t boundary_num = table.boundary_num();
+    Vector<double> coefs(starts.size() * boundary_num * 4, 0.);
+    for (size_t k = 0; k < starts.size(); k++) {
+      /// 段内任意一点的记录都相同, 取中点以避开断点处的查找规则
+      const double next = k + 1 < starts.size()
+                              ? starts[k + 1]
+                              : std::max(end_position_, starts[k]);
+      const double mid = starts[k] + 0.5 * (next - starts[k]);
+      double* seg = coefs.data() + k * boundary_num * 4;
+      const int offset_index = common::GetGeValuePoloy3(lane_offsets, mid);
+      if (offset_index >= 0) {
+        const auto& lane_offset = lane_offsets[offset_index];
+        LaneBoundaryTable::AddShifted(lane_offset, starts[k] - lane_offset.s(),
+                                      1., seg);
+      }
+      /// 段起点相对 section 起点
+      const double h = starts[k] - start;
+      AccumulateCoefs(left_lanes, left_order, mid - start, h, 1., seg,
+                      seg + 4);
+      AccumulateCoefs(right_lanes, right_order, mid - start, h, -1., seg,
+                      seg + (1 + table.left_num_) * 4);
+    }
+    table.starts_ = std::move(starts);
+    table.coefs_ = std::move(coefs);
+  }
+  /// 释放 boundary_table()
+  void ClearBoundaryTable() {
+    Vector<double>().swap(boundary_table_.starts_);
+    Vector<double>().swap(boundary_table_.coefs_);
+  }
+
+  /// lanes 由内向外(|id| 升序)的下标
+  static std::vector<size_t> LaneOrder(const Vector<Lane>& lanes) {
+    std::vector<size_t> order(lanes.size());
+    for (size_t j = 0; j < order.size(); j++) {
+      order[j] = j;
+    }
+    std::sort(order.begin(), order.end(), [&lanes](size_t a, size_t b) {
+      return std::abs(lanes[a].attribute().id()) <
+             std::abs(lanes[b].attribute().id());
+    });
+    return order;
+  }
+
+ private:
+
+  /// 一段内 lanes 各外边界的系数, out[j * 4]: lanes[j]
+  static void AccumulateCoefs(const Vector<Lane>& lanes,
+                              const std::vector<size_t>& order, double mid_ds,
+                              double h, double sign, const double* center,
+                              double* out) {
+    double t[4] = {center[0], center[1], center[2], center[3]};
+    for (size_t j : order) {
+      const Lane& lane = lanes[j];
+      if (!lane.widths().empty()) {
+        const int index = common::GetGtValuePoloy3(lane.widths(), mid_ds);
+        if (index >= 0) {
+          const auto& width = lane.widths()[index];
+          LaneBoundaryTable::AddShifted(width, h - width.s(), sign, t);
+        }
+      } else if (!lane.borders().empty()) {
+        const int index = common::GetGtValuePoloy3(lane.borders(), mid_ds);
+        if (index >= 0) {
+          const auto& border = lane.borders()[index];
+          std::copy(center, center + 4, t);
+          LaneBoundaryTable::AddShifted(border, h - border.s(), sign, t);
+        }
+      }
+      std::copy(t, t + 4, out + j * 4);
+    }
+  }
+
+  void BoundariesFromTable(const double* road_s, size_t n,
+                           LaneBoundaries* out) const {
+    const auto& table = boundary_table_;
+    const size_t left_num = table.left_num_;
+    const size_t right_num = table.right_num_;
+    size_t segment = 0;
+    for (size_t i = 0; i < n; i++) {
+      segment = table.Segment(road_s[i], segment);
+      const double* coef = table.coefs(segment);
+      const double u = table.SegmentOffset(segment, road_s[i]);
+      out->road_s_[i] = road_s[i];
+      out->center_[i] = LaneBoundaryTable::Horner(coef, u);
+      coef += 4;
+      for (size_t j = 0; j < left_num; j++, coef += 4) {
+        out->left_[i * left_num + j] = LaneBoundaryTable::Horner(coef, u);
+      }
+      for (size_t j = 0; j < right_num; j++, coef += 4) {
+        out->right_[i * right_num + j] = LaneBoundaryTable::Horner(coef, u);
+      }
+    }
+  }
+
+  /// out[i * lanes.size() + j]: 第 i 个样本 lanes[j] 的外边界
+  void AccumulateBoundaries(const Vector<Lane>& lanes, const double* road_s,
+                            size_t n, const double* center, double sign,
+                            double* out) const {
+    using WidthCursor =
+        common::Poloy3Cursor<LaneWidth, LaneWidths::allocator_type>;
+    using BorderCursor =
+        common::Poloy3Cursor<LaneBorder, LaneBorders::allocator_type>;
+    const size_t lane_num = lanes.size();
+    if (0 == lane_num) return;
+    /// 由内向外
+    const std::vector<size_t> order = LaneOrder(lanes);
+    std::vector<WidthCursor> width_cursors;
+    std::vector<BorderCursor> border_cursors;
+    width_cursors.reserve(lane_num);
+    border_cursors.reserve(lane_num);
+    for (size_t j : order) {
+      width_cursors.emplace_back(lanes[j].widths());
+      border_cursors.emplace_back(lanes[j].borders());
+    }
+    for (size_t i = 0; i < n; i++) {
+      /// 与 Lane::GetLaneWidth 相同, section 起点之前按起点计算
+      const double ds = std::max(0., road_s[i] - start_position_);
+      double t = center[i];
+      for (size_t k = 0; k < lane_num; k++) {
+        const Lane& lane = lanes[order[k]];
+        if (!lane.widths().empty()) {
+          const int index = width_cursors[k].Gt(ds);
+          if (index >= 0) {
+            t += sign * lane.widths()[index].GetOffsetValue(ds);
+          }
+        } else if (!lane.borders().empty()) {
+          const int index = border_cursors[k].Gt(ds);
+          if (index >= 0) {
+            t = center[i] + sign * lane.borders()[index].GetOffsetValue(ds);
+          }
+        }
+        out[i * lane_num + order[k]] = t;
+      }
+    }
+  }
+
+  LaneBoundaryTable boundary_table_;
 };
-using LaneSections = std::vector<LaneSection>;
+using LaneSections = Vector<LaneSection>;
 
 class Lanes {
   REGISTER_MEMBER_COMPLEX_TYPE(LaneOffsets, lane_offsets);
@@ -434,7 +1093,7 @@ class RoadLink {
 class RoadTypeInfo {
   REGISTER_MEMBER_BASIC_TYPE(double, start_position, -1);
   REGISTER_MEMBER_COMPLEX_TYPE(RoadType, type);
-  REGISTER_MEMBER_COMPLEX_TYPE(std::string, country);
+  REGISTER_MEMBER_COMPLEX_TYPE(String, country);
   REGISTER_MEMBER_BASIC_TYPE(float, max_speed, 0);
   REGISTER_MEMBER_COMPLEX_TYPE(SpeedUnit, speed_unit);
 
@@ -457,12 +1116,55 @@ class RoadPlanView {
 class Road {
   REGISTER_MEMBER_COMPLEX_TYPE(RoadAttribute, attribute);
   REGISTER_MEMBER_COMPLEX_TYPE(RoadLink, link);
-  REGISTER_MEMBER_COMPLEX_TYPE(std::vector<RoadTypeInfo>, type_info);
+  REGISTER_MEMBER_COMPLEX_TYPE(Vector<RoadTypeInfo>, type_info);
   REGISTER_MEMBER_COMPLEX_TYPE(RoadPlanView, plan_view);
   REGISTER_MEMBER_COMPLEX_TYPE(Lanes, lanes);
+  /// 原始 <road> 片段的指纹(common::Fingerprint), 0: 未知
+  REGISTER_MEMBER_BASIC_TYPE(uint64_t, fingerprint, 0);
 
  public:
-  Road() {}
+  Road() : fingerprint_(0) {}
+  /// 构建所有 LaneSection 的 boundary_table()
+  void BuildLaneBoundaryTables() {
+    for (auto& section : *lanes_.mutable_lane_sections()) {
+      section.BuildBoundaryTable(lanes_.lane_offsets());
+    }
+  }
+  /**
+   * @brief 批量计算参考线上的点
+   *
+   * 用 common::Poloy3Cursor 查找 geometry, 每段属于同一 geometry 的连续
+   * 样本只分派一次. 第一个 geometry 之前的 s 由第一个 geometry 外推,
+   * 之后的由最后一个外推.
+   *
+   * @param road_s n 个升序的 s; 乱序时结果仍然正确, 只是需要额外查找
+   * @param out n 个结果
+   * @return false: planView 为空
+   */
+  bool GetReferencePoints(const double* road_s, size_t n, Point* out) const {
+    const auto& geometrys = plan_view_.geometrys();
+    if (geometrys.empty()) return false;
+    const size_t geometry_num = geometrys.size();
+    auto cursor = common::MakePoloy3Cursor(geometrys);
+    size_t i = 0;
+    while (i < n) {
+      const size_t index =
+          static_cast<size_t>(std::max(0, cursor.Ge(road_s[i])));
+      const double begin_s =
+          0 == index ? -std::numeric_limits<double>::infinity()
+                     : geometrys[index]->s();
+      const double end_s = index + 1 < geometry_num
+                               ? geometrys[index + 1]->s()
+                               : std::numeric_limits<double>::infinity();
+      size_t j = i + 1;
+      while (j < n && road_s[j] >= begin_s && road_s[j] < end_s) {
+        j++;
+      }
+      geometrys[index]->GetPoints(road_s + i, j - i, out + i);
+      i = j;
+    }
+    return true;
+  }
 };
 
 class JunctionAttribute {
@@ -493,7 +1195,7 @@ class JunctionLaneLink {
  public:
   JunctionLaneLink() : from_(-1), to_(-1) {}
 };
-using JunctionLaneLinks = std::vector<JunctionLaneLink>;
+using JunctionLaneLinks = Vector<JunctionLaneLink>;
 
 class JunctionConnection {
   REGISTER_MEMBER_BASIC_TYPE(Id, id, -1);
@@ -513,25 +1215,43 @@ class JunctionConnection {
         linked_road_(-1),
         contact_point_(ContactPointType::kUnknown) {}
 };
-using JunctionConnections = std::vector<JunctionConnection>;
+using JunctionConnections = Vector<JunctionConnection>;
 
 class Junction {
   REGISTER_MEMBER_COMPLEX_TYPE(JunctionAttribute, attribute);
   REGISTER_MEMBER_COMPLEX_TYPE(JunctionConnections, connections);
+  /// 原始 <junction> 片段的指纹(common::Fingerprint), 0: 未知
+  REGISTER_MEMBER_BASIC_TYPE(uint64_t, fingerprint, 0);
 
  public:
-  Junction() {}
+  Junction() : fingerprint_(0) {}
 };
 
 class Map {
   REGISTER_MEMBER_COMPLEX_TYPE(Header, header);
-  REGISTER_MEMBER_COMPLEX_TYPE(std::vector<Road>, roads);
-  REGISTER_MEMBER_COMPLEX_TYPE(std::vector<Junction>, junctions);
+  REGISTER_MEMBER_COMPLEX_TYPE(Vector<Road>, roads);
+  REGISTER_MEMBER_COMPLEX_TYPE(Vector<Junction>, junctions);
 
  public:
   using Ptr = std::shared_ptr<Map>;
   using ConstPtr = std::shared_ptr<Map const>;
   Map() {}
+  /**
+   * @brief 创建整个元素树都从 arena 分配的地图
+   *
+   * 解析器向该地图写入时自动使用它的 arena. 地图及其元素(包括 geometry)
+   * 必须在 arena Release()/析构之前释放.
+   *
+   * @param arena nullptr: 堆分配
+   */
+  static Ptr Create(common::Arena* arena) {
+    common::ScopedArena scope(arena);
+    return std::allocate_shared<Map>(common::ArenaAllocator<Map>(arena));
+  }
+  /// 元素树所在的 arena, 堆分配时为 nullptr
+  common::Arena* arena() const noexcept {
+    return roads_.get_allocator().arena();
+  }
 };
 
 }  // namespace element
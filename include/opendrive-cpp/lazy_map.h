@@ -0,0 +1,131 @@
+#ifndef OPENDRIVE_CPP_LAZY_MAP_H_
+#define OPENDRIVE_CPP_LAZY_MAP_H_
+
+#include <tinyxml2.h>
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "opendrive-cpp/common/arena.h"
+#include "opendrive-cpp/common/mapped_file.h"
+#include "opendrive-cpp/common/status.h"
+#include "opendrive-cpp/geometry/element.h"
+
+namespace opendrive {
+
+/**
+ * @brief 按需解析 road 的地图
+ *
+ * Load 只完整解析 <header>/<junction>, 每个 <road> 只解析属性、<link>、
+ * <type> 并记录片段在文件中的位置. <planView>/<lanes> 在第一次 GetRoad
+ * 时才解析. GetRoad 可以被多个线程并发调用, 同一 road 只解析一次.
+ *
+ * Load(xml_file) 映射文件而不是读入内存, 扫描过的页面随即释放;
+ * LazyMap 存活期间文件内容不能改变.
+ *
+ * 扫描时由 <geometry> 的起点和长度估计每个 road 参考线的包围盒,
+ * LoadRegion 只解析与给定区域相交的 road, 区域可以多次扩大.
+ */
+class LazyMap {
+ public:
+  using Ptr = std::shared_ptr<LazyMap>;
+  LazyMap();
+  /// 元素树分配在 arena 中, 见 element::Map::Create
+  explicit LazyMap(common::Arena* arena);
+  LazyMap(const LazyMap&) = delete;
+  LazyMap& operator=(const LazyMap&) = delete;
+
+  opendrive::Status Load(const std::string& xml_file);
+  /// 从内存中的 xodr 加载, 数据由 LazyMap 持有
+  opendrive::Status LoadData(std::string xml_data);
+
+  std::string opendrive_version() const { return opendrive_version_; }
+  const element::Header& header() const { return map_->header(); }
+  const element::Vector<element::Junction>& junctions() const {
+    return map_->junctions();
+  }
+  /// 按文档顺序的 road id
+  element::Ids road_ids() const;
+  size_t road_size() const noexcept { return entries_.size(); }
+  bool HasRoad(element::Id id) const { return index_.count(id) > 0; }
+  /// 已解析 <planView>/<lanes> 的 road 个数
+  size_t loaded_road_size() const noexcept {
+    return loaded_num_.load(std::memory_order_relaxed);
+  }
+  bool IsRoadLoaded(element::Id id) const;
+
+  /**
+   * @brief 只含属性、link、type 的 road, 不触发解析
+   *
+   * @return id 不存在时为 nullptr
+   */
+  const element::Road* PeekRoad(element::Id id) const;
+  /**
+   * @brief 完整的 road, 第一次访问时解析, 线程安全
+   *
+   * @param status 可为空, 返回解析结果
+   * @return id 不存在或解析失败时为 nullptr
+   */
+  const element::Road* GetRoad(element::Id id,
+                               opendrive::Status* status = nullptr) const;
+
+  /**
+   * @brief 解析参考线包围盒与任一区域相交的 road, 已解析的保持不变
+   *
+   * 包围盒只覆盖参考线, 需要车道完整落在区域内时调用方应按路宽扩大区域.
+   * 与 GetRoad 一样线程安全.
+   *
+   * @return 按文档顺序的第一个错误
+   */
+  opendrive::Status LoadRegion(const element::Boxes& regions) const;
+  /// 参考线包围盒: 每段 geometry 起点为中心, 长度为半宽; id 不存在时为空
+  element::Box RoadBound(element::Id id) const;
+  /// 参考线包围盒与任一区域相交的 road id, 按文档顺序, 不触发解析
+  element::Ids RoadsInRegion(const element::Boxes& regions) const;
+
+  /**
+   * @brief 底层的 Map, 未解析的 road 只含属性、link、type
+   *
+   * 不能与 GetRoad/LoadRegion 并发使用
+   */
+  const element::Map& map() const noexcept { return *map_; }
+
+ private:
+  struct RoadEntry {
+    RoadEntry(size_t _offset, size_t _size, bool _loaded,
+              const element::Box& _bound)
+        : offset(_offset), size(_size), bound(_bound), loaded(_loaded) {}
+    size_t offset;
+    size_t size;
+    element::Box bound;
+    std::once_flag once;
+    std::atomic<bool> loaded;
+    opendrive::Status status;
+  };
+  void Reset();
+  opendrive::Status Scan();
+  opendrive::Status AddRoad(size_t offset, size_t size, size_t head_size,
+                            tinyxml2::XMLDocument* doc);
+  opendrive::Status LoadRoad(RoadEntry* entry, element::Road* road) const;
+
+  common::Arena* arena_ = nullptr;
+  element::Map::Ptr map_;
+  common::MappedFile file_;
+  std::string buffer_;
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  std::string opendrive_version_;
+  /// 与 map_->roads() 一一对应
+  mutable std::deque<RoadEntry> entries_;
+  std::unordered_map<element::Id, size_t> index_;
+  mutable std::atomic<size_t> loaded_num_{0};
+};
+
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_CPP_LAZY_MAP_H_
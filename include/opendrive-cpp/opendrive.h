@@ -2,33 +2,190 @@
 #define OPENDRIVE_CPP_H_
 #include <tinyxml2.h>
 
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "opendrive-cpp/common/common.hpp"
+#include "opendrive-cpp/common/inflate_stream.h"
+#include "opendrive-cpp/common/options.h"
+#include "opendrive-cpp/common/parse_stats.h"
 #include "opendrive-cpp/common/status.h"
+#include "opendrive-cpp/common/trace.h"
 #include "opendrive-cpp/geometry/element.h"
+#include "opendrive-cpp/lazy_map.h"
+#include "opendrive-cpp/parser/junction_parser.h"
 #include "opendrive-cpp/parser/map_parser.h"
+#include "opendrive-cpp/parser/reload_parser.h"
 #include "opendrive-cpp/parser/road_parser.h"
 #include "opendrive-cpp/parser/section_parser.h"
+#include "opendrive-cpp/parser/stream_parser.h"
+#include "opendrive-cpp/polylines.h"
+#include "opendrive-cpp/snapshot/map_image.h"
+#include "opendrive-cpp/snapshot/snapshot.h"
 
 namespace opendrive {
 
+/**
+ * @brief Parser::ParseMapAsync 的句柄
+ *
+ * 析构时取消并等待解析线程退出.
+ */
+class ParseTask {
+ public:
+  using Ptr = std::shared_ptr<ParseTask>;
+  ~ParseTask();
+  ParseTask(const ParseTask&) = delete;
+  ParseTask& operator=(const ParseTask&) = delete;
+
+  /// 请求取消, 解析线程在下一条 road/junction 之前退出
+  void Cancel() noexcept { cancel_.store(true, std::memory_order_relaxed); }
+  bool cancelled() const noexcept {
+    return cancel_.load(std::memory_order_relaxed);
+  }
+  bool ready() const;
+  /// 在 timeout 内完成返回 true
+  bool WaitFor(std::chrono::milliseconds timeout) const;
+  /// 等待完成并返回结果, 被取消时为 PARSE_CANCELLED
+  opendrive::Status Wait() const;
+  /// 最近一次报告的进度
+  ParseProgress progress() const;
+
+ private:
+  friend class Parser;
+  ParseTask() = default;
+  void set_progress(const ParseProgress& progress);
+
+  std::atomic<bool> cancel_{false};
+  mutable std::mutex mutex_;
+  ParseProgress progress_;
+  std::shared_future<opendrive::Status> future_;
+  std::thread thread_;
+};
+
 typedef class Parser ParserType;
+/**
+ * @brief 地图解析入口
+ *
+ * 每次调用使用各自的解析器与线程池, 同一个 Parser 可以重复使用,
+ * 也可以在多个线程中同时调用(ParseOptions::stats/trace 此时被共享,
+ * 需要各线程单独统计时使用不同的 Parser).
+ */
 class Parser {
  public:
   typedef std::shared_ptr<ParserType> Ptr;
   ~Parser() = default;
   Parser();
+  explicit Parser(const ParseOptions& options);
+  /// 最近一次成功的 ParseMap/ParseMapStream 解析到的版本
   std::string GetOpenDriveVersion() const;
   opendrive::Status ParseMap(const std::string& xml_file,
-                             element::Map::Ptr ele_map);
+                             element::Map::Ptr ele_map) const;
   opendrive::Status ParseMap(const tinyxml2::XMLElement* xml_root,
-                             element::Map::Ptr ele_map);
+                             element::Map::Ptr ele_map) const;
+  /// 解析内存中的 xodr, gzip/zlib 压缩数据边解压边解析
+  opendrive::Status ParseMap(const char* data, size_t size,
+                             element::Map::Ptr ele_map) const;
+  /**
+   * @brief 从数据源流式解析, 不需要临时文件和完整的解压副本
+   *
+   * gzip/zlib 压缩数据自动识别; thread_num != 1 时解压在独立线程中进行,
+   * 与解析流水并行
+   */
+  opendrive::Status ParseMap(const common::StreamReader& reader,
+                             element::Map::Ptr ele_map) const;
+  /// 按需解析 road: 启动时只扫描一遍文件, road 在第一次访问时解析
+  opendrive::Status ParseLazyMap(const std::string& xml_file,
+                                 LazyMap::Ptr lazy_map) const;
+  /**
+   * @brief 增量重新加载, 只重新解析内容变化的 road/junction
+   *
+   * ele_map 为上一次加载的结果(可以为空 Map), 成功后与 xml_file 一致.
+   * 用 ParseMapStream/ReloadMap 加载的 Map 带有片段指纹, 重新加载最快.
+   * 使用 thread_num 以外的 ParseOptions. ele_map 不能是 arena 地图
+   * (返回 INVALID_ARGUMENT), arena 地图使用带 next_arena 的重载.
+   *
+   * @param diff 可选, 新增/删除/修改的 id
+   */
+  opendrive::Status ReloadMap(const std::string& xml_file,
+                              element::Map::Ptr ele_map,
+                              parser::MapDiff* diff = nullptr) const;
+  opendrive::Status ReloadMap(const char* data, size_t size,
+                              element::Map::Ptr ele_map,
+                              parser::MapDiff* diff = nullptr) const;
+  /**
+   * @brief arena 地图的增量重新加载, 两个 arena 交替使用
+   *
+   * 新地图建在 next_arena 中, 未变化的 road/junction 从旧地图复制过去.
+   * 成功后 *ele_map 指向新地图, 释放旧地图的所有引用后即可 Release
+   * 旧 arena, 内存不随重新加载的次数增长. 失败时 *ele_map 不变.
+   */
+  opendrive::Status ReloadMap(const std::string& xml_file,
+                              common::Arena* next_arena,
+                              element::Map::Ptr* ele_map,
+                              parser::MapDiff* diff = nullptr) const;
+  opendrive::Status ReloadMap(const char* data, size_t size,
+                              common::Arena* next_arena,
+                              element::Map::Ptr* ele_map,
+                              parser::MapDiff* diff = nullptr) const;
+  /**
+   * @brief 只完整解析参考线与区域相交的 road
+   *
+   * 区域外 road 的 <planView>/<lanes> 不解析, 之后可以通过
+   * lazy_map->LoadRegion 扩大区域, 或 GetRoad 按需解析.
+   */
+  opendrive::Status ParseMap(const std::string& xml_file,
+                             const element::Boxes& regions,
+                             LazyMap::Ptr lazy_map) const;
+  /// 流式解析, 设置 road_callback 后 road 不写入 ele_map
+  opendrive::Status ParseMapStream(
+      const std::string& xml_file, element::Map::Ptr ele_map,
+      const parser::StreamXmlParser::RoadCallback& road_callback =
+          nullptr) const;
+
+  /**
+   * @brief 批量解析多个文件, 文件在 thread_num 个线程之间调度
+   *
+   * 每个文件在一个线程内串行解析. ele_maps 调整为与 xml_files 等长,
+   * 为空的元素自动创建.
+   *
+   * @return 与 xml_files 一一对应的结果
+   */
+  std::vector<opendrive::Status> ParseMaps(
+      const std::vector<std::string>& xml_files,
+      std::vector<element::Map::Ptr>* ele_maps) const;
+  /**
+   * @brief 在后台线程中解析 xml_file
+   *
+   * 进度同时交给 ParseOptions::progress 与 ParseTask::progress();
+   * 取消后 ele_map 中的 road/junction 被清空. ParseOptions::cancel
+   * 被忽略, 使用 ParseTask::Cancel.
+   */
+  ParseTask::Ptr ParseMapAsync(const std::string& xml_file,
+                               element::Map::Ptr ele_map) const;
 
  private:
-  tinyxml2::XMLDocument xml_doc_;
-  std::unique_ptr<parser::MapXmlParser> map_parser_;
+  opendrive::Status ParseXmlFile(const std::string& xml_file,
+                                 const ParseOptions& options,
+                                 element::Map::Ptr ele_map,
+                                 size_t* bytes) const;
+  opendrive::Status ParseXmlRoot(const tinyxml2::XMLElement* xml_root,
+                                 const ParseOptions& options, size_t bytes,
+                                 element::Map::Ptr ele_map) const;
+  /// 解析成功后记录版本, 供 GetOpenDriveVersion 返回
+  void SetOpenDriveVersion(const std::string& version) const;
+  opendrive::Status LoadXmlFile(const std::string& xml_file,
+                                tinyxml2::XMLDocument* xml_doc,
+                                size_t* bytes) const;
+  ParseOptions options_;
+  mutable std::mutex mutex_;
+  mutable std::string opendrive_version_;
 };
 
 }  // namespace opendrive
@@ -1,11 +1,18 @@
 #ifndef OPENDRIVE_CPP_MAP_PARSER_H_
 #define OPENDRIVE_CPP_MAP_PARSER_H_
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "opendrive-cpp/common/common.hpp"
+#include "opendrive-cpp/common/options.h"
 #include "opendrive-cpp/common/status.h"
+#include "opendrive-cpp/common/thread_pool.h"
 #include "opendrive-cpp/geometry/element.h"
+#include "opendrive-cpp/parser/header_parser.h"
+#include "opendrive-cpp/parser/junction_parser.h"
 #include "opendrive-cpp/parser/road_parser.h"
 #include "opendrive-cpp/parser/section_parser.h"
 
@@ -13,15 +20,33 @@ namespace opendrive {
 namespace parser {
 class MapXmlParser : public XmlParser {
  public:
+  MapXmlParser() = default;
+  explicit MapXmlParser(const ParseOptions& options);
   opendrive::Status Parse(const tinyxml2::XMLElement* map_ele,
                           element::Map::Ptr ele_map);
+  /// 输入的 xml 字节数, 只用于进度报告
+  void set_input_bytes(size_t bytes) noexcept { input_bytes_ = bytes; }
 
  private:
   MapXmlParser& HeaderElement();
   MapXmlParser& JunctionElement();
   MapXmlParser& RoadElement();
+  /// 按文档顺序返回第一个错误
+  bool CheckStatuses(const std::vector<Status>& statuses);
+  bool Cancelled() const noexcept {
+    return options_.cancel && options_.cancel->load(std::memory_order_relaxed);
+  }
+  /// 一条 road 解析完成
+  void ReportRoad();
   const tinyxml2::XMLElement* xml_map_;
   element::Map::Ptr ele_map_;
+  ParseOptions options_;
+  std::unique_ptr<common::ThreadPool> thread_pool_;
+  size_t input_bytes_ = 0;
+  size_t roads_total_ = 0;
+  std::atomic<size_t> roads_parsed_{0};
+  std::mutex progress_mutex_;
+  size_t roads_reported_ = 0;
 };
 
 }  // namespace parser
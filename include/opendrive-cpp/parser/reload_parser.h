@@ -0,0 +1,84 @@
+#ifndef OPENDRIVE_CPP_RELOAD_PARSER_H_
+#define OPENDRIVE_CPP_RELOAD_PARSER_H_
+
+#include <cstddef>
+
+#include "opendrive-cpp/common/arena.h"
+#include "opendrive-cpp/common/common.hpp"
+#include "opendrive-cpp/common/options.h"
+#include "opendrive-cpp/common/status.h"
+#include "opendrive-cpp/geometry/element.h"
+#include "opendrive-cpp/parser/util_parser.h"
+
+namespace opendrive {
+namespace parser {
+
+/// 两次加载之间的差异, added/modified 按新文档顺序, removed 按旧 Map 顺序
+struct MapDiff {
+  bool header_changed = false;
+  element::Ids added_roads;
+  element::Ids removed_roads;
+  element::Ids modified_roads;
+  element::Ids added_junctions;
+  element::Ids removed_junctions;
+  element::Ids modified_junctions;
+  /// 指纹未变化, 未重新解析而直接复用的个数
+  size_t reused_roads = 0;
+  size_t reused_junctions = 0;
+
+  bool empty() const noexcept;
+  void Clear();
+};
+
+/**
+ * @brief 增量重新加载
+ *
+ * 流式扫描新文档, 对每个 <road>/<junction> 片段计算指纹并与旧 Map 中
+ * 同 id 元素记录的指纹比较, 相同则直接移入新 Map, 不同才构建 DOM 解析.
+ * 旧元素没有指纹(非流式解析或快照加载)时解析新片段后按内容比较,
+ * 之后的重新加载即可复用. OpenDRIVE 版本变化时全部重新解析.
+ *
+ * 重新解析的 road 与复用的 road 都按 ParseOptions::lane_boundary_tables
+ * 构建或释放车道边界表; ParseOptions::cancel 在片段之间检查.
+ *
+ * 只支持未压缩的 xodr. 失败时 ele_map 保持不变.
+ */
+class ReloadXmlParser : public XmlParser {
+ public:
+  ReloadXmlParser() = default;
+  explicit ReloadXmlParser(const ParseOptions& options);
+  /**
+   * @brief 原地重新加载, 复用的元素直接移入新地图
+   *
+   * arena 地图的旧元素无法单独归还, 原地重新加载会使 arena 持续增长,
+   * 此时返回 INVALID_ARGUMENT, 需使用带 next_arena 的重载.
+   */
+  opendrive::Status Reload(const char* data, size_t size,
+                           element::Map::Ptr ele_map, MapDiff* diff);
+  /**
+   * @brief 在 next_arena 中构建新地图, 成功后 *ele_map 指向新地图
+   *
+   * 复用的 road/junction(包括 geometry)复制到 next_arena, 不重新解析.
+   * 之后新地图不再引用旧地图的 arena, 调用方释放旧地图后即可 Release
+   * 该 arena. next_arena 为 nullptr 时新地图使用堆分配; next_arena
+   * 不能是旧地图的 arena.
+   */
+  opendrive::Status Reload(const char* data, size_t size,
+                           common::Arena* next_arena,
+                           element::Map::Ptr* ele_map, MapDiff* diff);
+
+ private:
+  /// 把 data 解析到 next_map, 复用 old_map 中未变化的元素
+  opendrive::Status Build(const char* data, size_t size,
+                          element::Map* old_map, element::Map::Ptr next_map,
+                          MapDiff* diff);
+  /// 按 options_ 构建或释放 road 的车道边界表
+  void SyncBoundaryTables(element::Road* road) const;
+
+  ParseOptions options_;
+};
+
+}  // namespace parser
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_CPP_RELOAD_PARSER_H_
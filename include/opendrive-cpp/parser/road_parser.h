@@ -16,6 +16,16 @@ class RoadXmlParser : public XmlParser {
   RoadXmlParser(const std::string& version);
   opendrive::Status Parse(const tinyxml2::XMLElement* xml_road,
                           element::Road* ele_road);
+  /// 只解析 road 属性、<link>、<type>
+  opendrive::Status ParseHead(const tinyxml2::XMLElement* xml_road,
+                              element::Road* ele_road);
+  /// 只解析 <planView>、<lanes>, ele_road 的属性需已解析
+  opendrive::Status ParseBody(const tinyxml2::XMLElement* xml_road,
+                              element::Road* ele_road);
+  /// Parse 之后构建车道边界表, 见 ParseOptions::lane_boundary_tables
+  void set_lane_boundary_tables(bool enable) {
+    lane_boundary_tables_ = enable;
+  }
 
  private:
   RoadXmlParser& Attributes();
@@ -25,8 +35,10 @@ class RoadXmlParser : public XmlParser {
   RoadXmlParser& LanesElement();
   RoadXmlParser& CheckLanesElement();
   RoadXmlParser& GenerateRoad();
+  RoadXmlParser& BoundaryTables();
   const tinyxml2::XMLElement* xml_road_;
   element::Road* ele_road_;
+  bool lane_boundary_tables_ = false;
 };
 
 }  // namespace parser
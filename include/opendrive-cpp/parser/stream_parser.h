@@ -0,0 +1,123 @@
+#ifndef OPENDRIVE_CPP_STREAM_PARSER_H_
+#define OPENDRIVE_CPP_STREAM_PARSER_H_
+
+#include <tinyxml2.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "opendrive-cpp/common/common.hpp"
+#include "opendrive-cpp/common/options.h"
+#include "opendrive-cpp/common/status.h"
+#include "opendrive-cpp/geometry/element.h"
+#include "opendrive-cpp/parser/header_parser.h"
+#include "opendrive-cpp/parser/junction_parser.h"
+#include "opendrive-cpp/parser/road_parser.h"
+#include "opendrive-cpp/parser/util_parser.h"
+
+namespace opendrive {
+namespace parser {
+
+/**
+ * @brief 流式解析, 不构建整棵 DOM
+ *
+ * 增量扫描 <OpenDRIVE> 的直接子元素, 每当 <header>/<road>/<junction>
+ * 的结束标签出现时, 只对该子元素片段构建 DOM 并复用 HeaderXmlParser,
+ * RoadXmlParser, JunctionXmlParser 解析. 内存峰值与最大的单个片段相关,
+ * 与整个文件大小无关. 解析出的 road/junction 记录片段的指纹,
+ * 供 ReloadXmlParser 判断是否变化.
+ */
+class StreamXmlParser : public XmlParser {
+ public:
+  /// 设置回调后, road/junction 交给回调, 不再写入 Map
+  using RoadCallback = std::function<void(element::Road&&)>;
+  using JunctionCallback = std::function<void(element::Junction&&)>;
+  /**
+   * @brief 设置后 <road> 片段不构建 DOM, 原始文本交给回调
+   *
+   * head_size: 片段中第一个 <planView>/<lanes> 子元素之前的长度,
+   * 即 road 属性、<link>、<type> 所在的部分
+   */
+  using RoadFragmentCallback = std::function<opendrive::Status(
+      const char* data, size_t size, size_t head_size)>;
+  /// 设置后 <junction> 片段不构建 DOM, 原始文本交给回调
+  using JunctionFragmentCallback =
+      std::function<opendrive::Status(const char* data, size_t size)>;
+  StreamXmlParser() = default;
+  explicit StreamXmlParser(const ParseOptions& options);
+  void set_road_callback(const RoadCallback& callback);
+  void set_junction_callback(const JunctionCallback& callback);
+  void set_road_fragment_callback(const RoadFragmentCallback& callback);
+  void set_junction_fragment_callback(
+      const JunctionFragmentCallback& callback);
+
+  /// 增量接口: Begin -> Feed ... -> End
+  opendrive::Status Begin(element::Map::Ptr ele_map);
+  opendrive::Status Feed(const char* data, size_t size);
+  opendrive::Status End();
+
+  /// 解析一段连续的内存, 不复制输入
+  opendrive::Status Parse(const char* data, size_t size,
+                          element::Map::Ptr ele_map);
+  /// 解析文件, 已解析过的页面会及时释放
+  opendrive::Status ParseFile(const std::string& xml_file,
+                              element::Map::Ptr ele_map);
+
+  /// 已消费的输入字节数
+  size_t bytes_consumed() const noexcept { return bytes_consumed_; }
+
+ private:
+  enum class TagType { kUnknown = 0, kStart, kEmpty, kEnd, kOther };
+  /**
+   * @brief 扫描 [data, data + size), 返回不再需要的字节数
+   */
+  size_t Process(const char* data, size_t size);
+  /**
+   * @brief 定位从 begin('<')开始的标签
+   *
+   * @return 标签结束位置(不含), 标签不完整时返回 0
+   */
+  size_t ScanTag(const char* data, size_t size, size_t begin, TagType* type,
+                 std::string* name) const;
+  void Dispatch(const char* data, size_t size, const std::string& name);
+  bool Cancelled() const;
+  /// 每个 road 片段之后报告进度, 总 road 数未知
+  void ReportRoad() const;
+  /// 记录 road 片段头部的结束位置
+  void MarkRoadHead(size_t begin, const std::string& name);
+  StreamXmlParser& HeaderFragment(const tinyxml2::XMLElement* xml_header);
+  StreamXmlParser& RoadFragment(const tinyxml2::XMLElement* xml_road);
+  StreamXmlParser& JunctionFragment(
+      const tinyxml2::XMLElement* xml_junction);
+
+  ParseOptions options_;
+  RoadCallback road_callback_;
+  JunctionCallback junction_callback_;
+  RoadFragmentCallback road_fragment_callback_;
+  JunctionFragmentCallback junction_fragment_callback_;
+  element::Map::Ptr ele_map_;
+  tinyxml2::XMLDocument fragment_doc_;
+  std::string buffer_;
+  std::string root_name_;
+  std::string fragment_name_;
+  size_t scan_pos_ = 0;
+  size_t fragment_begin_ = 0;
+  size_t fragment_head_ = std::string::npos;
+  /// 当前片段的 common::Fingerprint, 写入 road/junction
+  uint64_t fragment_fingerprint_ = 0;
+  size_t depth_ = 0;
+  size_t bytes_consumed_ = 0;
+  /// 输入总字节数, Feed 时未知为 0
+  size_t bytes_total_ = 0;
+  size_t header_num_ = 0;
+  size_t road_num_ = 0;
+  bool scan_road_head_ = false;
+  bool finished_ = false;
+};
+
+}  // namespace parser
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_CPP_STREAM_PARSER_H_
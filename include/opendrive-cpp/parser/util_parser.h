@@ -3,7 +3,6 @@
 #include <tinyxml2.h>
 
 #include <memory>
-#include <mutex>
 
 #include "opendrive-cpp/common/choices.h"
 #include "opendrive-cpp/common/common.hpp"
@@ -13,6 +12,12 @@
 namespace opendrive {
 namespace parser {
 
+/**
+ * @brief 解析器基类, 保存版本与第一个错误
+ *
+ * 一个实例只在一个线程中使用; 并行解析时每个线程各自创建解析器,
+ * 结果按下标汇总(见 MapXmlParser), 因此状态读写不需要加锁.
+ */
 class XmlParser {
  public:
   XmlParser() = default;
@@ -26,7 +31,6 @@ class XmlParser {
 
  private:
   std::string opendrive_version_;
-  std::mutex mutex_;
   opendrive::Status status_{ErrorCode::OK, "ok"};
 };
 
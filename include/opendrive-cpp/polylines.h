@@ -0,0 +1,109 @@
+#ifndef OPENDRIVE_CPP_POLYLINES_H_
+#define OPENDRIVE_CPP_POLYLINES_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "opendrive-cpp/common/status.h"
+#include "opendrive-cpp/geometry/element.h"
+
+namespace opendrive {
+
+struct PolylineOptions {
+  /// 采样步长(m), 每条折线另外包含终点
+  double step = 0.5;
+  /// road 并行数, 1: 串行, 0: hardware concurrency
+  size_t thread_num = 1;
+  /// 参考线, 每条 road 一条
+  bool reference_lines = true;
+  /// 车道中心线, 每个 laneSection 的每条车道(含中心车道)一条
+  bool center_lines = true;
+  /// 车道左右边界, 每个 laneSection 的每条非中心车道各一条
+  bool boundaries = true;
+};
+
+/// 折线上的点, s 为 road s
+struct PolylinePoint {
+  double x;
+  double y;
+  double heading;
+  double s;
+};
+
+/**
+ * @brief 整张地图的折线, 所有点存放在一个连续的缓冲区中
+ *
+ * 折线按 road 的顺序排列; 每条 road 内先是参考线, 之后按 laneSection
+ * 的顺序, 每个 section 内依次为 left().lanes(), center().lanes(),
+ * right().lanes() 中各车道的中心线、左边界、右边界. 左右以参考线方向
+ * 为准.
+ */
+class MapPolylines {
+ public:
+  enum class Kind : std::uint8_t {
+    kReference = 0,
+    kCenter,
+    kLeftBoundary,
+    kRightBoundary
+  };
+  struct Line {
+    element::Id road_id;
+    /// kReference 时为 -1
+    element::Id section_id;
+    element::Id lane_id;
+    Kind kind;
+    /// 在 points() 中的起始下标与点数
+    size_t begin;
+    size_t size;
+  };
+
+  MapPolylines() = default;
+  const std::vector<PolylinePoint>& points() const noexcept { return points_; }
+  const std::vector<Line>& lines() const noexcept { return lines_; }
+  const PolylinePoint* line_points(const Line& line) const {
+    return points_.data() + line.begin;
+  }
+  void Clear();
+
+  /// 最近一次 GeneratePolylines 使用的线程数
+  size_t thread_num() const noexcept { return thread_num_; }
+  /// 最近一次 GeneratePolylines 的耗时
+  double wall_ms() const noexcept { return wall_ms_; }
+  /// 各线程生成折线的耗时之和
+  double busy_ms() const noexcept { return busy_ms_; }
+  /// 每个线程每秒生成的点数: points().size() / busy_ms
+  double points_per_core_second() const noexcept {
+    return busy_ms_ > 0 ? points_.size() / busy_ms_ * 1e3 : 0.;
+  }
+
+ private:
+  friend opendrive::Status GeneratePolylines(const element::Map& ele_map,
+                                             const PolylineOptions& options,
+                                             MapPolylines* polylines);
+  std::vector<PolylinePoint> points_;
+  std::vector<Line> lines_;
+  size_t thread_num_ = 0;
+  double wall_ms_ = 0;
+  double busy_ms_ = 0;
+};
+
+/**
+ * @brief 按固定 s 步长生成参考线、车道中心线与车道边界的折线
+ *
+ * 每个 laneSection 从起点按 step 采样到终点, 参考线覆盖 [0, length].
+ * 参考点由 Road::GetReferencePoints 批量计算, 车道边界由
+ * LaneSection::GetLaneBoundaries 计算(已构建 boundary_table() 时查表).
+ * 参考线的 heading 为参考线方向; 其余折线的 heading 由相邻点的差分
+ * 得到. 没有 planView 的 road 被跳过.
+ *
+ * 先统计每条 road 的点数, 再由 thread_num 个线程并行写入预先分配的
+ * 缓冲区, 结果与线程数无关.
+ */
+opendrive::Status GeneratePolylines(const element::Map& ele_map,
+                                    const PolylineOptions& options,
+                                    MapPolylines* polylines);
+
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_CPP_POLYLINES_H_
@@ -0,0 +1,519 @@
+#ifndef OPENDRIVE_CPP_MAP_IMAGE_H_
+#define OPENDRIVE_CPP_MAP_IMAGE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "opendrive-cpp/common/mapped_file.h"
+#include "opendrive-cpp/common/status.h"
+#include "opendrive-cpp/geometry/element.h"
+
+namespace opendrive {
+namespace snapshot {
+
+/**
+ * 只读地图镜像(map image)
+ *
+ * 镜像由定长 POD 记录表组成, 记录之间只通过表内下标(Range)和字符串池
+ * 偏移(Str)互相引用, 不含任何指针, 因此可以映射到任意地址. 一个进程
+ * 调用 SaveMapImage 生成镜像(可放在 /dev/shm), 其他进程 Attach 后直接
+ * 在映射内存上查询, 多个进程共享同一份物理页.
+ *
+ * 镜像使用本机字节序, 不同字节序或版本的镜像会被拒绝.
+ */
+constexpr uint32_t kMapImageVersion = 1;
+
+namespace record {
+
+/// 目标表中 [begin, begin + size)
+struct Range {
+  uint32_t begin;
+  uint32_t size;
+};
+
+/// 字符串池偏移, 以 '\0' 结尾
+struct Str {
+  uint32_t offset;
+  uint32_t size;
+};
+
+struct Poly3 {
+  double s;
+  double a;
+  double b;
+  double c;
+  double d;
+};
+
+struct Speed {
+  double s;
+  float max;
+  uint8_t unit;
+};
+
+struct RoadMark {
+  double s;
+  double width;
+  double height;
+  Str material;
+  uint8_t type;
+  uint8_t color;
+  uint8_t weight;
+  uint8_t lane_change;
+};
+
+struct Lane {
+  int32_t id;
+  uint8_t type;
+  uint8_t level;
+  Range predecessors;
+  Range successors;
+  Range widths;
+  Range borders;
+  Range road_marks;
+  Range speeds;
+};
+
+struct LaneSection {
+  double start_position;
+  double end_position;
+  int32_t id;
+  Range left;
+  Range center;
+  Range right;
+};
+
+/// params: arc: curvature; spiral: curve_start, curve_end;
+///         poly3: a, b, c, d; paramPoly3: au, bu, cu, du, av, bv, cv, dv
+struct Geometry {
+  double s;
+  double x;
+  double y;
+  double hdg;
+  double length;
+  double params[8];
+  uint8_t type;
+  uint8_t p_range;
+};
+
+struct RoadLink {
+  double start_position;
+  int32_t id;
+  uint8_t type;
+  uint8_t contact_point;
+  uint8_t dir;
+};
+
+struct RoadTypeInfo {
+  double start_position;
+  Str country;
+  float max_speed;
+  uint8_t type;
+  uint8_t speed_unit;
+};
+
+struct Road {
+  double length;
+  Str name;
+  int32_t id;
+  int32_t junction_id;
+  uint8_t rule;
+  RoadLink predecessor;
+  RoadLink successor;
+  Range type_info;
+  Range geometrys;
+  Range lane_offsets;
+  Range lane_sections;
+};
+
+struct LaneLink {
+  int32_t from;
+  int32_t to;
+};
+
+struct Connection {
+  int32_t id;
+  int32_t incoming_road;
+  int32_t connecting_road;
+  int32_t linked_road;
+  uint8_t type;
+  uint8_t contact_point;
+  Range lane_links;
+};
+
+struct Junction {
+  double start_position;
+  double end_position;
+  Str name;
+  int32_t id;
+  int32_t main_road;
+  uint8_t type;
+  uint8_t dir;
+  Range connections;
+};
+
+/// 按 id 排序的索引
+struct IdIndex {
+  int32_t id;
+  uint32_t index;
+};
+
+struct Header {
+  Str rev_major;
+  Str rev_minor;
+  Str version;
+  Str name;
+  Str date;
+  Str vendor;
+  double north;
+  double south;
+  double west;
+  double east;
+};
+
+enum TableType : uint32_t {
+  kRoads = 0,
+  kRoadIndex,
+  kJunctions,
+  kJunctionIndex,
+  kTypeInfos,
+  kGeometrys,
+  kLaneSections,
+  kLanes,
+  kPoly3s,
+  kRoadMarks,
+  kSpeeds,
+  kIds,
+  kConnections,
+  kLaneLinks,
+  kStrings,
+  kTableNum,
+};
+
+/// offset: 相对镜像起始地址; size: 记录个数
+struct Table {
+  uint64_t offset;
+  uint64_t size;
+};
+
+struct ImageHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint64_t image_size;
+  Header header;
+  Table tables[kTableNum];
+};
+
+}  // namespace record
+
+class MapImage;
+
+/// 连续记录的只读视图, 直接返回记录引用
+template <typename T>
+class RecordList {
+ public:
+  RecordList() = default;
+  RecordList(const T* data, size_t size) : data_(data), size_(size) {}
+  const T* begin() const noexcept { return data_; }
+  const T* end() const noexcept { return data_ + size_; }
+  const T& operator[](size_t i) const noexcept { return data_[i]; }
+  size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return 0 == size_; }
+
+ private:
+  const T* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+/// 连续记录的视图列表, 按下标构造 View
+template <typename View>
+class ViewList {
+ public:
+  using Record = typename View::Record;
+  class Iterator {
+   public:
+    Iterator(const MapImage* image, const Record* record)
+        : image_(image), record_(record) {}
+    View operator*() const { return View(image_, record_); }
+    Iterator& operator++() {
+      ++record_;
+      return *this;
+    }
+    bool operator!=(const Iterator& other) const {
+      return record_ != other.record_;
+    }
+
+   private:
+    const MapImage* image_;
+    const Record* record_;
+  };
+  ViewList() = default;
+  ViewList(const MapImage* image, const Record* data, size_t size)
+      : image_(image), data_(data), size_(size) {}
+  Iterator begin() const { return Iterator(image_, data_); }
+  Iterator end() const { return Iterator(image_, data_ + size_); }
+  View operator[](size_t i) const { return View(image_, data_ + i); }
+  size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return 0 == size_; }
+
+ private:
+  const MapImage* image_ = nullptr;
+  const Record* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+class GeometryView {
+ public:
+  using Record = record::Geometry;
+  GeometryView(const MapImage*, const Record* record) : record_(record) {}
+  double s() const noexcept { return record_->s; }
+  double x() const noexcept { return record_->x; }
+  double y() const noexcept { return record_->y; }
+  double hdg() const noexcept { return record_->hdg; }
+  double length() const noexcept { return record_->length; }
+  GeometryType type() const noexcept {
+    return static_cast<GeometryType>(record_->type);
+  }
+  const double* params() const noexcept { return record_->params; }
+  /// 与 element::Geometry::GetPoint 结果一致, 不分配堆内存
+  element::Point GetPoint(double road_s) const;
+  /// 转换为 element::Geometry
+  element::Geometry::Ptr ToElement() const;
+
+ private:
+  const Record* record_;
+};
+
+class RoadMarkView {
+ public:
+  using Record = record::RoadMark;
+  RoadMarkView(const MapImage* image, const Record* record)
+      : image_(image), record_(record) {}
+  double s() const noexcept { return record_->s; }
+  RoadMarkType type() const noexcept {
+    return static_cast<RoadMarkType>(record_->type);
+  }
+  RoadMarkColor color() const noexcept {
+    return static_cast<RoadMarkColor>(record_->color);
+  }
+  RoadMarkWeight weight() const noexcept {
+    return static_cast<RoadMarkWeight>(record_->weight);
+  }
+  RoadMarkLaneChange lane_change() const noexcept {
+    return static_cast<RoadMarkLaneChange>(record_->lane_change);
+  }
+  double width() const noexcept { return record_->width; }
+  double height() const noexcept { return record_->height; }
+  const char* material() const noexcept;
+
+ private:
+  const MapImage* image_;
+  const Record* record_;
+};
+
+class LaneView {
+ public:
+  using Record = record::Lane;
+  LaneView(const MapImage* image, const Record* record)
+      : image_(image), record_(record) {}
+  element::Id id() const noexcept { return record_->id; }
+  LaneType type() const noexcept {
+    return static_cast<LaneType>(record_->type);
+  }
+  Boolean level() const noexcept {
+    return static_cast<Boolean>(record_->level);
+  }
+  RecordList<int32_t> predecessors() const;
+  RecordList<int32_t> successors() const;
+  RecordList<record::Poly3> widths() const;
+  RecordList<record::Poly3> borders() const;
+  ViewList<RoadMarkView> road_marks() const;
+  RecordList<record::Speed> max_speeds() const;
+
+ private:
+  const MapImage* image_;
+  const Record* record_;
+};
+
+class LaneSectionView {
+ public:
+  using Record = record::LaneSection;
+  LaneSectionView(const MapImage* image, const Record* record)
+      : image_(image), record_(record) {}
+  element::Id id() const noexcept { return record_->id; }
+  double start_position() const noexcept { return record_->start_position; }
+  double end_position() const noexcept { return record_->end_position; }
+  ViewList<LaneView> left() const;
+  ViewList<LaneView> center() const;
+  ViewList<LaneView> right() const;
+
+ private:
+  const MapImage* image_;
+  const Record* record_;
+};
+
+class RoadTypeInfoView {
+ public:
+  using Record = record::RoadTypeInfo;
+  RoadTypeInfoView(const MapImage* image, const Record* record)
+      : image_(image), record_(record) {}
+  double start_position() const noexcept { return record_->start_position; }
+  RoadType type() const noexcept {
+    return static_cast<RoadType>(record_->type);
+  }
+  const char* country() const noexcept;
+  float max_speed() const noexcept { return record_->max_speed; }
+  SpeedUnit speed_unit() const noexcept {
+    return static_cast<SpeedUnit>(record_->speed_unit);
+  }
+
+ private:
+  const MapImage* image_;
+  const Record* record_;
+};
+
+class RoadView {
+ public:
+  using Record = record::Road;
+  RoadView() = default;
+  RoadView(const MapImage* image, const Record* record)
+      : image_(image), record_(record) {}
+  bool valid() const noexcept { return nullptr != record_; }
+  element::Id id() const noexcept { return record_->id; }
+  element::Id junction_id() const noexcept { return record_->junction_id; }
+  double length() const noexcept { return record_->length; }
+  const char* name() const noexcept;
+  RoadRule rule() const noexcept {
+    return static_cast<RoadRule>(record_->rule);
+  }
+  const record::RoadLink& predecessor() const noexcept {
+    return record_->predecessor;
+  }
+  const record::RoadLink& successor() const noexcept {
+    return record_->successor;
+  }
+  ViewList<RoadTypeInfoView> type_info() const;
+  ViewList<GeometryView> geometrys() const;
+  RecordList<record::Poly3> lane_offsets() const;
+  ViewList<LaneSectionView> lane_sections() const;
+
+ private:
+  const MapImage* image_ = nullptr;
+  const Record* record_ = nullptr;
+};
+
+class ConnectionView {
+ public:
+  using Record = record::Connection;
+  ConnectionView(const MapImage* image, const Record* record)
+      : image_(image), record_(record) {}
+  element::Id id() const noexcept { return record_->id; }
+  JunctionConnectionType type() const noexcept {
+    return static_cast<JunctionConnectionType>(record_->type);
+  }
+  element::Id incoming_road() const noexcept { return record_->incoming_road; }
+  element::Id connecting_road() const noexcept {
+    return record_->connecting_road;
+  }
+  element::Id linked_road() const noexcept { return record_->linked_road; }
+  ContactPointType contact_point() const noexcept {
+    return static_cast<ContactPointType>(record_->contact_point);
+  }
+  RecordList<record::LaneLink> lane_links() const;
+
+ private:
+  const MapImage* image_;
+  const Record* record_;
+};
+
+class JunctionView {
+ public:
+  using Record = record::Junction;
+  JunctionView() = default;
+  JunctionView(const MapImage* image, const Record* record)
+      : image_(image), record_(record) {}
+  bool valid() const noexcept { return nullptr != record_; }
+  element::Id id() const noexcept { return record_->id; }
+  const char* name() const noexcept;
+  JunctionType type() const noexcept {
+    return static_cast<JunctionType>(record_->type);
+  }
+  element::Id main_road() const noexcept { return record_->main_road; }
+  double start_position() const noexcept { return record_->start_position; }
+  double end_position() const noexcept { return record_->end_position; }
+  Dir dir() const noexcept { return static_cast<Dir>(record_->dir); }
+  ViewList<ConnectionView> connections() const;
+
+ private:
+  const MapImage* image_ = nullptr;
+  const Record* record_ = nullptr;
+};
+
+class MapImage {
+ public:
+  MapImage() = default;
+  MapImage(const MapImage&) = delete;
+  MapImage& operator=(const MapImage&) = delete;
+
+  /**
+   * @brief 映射镜像文件(如 /dev/shm/town.odrimg)
+   *
+   * @param file 镜像文件
+   * @param verify 校验所有记录的引用范围, 镜像来源可信时可关闭
+   */
+  opendrive::Status Attach(const std::string& file, bool verify = true);
+  /// 使用外部内存, 调用方保证 data 在 Detach 前有效且 8 字节对齐
+  opendrive::Status Attach(const char* data, size_t size, bool verify = true);
+  void Detach();
+  bool IsAttached() const noexcept { return nullptr != image_header_; }
+  size_t size() const noexcept { return size_; }
+
+  const char* rev_major() const noexcept;
+  const char* rev_minor() const noexcept;
+  const char* version() const noexcept;
+  const char* name() const noexcept;
+  const char* date() const noexcept;
+  const char* vendor() const noexcept;
+  const record::Header& header() const noexcept {
+    return image_header_->header;
+  }
+
+  ViewList<RoadView> roads() const;
+  ViewList<JunctionView> junctions() const;
+  /// 二分查找, 未找到时返回的 view valid() 为 false
+  RoadView GetRoad(element::Id id) const;
+  JunctionView GetJunction(element::Id id) const;
+
+  /// 供 View 使用: 解析表内范围和字符串
+  template <typename T>
+  const T* Slice(record::TableType table, const record::Range& range) const {
+    return reinterpret_cast<const T*>(data_ +
+                                      image_header_->tables[table].offset) +
+           range.begin;
+  }
+  const char* String(const record::Str& str) const noexcept {
+    return data_ + image_header_->tables[record::kStrings].offset + str.offset;
+  }
+
+ private:
+  bool Verify() const;
+  common::MappedFile mapped_file_;
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  const record::ImageHeader* image_header_ = nullptr;
+};
+
+/// 由 element::Map 生成镜像
+opendrive::Status BuildMapImage(const element::Map& ele_map,
+                                std::string* data);
+
+/// 生成镜像文件, 先写临时文件再 rename, 其他进程不会看到写了一半的镜像
+opendrive::Status SaveMapImage(const element::Map& ele_map,
+                               const std::string& file);
+
+}  // namespace snapshot
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_CPP_MAP_IMAGE_H_
@@ -0,0 +1,58 @@
+#ifndef OPENDRIVE_CPP_SNAPSHOT_H_
+#define OPENDRIVE_CPP_SNAPSHOT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "opendrive-cpp/common/status.h"
+#include "opendrive-cpp/geometry/element.h"
+
+namespace opendrive {
+namespace snapshot {
+
+/**
+ * 二进制快照格式(小端):
+ *   magic[8] "ODRSNAP\0" | uint32 version | uint32 byte order mark
+ *   | uint64 payload size | payload
+ * payload 按 header, junctions, roads 顺序写入; 字符串/容器以 uint32
+ * 长度为前缀, 枚举以 uint8 写入, Geometry 以 GeometryType 区分子类.
+ * 修改 payload 布局时必须增加 kSnapshotVersion.
+ */
+constexpr uint32_t kSnapshotVersion = 1;
+
+/// 序列化到内存
+opendrive::Status SerializeMap(const element::Map& ele_map, std::string* data);
+
+/**
+ * @brief 单个元素的 payload 编码, 不含快照文件头
+ *
+ * 覆盖全部解析出的字段(fingerprint 除外), 编码相同即内容相同
+ */
+opendrive::Status SerializeHeader(const element::Header& header,
+                                  std::string* data);
+opendrive::Status SerializeRoad(const element::Road& road, std::string* data);
+opendrive::Status SerializeJunction(const element::Junction& junction,
+                                    std::string* data);
+
+/// 从内存反序列化, ele_map 中已有的内容会被覆盖
+opendrive::Status DeserializeMap(const char* data, size_t size,
+                                 element::Map::Ptr ele_map);
+
+opendrive::Status SaveMap(const element::Map& ele_map,
+                          const std::string& file);
+
+/**
+ * @brief 读取快照文件
+ *
+ * @param file 快照文件
+ * @param ele_map 输出
+ * @param bytes_read 可选, 读取的字节数
+ */
+opendrive::Status LoadMap(const std::string& file, element::Map::Ptr ele_map,
+                          size_t* bytes_read = nullptr);
+
+}  // namespace snapshot
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_CPP_SNAPSHOT_H_
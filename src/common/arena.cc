@@ -0,0 +1,100 @@
+#include "opendrive-cpp/common/arena.h"
+
+#include <algorithm>
+
+namespace opendrive {
+namespace common {
+
+namespace {
+
+std::atomic<uint64_t> g_next_arena_id{1};
+
+/// 线程当前使用的内存块, id 与 Arena::id_ 不同时失效
+struct Cursor {
+  uint64_t id = 0;
+  char* ptr = nullptr;
+  char* end = nullptr;
+};
+
+thread_local Cursor t_cursor;
+thread_local Arena* t_current_arena = nullptr;
+
+char* AlignUp(char* ptr, size_t alignment) {
+  const uintptr_t value = reinterpret_cast<uintptr_t>(ptr);
+  return reinterpret_cast<char*>((value + alignment - 1) & ~(alignment - 1));
+}
+
+}  // namespace
+
+constexpr size_t Arena::kDefaultBlockSize;
+constexpr size_t Arena::kMaxBlockSize;
+
+Arena::Arena(size_t block_size)
+    : block_size_(std::max<size_t>(block_size, 1024)),
+      next_block_size_(block_size_),
+      id_(g_next_arena_id.fetch_add(1)) {}
+
+Arena::~Arena() { Release(); }
+
+Arena* Arena::Current() noexcept { return t_current_arena; }
+
+void* Arena::Allocate(size_t bytes, size_t alignment) {
+  Cursor& cursor = t_cursor;
+  if (cursor.id == id_.load(std::memory_order_relaxed)) {
+    char* ptr = AlignUp(cursor.ptr, alignment);
+    if (ptr <= cursor.end && bytes <= static_cast<size_t>(cursor.end - ptr)) {
+      cursor.ptr = ptr + bytes;
+      return ptr;
+    }
+  }
+  return AllocateSlow(bytes, alignment);
+}
+
+void* Arena::AllocateSlow(size_t bytes, size_t alignment) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const size_t need = bytes + alignment;
+  if (need > next_block_size_ / 4) {
+    /// 大块单独申请, 不替换线程当前的块
+    Block* block = NewBlock(need);
+    return AlignUp(reinterpret_cast<char*>(block + 1), alignment);
+  }
+  Block* block = NewBlock(next_block_size_);
+  next_block_size_ = std::min(next_block_size_ * 2, kMaxBlockSize);
+  char* begin = reinterpret_cast<char*>(block + 1);
+  char* ptr = AlignUp(begin, alignment);
+  Cursor& cursor = t_cursor;
+  cursor.id = id_.load(std::memory_order_relaxed);
+  cursor.ptr = ptr + bytes;
+  cursor.end = begin + block->size;
+  return ptr;
+}
+
+Arena::Block* Arena::NewBlock(size_t size) {
+  Block* block = static_cast<Block*>(::operator new(sizeof(Block) + size));
+  block->next = blocks_;
+  block->size = size;
+  blocks_ = block;
+  bytes_reserved_.fetch_add(sizeof(Block) + size, std::memory_order_relaxed);
+  return block;
+}
+
+void Arena::Release() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  while (blocks_) {
+    Block* next = blocks_->next;
+    ::operator delete(blocks_);
+    blocks_ = next;
+  }
+  next_block_size_ = block_size_;
+  bytes_reserved_.store(0, std::memory_order_relaxed);
+  id_.store(g_next_arena_id.fetch_add(1), std::memory_order_relaxed);
+}
+
+ScopedArena::ScopedArena(Arena* arena) noexcept : prev_(t_current_arena) {
+  t_current_arena = arena;
+}
+
+ScopedArena::~ScopedArena() { t_current_arena = prev_; }
+
+}  // namespace common
+}  // namespace opendrive
@@ -149,4 +149,203 @@ const std::map<Dir, std::string> DIR_CHOICES{
     std::make_pair(Dir::kMinus, "-"),
 };
 
+/// ------------------------------ tables ------------------------------
+
+constexpr Choice<Boolean> kBooleanChoices[] = {
+    {"false", Boolean::kFalse},
+    {"true", Boolean::kTrue},
+    {"unknown", Boolean::kUnknown},
+};
+static_assert(IsSortedChoices(kBooleanChoices),
+              "kBooleanChoices must be sorted");
+const ChoiceTable<Boolean> BOOLEAN_TABLE(kBooleanChoices);
+
+constexpr Choice<GeometryType> kGeometryTypeChoices[] = {
+    {"arc", GeometryType::kArc},
+    {"line", GeometryType::kLine},
+    {"parampoly3", GeometryType::kParamPoly3},
+    {"poly3", GeometryType::kPoly3},
+    {"spiral", GeometryType::kSpiral},
+};
+static_assert(IsSortedChoices(kGeometryTypeChoices),
+              "kGeometryTypeChoices must be sorted");
+const ChoiceTable<GeometryType> GEOMETRY_TYPE_TABLE(kGeometryTypeChoices);
+
+constexpr Choice<LaneType> kLaneTypeChoices[] = {
+    {"bidirectional", LaneType::kBidirectional},
+    {"biking", LaneType::kBiking},
+    {"border", LaneType::kBorder},
+    {"bus", LaneType::kBus},
+    {"connectingramp", LaneType::kConnectingramp},
+    {"curb", LaneType::kCurb},
+    {"driving", LaneType::kDriving},
+    {"entry", LaneType::kEntry},
+    {"exit", LaneType::kExit},
+    {"hov", LaneType::kHov},
+    {"median", LaneType::kMedian},
+    {"mwyentry", LaneType::kMwyentry},
+    {"mwyexit", LaneType::kMwyexit},
+    {"none", LaneType::kNone},
+    {"offramp", LaneType::kOfframp},
+    {"onramp", LaneType::kOnramp},
+    {"parking", LaneType::kParking},
+    {"rail", LaneType::kRail},
+    {"restricted", LaneType::kRestricted},
+    {"roadworks", LaneType::kRoadworks},
+    {"shoulder", LaneType::kSholder},
+    {"sidewalk", LaneType::kSidewalk},
+    {"special1", LaneType::kSpecial1},
+    {"special2", LaneType::kSpecial2},
+    {"special3", LaneType::kSpecial3},
+    {"stop", LaneType::kStop},
+    {"taxi", LaneType::kTaxi},
+    {"tram", LaneType::kTram},
+};
+static_assert(IsSortedChoices(kLaneTypeChoices),
+              "kLaneTypeChoices must be sorted");
+const ChoiceTable<LaneType> LANE_TYPE_TABLE(kLaneTypeChoices);
+
+constexpr Choice<RoadMarkType> kRoadMarkTypeChoices[] = {
+    {"botts dots", RoadMarkType::kBottsdots},
+    {"broken", RoadMarkType::kBroken},
+    {"broken broken", RoadMarkType::kBrokenbroken},
+    {"broken solid", RoadMarkType::kBrokensolid},
+    {"curb", RoadMarkType::kCurb},
+    {"custom", RoadMarkType::kCustom},
+    {"edge", RoadMarkType::kEdge},
+    {"grass", RoadMarkType::kGrass},
+    {"none", RoadMarkType::kNone},
+    {"solid", RoadMarkType::kSolid},
+    {"solid broken", RoadMarkType::kSolidbroken},
+    {"solid solid", RoadMarkType::kSolidsolid},
+};
+static_assert(IsSortedChoices(kRoadMarkTypeChoices),
+              "kRoadMarkTypeChoices must be sorted");
+const ChoiceTable<RoadMarkType> ROADMARK_TYPE_TABLE(kRoadMarkTypeChoices);
+
+constexpr Choice<RoadMarkColor> kRoadMarkColorChoices[] = {
+    {"blue", RoadMarkColor::kBlue},
+    {"green", RoadMarkColor::kGreen},
+    {"orange", RoadMarkColor::kOrange},
+    {"red", RoadMarkColor::kRed},
+    {"standard", RoadMarkColor::kStandard},
+    {"white", RoadMarkColor::kWhite},
+    {"yellow", RoadMarkColor::kYellow},
+};
+static_assert(IsSortedChoices(kRoadMarkColorChoices),
+              "kRoadMarkColorChoices must be sorted");
+const ChoiceTable<RoadMarkColor> ROAD_MARK_COLOR_TABLE(kRoadMarkColorChoices);
+
+constexpr Choice<RoadMarkWeight> kRoadMarkWeightChoices[] = {
+    {"bold", RoadMarkWeight::kBold},
+    {"standard", RoadMarkWeight::kStandard},
+    {"unknown", RoadMarkWeight::kUnknown},
+};
+static_assert(IsSortedChoices(kRoadMarkWeightChoices),
+              "kRoadMarkWeightChoices must be sorted");
+const ChoiceTable<RoadMarkWeight> ROAD_MARK_WEIGHT_TABLE(
+    kRoadMarkWeightChoices);
+
+constexpr Choice<RoadMarkLaneChange> kRoadMarkLaneChangeChoices[] = {
+    {"both", RoadMarkLaneChange::kBoth},
+    {"decrease", RoadMarkLaneChange::kDecrease},
+    {"increase", RoadMarkLaneChange::kIncrease},
+    {"none", RoadMarkLaneChange::kNone},
+    {"unknown", RoadMarkLaneChange::kUnknown},
+};
+static_assert(IsSortedChoices(kRoadMarkLaneChangeChoices),
+              "kRoadMarkLaneChangeChoices must be sorted");
+const ChoiceTable<RoadMarkLaneChange> ROAD_MARK_LANE_CHANGE_TABLE(
+    kRoadMarkLaneChangeChoices);
+
+constexpr Choice<RoadRule> kRoadRuleChoices[] = {
+    {"lht", RoadRule::kLht},
+    {"rht", RoadRule::kRht},
+};
+static_assert(IsSortedChoices(kRoadRuleChoices),
+              "kRoadRuleChoices must be sorted");
+const ChoiceTable<RoadRule> ROAD_RULE_TABLE(kRoadRuleChoices);
+
+constexpr Choice<RoadType> kRoadTypeChoices[] = {
+    {"bicycle", RoadType::kBicycle},
+    {"lowspeed", RoadType::kLowspeed},
+    {"motorway", RoadType::kMotorway},
+    {"pedestrian", RoadType::kPedestrian},
+    {"rural", RoadType::kRural},
+    {"town", RoadType::kTown},
+    {"townarterial", RoadType::kTownarterial},
+    {"towncollector", RoadType::kTowncollector},
+    {"townexpressway", RoadType::kTownexpressway},
+    {"townlocal", RoadType::kTownlocal},
+    {"townplaystreet", RoadType::kTownplaystreet},
+    {"townprivate", RoadType::kTownprivate},
+};
+static_assert(IsSortedChoices(kRoadTypeChoices),
+              "kRoadTypeChoices must be sorted");
+const ChoiceTable<RoadType> ROAD_TYPE_TABLE(kRoadTypeChoices);
+
+constexpr Choice<RoadLinkType> kRoadLinkTypeChoices[] = {
+    {"junction", RoadLinkType::kJunction},
+    {"road", RoadLinkType::kRoad},
+};
+static_assert(IsSortedChoices(kRoadLinkTypeChoices),
+              "kRoadLinkTypeChoices must be sorted");
+const ChoiceTable<RoadLinkType> ROAD_LINK_TYPE_TABLE(kRoadLinkTypeChoices);
+
+constexpr Choice<SpeedUnit> kSpeedUnitChoices[] = {
+    {"km/h", SpeedUnit::kKmh},
+    {"m/s", SpeedUnit::kMs},
+    {"mph", SpeedUnit::kMph},
+};
+static_assert(IsSortedChoices(kSpeedUnitChoices),
+              "kSpeedUnitChoices must be sorted");
+const ChoiceTable<SpeedUnit> SPEEDUNIT_TABLE(kSpeedUnitChoices);
+
+constexpr Choice<LaneDirection> kLaneDirectionChoices[] = {
+    {"center", LaneDirection::kCenter},
+    {"left", LaneDirection::kLeft},
+    {"right", LaneDirection::kRight},
+    {"unknown", LaneDirection::kUnknown},
+};
+static_assert(IsSortedChoices(kLaneDirectionChoices),
+              "kLaneDirectionChoices must be sorted");
+const ChoiceTable<LaneDirection> LANE_DIRECTION_TABLE(kLaneDirectionChoices);
+
+constexpr Choice<JunctionType> kJunctionTypeChoices[] = {
+    {"default", JunctionType::kDefault},
+    {"direct", JunctionType::kDirect},
+    {"virtual", JunctionType::kVirtual},
+};
+static_assert(IsSortedChoices(kJunctionTypeChoices),
+              "kJunctionTypeChoices must be sorted");
+const ChoiceTable<JunctionType> JUNCTION_TYPE_TABLE(kJunctionTypeChoices);
+
+constexpr Choice<JunctionConnectionType> kJunctionConnectionTypeChoices[] = {
+    {"default", JunctionConnectionType::kDefault},
+    {"unknown", JunctionConnectionType::kUnknown},
+    {"virtual", JunctionConnectionType::kVirtual},
+};
+static_assert(IsSortedChoices(kJunctionConnectionTypeChoices),
+              "kJunctionConnectionTypeChoices must be sorted");
+const ChoiceTable<JunctionConnectionType> JUNCTION_CONNECTION_TYPE_TABLE(
+    kJunctionConnectionTypeChoices);
+
+constexpr Choice<ContactPointType> kContactPointTypeChoices[] = {
+    {"end", ContactPointType::kEnd},
+    {"start", ContactPointType::kStart},
+    {"unknown", ContactPointType::kUnknown},
+};
+static_assert(IsSortedChoices(kContactPointTypeChoices),
+              "kContactPointTypeChoices must be sorted");
+const ChoiceTable<ContactPointType> CONTACT_POINT_TYPE_TABLE(
+    kContactPointTypeChoices);
+
+constexpr Choice<Dir> kDirChoices[] = {
+    {"+", Dir::kPlus},
+    {"-", Dir::kMinus},
+    {"unknown", Dir::kUnknown},
+};
+static_assert(IsSortedChoices(kDirChoices), "kDirChoices must be sorted");
+const ChoiceTable<Dir> DIR_TABLE(kDirChoices);
+
 }  // namespace opendrive
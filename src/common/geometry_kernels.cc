@@ -0,0 +1,226 @@
+#include "opendrive-cpp/common/geometry_kernels.h"
+
+#include <atomic>
+#include <cmath>
+#include <complex>
+
+#include "simd_math.h"
+
+namespace opendrive {
+namespace common {
+
+namespace {
+
+SimdLevel DetectSimdLevel() {
+#if defined(OPENDRIVE_CPP_WITH_AVX2)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return SimdLevel::kAvx2;
+  }
+#endif
+#if defined(__SSE2__)
+  return SimdLevel::kSse2;
+#else
+  return SimdLevel::kScalar;
+#endif
+}
+
+const SimdLevel g_supported_level = DetectSimdLevel();
+std::atomic<SimdLevel> g_level{g_supported_level};
+
+/// NearArcSpiralPoints 展开的最高阶数
+constexpr int kNearArcMaxOrder = 8;
+/// 展开项(相对 |ds|)小于该值时截断
+constexpr double kNearArcEpsilon = 1e-17;
+
+/**
+ * @brief K_k(w) = int_0^1 v^k * e^(iwv) dv, k = 0..order
+ *
+ * k <= |w| 时向前递推 K_k = (e^(iw) - k * K_(k-1)) / (iw), 每步误差乘以
+ * k / |w| <= 1; k > |w| 时 K_k = e^(iw) * sum_j (-iw)^j * k! / (k+j+1)!,
+ * 各项的模单调递减.
+ */
+void ArcMoments(double w, int order, std::complex<double>* moments) {
+  const std::complex<double> e(std::cos(w), std::sin(w));
+  const double half = 0.5 * w;
+  const double sinc = 0 == half ? 1. : std::sin(half) / half;
+  moments[0] = std::complex<double>(std::cos(half), std::sin(half)) * sinc;
+  for (int k = 1; k <= order; k++) {
+    if (k <= std::fabs(w)) {
+      moments[k] = (e - static_cast<double>(k) * moments[k - 1]) /
+                   std::complex<double>(0, w);
+      continue;
+    }
+    std::complex<double> term(1. / (k + 1), 0);
+    std::complex<double> sum = term;
+    for (int j = 0; std::abs(term) > kNearArcEpsilon; j++) {
+      term *= std::complex<double>(0, -w) / static_cast<double>(k + j + 2);
+      sum += term;
+    }
+    moments[k] = e * sum;
+  }
+}
+
+}  // namespace
+
+SimdLevel SupportedSimdLevel() { return g_supported_level; }
+
+SimdLevel GetSimdLevel() { return g_level.load(std::memory_order_relaxed); }
+
+void SetSimdLevel(SimdLevel level) {
+  g_level.store(level > g_supported_level ? g_supported_level : level,
+                std::memory_order_relaxed);
+}
+
+const char* SimdLevelName(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::kAvx2:
+      return "avx2";
+    case SimdLevel::kSse2:
+      return "sse2";
+    default:
+      return "scalar";
+  }
+}
+
+void LinePoints(const GeometryOrigin& origin, const double* road_s, size_t n,
+                double* x, double* y, double* heading) {
+  switch (GetSimdLevel()) {
+#if defined(OPENDRIVE_CPP_WITH_AVX2)
+    case SimdLevel::kAvx2:
+      return avx2::LinePoints(origin, road_s, n, x, y, heading);
+#endif
+#if defined(__SSE2__)
+    case SimdLevel::kSse2:
+      return LinePointsImpl<DoubleX2>(origin, road_s, n, x, y, heading);
+#endif
+    default:
+      return LinePointsImpl<DoubleX1>(origin, road_s, n, x, y, heading);
+  }
+}
+
+void ArcPoints(const GeometryOrigin& origin, double curvature,
+               const double* road_s, size_t n, double* x, double* y,
+               double* heading) {
+  switch (GetSimdLevel()) {
+#if defined(OPENDRIVE_CPP_WITH_AVX2)
+    case SimdLevel::kAvx2:
+      return avx2::ArcPoints(origin, curvature, road_s, n, x, y, heading);
+#endif
+#if defined(__SSE2__)
+    case SimdLevel::kSse2:
+      return ArcPointsImpl<DoubleX2>(origin, curvature, road_s, n, x, y,
+                                     heading);
+#endif
+    default:
+      return ArcPointsImpl<DoubleX1>(origin, curvature, road_s, n, x, y,
+                                     heading);
+  }
+}
+
+void Poly3Points(const GeometryOrigin& origin, const double coef[4],
+                 const double* road_s, size_t n, double* x, double* y,
+                 double* heading) {
+  switch (GetSimdLevel()) {
+#if defined(OPENDRIVE_CPP_WITH_AVX2)
+    case SimdLevel::kAvx2:
+      return avx2::Poly3Points(origin, coef, road_s, n, x, y, heading);
+#endif
+#if defined(__SSE2__)
+    case SimdLevel::kSse2:
+      return Poly3PointsImpl<DoubleX2>(origin, coef, road_s, n, x, y,
+                                       heading);
+#endif
+    default:
+      return Poly3PointsImpl<DoubleX1>(origin, coef, road_s, n, x, y,
+                                       heading);
+  }
+}
+
+void ParamPoly3Points(const GeometryOrigin& origin, const double coef_u[4],
+                      const double coef_v[4], double length, bool normalized,
+                      const double* road_s, size_t n, double* x, double* y,
+                      double* heading) {
+  switch (GetSimdLevel()) {
+#if defined(OPENDRIVE_CPP_WITH_AVX2)
+    case SimdLevel::kAvx2:
+      return avx2::ParamPoly3Points(origin, coef_u, coef_v, length,
+                                    normalized, road_s, n, x, y, heading);
+#endif
+#if defined(__SSE2__)
+    case SimdLevel::kSse2:
+      return ParamPoly3PointsImpl<DoubleX2>(origin, coef_u, coef_v, length,
+                                            normalized, road_s, n, x, y,
+                                            heading);
+#endif
+    default:
+      return ParamPoly3PointsImpl<DoubleX1>(origin, coef_u, coef_v, length,
+                                            normalized, road_s, n, x, y,
+                                            heading);
+  }
+}
+
+void SpiralPoints(const GeometryOrigin& origin, const SpiralParams& spiral,
+                  const double* road_s, size_t n, double* x, double* y,
+                  double* heading) {
+  switch (GetSimdLevel()) {
+#if defined(OPENDRIVE_CPP_WITH_AVX2)
+    case SimdLevel::kAvx2:
+      return avx2::SpiralPoints(origin, spiral, road_s, n, x, y, heading);
+#endif
+#if defined(__SSE2__)
+    case SimdLevel::kSse2:
+      return SpiralPointsImpl<DoubleX2>(origin, spiral, road_s, n, x, y,
+                                        heading);
+#endif
+    default:
+      return SpiralPointsImpl<DoubleX1>(origin, spiral, road_s, n, x, y,
+                                        heading);
+  }
+}
+
+void NearArcSpiralPoints(const GeometryOrigin& origin, double curve_start,
+                         double curve_dot, const double* road_s, size_t n,
+                         double* x, double* y, double* heading) {
+  std::complex<double> moments[2 * kNearArcMaxOrder + 1];
+  for (size_t i = 0; i < n; i++) {
+    const double ds = road_s[i] - origin.s;
+    /// 相对圆弧的 heading 偏差, 局部坐标下
+    /// x + iy = ds * sum_m (i * phase)^m / m! * K_2m(curve_start * ds)
+    const double phase = 0.5 * curve_dot * ds * ds;
+    int order = 0;
+    for (double bound = std::fabs(phase);
+         order < kNearArcMaxOrder && bound > kNearArcEpsilon;
+         bound *= std::fabs(phase) / (order + 1)) {
+      order++;
+    }
+    ArcMoments(curve_start * ds, 2 * order, moments);
+    std::complex<double> sum = moments[2 * order];
+    for (int m = order; m > 0; m--) {
+      sum = moments[2 * m - 2] + std::complex<double>(0, phase / m) * sum;
+    }
+    const double u = ds * sum.real();
+    const double v = ds * sum.imag();
+    x[i] = origin.x + u * origin.cos_hdg - v * origin.sin_hdg;
+    y[i] = origin.y + u * origin.sin_hdg + v * origin.cos_hdg;
+    heading[i] = origin.hdg + ds * (curve_start + 0.5 * curve_dot * ds);
+  }
+}
+
+void FresnelIntegrals(const double* x, size_t n, double* s, double* c) {
+  switch (GetSimdLevel()) {
+#if defined(OPENDRIVE_CPP_WITH_AVX2)
+    case SimdLevel::kAvx2:
+      return avx2::FresnelIntegrals(x, n, s, c);
+#endif
+#if defined(__SSE2__)
+    case SimdLevel::kSse2:
+      return FresnelIntegralsImpl<DoubleX2>(x, n, s, c);
+#endif
+    default:
+      return FresnelIntegralsImpl<DoubleX1>(x, n, s, c);
+  }
+}
+
+}  // namespace common
+}  // namespace opendrive
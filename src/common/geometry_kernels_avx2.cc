@@ -0,0 +1,49 @@
+/// AVX2 版本的批量求值, 只有 CPU 支持时才由 geometry_kernels.cc 调用
+#if defined(OPENDRIVE_CPP_WITH_AVX2)
+
+#include "simd_math.h"
+
+namespace opendrive {
+namespace common {
+namespace avx2 {
+
+void LinePoints(const GeometryOrigin& origin, const double* road_s, size_t n,
+                double* x, double* y, double* heading) {
+  LinePointsImpl<DoubleX4>(origin, road_s, n, x, y, heading);
+}
+
+void ArcPoints(const GeometryOrigin& origin, double curvature,
+               const double* road_s, size_t n, double* x, double* y,
+               double* heading) {
+  ArcPointsImpl<DoubleX4>(origin, curvature, road_s, n, x, y, heading);
+}
+
+void Poly3Points(const GeometryOrigin& origin, const double coef[4],
+                 const double* road_s, size_t n, double* x, double* y,
+                 double* heading) {
+  Poly3PointsImpl<DoubleX4>(origin, coef, road_s, n, x, y, heading);
+}
+
+void ParamPoly3Points(const GeometryOrigin& origin, const double coef_u[4],
+                      const double coef_v[4], double length, bool normalized,
+                      const double* road_s, size_t n, double* x, double* y,
+                      double* heading) {
+  ParamPoly3PointsImpl<DoubleX4>(origin, coef_u, coef_v, length, normalized,
+                                 road_s, n, x, y, heading);
+}
+
+void SpiralPoints(const GeometryOrigin& origin, const SpiralParams& spiral,
+                  const double* road_s, size_t n, double* x, double* y,
+                  double* heading) {
+  SpiralPointsImpl<DoubleX4>(origin, spiral, road_s, n, x, y, heading);
+}
+
+void FresnelIntegrals(const double* x, size_t n, double* s, double* c) {
+  FresnelIntegralsImpl<DoubleX4>(x, n, s, c);
+}
+
+}  // namespace avx2
+}  // namespace common
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_CPP_WITH_AVX2
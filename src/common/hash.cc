@@ -0,0 +1,56 @@
+#include "opendrive-cpp/common/hash.h"
+
+namespace opendrive {
+namespace common {
+
+namespace {
+
+constexpr uint64_t kMul1 = 0x87c37b91114253d5ULL;
+constexpr uint64_t kMul2 = 0x4cf5ad432745937fULL;
+constexpr uint64_t kSeed = 0x9e3779b97f4a7c15ULL;
+
+inline uint64_t Rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+/// 小端读取, 与平台字节序无关
+inline uint64_t Load64(const unsigned char* p, size_t n) {
+  uint64_t v = 0;
+  for (size_t i = 0; i < n; i++) {
+    v |= static_cast<uint64_t>(p[i]) << (8 * i);
+  }
+  return v;
+}
+
+inline uint64_t Mix(uint64_t k) {
+  k *= kMul1;
+  k = Rotl(k, 31);
+  return k * kMul2;
+}
+
+inline uint64_t Finalize(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+}  // namespace
+
+uint64_t Fingerprint(const char* data, size_t size) {
+  const auto* p = reinterpret_cast<const unsigned char*>(data);
+  uint64_t h = kSeed ^ (size * kMul2);
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    h ^= Mix(Load64(p + i, 8));
+    h = Rotl(h, 27) * 5 + 0x52dce729;
+  }
+  if (i < size) {
+    h ^= Mix(Load64(p + i, size - i));
+  }
+  h = Finalize(h);
+  return 0 == h ? 1 : h;
+}
+
+}  // namespace common
+}  // namespace opendrive
@@ -0,0 +1,150 @@
+#include "opendrive-cpp/common/inflate_stream.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+
+#ifdef OPENDRIVE_CPP_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+namespace opendrive {
+namespace common {
+
+struct InflateStream::Inflater {
+#ifdef OPENDRIVE_CPP_WITH_ZLIB
+  z_stream stream;
+  bool initialized = false;
+#endif
+};
+
+InflateStream::InflateStream(const StreamReader& reader, size_t chunk_size)
+    : reader_(reader),
+      input_(std::max<size_t>(chunk_size, 16), '\0'),
+      inflater_(new Inflater) {}
+
+InflateStream::~InflateStream() {
+#ifdef OPENDRIVE_CPP_WITH_ZLIB
+  if (inflater_->initialized) {
+    inflateEnd(&inflater_->stream);
+  }
+#endif
+}
+
+bool InflateStream::IsCompressed(const char* data, size_t size) {
+  if (!data || size < 2) return false;
+  const auto b0 = static_cast<uint8_t>(data[0]);
+  const auto b1 = static_cast<uint8_t>(data[1]);
+  /// gzip
+  if (0x1f == b0 && 0x8b == b1) return true;
+  /// zlib: CM = 8(deflate), (CMF * 256 + FLG) % 31 == 0
+  return 8 == (b0 & 0x0f) && 0 == ((b0 << 8) | b1) % 31;
+}
+
+bool InflateStream::Supported() {
+#ifdef OPENDRIVE_CPP_WITH_ZLIB
+  return true;
+#else
+  return false;
+#endif
+}
+
+long InflateStream::Fail(const std::string& error) {
+  error_ = error;
+  return -1;
+}
+
+bool InflateStream::FillInput() {
+  if (input_eof_) return false;
+  const long n = reader_ ? reader_(&input_[0], input_.size()) : 0;
+  if (n < 0) {
+    Fail("Read Input Stream Exection.");
+    return false;
+  }
+  if (0 == n) {
+    input_eof_ = true;
+    return false;
+  }
+  input_pos_ = 0;
+  input_size_ = static_cast<size_t>(n);
+  return true;
+}
+
+long InflateStream::Read(char* buf, size_t size) {
+  if (!error_.empty()) return -1;
+  if (0 == size) return 0;
+  if (!started_) {
+    started_ = true;
+    /// 至少读取 2 字节用于识别格式
+    while (input_size_ < 2 && !input_eof_) {
+      const long n = reader_ ? reader_(&input_[input_size_],
+                                       input_.size() - input_size_)
+                             : 0;
+      if (n < 0) return Fail("Read Input Stream Exection.");
+      if (0 == n) input_eof_ = true;
+      input_size_ += static_cast<size_t>(std::max(n, 0L));
+    }
+    compressed_ = IsCompressed(input_.data(), input_size_);
+    if (compressed_) {
+#ifdef OPENDRIVE_CPP_WITH_ZLIB
+      std::memset(&inflater_->stream, 0, sizeof(inflater_->stream));
+      /// 15 + 32: 自动识别 gzip 与 zlib 头
+      if (Z_OK != inflateInit2(&inflater_->stream, 15 + 32)) {
+        return Fail("Init Zlib Exection.");
+      }
+      inflater_->initialized = true;
+#else
+      return Fail("Compressed Input Requires Zlib.");
+#endif
+    }
+  }
+
+  if (!compressed_) {
+    if (input_pos_ == input_size_ && !FillInput()) {
+      return error_.empty() ? 0 : -1;
+    }
+    const size_t n = std::min(size, input_size_ - input_pos_);
+    std::memcpy(buf, input_.data() + input_pos_, n);
+    input_pos_ += n;
+    return static_cast<long>(n);
+  }
+
+#ifdef OPENDRIVE_CPP_WITH_ZLIB
+  auto& stream = inflater_->stream;
+  const auto out_size =
+      static_cast<uInt>(std::min<size_t>(size, UINT_MAX / 2));
+  stream.next_out = reinterpret_cast<Bytef*>(buf);
+  stream.avail_out = out_size;
+  while (stream.avail_out == out_size) {
+    if (input_pos_ == input_size_ && !FillInput()) {
+      if (!error_.empty()) return -1;
+      if (stream_end_) return 0;
+      return Fail("Compressed Input Is Truncated.");
+    }
+    if (stream_end_) {
+      /// 串联的下一个 gzip member
+      inflateReset(&stream);
+      stream_end_ = false;
+    }
+    stream.next_in =
+        reinterpret_cast<Bytef*>(const_cast<char*>(input_.data())) +
+        input_pos_;
+    stream.avail_in = static_cast<uInt>(input_size_ - input_pos_);
+    const int ret = inflate(&stream, Z_NO_FLUSH);
+    input_pos_ = input_size_ - stream.avail_in;
+    if (Z_STREAM_END == ret) {
+      stream_end_ = true;
+    } else if (Z_OK != ret && Z_BUF_ERROR != ret) {
+      return Fail(std::string("Inflate Exection: ") +
+                  (stream.msg ? stream.msg : "unknown"));
+    }
+  }
+  return static_cast<long>(out_size - stream.avail_out);
+#else
+  return Fail("Compressed Input Requires Zlib.");
+#endif
+}
+
+}  // namespace common
+}  // namespace opendrive
@@ -0,0 +1,240 @@
+#include "opendrive-cpp/common/numeric.h"
+
+#include <cerrno>
+#include <climits>
+#include <clocale>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace opendrive {
+namespace common {
+
+namespace {
+
+constexpr int kMaxMantissaDigits = 19;
+constexpr size_t kFallbackBufferSize = 128;
+
+constexpr double kDoublePow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+constexpr float kFloatPow10[] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f,
+};
+
+inline bool IsSpace(char c) {
+  return ' ' == c || '\t' == c || '\n' == c || '\r' == c || '\f' == c ||
+         '\v' == c;
+}
+
+inline bool IsDigit(char c) { return '0' <= c && c <= '9'; }
+
+/// 十进制数值: (-1)^negative * mantissa * 10^exponent
+struct Decimal {
+  const char* begin = nullptr;  // 符号位置
+  const char* end = nullptr;    // 数值前缀结束位置
+  uint64_t mantissa = 0;
+  int exponent = 0;
+  bool negative = false;
+  /// 尾数超过 kMaxMantissaDigits 位, 有非零数字被截断
+  bool truncated = false;
+};
+
+/**
+ * @brief 扫描十进制数值前缀
+ *
+ * @return false: 不是十进制数值(无数字, 或 inf/nan/十六进制)
+ */
+bool ScanDecimal(const char* str, Decimal* decimal) {
+  const char* p = str;
+  while (IsSpace(*p)) ++p;
+  decimal->begin = p;
+  if ('+' == *p || '-' == *p) {
+    decimal->negative = '-' == *p;
+    ++p;
+  }
+  if ('0' == p[0] && ('x' == p[1] || 'X' == p[1])) return false;
+  int digits = 0;
+  bool any_digit = false;
+  auto take = [decimal, &digits](char c, bool fraction) {
+    if (digits < kMaxMantissaDigits) {
+      decimal->mantissa = decimal->mantissa * 10 + (c - '0');
+      if (decimal->mantissa) ++digits;
+      if (fraction) --decimal->exponent;
+    } else {
+      decimal->truncated = decimal->truncated || '0' != c;
+      if (!fraction) ++decimal->exponent;
+    }
+  };
+  for (; IsDigit(*p); ++p) {
+    any_digit = true;
+    take(*p, false);
+  }
+  if ('.' == *p) {
+    ++p;
+    for (; IsDigit(*p); ++p) {
+      any_digit = true;
+      take(*p, true);
+    }
+  }
+  if (!any_digit) return false;
+  if ('e' == *p || 'E' == *p) {
+    const char* q = p + 1;
+    bool exp_negative = false;
+    if ('+' == *q || '-' == *q) {
+      exp_negative = '-' == *q;
+      ++q;
+    }
+    if (IsDigit(*q)) {
+      int exp = 0;
+      for (; IsDigit(*q); ++q) {
+        if (exp < 100000) exp = exp * 10 + (*q - '0');
+      }
+      decimal->exponent += exp_negative ? -exp : exp;
+      p = q;
+    }
+  }
+  decimal->end = p;
+  return true;
+}
+
+/**
+ * @brief 回退路径: 复制数值前缀, '.' 替换为当前 locale 的小数点
+ */
+template <typename T, typename F>
+bool Fallback(const char* begin, const char* end, T* value, F convert) {
+  const char* point = std::localeconv()->decimal_point;
+  const size_t point_size = std::strlen(point);
+  char stack_buffer[kFallbackBufferSize];
+  std::string heap_buffer;
+  char* buffer = stack_buffer;
+  const size_t capacity = (end - begin) * point_size + 1;
+  if (capacity > kFallbackBufferSize) {
+    heap_buffer.resize(capacity);
+    buffer = &heap_buffer[0];
+  }
+  char* out = buffer;
+  for (const char* p = begin; p < end; ++p) {
+    if ('.' == *p && !(1 == point_size && '.' == point[0])) {
+      std::memcpy(out, point, point_size);
+      out += point_size;
+    } else {
+      *out++ = *p;
+    }
+  }
+  *out = '\0';
+  char* parsed = nullptr;
+  const T ret = convert(buffer, &parsed);
+  if (parsed == buffer) return false;
+  *value = ret;
+  return true;
+}
+
+/// inf/nan/十六进制等非十进制输入的数值前缀结束位置
+const char* TokenEnd(const char* begin) {
+  const char* p = begin;
+  while (*p && !IsSpace(*p)) ++p;
+  return p;
+}
+
+}  // namespace
+
+bool ParseDouble(const char* str, double* value) {
+  if (!str || !value) return false;
+  Decimal decimal;
+  if (!ScanDecimal(str, &decimal)) {
+    if (!decimal.begin) return false;
+    return Fallback<double>(decimal.begin, TokenEnd(decimal.begin), value,
+                            [](const char* s, char** e) {
+                              return std::strtod(s, e);
+                            });
+  }
+  if (0 == decimal.mantissa) {
+    *value = decimal.negative ? -0.0 : 0.0;
+    return true;
+  }
+  if (!decimal.truncated && decimal.mantissa <= (uint64_t(1) << 53) &&
+      decimal.exponent >= -22 && decimal.exponent <= 22) {
+    double ret = static_cast<double>(decimal.mantissa);
+    if (decimal.exponent < 0) {
+      ret /= kDoublePow10[-decimal.exponent];
+    } else {
+      ret *= kDoublePow10[decimal.exponent];
+    }
+    *value = decimal.negative ? -ret : ret;
+    return true;
+  }
+  return Fallback<double>(decimal.begin, decimal.end, value,
+                          [](const char* s, char** e) {
+                            return std::strtod(s, e);
+                          });
+}
+
+bool ParseFloat(const char* str, float* value) {
+  if (!str || !value) return false;
+  Decimal decimal;
+  if (!ScanDecimal(str, &decimal)) {
+    if (!decimal.begin) return false;
+    return Fallback<float>(decimal.begin, TokenEnd(decimal.begin), value,
+                           [](const char* s, char** e) {
+                             return std::strtof(s, e);
+                           });
+  }
+  if (0 == decimal.mantissa) {
+    *value = decimal.negative ? -0.0f : 0.0f;
+    return true;
+  }
+  if (!decimal.truncated && decimal.mantissa <= (uint64_t(1) << 24) &&
+      decimal.exponent >= -10 && decimal.exponent <= 10) {
+    float ret = static_cast<float>(decimal.mantissa);
+    if (decimal.exponent < 0) {
+      ret /= kFloatPow10[-decimal.exponent];
+    } else {
+      ret *= kFloatPow10[decimal.exponent];
+    }
+    *value = decimal.negative ? -ret : ret;
+    return true;
+  }
+  return Fallback<float>(decimal.begin, decimal.end, value,
+                         [](const char* s, char** e) {
+                           return std::strtof(s, e);
+                         });
+}
+
+bool ParseInt(const char* str, int* value) {
+  if (!str || !value) return false;
+  const char* p = str;
+  while (IsSpace(*p)) ++p;
+  bool negative = false;
+  if ('+' == *p || '-' == *p) {
+    negative = '-' == *p;
+    ++p;
+  }
+  if ('0' == p[0] && ('x' == p[1] || 'X' == p[1])) {
+    char* end = nullptr;
+    errno = 0;
+    const long ret = std::strtol(p, &end, 16);
+    if (end == p + 1 || 0 != errno || ret > INT_MAX) return false;
+    *value = static_cast<int>(negative ? -ret : ret);
+    return true;
+  }
+  if (!IsDigit(*p)) return false;
+  /// 以负数累加, 可以表示 INT_MIN
+  int64_t ret = 0;
+  for (; IsDigit(*p); ++p) {
+    ret = ret * 10 - (*p - '0');
+    if (ret < static_cast<int64_t>(INT_MIN)) return false;
+  }
+  if (!negative) {
+    if (-ret > static_cast<int64_t>(INT_MAX)) return false;
+    ret = -ret;
+  }
+  *value = static_cast<int>(ret);
+  return true;
+}
+
+}  // namespace common
+}  // namespace opendrive
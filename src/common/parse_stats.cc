@@ -0,0 +1,216 @@
+#include "opendrive-cpp/common/parse_stats.h"
+
+#ifdef __APPLE__
+#include <mach/mach.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <cstdio>
+
+namespace opendrive {
+
+namespace {
+
+thread_local ParseStats* t_current_stats = nullptr;
+
+constexpr const char* kStageNames[] = {
+    "load_xml", "header", "junction",     "road",
+    "plan_view", "lanes", "lane_section", "lane_boundary",
+};
+static_assert(sizeof(kStageNames) / sizeof(kStageNames[0]) ==
+                  ParseStats::kStageNum,
+              "kStageNames must match ParseStats::Stage");
+
+constexpr const char* kCounterNames[] = {
+    "junctions", "connections", "roads",   "geometries", "lane_sections",
+    "lanes",     "widths",      "borders", "road_marks", "speeds",
+    "boundary_segs", "boundary_bytes",
+};
+static_assert(sizeof(kCounterNames) / sizeof(kCounterNames[0]) ==
+                  ParseStats::kCounterNum,
+              "kCounterNames must match ParseStats::Counter");
+
+constexpr const char* kGeometryNames[] = {
+    "arc", "line", "spiral", "poly3", "param_poly3",
+};
+static_assert(sizeof(kGeometryNames) / sizeof(kGeometryNames[0]) ==
+                  ParseStats::kGeometryTypeNum,
+              "kGeometryNames must match GeometryType");
+
+/// 进程当前的 RSS, 无法读取时为 0
+size_t CurrentRss() noexcept {
+#ifdef __APPLE__
+  mach_task_basic_info info;
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if (KERN_SUCCESS != task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                                reinterpret_cast<task_info_t>(&info),
+                                &count)) {
+    return 0;
+  }
+  return static_cast<size_t>(info.resident_size);
+#else
+  FILE* file = std::fopen("/proc/self/statm", "r");
+  if (!file) return 0;
+  unsigned long size = 0;
+  unsigned long resident = 0;
+  const int n = std::fscanf(file, "%lu %lu", &size, &resident);
+  std::fclose(file);
+  if (2 != n) return 0;
+  return static_cast<size_t>(resident) *
+         static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+template <typename T, size_t N>
+void Clear(std::array<std::atomic<T>, N>* values) {
+  for (auto& value : *values) {
+    value.store(0, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace
+
+void ParseStats::Reset() {
+  Clear(&stage_ns_);
+  Clear(&stage_calls_);
+  Clear(&counters_);
+  Clear(&geometries_);
+  bytes_processed_ = 0;
+  arena_bytes_ = 0;
+  rss_begin_bytes_ = 0;
+  rss_delta_bytes_ = 0;
+}
+
+double ParseStats::stage_ms(Stage stage) const {
+  return stage_ns_[static_cast<size_t>(stage)].load(
+             std::memory_order_relaxed) /
+         1e6;
+}
+
+uint64_t ParseStats::stage_calls(Stage stage) const {
+  return stage_calls_[static_cast<size_t>(stage)].load(
+      std::memory_order_relaxed);
+}
+
+uint64_t ParseStats::count(Counter counter) const {
+  return counters_[static_cast<size_t>(counter)].load(
+      std::memory_order_relaxed);
+}
+
+uint64_t ParseStats::geometry_count(GeometryType type) const {
+  return geometries_[static_cast<size_t>(type)].load(
+      std::memory_order_relaxed);
+}
+
+const char* ParseStats::StageName(Stage stage) {
+  return kStageNames[static_cast<size_t>(stage)];
+}
+
+const char* ParseStats::CounterName(Counter counter) {
+  return kCounterNames[static_cast<size_t>(counter)];
+}
+
+std::string ParseStats::ToString() const {
+  std::string out;
+  char line[128];
+  for (size_t i = 0; i < kStageNum; i++) {
+    const auto stage = static_cast<Stage>(i);
+    std::snprintf(line, sizeof(line), "%-14s %12.3f ms %10llu calls\n",
+                  StageName(stage), stage_ms(stage),
+                  static_cast<unsigned long long>(stage_calls(stage)));
+    out.append(line);
+  }
+  for (size_t i = 0; i < kCounterNum; i++) {
+    const auto counter = static_cast<Counter>(i);
+    std::snprintf(line, sizeof(line), "%-14s %12llu\n", CounterName(counter),
+                  static_cast<unsigned long long>(count(counter)));
+    out.append(line);
+  }
+  for (size_t i = 0; i < kGeometryTypeNum; i++) {
+    std::snprintf(line, sizeof(line), "  %-12s %12llu\n", kGeometryNames[i],
+                  static_cast<unsigned long long>(
+                      geometry_count(static_cast<GeometryType>(i))));
+    out.append(line);
+  }
+  std::snprintf(line, sizeof(line),
+                "%-14s %12.2f MB\n%-14s %12.2f MB\n%-14s %12.2f MB\n",
+                "bytes", bytes_processed_ / 1024.0 / 1024.0, "arena",
+                arena_bytes_ / 1024.0 / 1024.0, "rss_delta",
+                rss_delta_bytes_ / 1024.0 / 1024.0);
+  out.append(line);
+  return out;
+}
+
+void ParseStats::AddStageTime(Stage stage, uint64_t ns) noexcept {
+  const size_t index = static_cast<size_t>(stage);
+  stage_ns_[index].fetch_add(ns, std::memory_order_relaxed);
+  stage_calls_[index].fetch_add(1, std::memory_order_relaxed);
+}
+
+void ParseStats::CountRoad(const element::Road& road) noexcept {
+  Add(Counter::kRoads, 1);
+  const auto& geometrys = road.plan_view().geometrys();
+  Add(Counter::kGeometries, geometrys.size());
+  for (const auto& geometry : geometrys) {
+    const size_t type = static_cast<size_t>(geometry->type());
+    if (type < kGeometryTypeNum) {
+      geometries_[type].fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  const auto& sections = road.lanes().lane_sections();
+  Add(Counter::kLaneSections, sections.size());
+  uint64_t lanes = 0;
+  uint64_t widths = 0;
+  uint64_t borders = 0;
+  uint64_t road_marks = 0;
+  uint64_t speeds = 0;
+  uint64_t boundary_segments = 0;
+  uint64_t boundary_bytes = 0;
+  for (const auto& section : sections) {
+    boundary_segments += section.boundary_table().segment_num();
+    boundary_bytes += section.boundary_table().bytes();
+    for (const auto* info :
+         {&section.left(), &section.center(), &section.right()}) {
+      lanes += info->lanes().size();
+      for (const auto& lane : info->lanes()) {
+        widths += lane.widths().size();
+        borders += lane.borders().size();
+        road_marks += lane.road_marks().size();
+        speeds += lane.max_speeds().size();
+      }
+    }
+  }
+  Add(Counter::kLanes, lanes);
+  Add(Counter::kWidths, widths);
+  Add(Counter::kBorders, borders);
+  Add(Counter::kRoadMarks, road_marks);
+  Add(Counter::kSpeeds, speeds);
+  Add(Counter::kBoundarySegments, boundary_segments);
+  Add(Counter::kBoundaryBytes, boundary_bytes);
+}
+
+void ParseStats::CountJunction(const element::Junction& junction) noexcept {
+  Add(Counter::kJunctions, 1);
+  Add(Counter::kConnections, junction.connections().size());
+}
+
+void ParseStats::MarkRssBegin() noexcept { rss_begin_bytes_ = CurrentRss(); }
+
+void ParseStats::UpdateRssDelta() noexcept {
+  const size_t rss = CurrentRss();
+  if (0 == rss || 0 == rss_begin_bytes_) return;
+  rss_delta_bytes_ =
+      static_cast<int64_t>(rss) - static_cast<int64_t>(rss_begin_bytes_);
+}
+
+ParseStats* ParseStats::Current() noexcept { return t_current_stats; }
+
+ScopedParseStats::ScopedParseStats(ParseStats* stats) noexcept
+    : prev_(t_current_stats) {
+  t_current_stats = stats;
+}
+
+ScopedParseStats::~ScopedParseStats() { t_current_stats = prev_; }
+
+}  // namespace opendrive
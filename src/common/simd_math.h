@@ -0,0 +1,545 @@
+#ifndef OPENDRIVE_CPP_COMMON_SIMD_MATH_H_
+#define OPENDRIVE_CPP_COMMON_SIMD_MATH_H_
+
+/**
+ * 仅供 geometry_kernels*.cc 使用的内部头文件.
+ *
+ * 同一套 sincos/atan/fresnel/geometry 模板以不同的向量类型实例化; 不同 .cc 以
+ * 不同的指令集编译, 因此全部放在匿名命名空间中, 避免链接器在 AVX2 与
+ * 基础版本之间合并同名实例.
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "opendrive-cpp/common/geometry_kernels.h"
+
+namespace opendrive {
+namespace common {
+namespace {
+
+/// 标量版本, 与 SIMD 版本共用同一套多项式
+struct DoubleX1 {
+  static constexpr size_t kWidth = 1;
+  struct Mask {
+    bool m;
+  };
+  double v;
+
+  static DoubleX1 Set(double x) { return DoubleX1{x}; }
+  static DoubleX1 Load(const double* p) { return DoubleX1{*p}; }
+  void Store(double* p) const { *p = v; }
+  friend DoubleX1 operator+(DoubleX1 a, DoubleX1 b) { return {a.v + b.v}; }
+  friend DoubleX1 operator-(DoubleX1 a, DoubleX1 b) { return {a.v - b.v}; }
+  friend DoubleX1 operator*(DoubleX1 a, DoubleX1 b) { return {a.v * b.v}; }
+  friend DoubleX1 operator/(DoubleX1 a, DoubleX1 b) { return {a.v / b.v}; }
+  friend DoubleX1 Min(DoubleX1 a, DoubleX1 b) {
+    return {a.v < b.v ? a.v : b.v};
+  }
+  friend DoubleX1 Abs(DoubleX1 a) { return {std::fabs(a.v)}; }
+  /// a 的绝对值, b 的符号
+  friend DoubleX1 CopySign(DoubleX1 a, DoubleX1 b) {
+    return {std::copysign(a.v, b.v)};
+  }
+  friend Mask Gt(DoubleX1 a, DoubleX1 b) { return {a.v > b.v}; }
+  friend Mask Lt(DoubleX1 a, DoubleX1 b) { return {a.v < b.v}; }
+  friend Mask Eq(DoubleX1 a, DoubleX1 b) { return {a.v == b.v}; }
+  friend Mask And(Mask a, Mask b) { return {a.m && b.m}; }
+  friend Mask Or(Mask a, Mask b) { return {a.m || b.m}; }
+  friend bool Any(Mask a) { return a.m; }
+  friend bool All(Mask a) { return a.m; }
+  friend DoubleX1 Select(Mask m, DoubleX1 a, DoubleX1 b) {
+    return m.m ? a : b;
+  }
+};
+
+#if defined(__SSE2__)
+struct DoubleX2 {
+  static constexpr size_t kWidth = 2;
+  struct Mask {
+    __m128d m;
+  };
+  __m128d v;
+
+  static DoubleX2 Set(double x) { return {_mm_set1_pd(x)}; }
+  static DoubleX2 Load(const double* p) { return {_mm_loadu_pd(p)}; }
+  void Store(double* p) const { _mm_storeu_pd(p, v); }
+  friend DoubleX2 operator+(DoubleX2 a, DoubleX2 b) {
+    return {_mm_add_pd(a.v, b.v)};
+  }
+  friend DoubleX2 operator-(DoubleX2 a, DoubleX2 b) {
+    return {_mm_sub_pd(a.v, b.v)};
+  }
+  friend DoubleX2 operator*(DoubleX2 a, DoubleX2 b) {
+    return {_mm_mul_pd(a.v, b.v)};
+  }
+  friend DoubleX2 operator/(DoubleX2 a, DoubleX2 b) {
+    return {_mm_div_pd(a.v, b.v)};
+  }
+  friend DoubleX2 Min(DoubleX2 a, DoubleX2 b) {
+    return {_mm_min_pd(a.v, b.v)};
+  }
+  friend DoubleX2 Abs(DoubleX2 a) {
+    return {_mm_andnot_pd(_mm_set1_pd(-0.0), a.v)};
+  }
+  friend DoubleX2 CopySign(DoubleX2 a, DoubleX2 b) {
+    const __m128d sign = _mm_set1_pd(-0.0);
+    return {_mm_or_pd(_mm_andnot_pd(sign, a.v), _mm_and_pd(sign, b.v))};
+  }
+  friend Mask Gt(DoubleX2 a, DoubleX2 b) { return {_mm_cmpgt_pd(a.v, b.v)}; }
+  friend Mask Lt(DoubleX2 a, DoubleX2 b) { return {_mm_cmplt_pd(a.v, b.v)}; }
+  friend Mask Eq(DoubleX2 a, DoubleX2 b) { return {_mm_cmpeq_pd(a.v, b.v)}; }
+  friend Mask And(Mask a, Mask b) { return {_mm_and_pd(a.m, b.m)}; }
+  friend Mask Or(Mask a, Mask b) { return {_mm_or_pd(a.m, b.m)}; }
+  friend bool Any(Mask a) { return 0 != _mm_movemask_pd(a.m); }
+  friend bool All(Mask a) { return 0x3 == _mm_movemask_pd(a.m); }
+  friend DoubleX2 Select(Mask m, DoubleX2 a, DoubleX2 b) {
+    return {_mm_or_pd(_mm_and_pd(m.m, a.v), _mm_andnot_pd(m.m, b.v))};
+  }
+};
+#endif
+
+#if defined(__AVX2__)
+struct DoubleX4 {
+  static constexpr size_t kWidth = 4;
+  struct Mask {
+    __m256d m;
+  };
+  __m256d v;
+
+  static DoubleX4 Set(double x) { return {_mm256_set1_pd(x)}; }
+  static DoubleX4 Load(const double* p) { return {_mm256_loadu_pd(p)}; }
+  void Store(double* p) const { _mm256_storeu_pd(p, v); }
+  friend DoubleX4 operator+(DoubleX4 a, DoubleX4 b) {
+    return {_mm256_add_pd(a.v, b.v)};
+  }
+  friend DoubleX4 operator-(DoubleX4 a, DoubleX4 b) {
+    return {_mm256_sub_pd(a.v, b.v)};
+  }
+  friend DoubleX4 operator*(DoubleX4 a, DoubleX4 b) {
+    return {_mm256_mul_pd(a.v, b.v)};
+  }
+  friend DoubleX4 operator/(DoubleX4 a, DoubleX4 b) {
+    return {_mm256_div_pd(a.v, b.v)};
+  }
+  friend DoubleX4 Min(DoubleX4 a, DoubleX4 b) {
+    return {_mm256_min_pd(a.v, b.v)};
+  }
+  friend DoubleX4 Abs(DoubleX4 a) {
+    return {_mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v)};
+  }
+  friend DoubleX4 CopySign(DoubleX4 a, DoubleX4 b) {
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    return {
+        _mm256_or_pd(_mm256_andnot_pd(sign, a.v), _mm256_and_pd(sign, b.v))};
+  }
+  friend Mask Gt(DoubleX4 a, DoubleX4 b) {
+    return {_mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ)};
+  }
+  friend Mask Lt(DoubleX4 a, DoubleX4 b) {
+    return {_mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ)};
+  }
+  friend Mask Eq(DoubleX4 a, DoubleX4 b) {
+    return {_mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ)};
+  }
+  friend Mask And(Mask a, Mask b) { return {_mm256_and_pd(a.m, b.m)}; }
+  friend Mask Or(Mask a, Mask b) { return {_mm256_or_pd(a.m, b.m)}; }
+  friend bool Any(Mask a) { return 0 != _mm256_movemask_pd(a.m); }
+  friend bool All(Mask a) { return 0xf == _mm256_movemask_pd(a.m); }
+  friend DoubleX4 Select(Mask m, DoubleX4 a, DoubleX4 b) {
+    return {_mm256_blendv_pd(b.v, a.v, m.m)};
+  }
+};
+#endif
+
+/// 就近取整, |x| < 2^51
+template <typename V>
+inline V Round(V x) {
+  const V magic = V::Set(6755399441055744.0);
+  return (x + magic) - magic;
+}
+
+template <typename V>
+inline V Floor(V x) {
+  const V r = Round(x);
+  return Select(Gt(r, x), r - V::Set(1.0), r);
+}
+
+/// 多项式 c[0]*x^(n-1) + ... + c[n-1], Horner 形式
+template <typename V, size_t N>
+inline V Polevl(V x, const double (&c)[N]) {
+  V y = V::Set(c[0]);
+  for (size_t i = 1; i < N; i++) {
+    y = y * x + V::Set(c[i]);
+  }
+  return y;
+}
+
+/// sin/cos(q * pi/2 + r), q 为整数, |r| <= pi/4, 无分支
+template <typename V>
+inline void SinCosQuadrant(V r, V q, V* sin_x, V* cos_x) {
+  static constexpr double kSin[] = {
+      1.58962301576546568060E-10, -2.50507477628578072866E-8,
+      2.75573136213857245213E-6,  -1.98412698295895385996E-4,
+      8.33333333332211858878E-3,  -1.66666666666666307295E-1,
+  };
+  static constexpr double kCos[] = {
+      -1.13585365213876817300E-11, 2.08757008419747316778E-9,
+      -2.75573141792967388112E-7,  2.48015872888517045348E-5,
+      -1.38888888888730564116E-3,  4.16666666666665929218E-2,
+  };
+  const V z = r * r;
+  const V sin_r = r + r * z * Polevl(z, kSin);
+  const V cos_r = V::Set(1.0) - V::Set(0.5) * z + z * z * Polevl(z, kCos);
+  /// 象限 q mod 4
+  const V quadrant = q - V::Set(4.0) * Floor(q * V::Set(0.25));
+  const auto q1 = Eq(quadrant, V::Set(1.0));
+  const auto q2 = Eq(quadrant, V::Set(2.0));
+  const auto q3 = Eq(quadrant, V::Set(3.0));
+  const auto odd = Or(q1, q3);
+  const V s = Select(odd, cos_r, sin_r);
+  const V c = Select(odd, sin_r, cos_r);
+  const V zero = V::Set(0.0);
+  *sin_x = Select(Or(q2, q3), zero - s, s);
+  *cos_x = Select(Or(q1, q2), zero - c, c);
+}
+
+/**
+ * @brief 同时计算 sin/cos, 无分支
+ *
+ * 按 pi/2 做三段 Cody-Waite 约简到 [-pi/4, pi/4], 多项式系数取自
+ * cephes sin.c; |x| < 1e5 时与 std::sin/std::cos 相差不超过几个 ulp.
+ */
+template <typename V>
+inline void SinCos(V x, V* sin_x, V* cos_x) {
+  const V q = Round(x * V::Set(0.63661977236758134308));
+  const V r = ((x - q * V::Set(1.57079625129699707031E0)) -
+               q * V::Set(7.54978941586159635335E-8)) -
+              q * V::Set(5.39030285815811905290E-15);
+  SinCosQuadrant(r, q, sin_x, cos_x);
+}
+
+/// atan, 无分支; 约简与有理逼近取自 cephes atan.c
+template <typename V>
+inline V Atan(V x) {
+  static constexpr double kP[] = {
+      -8.750608600031904122785E-1, -1.615753718733365076637E1,
+      -7.500855792314704667340E1,  -1.228866684490136173410E2,
+      -6.485021904942025371773E1,
+  };
+  static constexpr double kQ[] = {
+      1.0,
+      2.485846490142306297962E1,
+      1.650270098316988542046E2,
+      4.328810604912902668951E2,
+      4.853903996359136964868E2,
+      1.945506571482613964425E2,
+  };
+  constexpr double kMoreBits = 6.123233995736765886130E-17;
+  const V ax = Abs(x);
+  const V one = V::Set(1.0);
+  const auto big = Gt(ax, V::Set(2.41421356237309504880));
+  const auto mid = Gt(ax, V::Set(0.66));
+  /// 未选中的分支可能产生 inf/nan, 由 Select 丢弃
+  V xr = Select(mid, (ax - one) / (ax + one), ax);
+  xr = Select(big, V::Set(-1.0) / ax, xr);
+  V offset = Select(mid, V::Set(0.78539816339744830962 + 0.5 * kMoreBits),
+                    V::Set(0.0));
+  offset = Select(big, V::Set(1.57079632679489661923 + kMoreBits), offset);
+  const V z = xr * xr;
+  const V y = offset + (xr * (z * Polevl(z, kP) / Polevl(z, kQ)) + xr);
+  return CopySign(y, x);
+}
+
+/// atan2(y, x), x == y == 0 时为 0
+template <typename V>
+inline V Atan2(V y, V x) {
+  const V zero = V::Set(0.0);
+  const auto origin = And(Eq(x, zero), Eq(y, zero));
+  const V a = Atan(Select(origin, zero, y / x));
+  const V pi = CopySign(V::Set(3.14159265358979323846), y);
+  return Select(Lt(x, zero), a + pi, a);
+}
+
+/**
+ * @brief Fresnel 积分 S(x), C(x), 与 odrSpiral.cc 中的 fresnel 相同
+ *
+ * 有理逼近系数取自 cephes fresnl.c. 按 x^2 < 2.5625 与 x > 36974 在每个
+ * 元素上用 Select 选择结果; 只有向量中没有元素落在某个区间时才跳过该区间
+ * 的计算. 大参数区间的 sin/cos(pi/2 * x^2) 按 x^2 的整数部分确定象限,
+ * 约简没有舍入误差.
+ */
+template <typename V>
+inline void Fresnel(V xxa, V* s, V* c) {
+  static constexpr double kSn[] = {
+      -2.99181919401019853726E3, 7.08840045257738576863E5,
+      -6.29741486205862506537E7, 2.54890880573376359104E9,
+      -4.42979518059697779103E10, 3.18016297876567817986E11,
+  };
+  static constexpr double kSd[] = {
+      1.0,
+      2.81376268889994315696E2,
+      4.55847810806532581675E4,
+      5.17343888770096400730E6,
+      4.19320245898111231129E8,
+      2.24411795645340920940E10,
+      6.07366389490084639049E11,
+  };
+  static constexpr double kCn[] = {
+      -4.98843114573573548651E-8, 9.50428062829859605134E-6,
+      -6.45191435683965050962E-4, 1.88843319396703850064E-2,
+      -2.05525900955013891793E-1, 9.99999999999999998822E-1,
+  };
+  static constexpr double kCd[] = {
+      3.99982968972495980367E-12, 9.15439215774657478799E-10,
+      1.25001862479598821474E-7,  1.22262789024179030997E-5,
+      8.68029542941784300606E-4,  4.12142090722199792936E-2,
+      1.00000000000000000118E0,
+  };
+  static constexpr double kFn[] = {
+      4.21543555043677546506E-1, 1.43407919780758885261E-1,
+      1.15220955073585758835E-2, 3.45017939782574027900E-4,
+      4.63613749287867322088E-6, 3.05568983790257605827E-8,
+      1.02304514164907233465E-10, 1.72010743268161828879E-13,
+      1.34283276233062758925E-16, 3.76329711269987889006E-20,
+  };
+  static constexpr double kFd[] = {
+      1.0,
+      7.51586398353378947175E-1,
+      1.16888925859191382142E-1,
+      6.44051526508858611005E-3,
+      1.55934409164153020873E-4,
+      1.84627567348930545870E-6,
+      1.12699224763999035261E-8,
+      3.60140029589371370404E-11,
+      5.88754533621578410010E-14,
+      4.52001434074129701496E-17,
+      1.25443237090011264384E-20,
+  };
+  static constexpr double kGn[] = {
+      5.04442073643383265887E-1, 1.97102833525523411709E-1,
+      1.87648584092575249293E-2, 6.84079380915393090172E-4,
+      1.15138826111884280931E-5, 9.82852443688422223854E-8,
+      4.45344415861750144738E-10, 1.08268041139020870318E-12,
+      1.37555460633261799868E-15, 8.36354435630677421531E-19,
+      1.86958710162783235106E-22,
+  };
+  static constexpr double kGd[] = {
+      1.0,
+      1.47495759925128324529E0,
+      3.37748989120019970451E-1,
+      2.53603741420338795122E-2,
+      8.14679107184306179049E-4,
+      1.27545075667729118702E-5,
+      1.04314589657571990585E-7,
+      4.60680728146520428211E-10,
+      1.10273215066240270757E-12,
+      1.38796531259578871258E-15,
+      8.39158816283118707363E-19,
+      1.86958710162783236342E-22,
+  };
+  constexpr double kPi = 3.14159265358979323846;
+  const V x = Abs(xxa);
+  const V x2 = x * x;
+  const auto small = Lt(x2, V::Set(2.5625));
+  V ss_small = V::Set(0.0);
+  V cc_small = V::Set(0.0);
+  if (Any(small)) {
+    const V t = x2 * x2;
+    ss_small = x * x2 * Polevl(t, kSn) / Polevl(t, kSd);
+    cc_small = x * Polevl(t, kCn) / Polevl(t, kCd);
+  }
+  V ss_large = V::Set(0.5);
+  V cc_large = V::Set(0.5);
+  if (!All(small)) {
+    /// x 较小的元素在这里可能产生 inf/nan, 由 Select 丢弃
+    const V one = V::Set(1.0);
+    const V pi_x2 = V::Set(kPi) * x2;
+    const V u = one / (pi_x2 * pi_x2);
+    const V f = one - u * Polevl(u, kFn) / Polevl(u, kFd);
+    const V g = one / pi_x2 * Polevl(u, kGn) / Polevl(u, kGd);
+    const V q = Round(x2);
+    V sin_t;
+    V cos_t;
+    SinCosQuadrant((x2 - q) * V::Set(0.5 * kPi), q, &sin_t, &cos_t);
+    const V pi_x = V::Set(kPi) * x;
+    const auto huge = Gt(x, V::Set(36974.0));
+    cc_large = Select(huge, cc_large,
+                      V::Set(0.5) + (f * sin_t - g * cos_t) / pi_x);
+    ss_large = Select(huge, ss_large,
+                      V::Set(0.5) - (f * cos_t + g * sin_t) / pi_x);
+  }
+  *s = CopySign(Select(small, ss_small, ss_large), xxa);
+  *c = CopySign(Select(small, cc_small, cc_large), xxa);
+}
+
+/// 按向量宽度处理 [0, n), 尾部用标量版本
+template <typename V, typename F>
+inline void ForEachBatch(size_t n, const F& kernel) {
+  size_t i = 0;
+  for (; i + V::kWidth <= n; i += V::kWidth) {
+    kernel(V(), i);
+  }
+  for (; i < n; i++) {
+    kernel(DoubleX1(), i);
+  }
+}
+
+template <typename V>
+void LinePointsImpl(const GeometryOrigin& origin, const double* road_s,
+                    size_t n, double* x, double* y, double* heading) {
+  ForEachBatch<V>(n, [&](auto tag, size_t i) {
+    using T = decltype(tag);
+    const T ds = T::Load(road_s + i) - T::Set(origin.s);
+    (T::Set(origin.x) + T::Set(origin.cos_hdg) * ds).Store(x + i);
+    (T::Set(origin.y) + T::Set(origin.sin_hdg) * ds).Store(y + i);
+    T::Set(origin.hdg).Store(heading + i);
+  });
+}
+
+template <typename V>
+void ArcPointsImpl(const GeometryOrigin& origin, double curvature,
+                   const double* road_s, size_t n, double* x, double* y,
+                   double* heading) {
+  const double radius = 1.0 / curvature;
+  ForEachBatch<V>(n, [&](auto tag, size_t i) {
+    using T = decltype(tag);
+    const T ds = T::Load(road_s + i) - T::Set(origin.s);
+    const T tangent = T::Set(origin.hdg) + ds * T::Set(curvature);
+    T sin_t;
+    T cos_t;
+    SinCos(tangent, &sin_t, &cos_t);
+    /// cos(t - pi/2) = sin(t), sin(t - pi/2) = -cos(t)
+    (T::Set(radius) * (sin_t - T::Set(origin.sin_hdg)) + T::Set(origin.x))
+        .Store(x + i);
+    (T::Set(radius) * (T::Set(origin.cos_hdg) - cos_t) + T::Set(origin.y))
+        .Store(y + i);
+    tangent.Store(heading + i);
+  });
+}
+
+template <typename V>
+void Poly3PointsImpl(const GeometryOrigin& origin, const double* coef,
+                     const double* road_s, size_t n, double* x, double* y,
+                     double* heading) {
+  ForEachBatch<V>(n, [&](auto tag, size_t i) {
+    using T = decltype(tag);
+    const T u = T::Load(road_s + i) - T::Set(origin.s);
+    const T v = T::Set(coef[0]) +
+                u * (T::Set(coef[1]) + u * (T::Set(coef[2]) +
+                                            u * T::Set(coef[3])));
+    const T tangent_v =
+        T::Set(coef[1]) +
+        u * (T::Set(2.0 * coef[2]) + u * T::Set(3.0 * coef[3]));
+    const T cos_hdg = T::Set(origin.cos_hdg);
+    const T sin_hdg = T::Set(origin.sin_hdg);
+    (T::Set(origin.x) + (u * cos_hdg - v * sin_hdg)).Store(x + i);
+    (T::Set(origin.y) + (u * sin_hdg + v * cos_hdg)).Store(y + i);
+    (T::Set(origin.hdg) + Atan(tangent_v)).Store(heading + i);
+  });
+}
+
+template <typename V>
+void ParamPoly3PointsImpl(const GeometryOrigin& origin, const double* coef_u,
+                          const double* coef_v, double length, bool normalized,
+                          const double* road_s, size_t n, double* x, double* y,
+                          double* heading) {
+  ForEachBatch<V>(n, [&](auto tag, size_t i) {
+    using T = decltype(tag);
+    T p = T::Load(road_s + i) - T::Set(origin.s);
+    if (normalized) {
+      p = Min(T::Set(1.0), p / T::Set(length));
+    }
+    const T u = T::Set(coef_u[0]) +
+                p * (T::Set(coef_u[1]) +
+                     p * (T::Set(coef_u[2]) + p * T::Set(coef_u[3])));
+    const T v = T::Set(coef_v[0]) +
+                p * (T::Set(coef_v[1]) +
+                     p * (T::Set(coef_v[2]) + p * T::Set(coef_v[3])));
+    const T tangent_u =
+        T::Set(coef_u[1]) +
+        p * (T::Set(2.0 * coef_u[2]) + p * T::Set(3.0 * coef_u[3]));
+    const T tangent_v =
+        T::Set(coef_v[1]) +
+        p * (T::Set(2.0 * coef_v[2]) + p * T::Set(3.0 * coef_v[3]));
+    const T cos_hdg = T::Set(origin.cos_hdg);
+    const T sin_hdg = T::Set(origin.sin_hdg);
+    (T::Set(origin.x) + (u * cos_hdg - v * sin_hdg)).Store(x + i);
+    (T::Set(origin.y) + (u * sin_hdg + v * cos_hdg)).Store(y + i);
+    (T::Set(origin.hdg) + Atan2(tangent_v, tangent_u)).Store(heading + i);
+  });
+}
+
+template <typename V>
+void FresnelIntegralsImpl(const double* x, size_t n, double* s, double* c) {
+  ForEachBatch<V>(n, [&](auto tag, size_t i) {
+    using T = decltype(tag);
+    T ss;
+    T cc;
+    Fresnel(T::Load(x + i), &ss, &cc);
+    ss.Store(s + i);
+    cc.Store(c + i);
+  });
+}
+
+template <typename V>
+void SpiralPointsImpl(const GeometryOrigin& origin, const SpiralParams& spiral,
+                      const double* road_s, size_t n, double* x, double* y,
+                      double* heading) {
+  ForEachBatch<V>(n, [&](auto tag, size_t i) {
+    using T = decltype(tag);
+    const T ds = T::Load(road_s + i) - T::Set(origin.s);
+    T fresnel_s;
+    T fresnel_c;
+    Fresnel((T::Set(spiral.spiral_start) + ds) * T::Set(spiral.fresnel_scale),
+            &fresnel_s, &fresnel_c);
+    fresnel_s = fresnel_s - T::Set(spiral.fresnel_s0);
+    fresnel_c = fresnel_c - T::Set(spiral.fresnel_c0);
+    (T::Set(origin.x) + fresnel_c * T::Set(spiral.rotation[0]) +
+     fresnel_s * T::Set(spiral.rotation[1]))
+        .Store(x + i);
+    (T::Set(origin.y) + fresnel_c * T::Set(spiral.rotation[2]) +
+     fresnel_s * T::Set(spiral.rotation[3]))
+        .Store(y + i);
+    (T::Set(origin.hdg) +
+     ds * (T::Set(spiral.curve_start) + T::Set(0.5 * spiral.curve_dot) * ds))
+        .Store(heading + i);
+  });
+}
+
+}  // namespace
+
+#if defined(OPENDRIVE_CPP_WITH_AVX2)
+/// geometry_kernels_avx2.cc, 以 -mavx2 -mfma 编译, 调用前需检查 CPU
+namespace avx2 {
+void LinePoints(const GeometryOrigin& origin, const double* road_s, size_t n,
+                double* x, double* y, double* heading);
+void ArcPoints(const GeometryOrigin& origin, double curvature,
+               const double* road_s, size_t n, double* x, double* y,
+               double* heading);
+void Poly3Points(const GeometryOrigin& origin, const double coef[4],
+                 const double* road_s, size_t n, double* x, double* y,
+                 double* heading);
+void ParamPoly3Points(const GeometryOrigin& origin, const double coef_u[4],
+                      const double coef_v[4], double length, bool normalized,
+                      const double* road_s, size_t n, double* x, double* y,
+                      double* heading);
+void SpiralPoints(const GeometryOrigin& origin, const SpiralParams& spiral,
+                  const double* road_s, size_t n, double* x, double* y,
+                  double* heading);
+void FresnelIntegrals(const double* x, size_t n, double* s, double* c);
+}  // namespace avx2
+#endif
+
+}  // namespace common
+}  // namespace opendrive
+
+#endif  // OPENDRIVE_CPP_COMMON_SIMD_MATH_H_
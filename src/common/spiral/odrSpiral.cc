@@ -54,6 +54,8 @@
 #include <unistd.h>
 #include <math.h>
 
+#include "opendrive-cpp/common/geometry_kernels.h"
+
 /* ====== LOCAL VARIABLES ====== */
 
 /* S(x) for small x */
@@ -262,3 +264,47 @@ void odrSpiral( double s, double cDot, double *x, double *y, double *t )
     *t = s * s * cDot * 0.5;
 }
 
+/**
+* compute the Fresnel integrals S(x) and C(x), normalized as in odrSpiral
+* @param x      argument
+* @param s      resulting S(x)
+* @param c      resulting C(x)
+*/
+
+void odrFresnel( double x, double *s, double *c )
+{
+    fresnel( x, s, c );
+}
+
+/**
+* compute the "standard" spiral for n run-lengths at once
+* @param s      n run-lengths along spiral
+* @param n      number of run-lengths
+* @param cDot   first derivative of curvature [1/m2]
+* @param x      n resulting x-coordinates, must not overlap s
+* @param y      n resulting y-coordinates, must not overlap s
+* @param t      n resulting tangent directions, must not overlap s
+*/
+
+void odrSpiralBatch( const double *s, size_t n, double cDot, double *x, double *y, double *t )
+{
+    double a;
+    size_t i;
+
+    a = 1.0 / sqrt( fabs( cDot ) );
+    a *= sqrt( M_PI );
+
+    /* t holds the fresnel arguments until the last loop */
+    for ( i = 0; i < n; i++ )
+        t[i] = s[i] / a;
+
+    opendrive::common::FresnelIntegrals( t, n, y, x );
+
+    const double ya = cDot < 0.0 ? -a : a;
+    for ( i = 0; i < n; i++ )
+    {
+        x[i] *= a;
+        y[i] *= ya;
+        t[i] = s[i] * s[i] * cDot * 0.5;
+    }
+}
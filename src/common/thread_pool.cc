@@ -0,0 +1,47 @@
+#include "opendrive-cpp/common/thread_pool.h"
+
+namespace opendrive {
+namespace common {
+
+ThreadPool::ThreadPool(size_t thread_num) {
+  if (0 == thread_num) {
+    thread_num = HardwareConcurrency();
+  }
+  workers_.reserve(thread_num);
+  for (size_t i = 0; i < thread_num; i++) {
+    workers_.emplace_back(&ThreadPool::Run, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cond_.notify_all();
+  for (auto& worker : workers_) {
+    if (worker.joinable()) worker.join();
+  }
+}
+
+size_t ThreadPool::HardwareConcurrency() {
+  const size_t n = std::thread::hardware_concurrency();
+  return n > 0 ? n : 1;
+}
+
+void ThreadPool::Run() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cond_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+      if (stop_ && tasks_.empty()) return;
+      task = std::move(tasks_.front());
+      tasks_.pop();
+    }
+    task();
+  }
+}
+
+}  // namespace common
+}  // namespace opendrive
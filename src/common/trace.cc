@@ -0,0 +1,141 @@
+#include "opendrive-cpp/common/trace.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+
+namespace opendrive {
+namespace common {
+
+namespace {
+
+std::atomic<uint64_t> g_next_sink_id{1};
+std::atomic<uint32_t> g_next_tid{1};
+
+/// 线程当前使用的缓冲区, id 与 TraceSink::id_ 不同时失效
+struct LocalCache {
+  uint64_t id = 0;
+  void* buffer = nullptr;
+};
+
+thread_local LocalCache t_cache;
+thread_local TraceSink* t_current_sink = nullptr;
+
+/// 线程编号, 按第一次记录事件的顺序分配, 便于阅读
+uint32_t ThreadId() {
+  thread_local uint32_t tid = g_next_tid.fetch_add(1);
+  return tid;
+}
+
+}  // namespace
+
+TraceSink::TraceSink()
+    : id_(g_next_sink_id.fetch_add(1)),
+      origin_(std::chrono::steady_clock::now()) {}
+
+bool TraceSink::Supported() noexcept {
+#ifdef OPENDRIVE_CPP_WITH_TRACE
+  return true;
+#else
+  return false;
+#endif
+}
+
+TraceSink* TraceSink::Current() noexcept { return t_current_sink; }
+
+void TraceSink::Begin(const char* name, int64_t id) { Record(name, 'B', id); }
+
+void TraceSink::End(const char* name) { Record(name, 'E', -1); }
+
+void TraceSink::Record(const char* name, char phase, int64_t id) {
+  const int64_t ts_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - origin_)
+                            .count();
+  LocalBuffer()->events.push_back(Event{name, ts_ns, id, phase});
+}
+
+TraceSink::Buffer* TraceSink::LocalBuffer() {
+  LocalCache& cache = t_cache;
+  if (cache.id == id_.load(std::memory_order_relaxed)) {
+    return static_cast<Buffer*>(cache.buffer);
+  }
+  const uint32_t tid = ThreadId();
+  std::lock_guard<std::mutex> lock(mutex_);
+  Buffer* buffer = nullptr;
+  for (auto& candidate : buffers_) {
+    if (tid == candidate.tid) {
+      buffer = &candidate;
+      break;
+    }
+  }
+  if (!buffer) {
+    buffers_.emplace_back();
+    buffer = &buffers_.back();
+    buffer->tid = tid;
+  }
+  cache.id = id_.load(std::memory_order_relaxed);
+  cache.buffer = buffer;
+  return buffer;
+}
+
+size_t TraceSink::event_size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t size = 0;
+  for (const auto& buffer : buffers_) {
+    size += buffer.events.size();
+  }
+  return size;
+}
+
+void TraceSink::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  buffers_.clear();
+  id_.store(g_next_sink_id.fetch_add(1), std::memory_order_relaxed);
+  origin_ = std::chrono::steady_clock::now();
+}
+
+std::string TraceSink::ToJson() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  char line[256];
+  bool first = true;
+  for (const auto& buffer : buffers_) {
+    for (const auto& event : buffer.events) {
+      /// ts 单位为微秒
+      int n = std::snprintf(
+          line, sizeof(line),
+          "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%" PRId64
+          ".%03d,\"pid\":1,\"tid\":%u",
+          first ? "" : ",", event.name, event.phase, event.ts_ns / 1000,
+          static_cast<int>(event.ts_ns % 1000), buffer.tid);
+      out.append(line, static_cast<size_t>(n));
+      if (event.id >= 0) {
+        n = std::snprintf(line, sizeof(line), ",\"args\":{\"id\":%" PRId64 "}",
+                          event.id);
+        out.append(line, static_cast<size_t>(n));
+      }
+      out.push_back('}');
+      first = false;
+    }
+  }
+  out.append("\n]}\n");
+  return out;
+}
+
+bool TraceSink::Save(const std::string& file) const {
+  std::ofstream out(file, std::ios::binary | std::ios::trunc);
+  if (!out) return false;
+  const std::string json = ToJson();
+  out.write(json.data(), static_cast<std::streamsize>(json.size()));
+  return static_cast<bool>(out);
+}
+
+ScopedTraceSink::ScopedTraceSink(TraceSink* sink) noexcept
+    : prev_(t_current_sink) {
+  t_current_sink = sink;
+}
+
+ScopedTraceSink::~ScopedTraceSink() { t_current_sink = prev_; }
+
+}  // namespace common
+}  // namespace opendrive
@@ -0,0 +1,261 @@
+#include "opendrive-cpp/lazy_map.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "opendrive-cpp/common/numeric.h"
+#include "opendrive-cpp/parser/road_parser.h"
+#include "opendrive-cpp/parser/stream_parser.h"
+
+namespace opendrive {
+
+namespace {
+
+constexpr char kRoadEndTag[] = "</road>";
+constexpr char kGeometryTag[] = "<geometry";
+
+bool IsSpace(char c) {
+  return ' ' == c || '\t' == c || '\r' == c || '\n' == c;
+}
+
+/// 在起始标签 [tag, tag_end) 中读取数值属性, 不构建 DOM
+bool ReadDoubleAttribute(const char* tag, const char* tag_end,
+                         const std::string& name, double* value) {
+  const char* p = tag;
+  while (true) {
+    p = std::search(p, tag_end, name.begin(), name.end());
+    if (p == tag_end) return false;
+    const char* q = p + name.size();
+    const bool name_begin = p > tag && IsSpace(*(p - 1));
+    p = q;
+    if (!name_begin) continue;
+    while (q < tag_end && IsSpace(*q)) q++;
+    if (q >= tag_end || '=' != *q) continue;
+    q++;
+    while (q < tag_end && IsSpace(*q)) q++;
+    if (q >= tag_end || ('"' != *q && '\'' != *q)) continue;
+    return common::ParseDouble(q + 1, value);
+  }
+}
+
+/**
+ * @brief 由 <geometry> 的起点和长度估计参考线的包围盒
+ *
+ * 任意形状的一段 geometry 都不会离开以起点为中心、长度为半径的圆
+ */
+element::Box EstimateBound(const char* data, size_t size) {
+  element::Box bound;
+  const char* end = data + size;
+  const char* p = data;
+  const size_t tag_size = sizeof(kGeometryTag) - 1;
+  while ((p = std::search(p, end, kGeometryTag, kGeometryTag + tag_size)) !=
+         end) {
+    p += tag_size;
+    if (p >= end || !(IsSpace(*p) || '/' == *p || '>' == *p)) continue;
+    const char* tag_end = std::find(p, end, '>');
+    double x = 0;
+    double y = 0;
+    double length = 0;
+    if (ReadDoubleAttribute(p, tag_end, "x", &x) &&
+        ReadDoubleAttribute(p, tag_end, "y", &y)) {
+      ReadDoubleAttribute(p, tag_end, "length", &length);
+      bound.Extend(x, y, std::fabs(length));
+    }
+    p = tag_end;
+  }
+  return bound;
+}
+
+}  // namespace
+
+LazyMap::LazyMap() : LazyMap(nullptr) {}
+
+LazyMap::LazyMap(common::Arena* arena)
+    : arena_(arena), map_(element::Map::Create(arena)) {}
+
+opendrive::Status LazyMap::Load(const std::string& xml_file) {
+  Reset();
+  if (!file_.Open(xml_file)) {
+    return Status{ErrorCode::XML_ROAD_ELEMENT_ERROR, "Map Xml File Exection."};
+  }
+  file_.Advise(common::MappedFile::Advice::kSequential);
+  data_ = file_.data();
+  size_ = file_.size();
+  auto status = Scan();
+  /// 之后只按 road 随机访问, 扫描过的页面不再常驻
+  file_.Advise(common::MappedFile::Advice::kRandom);
+  file_.Release(0, size_);
+  return status;
+}
+
+opendrive::Status LazyMap::LoadData(std::string xml_data) {
+  Reset();
+  buffer_ = std::move(xml_data);
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+  return Scan();
+}
+
+element::Ids LazyMap::road_ids() const {
+  element::Ids ids;
+  ids.reserve(map_->roads().size());
+  for (const auto& road : map_->roads()) {
+    ids.emplace_back(road.attribute().id());
+  }
+  return ids;
+}
+
+bool LazyMap::IsRoadLoaded(element::Id id) const {
+  auto it = index_.find(id);
+  if (index_.end() == it) return false;
+  return entries_[it->second].loaded.load(std::memory_order_acquire);
+}
+
+const element::Road* LazyMap::PeekRoad(element::Id id) const {
+  auto it = index_.find(id);
+  if (index_.end() == it) return nullptr;
+  return &map_->roads()[it->second];
+}
+
+const element::Road* LazyMap::GetRoad(element::Id id,
+                                      opendrive::Status* status) const {
+  auto it = index_.find(id);
+  if (index_.end() == it) {
+    if (status) {
+      *status = Status{ErrorCode::XML_ROAD_ELEMENT_ERROR,
+                       "Road " + std::to_string(id) + " Not Found."};
+    }
+    return nullptr;
+  }
+  RoadEntry& entry = entries_[it->second];
+  element::Road* road = &(*map_->mutable_roads())[it->second];
+  std::call_once(entry.once, [this, &entry, road]() {
+    entry.status = LoadRoad(&entry, road);
+  });
+  if (status) {
+    *status = entry.status;
+  }
+  return ErrorCode::OK == entry.status.error_code ? road : nullptr;
+}
+
+opendrive::Status LazyMap::LoadRegion(const element::Boxes& regions) const {
+  opendrive::Status status{ErrorCode::OK, "ok"};
+  for (auto id : RoadsInRegion(regions)) {
+    opendrive::Status road_status;
+    if (!GetRoad(id, &road_status) && ErrorCode::OK == status.error_code) {
+      status = road_status;
+    }
+  }
+  return status;
+}
+
+element::Box LazyMap::RoadBound(element::Id id) const {
+  auto it = index_.find(id);
+  if (index_.end() == it) return element::Box();
+  return entries_[it->second].bound;
+}
+
+element::Ids LazyMap::RoadsInRegion(const element::Boxes& regions) const {
+  element::Ids ids;
+  for (size_t i = 0; i < entries_.size(); i++) {
+    for (const auto& region : regions) {
+      if (entries_[i].bound.Intersects(region)) {
+        ids.emplace_back(map_->roads()[i].attribute().id());
+        break;
+      }
+    }
+  }
+  return ids;
+}
+
+void LazyMap::Reset() {
+  map_ = element::Map::Create(arena_);
+  file_.Close();
+  std::string().swap(buffer_);
+  data_ = nullptr;
+  size_ = 0;
+  opendrive_version_.clear();
+  entries_.clear();
+  index_.clear();
+  loaded_num_.store(0, std::memory_order_relaxed);
+}
+
+opendrive::Status LazyMap::Scan() {
+  if (!data_) {
+    return Status{ErrorCode::XML_ROOT_ELEMENT_ERROR, "Input is null."};
+  }
+  parser::StreamXmlParser stream_parser;
+  tinyxml2::XMLDocument doc;
+  stream_parser.set_road_fragment_callback(
+      [this, &stream_parser, &doc](const char* fragment, size_t size,
+                                   size_t head_size) {
+        if (opendrive_version_.empty()) {
+          opendrive_version_ = stream_parser.opendrive_version();
+        }
+        return AddRoad(fragment - data_, size, head_size, &doc);
+      });
+  auto status = stream_parser.Parse(data_, size_, map_);
+  opendrive_version_ = stream_parser.opendrive_version();
+  return status;
+}
+
+opendrive::Status LazyMap::AddRoad(size_t offset, size_t size,
+                                   size_t head_size,
+                                   tinyxml2::XMLDocument* doc) {
+  const char* fragment = data_ + offset;
+  /// 没有 <planView>/<lanes> 时按完整 road 解析, 错误与 ParseMap 一致
+  const bool whole = head_size >= size;
+  std::string head;
+  if (whole) {
+    doc->Parse(fragment, size);
+  } else {
+    head.reserve(head_size + sizeof(kRoadEndTag));
+    head.assign(fragment, head_size);
+    head.append(kRoadEndTag);
+    doc->Parse(head.data(), head.size());
+  }
+  if (doc->Error()) {
+    return Status{ErrorCode::XML_ROAD_ELEMENT_ERROR,
+                  "Parse <road> Element Exception."};
+  }
+  common::ScopedArena scope(map_->arena());
+  map_->mutable_roads()->emplace_back();
+  element::Road* road = &map_->mutable_roads()->back();
+  parser::RoadXmlParser road_parser{opendrive_version_};
+  auto status = whole ? road_parser.Parse(doc->RootElement(), road)
+                      : road_parser.ParseHead(doc->RootElement(), road);
+  if (ErrorCode::OK != status.error_code) {
+    return status;
+  }
+  entries_.emplace_back(offset, size, whole,
+                        EstimateBound(fragment + head_size, size - head_size));
+  if (whole) {
+    loaded_num_++;
+  }
+  index_.emplace(road->attribute().id(), entries_.size() - 1);
+  return status;
+}
+
+opendrive::Status LazyMap::LoadRoad(RoadEntry* entry,
+                                    element::Road* road) const {
+  if (entry->loaded.load(std::memory_order_acquire)) {
+    return Status{ErrorCode::OK, "ok"};
+  }
+  tinyxml2::XMLDocument doc;
+  doc.Parse(data_ + entry->offset, entry->size);
+  if (doc.Error()) {
+    return Status{ErrorCode::XML_ROAD_ELEMENT_ERROR,
+                  "Parse <road> Element Exception."};
+  }
+  common::ScopedArena scope(map_->arena());
+  parser::RoadXmlParser road_parser{opendrive_version_};
+  auto status = road_parser.ParseBody(doc.RootElement(), road);
+  if (ErrorCode::OK == status.error_code) {
+    entry->loaded.store(true, std::memory_order_release);
+    loaded_num_++;
+  }
+  return status;
+}
+
+}  // namespace opendrive
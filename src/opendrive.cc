@@ -1,30 +1,480 @@
 #include "opendrive-cpp/opendrive.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include "opendrive-cpp/common/mapped_file.h"
+#include "opendrive-cpp/common/thread_pool.h"
 
 namespace opendrive {
 
-Parser::Parser() : map_parser_(std::make_unique<parser::MapXmlParser>()) {}
+namespace {
+
+constexpr size_t kStreamChunkSize = 256 * 1024;
+constexpr size_t kPipelineDepth = 4;
+
+/**
+ * @brief 读取(解压)线程与解析线程之间的块流水线
+ *
+ * kPipelineDepth 个块循环使用, 读取线程填充空闲块, 调用线程按顺序消费.
+ */
+class ChunkPipeline {
+ public:
+  using Consumer = std::function<bool(const char* data, size_t size)>;
+  explicit ChunkPipeline(common::InflateStream* stream)
+      : stream_(stream),
+        chunks_(kPipelineDepth, std::string(kStreamChunkSize, '\0')) {
+    for (size_t i = 0; i < kPipelineDepth; i++) {
+      free_.push_back(i);
+    }
+  }
+
+  /// consumer 返回 false 时停止读取
+  void Run(const Consumer& consumer) {
+    std::thread producer([this]() { Produce(); });
+    while (true) {
+      std::pair<size_t, long> chunk;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_cv_.wait(lock, [this]() { return !ready_.empty(); });
+        chunk = ready_.front();
+        ready_.pop_front();
+      }
+      if (chunk.second <= 0) break;
+      const bool consumed = consumer(chunks_[chunk.first].data(),
+                                     static_cast<size_t>(chunk.second));
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.push_back(chunk.first);
+        stop_ = !consumed;
+      }
+      free_cv_.notify_one();
+      if (!consumed) break;
+    }
+    producer.join();
+  }
+
+ private:
+  void Produce() {
+    while (true) {
+      size_t index = 0;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        free_cv_.wait(lock, [this]() { return stop_ || !free_.empty(); });
+        if (stop_) return;
+        index = free_.front();
+        free_.pop_front();
+      }
+      const long n = stream_->Read(&chunks_[index][0], chunks_[index].size());
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ready_.emplace_back(index, n);
+      }
+      ready_cv_.notify_one();
+      if (n <= 0) return;
+    }
+  }
+
+  common::InflateStream* stream_;
+  std::vector<std::string> chunks_;
+  std::deque<size_t> free_;
+  std::deque<std::pair<size_t, long>> ready_;
+  std::mutex mutex_;
+  std::condition_variable free_cv_;
+  std::condition_variable ready_cv_;
+  bool stop_ = false;
+};
+
+/// ParseMap 结束时补充读入字节数与内存统计
+void FinishStats(ParseStats* stats, const element::Map::Ptr& ele_map,
+                 size_t bytes) {
+  if (!stats) return;
+  stats->set_bytes_processed(bytes);
+  if (ele_map && ele_map->arena()) {
+    stats->set_arena_bytes(ele_map->arena()->bytes_reserved());
+  }
+  stats->UpdateRssDelta();
+}
+
+/// 放弃的地图立即归还内存(arena 地图在 arena 释放时归还)
+void DiscardMap(const element::Map::Ptr& ele_map) {
+  if (!ele_map) return;
+  element::Vector<element::Road>(ele_map->roads().get_allocator())
+      .swap(*ele_map->mutable_roads());
+  element::Vector<element::Junction>(ele_map->junctions().get_allocator())
+      .swap(*ele_map->mutable_junctions());
+}
+
+/// 设置当前线程的统计对象并清零, 同时设置 trace sink
+class StatsScope {
+ public:
+  StatsScope(ParseStats* stats, common::TraceSink* trace)
+      : scope_(stats), trace_scope_(trace) {
+    if (stats) {
+      stats->Reset();
+      stats->MarkRssBegin();
+    }
+  }
+
+ private:
+  ScopedParseStats scope_;
+  common::ScopedTraceSink trace_scope_;
+};
+
+}  // namespace
+
+Parser::Parser() = default;
+
+Parser::Parser(const ParseOptions& options) : options_(options) {}
 
 std::string Parser::GetOpenDriveVersion() const {
-  return map_parser_->opendrive_version();
+  std::lock_guard<std::mutex> lock(mutex_);
+  return opendrive_version_;
+}
+
+void Parser::SetOpenDriveVersion(const std::string& version) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  opendrive_version_ = version;
 }
 
 opendrive::Status Parser::ParseMap(const std::string& xml_file,
-                                   element::Map::Ptr ele_map) {
+                                   element::Map::Ptr ele_map) const {
+  StatsScope stats_scope(options_.stats, options_.trace);
+  size_t bytes = 0;
+  auto status = ParseXmlFile(xml_file, options_, ele_map, &bytes);
+  FinishStats(options_.stats, ele_map, bytes);
+  return status;
+}
+
+opendrive::Status Parser::ParseMap(const tinyxml2::XMLElement* xml_root,
+                                   element::Map::Ptr ele_map) const {
+  StatsScope stats_scope(options_.stats, options_.trace);
+  auto status = ParseXmlRoot(xml_root, options_, 0, ele_map);
+  FinishStats(options_.stats, ele_map, 0);
+  return status;
+}
+
+std::vector<opendrive::Status> Parser::ParseMaps(
+    const std::vector<std::string>& xml_files,
+    std::vector<element::Map::Ptr>* ele_maps) const {
+  std::vector<opendrive::Status> statuses(xml_files.size());
+  if (!ele_maps) {
+    for (auto& status : statuses) {
+      status = Status{ErrorCode::XML_ROOT_ELEMENT_ERROR, "Input is null."};
+    }
+    return statuses;
+  }
+  StatsScope stats_scope(options_.stats, options_.trace);
+  ele_maps->resize(xml_files.size());
+  for (auto& ele_map : *ele_maps) {
+    if (!ele_map) ele_map = std::make_shared<element::Map>();
+  }
+  /// 并行粒度为文件, 单个文件内不再开线程
+  ParseOptions file_options = options_;
+  file_options.thread_num = 1;
+  std::atomic<size_t> bytes{0};
+  ParseStats* stats = ParseStats::Current();
+  common::TraceSink* trace = common::TraceSink::Current();
+  auto parse_file = [&](size_t i) {
+    ScopedParseStats scope(stats);
+    common::ScopedTraceSink trace_scope(trace);
+    size_t file_bytes = 0;
+    statuses.at(i) = ParseXmlFile(xml_files.at(i), file_options,
+                                  ele_maps->at(i), &file_bytes);
+    bytes.fetch_add(file_bytes, std::memory_order_relaxed);
+  };
+  if (1 == options_.thread_num || xml_files.size() < 2) {
+    for (size_t i = 0; i < xml_files.size(); i++) {
+      parse_file(i);
+    }
+  } else {
+    /// 文件大小差异大, 逐个入队以均衡负载
+    const size_t thread_num = 0 == options_.thread_num
+                                  ? common::ThreadPool::HardwareConcurrency()
+                                  : options_.thread_num;
+    common::ThreadPool thread_pool(std::min(xml_files.size(), thread_num));
+    std::vector<std::future<void>> futures;
+    futures.reserve(xml_files.size());
+    for (size_t i = 0; i < xml_files.size(); i++) {
+      futures.emplace_back(
+          thread_pool.Enqueue([&parse_file, i]() { parse_file(i); }));
+    }
+    for (auto& future : futures) {
+      future.get();
+    }
+  }
+  FinishStats(options_.stats, nullptr, bytes.load());
+  return statuses;
+}
+
+ParseTask::Ptr Parser::ParseMapAsync(const std::string& xml_file,
+                                     element::Map::Ptr ele_map) const {
+  ParseTask::Ptr task(new ParseTask());
+  ParseTask* raw_task = task.get();
+  ParseOptions options = options_;
+  options.cancel = &raw_task->cancel_;
+  options.progress = [raw_task, callback = options_.progress](
+                         const ParseProgress& progress) {
+    raw_task->set_progress(progress);
+    if (callback) callback(progress);
+  };
+  /// 线程不引用 this, Parser 可以先于 ParseTask 析构
+  std::packaged_task<Status()> run([options, xml_file, ele_map]() {
+    return Parser(options).ParseMap(xml_file, ele_map);
+  });
+  task->future_ = run.get_future().share();
+  task->thread_ = std::thread(std::move(run));
+  return task;
+}
+
+ParseTask::~ParseTask() {
+  Cancel();
+  if (thread_.joinable()) thread_.join();
+}
+
+bool ParseTask::ready() const {
+  return WaitFor(std::chrono::milliseconds(0));
+}
+
+bool ParseTask::WaitFor(std::chrono::milliseconds timeout) const {
+  return std::future_status::ready == future_.wait_for(timeout);
+}
+
+opendrive::Status ParseTask::Wait() const { return future_.get(); }
+
+ParseProgress ParseTask::progress() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return progress_;
+}
+
+void ParseTask::set_progress(const ParseProgress& progress) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  progress_ = progress;
+}
+
+opendrive::Status Parser::ParseXmlFile(const std::string& xml_file,
+                                       const ParseOptions& options,
+                                       element::Map::Ptr ele_map,
+                                       size_t* bytes) const {
+  if (options.cancel && options.cancel->load(std::memory_order_relaxed)) {
+    return Status{ErrorCode::PARSE_CANCELLED, "Cancelled."};
+  }
+  if (options.use_mmap) {
+    /// 片段直接在映射页面上解析, 不复制整个文件, 已解析的页面及时释放
+    parser::StreamXmlParser stream_parser(options);
+    auto status = stream_parser.ParseFile(xml_file, ele_map);
+    *bytes = stream_parser.bytes_consumed();
+    if (ErrorCode::OK == status.error_code) {
+      SetOpenDriveVersion(stream_parser.opendrive_version());
+    } else if (ErrorCode::PARSE_CANCELLED == status.error_code) {
+      DiscardMap(ele_map);
+    }
+    return status;
+  }
+  tinyxml2::XMLDocument xml_doc;
+  auto status = LoadXmlFile(xml_file, &xml_doc, bytes);
+  if (ErrorCode::OK != status.error_code) {
+    return status;
+  }
+  return ParseXmlRoot(xml_doc.RootElement(), options, *bytes, ele_map);
+}
+
+opendrive::Status Parser::ParseXmlRoot(const tinyxml2::XMLElement* xml_root,
+                                       const ParseOptions& options,
+                                       size_t bytes,
+                                       element::Map::Ptr ele_map) const {
+  parser::MapXmlParser map_parser(options);
+  map_parser.set_input_bytes(bytes);
+  auto status = map_parser.Parse(xml_root, ele_map);
+  if (ErrorCode::OK == status.error_code) {
+    SetOpenDriveVersion(map_parser.opendrive_version());
+  } else if (ErrorCode::PARSE_CANCELLED == status.error_code) {
+    DiscardMap(ele_map);
+  }
+  return status;
+}
+
+opendrive::Status Parser::ParseMap(const char* data, size_t size,
+                                   element::Map::Ptr ele_map) const {
+  if (!data) {
+    return Status{ErrorCode::XML_ROOT_ELEMENT_ERROR, "Input is null."};
+  }
+  if (common::InflateStream::IsCompressed(data, size)) {
+    size_t pos = 0;
+    return ParseMap(
+        [data, size, &pos](char* buf, size_t n) -> long {
+          n = std::min(n, size - pos);
+          std::memcpy(buf, data + pos, n);
+          pos += n;
+          return static_cast<long>(n);
+        },
+        ele_map);
+  }
+  StatsScope stats_scope(options_.stats, options_.trace);
   tinyxml2::XMLDocument xml_doc;
-  xml_doc.LoadFile(xml_file.c_str());
+  {
+    ScopedStageTimer timer(ParseStats::Stage::kLoadXml);
+    xml_doc.Parse(data, size);
+  }
   if (xml_doc.Error()) {
     return Status{ErrorCode::XML_ROAD_ELEMENT_ERROR,
-                  "Parse Xml File Exection."};
+                  "Parse Xml Data Exection."};
   }
-  tinyxml2::XMLElement* xml_root = xml_doc.RootElement();
-  return map_parser_->Parse(xml_root, ele_map);
+  auto status = ParseXmlRoot(xml_doc.RootElement(), options_, size, ele_map);
+  FinishStats(options_.stats, ele_map, size);
+  return status;
 }
 
-opendrive::Status Parser::ParseMap(const tinyxml2::XMLElement* xml_root,
-                                   element::Map::Ptr ele_map) {
-  return map_parser_->Parse(xml_root, ele_map);
+opendrive::Status Parser::ParseMap(const common::StreamReader& reader,
+                                   element::Map::Ptr ele_map) const {
+  StatsScope stats_scope(options_.stats, options_.trace);
+  parser::StreamXmlParser stream_parser(options_);
+  auto status = stream_parser.Begin(ele_map);
+  if (ErrorCode::OK != status.error_code) {
+    return status;
+  }
+  common::InflateStream stream(reader, kStreamChunkSize);
+  auto consumer = [&stream_parser, &status](const char* data, size_t size) {
+    status = stream_parser.Feed(data, size);
+    return ErrorCode::OK == status.error_code;
+  };
+  if (1 == options_.thread_num) {
+    std::string chunk(kStreamChunkSize, '\0');
+    long n = 0;
+    while ((n = stream.Read(&chunk[0], chunk.size())) > 0 &&
+           consumer(chunk.data(), static_cast<size_t>(n))) {
+    }
+  } else {
+    ChunkPipeline(&stream).Run(consumer);
+  }
+  if (ErrorCode::OK != status.error_code) {
+    return status;
+  }
+  if (!stream.error().empty()) {
+    return Status{ErrorCode::LOAD_DATA_ERROR, stream.error()};
+  }
+  status = stream_parser.End();
+  if (ErrorCode::OK == status.error_code) {
+    SetOpenDriveVersion(stream_parser.opendrive_version());
+  }
+  FinishStats(options_.stats, ele_map, stream_parser.bytes_consumed());
+  return status;
+}
+
+opendrive::Status Parser::ParseLazyMap(const std::string& xml_file,
+                                       LazyMap::Ptr lazy_map) const {
+  if (!lazy_map) {
+    return Status{ErrorCode::XML_ROOT_ELEMENT_ERROR, "Input is null."};
+  }
+  return lazy_map->Load(xml_file);
+}
+
+opendrive::Status Parser::ParseMap(const std::string& xml_file,
+                                   const element::Boxes& regions,
+                                   LazyMap::Ptr lazy_map) const {
+  auto status = ParseLazyMap(xml_file, lazy_map);
+  if (ErrorCode::OK != status.error_code) {
+    return status;
+  }
+  return lazy_map->LoadRegion(regions);
+}
+
+opendrive::Status Parser::ReloadMap(const std::string& xml_file,
+                                    element::Map::Ptr ele_map,
+                                    parser::MapDiff* diff) const {
+  common::MappedFile mapped_file;
+  if (!mapped_file.Open(xml_file)) {
+    return Status{ErrorCode::XML_ROAD_ELEMENT_ERROR, "Map Xml File Exection."};
+  }
+  mapped_file.Advise(common::MappedFile::Advice::kSequential);
+  return ReloadMap(mapped_file.data(), mapped_file.size(), ele_map, diff);
+}
+
+opendrive::Status Parser::ReloadMap(const char* data, size_t size,
+                                    element::Map::Ptr ele_map,
+                                    parser::MapDiff* diff) const {
+  StatsScope stats_scope(options_.stats, options_.trace);
+  parser::MapDiff local_diff;
+  parser::ReloadXmlParser reload_parser(options_);
+  auto status =
+      reload_parser.Reload(data, size, ele_map, diff ? diff : &local_diff);
+  if (ErrorCode::OK == status.error_code) {
+    SetOpenDriveVersion(reload_parser.opendrive_version());
+  }
+  FinishStats(options_.stats, ele_map, size);
+  return status;
+}
+
+opendrive::Status Parser::ReloadMap(const std::string& xml_file,
+                                    common::Arena* next_arena,
+                                    element::Map::Ptr* ele_map,
+                                    parser::MapDiff* diff) const {
+  common::MappedFile mapped_file;
+  if (!mapped_file.Open(xml_file)) {
+    return Status{ErrorCode::XML_ROAD_ELEMENT_ERROR, "Map Xml File Exection."};
+  }
+  mapped_file.Advise(common::MappedFile::Advice::kSequential);
+  return ReloadMap(mapped_file.data(), mapped_file.size(), next_arena,
+                   ele_map, diff);
+}
+
+opendrive::Status Parser::ReloadMap(const char* data, size_t size,
+                                    common::Arena* next_arena,
+                                    element::Map::Ptr* ele_map,
+                                    parser::MapDiff* diff) const {
+  StatsScope stats_scope(options_.stats, options_.trace);
+  parser::MapDiff local_diff;
+  parser::ReloadXmlParser reload_parser(options_);
+  auto status = reload_parser.Reload(data, size, next_arena, ele_map,
+                                     diff ? diff : &local_diff);
+  if (ErrorCode::OK == status.error_code) {
+    SetOpenDriveVersion(reload_parser.opendrive_version());
+  }
+  FinishStats(options_.stats, ele_map ? *ele_map : nullptr, size);
+  return status;
+}
+
+opendrive::Status Parser::ParseMapStream(
+    const std::string& xml_file, element::Map::Ptr ele_map,
+    const parser::StreamXmlParser::RoadCallback& road_callback) const {
+  StatsScope stats_scope(options_.stats, options_.trace);
+  parser::StreamXmlParser stream_parser(options_);
+  stream_parser.set_road_callback(road_callback);
+  auto status = stream_parser.ParseFile(xml_file, ele_map);
+  if (ErrorCode::OK == status.error_code) {
+    SetOpenDriveVersion(stream_parser.opendrive_version());
+  }
+  FinishStats(options_.stats, ele_map, stream_parser.bytes_consumed());
+  return status;
+}
+
+opendrive::Status Parser::LoadXmlFile(const std::string& xml_file,
+                                      tinyxml2::XMLDocument* xml_doc,
+                                      size_t* bytes) const {
+  ScopedStageTimer timer(ParseStats::Stage::kLoadXml);
+  xml_doc->LoadFile(xml_file.c_str());
+  struct stat file_stat;
+  if ((options_.stats || options_.progress) &&
+      0 == stat(xml_file.c_str(), &file_stat)) {
+    *bytes = static_cast<size_t>(file_stat.st_size);
+  }
+  if (xml_doc->Error()) {
+    return Status{ErrorCode::XML_ROAD_ELEMENT_ERROR,
+                  "Parse Xml File Exection."};
+  }
+  return Status{ErrorCode::OK, "ok"};
 }
 
 }  // namespace opendrive
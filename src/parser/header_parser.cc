@@ -0,0 +1,55 @@
+#include "opendrive-cpp/parser/header_parser.h"
+
+#include "opendrive-cpp/common/parse_stats.h"
+
+namespace opendrive {
+namespace parser {
+
+opendrive::Status HeaderXmlParser::Parse(
+    const tinyxml2::XMLElement* xml_header, element::Header* ele_header) {
+  ScopedStageTimer timer(ParseStats::Stage::kHeader);
+  xml_header_ = xml_header;
+  ele_header_ = ele_header;
+  if (!xml_header_ || !ele_header_) {
+    set_status(ErrorCode::XML_HEADER_ELEMENT_ERROR, "HEADER ELEMENT IS NULL.");
+    return status();
+  }
+  Attributes();
+  return status();
+}
+
+HeaderXmlParser& HeaderXmlParser::Attributes() {
+  if (!IsValid()) return *this;
+  common::XmlQueryStringAttribute(xml_header_, "revMajor",
+                                  ele_header_->mutable_rev_major());
+  common::XmlQueryStringAttribute(xml_header_, "revMinor",
+                                  ele_header_->mutable_rev_minor());
+  common::XmlQueryStringAttribute(xml_header_, "name",
+                                  ele_header_->mutable_name());
+  common::XmlQueryStringAttribute(xml_header_, "version",
+                                  ele_header_->mutable_version());
+  common::XmlQueryStringAttribute(xml_header_, "vendor",
+                                  ele_header_->mutable_vendor());
+  common::XmlQueryStringAttribute(xml_header_, "date",
+                                  ele_header_->mutable_date());
+  double north = ele_header_->north();
+  double south = ele_header_->south();
+  double west = ele_header_->west();
+  double east = ele_header_->east();
+  common::XmlQueryDoubleAttribute(xml_header_, "north", &north);
+  ele_header_->set_north(north);
+  common::XmlQueryDoubleAttribute(xml_header_, "south", &south);
+  ele_header_->set_south(south);
+  common::XmlQueryDoubleAttribute(xml_header_, "west", &west);
+  ele_header_->set_west(west);
+  common::XmlQueryDoubleAttribute(xml_header_, "east", &east);
+  ele_header_->set_east(east);
+  const element::String version = ele_header_->rev_major() + "_" +
+                                  ele_header_->rev_minor() + "_" +
+                                  ele_header_->version();
+  this->set_opendrive_version(std::string(version.data(), version.size()));
+  return *this;
+}
+
+}  // namespace parser
+}  // namespace opendrive
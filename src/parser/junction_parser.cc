@@ -0,0 +1,116 @@
+#include "opendrive-cpp/parser/junction_parser.h"
+
+#include "opendrive-cpp/common/choices.h"
+#include "opendrive-cpp/common/parse_stats.h"
+
+namespace opendrive {
+namespace parser {
+
+JunctionXmlParser::JunctionXmlParser(const std::string& version)
+    : XmlParser(version) {}
+
+opendrive::Status JunctionXmlParser::Parse(
+    const tinyxml2::XMLElement* xml_junction,
+    element::Junction* ele_junction) {
+  ScopedStageTimer timer(ParseStats::Stage::kJunction);
+  xml_junction_ = xml_junction;
+  ele_junction_ = ele_junction;
+  if (!xml_junction_ || !ele_junction_) {
+    set_status(ErrorCode::XML_JUNCTION_ELEMENT_ERROR, "Input is null.");
+    return status();
+  }
+  Attributes().ConnectionElement();
+  ParseStats* stats = ParseStats::Current();
+  if (stats && IsValid()) {
+    stats->CountJunction(*ele_junction_);
+  }
+  return status();
+}
+
+JunctionXmlParser& JunctionXmlParser::Attributes() {
+  if (!IsValid()) return *this;
+  int id = ele_junction_->mutable_attribute()->id();
+  int main_road = ele_junction_->mutable_attribute()->main_road();
+  double s = ele_junction_->mutable_attribute()->start_position();
+  double e = ele_junction_->mutable_attribute()->end_position();
+  common::XmlQueryIntAttribute(xml_junction_, "id", &id);
+  ele_junction_->mutable_attribute()->set_id(id);
+  common::XmlQueryIntAttribute(xml_junction_, "mainRoad", &main_road);
+  ele_junction_->mutable_attribute()->set_main_road(main_road);
+  common::XmlQueryDoubleAttribute(xml_junction_, "sStart", &s);
+  ele_junction_->mutable_attribute()->set_start_position(s);
+  common::XmlQueryDoubleAttribute(xml_junction_, "sEnd", &e);
+  ele_junction_->mutable_attribute()->set_end_position(e);
+  common::XmlQueryStringAttribute(
+      xml_junction_, "name", ele_junction_->mutable_attribute()->mutable_name());
+  common::XmlQueryEnumAttribute(
+      xml_junction_, "orientation",
+      ele_junction_->mutable_attribute()->mutable_dir(), DIR_TABLE);
+  common::XmlQueryEnumAttribute(
+      xml_junction_, "type", ele_junction_->mutable_attribute()->mutable_type(),
+      JUNCTION_TYPE_TABLE);
+  return *this;
+}
+
+JunctionXmlParser& JunctionXmlParser::ConnectionElement() {
+  if (!IsValid()) return *this;
+  // junction connection
+  // 1~*
+  const tinyxml2::XMLElement* curr_xml_connection =
+      xml_junction_->FirstChildElement("connection");
+  if (!curr_xml_connection) {
+    set_status(ErrorCode::XML_JUNCTION_CONNECTION_ELEMENT_ERROR,
+               "JUNCTION CONNECTION ELEMENT IS NULL.");
+    return *this;
+  }
+  // 原地构造, 避免拷贝JunctionConnection
+  auto connections = ele_junction_->mutable_connections();
+  connections->reserve(common::XmlSiblingElementCount(curr_xml_connection));
+  while (curr_xml_connection) {
+    connections->emplace_back();
+    element::JunctionConnection& connection = connections->back();
+    int connection_id = connection.id();
+    int linked_road = connection.linked_road();
+    int incoming_road = connection.incoming_road();
+    int connecting_road = connection.connecting_road();
+    common::XmlQueryIntAttribute(curr_xml_connection, "id", &connection_id);
+    connection.set_id(connection_id);
+    common::XmlQueryEnumAttribute(curr_xml_connection, "type",
+                                  connection.mutable_type(),
+                                  JUNCTION_CONNECTION_TYPE_TABLE);
+    common::XmlQueryIntAttribute(curr_xml_connection, "linkedRoad",
+                                 &linked_road);
+    connection.set_linked_road(linked_road);
+    common::XmlQueryIntAttribute(curr_xml_connection, "incomingRoad",
+                                 &incoming_road);
+    connection.set_incoming_road(incoming_road);
+    common::XmlQueryIntAttribute(curr_xml_connection, "connectingRoad",
+                                 &connecting_road);
+    connection.set_connecting_road(connecting_road);
+    common::XmlQueryEnumAttribute(curr_xml_connection, "contactPoint",
+                                  connection.mutable_contact_point(),
+                                  CONTACT_POINT_TYPE_TABLE);
+    // connection link
+    // 0~*
+    const tinyxml2::XMLElement* curr_xml_laneLink =
+        curr_xml_connection->FirstChildElement("laneLink");
+    connection.mutable_lane_links()->reserve(
+        common::XmlSiblingElementCount(curr_xml_laneLink));
+    while (curr_xml_laneLink) {
+      element::JunctionLaneLink lane_link;
+      int from = lane_link.from();
+      int to = lane_link.to();
+      common::XmlQueryIntAttribute(curr_xml_laneLink, "from", &from);
+      lane_link.set_from(from);
+      common::XmlQueryIntAttribute(curr_xml_laneLink, "to", &to);
+      lane_link.set_to(to);
+      connection.mutable_lane_links()->emplace_back(lane_link);
+      curr_xml_laneLink = common::XmlNextSiblingElement(curr_xml_laneLink);
+    }
+    curr_xml_connection = common::XmlNextSiblingElement(curr_xml_connection);
+  }
+  return *this;
+}
+
+}  // namespace parser
+}  // namespace opendrive
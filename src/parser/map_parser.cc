@@ -1,17 +1,32 @@
 #include "opendrive-cpp/parser/map_parser.h"
 
+#include "opendrive-cpp/common/parse_stats.h"
+#include "opendrive-cpp/common/trace.h"
+
 namespace opendrive {
 namespace parser {
 
+MapXmlParser::MapXmlParser(const ParseOptions& options) : options_(options) {}
+
 opendrive::Status MapXmlParser::Parse(const tinyxml2::XMLElement* xml_map,
                                       element::Map::Ptr ele_map) {
+  OPENDRIVE_TRACE_SCOPE("MapXmlParser::Parse");
+  /// 同一个实例可以重复调用 Parse
+  set_status(ErrorCode::OK, "ok");
+  set_opendrive_version("");
   xml_map_ = xml_map;
   ele_map_ = ele_map;
   if (!xml_map_ || !ele_map_) {
     set_status(ErrorCode::XML_ROAD_ELEMENT_ERROR, "Input is null.");
     return status();
   }
+  if (1 != options_.thread_num) {
+    thread_pool_.reset(new common::ThreadPool(options_.thread_num));
+  }
+  /// 新建的元素与地图分配在同一个 arena 中, 工作线程各自设置
+  common::ScopedArena scope(ele_map_->arena());
   HeaderElement().JunctionElement().RoadElement();
+  thread_pool_.reset();
   return status();
 }
 
@@ -20,123 +35,50 @@ MapXmlParser& MapXmlParser::HeaderElement() {
   // eq 1
   const tinyxml2::XMLElement* xml_header =
       xml_map_->FirstChildElement("header");
-  if (!xml_header) {
-    set_status(ErrorCode::XML_HEADER_ELEMENT_ERROR, "HEADER ELEMENT IS NULL.");
+  HeaderXmlParser header_parser;
+  if (!CheckStatus(
+          header_parser.Parse(xml_header, ele_map_->mutable_header()))) {
     return *this;
   }
-  common::XmlQueryStringAttribute(
-      xml_header, "revMajor", ele_map_->mutable_header()->mutable_rev_major());
-  common::XmlQueryStringAttribute(
-      xml_header, "revMinor", ele_map_->mutable_header()->mutable_rev_minor());
-  common::XmlQueryStringAttribute(xml_header, "name",
-                                  ele_map_->mutable_header()->mutable_name());
-  common::XmlQueryStringAttribute(
-      xml_header, "version", ele_map_->mutable_header()->mutable_version());
-  common::XmlQueryStringAttribute(xml_header, "vendor",
-                                  ele_map_->mutable_header()->mutable_vendor());
-  common::XmlQueryStringAttribute(xml_header, "date",
-                                  ele_map_->mutable_header()->mutable_date());
-  double north = ele_map_->mutable_header()->north();
-  double south = ele_map_->mutable_header()->south();
-  double west = ele_map_->mutable_header()->west();
-  double east = ele_map_->mutable_header()->east();
-  common::XmlQueryDoubleAttribute(xml_header, "north", &north);
-  ele_map_->mutable_header()->set_north(north);
-  common::XmlQueryDoubleAttribute(xml_header, "south", &south);
-  ele_map_->mutable_header()->set_south(south);
-  common::XmlQueryDoubleAttribute(xml_header, "west", &west);
-  ele_map_->mutable_header()->set_west(west);
-  common::XmlQueryDoubleAttribute(xml_header, "east", &east);
-  ele_map_->mutable_header()->set_east(east);
-  this->set_opendrive_version(ele_map_->header().rev_major() + "_" +
-                              ele_map_->header().rev_minor() + "_" +
-                              ele_map_->header().version());
+  this->set_opendrive_version(header_parser.opendrive_version());
   return *this;
 }
 
 MapXmlParser& MapXmlParser::JunctionElement() {
   if (!IsValid()) return *this;
   // 0~*
+  std::vector<const tinyxml2::XMLElement*> xml_junctions;
   const tinyxml2::XMLElement* curr_xml_junction =
       xml_map_->FirstChildElement("junction");
-  Status status{ErrorCode::OK, "ok"};
   while (curr_xml_junction) {
-    element::Junction ele_junction;
-    int id = ele_junction.mutable_attribute()->id();
-    int main_road = ele_junction.mutable_attribute()->main_road();
-    double s = ele_junction.mutable_attribute()->start_position();
-    double e = ele_junction.mutable_attribute()->end_position();
-    common::XmlQueryIntAttribute(curr_xml_junction, "id", &id);
-    ele_junction.mutable_attribute()->set_id(id);
-    common::XmlQueryIntAttribute(curr_xml_junction, "mainRoad", &main_road);
-    ele_junction.mutable_attribute()->set_main_road(main_road);
-    common::XmlQueryDoubleAttribute(curr_xml_junction, "sStart", &s);
-    ele_junction.mutable_attribute()->set_start_position(s);
-    common::XmlQueryDoubleAttribute(curr_xml_junction, "sEnd", &e);
-    ele_junction.mutable_attribute()->set_end_position(e);
-    common::XmlQueryStringAttribute(
-        curr_xml_junction, "name",
-        ele_junction.mutable_attribute()->mutable_name());
-    common::XmlQueryEnumAttribute(
-        curr_xml_junction, "orientation",
-        ele_junction.mutable_attribute()->mutable_dir(), DIR_CHOICES);
-    common::XmlQueryEnumAttribute(
-        curr_xml_junction, "type",
-        ele_junction.mutable_attribute()->mutable_type(),
-        JUNCTION_TYPE_CHOICES);
-    // junction connection
-    // 1~*
-    const tinyxml2::XMLElement* curr_xml_connection =
-        curr_xml_junction->FirstChildElement("connection");
-    if (!curr_xml_connection) {
-      set_status(ErrorCode::XML_JUNCTION_CONNECTION_ELEMENT_ERROR,
-                 "JUNCTION CONNECTION ELEMENT IS NULL.");
-      return *this;
-    }
-    while (curr_xml_connection) {
-      element::JunctionConnection connection;
-      int connection_id = connection.id();
-      int linked_road = connection.linked_road();
-      int incoming_road = connection.incoming_road();
-      int connecting_road = connection.connecting_road();
-      common::XmlQueryIntAttribute(curr_xml_connection, "id", &connection_id);
-      connection.set_id(connection_id);
-      common::XmlQueryEnumAttribute(curr_xml_connection, "type",
-                                    connection.mutable_type(),
-                                    JUNCTION_CONNECTION_TYPE_CHOICES);
-      common::XmlQueryIntAttribute(curr_xml_connection, "linkedRoad",
-                                   &linked_road);
-      connection.set_linked_road(linked_road);
-      common::XmlQueryIntAttribute(curr_xml_connection, "incomingRoad",
-                                   &incoming_road);
-      connection.set_incoming_road(incoming_road);
-      common::XmlQueryIntAttribute(curr_xml_connection, "connectingRoad",
-                                   &connecting_road);
-      connection.set_connecting_road(connecting_road);
-      common::XmlQueryEnumAttribute(curr_xml_connection, "contactPoint",
-                                    connection.mutable_contact_point(),
-                                    CONTACT_POINT_TYPE_CHOICES);
-      // connection link
-      // 0~*
-      const tinyxml2::XMLElement* curr_xml_laneLink =
-          curr_xml_connection->FirstChildElement("laneLink");
-      while (curr_xml_laneLink) {
-        element::JunctionLaneLink lane_link;
-        int from = lane_link.from();
-        int to = lane_link.to();
-        common::XmlQueryIntAttribute(curr_xml_laneLink, "from", &from);
-        lane_link.set_from(from);
-        common::XmlQueryIntAttribute(curr_xml_laneLink, "to", &to);
-        lane_link.set_to(to);
-        connection.mutable_lane_links()->emplace_back(lane_link);
-        curr_xml_laneLink = common::XmlNextSiblingElement(curr_xml_laneLink);
+    xml_junctions.emplace_back(curr_xml_junction);
+    curr_xml_junction = common::XmlNextSiblingElement(curr_xml_junction);
+  }
+  const size_t offset = ele_map_->junctions().size();
+  ele_map_->mutable_junctions()->resize(offset + xml_junctions.size());
+  std::vector<Status> statuses(xml_junctions.size());
+  ParseStats* stats = ParseStats::Current();
+  common::TraceSink* trace = common::TraceSink::Current();
+  auto parse_range = [&](size_t begin, size_t end) {
+    common::ScopedArena scope(ele_map_->arena());
+    ScopedParseStats stats_scope(stats);
+    OPENDRIVE_TRACE_SINK_SCOPE(trace);
+    JunctionXmlParser junction_parser{this->opendrive_version()};
+    for (size_t i = begin; i < end; i++) {
+      if (Cancelled()) {
+        statuses.at(i) = Status{ErrorCode::PARSE_CANCELLED, "Cancelled."};
+        return;
       }
-      ele_junction.mutable_connections()->emplace_back(connection);
-      curr_xml_connection = common::XmlNextSiblingElement(curr_xml_connection);
+      statuses.at(i) = junction_parser.Parse(
+          xml_junctions.at(i), &ele_map_->mutable_junctions()->at(offset + i));
     }
-    ele_map_->mutable_junctions()->emplace_back(ele_junction);
-    curr_xml_junction = common::XmlNextSiblingElement(curr_xml_junction);
+  };
+  if (thread_pool_) {
+    thread_pool_->ParallelFor(xml_junctions.size(), parse_range);
+  } else {
+    parse_range(0, xml_junctions.size());
   }
+  CheckStatuses(statuses);
   return *this;
 }
 
@@ -149,17 +91,70 @@ MapXmlParser& MapXmlParser::RoadElement() {
     set_status(ErrorCode::XML_ROAD_ELEMENT_ERROR, "ROAD ELEMENT IS NULL.");
     return *this;
   }
-  RoadXmlParser road_parser{this->opendrive_version()};
-  Status status{ErrorCode::OK, "ok"};
+  std::vector<const tinyxml2::XMLElement*> xml_roads;
   while (curr_xml_road) {
-    element::Road ele_road;
-    status = road_parser.Parse(curr_xml_road, &ele_road);
-    CheckStatus(status);
-    ele_map_->mutable_roads()->emplace_back(ele_road);
+    xml_roads.emplace_back(curr_xml_road);
     curr_xml_road = common::XmlNextSiblingElement(curr_xml_road);
   }
+  const size_t offset = ele_map_->roads().size();
+  ele_map_->mutable_roads()->resize(offset + xml_roads.size());
+  roads_total_ = xml_roads.size();
+  roads_parsed_ = 0;
+  roads_reported_ = 0;
+  if (options_.progress) {
+    options_.progress(
+        ParseProgress{0, roads_total_, input_bytes_, input_bytes_});
+  }
+  std::vector<Status> statuses(xml_roads.size());
+  ParseStats* stats = ParseStats::Current();
+  common::TraceSink* trace = common::TraceSink::Current();
+  auto parse_range = [&](size_t begin, size_t end) {
+    common::ScopedArena scope(ele_map_->arena());
+    ScopedParseStats stats_scope(stats);
+    OPENDRIVE_TRACE_SINK_SCOPE(trace);
+    RoadXmlParser road_parser{this->opendrive_version()};
+    road_parser.set_lane_boundary_tables(options_.lane_boundary_tables);
+    for (size_t i = begin; i < end; i++) {
+      if (Cancelled()) {
+        statuses.at(i) = Status{ErrorCode::PARSE_CANCELLED, "Cancelled."};
+        return;
+      }
+      statuses.at(i) = road_parser.Parse(
+          xml_roads.at(i), &ele_map_->mutable_roads()->at(offset + i));
+      ReportRoad();
+    }
+  };
+  if (thread_pool_) {
+    thread_pool_->ParallelFor(xml_roads.size(), parse_range);
+  } else {
+    parse_range(0, xml_roads.size());
+  }
+  CheckStatuses(statuses);
   return *this;
 }
 
+void MapXmlParser::ReportRoad() {
+  if (!options_.progress) return;
+  const size_t done =
+      roads_parsed_.fetch_add(1, std::memory_order_relaxed) + 1;
+  /// 按百分比节流, road 较少时每条都报告
+  if (done != roads_total_ &&
+      done * 100 / roads_total_ == (done - 1) * 100 / roads_total_) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(progress_mutex_);
+  if (done <= roads_reported_) return;
+  roads_reported_ = done;
+  options_.progress(
+      ParseProgress{done, roads_total_, input_bytes_, input_bytes_});
+}
+
+bool MapXmlParser::CheckStatuses(const std::vector<Status>& statuses) {
+  for (const auto& status : statuses) {
+    if (!CheckStatus(status)) return false;
+  }
+  return true;
+}
+
 }  // namespace parser
 }  // namespace opendrive
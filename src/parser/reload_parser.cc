@@ -0,0 +1,368 @@
+#include "opendrive-cpp/parser/reload_parser.h"
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "opendrive-cpp/common/hash.h"
+#include "opendrive-cpp/parser/junction_parser.h"
+#include "opendrive-cpp/parser/road_parser.h"
+#include "opendrive-cpp/parser/stream_parser.h"
+#include "opendrive-cpp/snapshot/snapshot.h"
+
+namespace opendrive {
+namespace parser {
+
+namespace {
+
+constexpr size_t kNone = static_cast<size_t>(-1);
+
+/// 片段起始标签的长度, 属性值中可能出现 '>'
+size_t StartTagSize(const char* data, size_t size) {
+  char quote = 0;
+  for (size_t i = 0; i < size; i++) {
+    const char ch = data[i];
+    if (quote) {
+      if (ch == quote) quote = 0;
+    } else if ('"' == ch || '\'' == ch) {
+      quote = ch;
+    } else if ('>' == ch) {
+      return i + 1;
+    }
+  }
+  return size;
+}
+
+/// 只解析起始标签, 读取 id 属性
+bool QueryFragmentId(const char* data, size_t size, const char* name,
+                     tinyxml2::XMLDocument* doc, element::Id* id) {
+  const size_t tag_size = StartTagSize(data, size);
+  std::string tag(data, tag_size);
+  if (tag_size < 2 || '/' != data[tag_size - 2]) {
+    tag.append("</").append(name).append(">");
+  }
+  doc->Parse(tag.data(), tag.size());
+  if (doc->Error() || !doc->RootElement()) return false;
+  int value = -1;
+  common::XmlQueryIntAttribute(doc->RootElement(), "id", &value);
+  *id = value;
+  return true;
+}
+
+bool SameVersion(const element::Header& a, const element::Header& b) {
+  return a.rev_major() == b.rev_major() && a.rev_minor() == b.rev_minor() &&
+         a.version() == b.version();
+}
+
+bool SameContent(const element::Road& a, const element::Road& b) {
+  std::string lhs, rhs;
+  snapshot::SerializeRoad(a, &lhs);
+  snapshot::SerializeRoad(b, &rhs);
+  return lhs == rhs;
+}
+
+bool SameContent(const element::Junction& a, const element::Junction& b) {
+  std::string lhs, rhs;
+  snapshot::SerializeJunction(a, &lhs);
+  snapshot::SerializeJunction(b, &rhs);
+  return lhs == rhs;
+}
+
+/// 在当前线程的 arena 中复制 geometry
+element::Geometry::Ptr CloneGeometry(const element::Geometry& geometry) {
+  switch (geometry.type()) {
+    case GeometryType::kArc:
+      return element::AllocateGeometry<element::GeometryArc>(
+          static_cast<const element::GeometryArc&>(geometry));
+    case GeometryType::kSpiral:
+      return element::AllocateGeometry<element::GeometrySpiral>(
+          static_cast<const element::GeometrySpiral&>(geometry));
+    case GeometryType::kPoly3:
+      return element::AllocateGeometry<element::GeometryPoly3>(
+          static_cast<const element::GeometryPoly3&>(geometry));
+    case GeometryType::kParamPoly3:
+      return element::AllocateGeometry<element::GeometryParamPoly3>(
+          static_cast<const element::GeometryParamPoly3&>(geometry));
+    default:
+      return element::AllocateGeometry<element::GeometryLine>(
+          static_cast<const element::GeometryLine&>(geometry));
+  }
+}
+
+/// 在当前线程的 arena 中复制元素, 不与原元素共享内存
+void CopyElement(const element::Road& from,
+                 element::Vector<element::Road>* to) {
+  to->emplace_back(from);
+  for (auto& geometry :
+       *to->back().mutable_plan_view()->mutable_geometrys()) {
+    geometry = CloneGeometry(*geometry);
+  }
+}
+
+void CopyElement(const element::Junction& from,
+                 element::Vector<element::Junction>* to) {
+  to->emplace_back(from);
+}
+
+/**
+ * @brief 按 id 把新文档的片段与旧 Map 中的元素对应起来
+ *
+ * 复用的旧元素被移入新 Map, 失败时 Rollback 移回; 两个 Map 不在同一个
+ * arena 时复制, 旧 Map 保持不变.
+ */
+template <typename T>
+class Reconciler {
+ public:
+  using ParseFunc = std::function<opendrive::Status(T*)>;
+  Reconciler(element::Vector<T>* old_elements, element::Vector<T>* elements)
+      : old_elements_(old_elements),
+        elements_(elements),
+        copy_(old_elements->get_allocator() != elements->get_allocator()),
+        taken_(old_elements->size(), false) {
+    index_.reserve(old_elements_->size());
+    for (size_t i = 0; i < old_elements_->size(); i++) {
+      index_.emplace((*old_elements_)[i].attribute().id(), i);
+    }
+  }
+
+  /**
+   * @brief 处理一个片段
+   *
+   * @param reusable false: 即使指纹相同也重新解析
+   * @param parse 把片段解析到新追加的元素
+   */
+  opendrive::Status Apply(const char* data, size_t size, element::Id id,
+                          bool reusable, const ParseFunc& parse,
+                          element::Ids* added, element::Ids* modified,
+                          size_t* reused) {
+    const uint64_t fingerprint = common::Fingerprint(data, size);
+    size_t old_index = kNone;
+    auto it = index_.find(id);
+    if (index_.end() != it && !taken_[it->second]) {
+      old_index = it->second;
+      taken_[old_index] = true;
+    }
+    if (kNone != old_index && reusable &&
+        fingerprint == (*old_elements_)[old_index].fingerprint()) {
+      if (copy_) {
+        CopyElement((*old_elements_)[old_index], elements_);
+      } else {
+        moved_.emplace_back(old_index, elements_->size());
+        elements_->emplace_back(std::move((*old_elements_)[old_index]));
+      }
+      (*reused)++;
+      return Status{ErrorCode::OK, "ok"};
+    }
+    elements_->emplace_back();
+    T* element = &elements_->back();
+    element->set_fingerprint(fingerprint);
+    auto status = parse(element);
+    if (ErrorCode::OK != status.error_code) {
+      return status;
+    }
+    if (kNone == old_index) {
+      added->emplace_back(id);
+    } else {
+      const T& old_element = (*old_elements_)[old_index];
+      /// 指纹可信时不同即修改, 否则比较内容
+      if ((reusable && 0 != old_element.fingerprint()) ||
+          !SameContent(old_element, *element)) {
+        modified->emplace_back(id);
+      }
+    }
+    return status;
+  }
+
+  void CollectRemoved(element::Ids* removed) const {
+    for (size_t i = 0; i < taken_.size(); i++) {
+      if (!taken_[i]) {
+        removed->emplace_back((*old_elements_)[i].attribute().id());
+      }
+    }
+  }
+
+  void Rollback() {
+    for (const auto& move : moved_) {
+      (*old_elements_)[move.first] = std::move((*elements_)[move.second]);
+    }
+    moved_.clear();
+  }
+
+ private:
+  element::Vector<T>* old_elements_;
+  element::Vector<T>* elements_;
+  bool copy_;
+  std::unordered_map<element::Id, size_t> index_;
+  std::vector<bool> taken_;
+  /// (旧下标, 新下标)
+  std::vector<std::pair<size_t, size_t>> moved_;
+};
+
+}  // namespace
+
+bool MapDiff::empty() const noexcept {
+  return !header_changed && added_roads.empty() && removed_roads.empty() &&
+         modified_roads.empty() && added_junctions.empty() &&
+         removed_junctions.empty() && modified_junctions.empty();
+}
+
+void MapDiff::Clear() {
+  header_changed = false;
+  added_roads.clear();
+  removed_roads.clear();
+  modified_roads.clear();
+  added_junctions.clear();
+  removed_junctions.clear();
+  modified_junctions.clear();
+  reused_roads = 0;
+  reused_junctions = 0;
+}
+
+ReloadXmlParser::ReloadXmlParser(const ParseOptions& options)
+    : options_(options) {}
+
+opendrive::Status ReloadXmlParser::Reload(const char* data, size_t size,
+                                          element::Map::Ptr ele_map,
+                                          MapDiff* diff) {
+  set_status(ErrorCode::OK, "ok");
+  if (!data || !ele_map || !diff) {
+    set_status(ErrorCode::XML_ROOT_ELEMENT_ERROR, "Input is null.");
+    return status();
+  }
+  if (ele_map->arena()) {
+    set_status(ErrorCode::INVALID_ARGUMENT,
+               "Arena map requires a next arena to reload.");
+    return status();
+  }
+  auto next_map = element::Map::Create(nullptr);
+  if (ErrorCode::OK ==
+      Build(data, size, ele_map.get(), next_map, diff).error_code) {
+    *ele_map = std::move(*next_map);
+  }
+  return status();
+}
+
+opendrive::Status ReloadXmlParser::Reload(const char* data, size_t size,
+                                          common::Arena* next_arena,
+                                          element::Map::Ptr* ele_map,
+                                          MapDiff* diff) {
+  set_status(ErrorCode::OK, "ok");
+  if (!data || !ele_map || !*ele_map || !diff) {
+    set_status(ErrorCode::XML_ROOT_ELEMENT_ERROR, "Input is null.");
+    return status();
+  }
+  if (next_arena && next_arena == (*ele_map)->arena()) {
+    set_status(ErrorCode::INVALID_ARGUMENT,
+               "Next arena must differ from the map arena.");
+    return status();
+  }
+  auto next_map = element::Map::Create(next_arena);
+  if (ErrorCode::OK ==
+      Build(data, size, ele_map->get(), next_map, diff).error_code) {
+    *ele_map = std::move(next_map);
+  }
+  return status();
+}
+
+void ReloadXmlParser::SyncBoundaryTables(element::Road* road) const {
+  auto* sections = road->mutable_lanes()->mutable_lane_sections();
+  if (!options_.lane_boundary_tables) {
+    for (auto& section : *sections) {
+      section.ClearBoundaryTable();
+    }
+    return;
+  }
+  for (const auto& section : *sections) {
+    if (section.boundary_table().empty()) {
+      road->BuildLaneBoundaryTables();
+      return;
+    }
+  }
+}
+
+opendrive::Status ReloadXmlParser::Build(const char* data, size_t size,
+                                         element::Map* old_map,
+                                         element::Map::Ptr next_map,
+                                         MapDiff* diff) {
+  diff->Clear();
+  common::ScopedArena scope(next_map->arena());
+  Reconciler<element::Road> roads(old_map->mutable_roads(),
+                                  next_map->mutable_roads());
+  Reconciler<element::Junction> junctions(old_map->mutable_junctions(),
+                                          next_map->mutable_junctions());
+  StreamXmlParser stream_parser(options_);
+  tinyxml2::XMLDocument doc;
+  /// 片段之前必须已经出现 <header>, 否则版本未知, 不复用
+  auto reusable = [&]() {
+    return !stream_parser.opendrive_version().empty() &&
+           SameVersion(old_map->header(), next_map->header());
+  };
+  stream_parser.set_road_fragment_callback(
+      [&](const char* fragment, size_t fragment_size, size_t) {
+        element::Id id = -1;
+        if (!QueryFragmentId(fragment, fragment_size, "road", &doc, &id)) {
+          return Status{ErrorCode::XML_ROAD_ELEMENT_ERROR,
+                        "Parse <road> Element Exception."};
+        }
+        return roads.Apply(
+            fragment, fragment_size, id, reusable(),
+            [&](element::Road* road) {
+              doc.Parse(fragment, fragment_size);
+              if (doc.Error()) {
+                return Status{ErrorCode::XML_ROAD_ELEMENT_ERROR,
+                              "Parse <road> Element Exception."};
+              }
+              RoadXmlParser road_parser{stream_parser.opendrive_version()};
+              road_parser.set_lane_boundary_tables(
+                  options_.lane_boundary_tables);
+              return road_parser.Parse(doc.RootElement(), road);
+            },
+            &diff->added_roads, &diff->modified_roads, &diff->reused_roads);
+      });
+  stream_parser.set_junction_fragment_callback(
+      [&](const char* fragment, size_t fragment_size) {
+        element::Id id = -1;
+        if (!QueryFragmentId(fragment, fragment_size, "junction", &doc,
+                             &id)) {
+          return Status{ErrorCode::XML_JUNCTION_ELEMENT_ERROR,
+                        "Parse <junction> Element Exception."};
+        }
+        return junctions.Apply(
+            fragment, fragment_size, id, reusable(),
+            [&](element::Junction* junction) {
+              doc.Parse(fragment, fragment_size);
+              if (doc.Error()) {
+                return Status{ErrorCode::XML_JUNCTION_ELEMENT_ERROR,
+                              "Parse <junction> Element Exception."};
+              }
+              JunctionXmlParser junction_parser{
+                  stream_parser.opendrive_version()};
+              return junction_parser.Parse(doc.RootElement(), junction);
+            },
+            &diff->added_junctions, &diff->modified_junctions,
+            &diff->reused_junctions);
+      });
+  if (!CheckStatus(stream_parser.Parse(data, size, next_map))) {
+    roads.Rollback();
+    junctions.Rollback();
+    diff->Clear();
+    return status();
+  }
+  /// 复用的 road 保留旧的车道边界表, 成功后再与 options_ 对齐
+  for (auto& road : *next_map->mutable_roads()) {
+    SyncBoundaryTables(&road);
+  }
+  roads.CollectRemoved(&diff->removed_roads);
+  junctions.CollectRemoved(&diff->removed_junctions);
+  std::string old_header, new_header;
+  snapshot::SerializeHeader(old_map->header(), &old_header);
+  snapshot::SerializeHeader(next_map->header(), &new_header);
+  diff->header_changed = old_header != new_header;
+  set_opendrive_version(stream_parser.opendrive_version());
+  return status();
+}
+
+}  // namespace parser
+}  // namespace opendrive
@@ -3,15 +3,41 @@
 #include <unordered_map>
 
 #include "opendrive-cpp/common/choices.h"
+#include "opendrive-cpp/common/parse_stats.h"
+#include "opendrive-cpp/common/trace.h"
 #include "opendrive-cpp/geometry/enums.h"
 
 namespace opendrive {
 namespace parser {
 
+namespace {
+
+constexpr Choice<element::GeometryParamPoly3::PRange> kPRangeChoices[] = {
+    {"arclength", element::GeometryParamPoly3::PRange::ARCLENGTH},
+    {"normalized", element::GeometryParamPoly3::PRange::NORMALIZED},
+};
+static_assert(IsSortedChoices(kPRangeChoices),
+              "kPRangeChoices must be sorted");
+const ChoiceTable<element::GeometryParamPoly3::PRange> P_RANGE_TABLE(
+    kPRangeChoices);
+
+#ifdef OPENDRIVE_CPP_WITH_TRACE
+/// trace 事件的 args.id, 此时属性尚未解析
+int64_t TraceRoadId(const tinyxml2::XMLElement* xml_road) {
+  int id = -1;
+  if (xml_road) common::XmlQueryIntAttribute(xml_road, "id", &id);
+  return id;
+}
+#endif
+
+}  // namespace
+
 RoadXmlParser::RoadXmlParser(const std::string& version) : XmlParser(version) {}
 
 opendrive::Status RoadXmlParser::Parse(const tinyxml2::XMLElement* xml_road,
                                        element::Road* ele_road) {
+  ScopedStageTimer timer(ParseStats::Stage::kRoad);
+  OPENDRIVE_TRACE_SCOPE("RoadXmlParser::Parse", TraceRoadId(xml_road));
   xml_road_ = xml_road;
   ele_road_ = ele_road;
   if (!xml_road_ || !ele_road_) {
@@ -23,7 +49,36 @@ opendrive::Status RoadXmlParser::Parse(const tinyxml2::XMLElement* xml_road,
       .TypeElement()
       .PlanViewElement()
       .LanesElement()
-      .GenerateRoad();
+      .GenerateRoad()
+      .BoundaryTables();
+  ParseStats* stats = ParseStats::Current();
+  if (stats && IsValid()) {
+    stats->CountRoad(*ele_road_);
+  }
+  return status();
+}
+
+opendrive::Status RoadXmlParser::ParseHead(
+    const tinyxml2::XMLElement* xml_road, element::Road* ele_road) {
+  xml_road_ = xml_road;
+  ele_road_ = ele_road;
+  if (!xml_road_ || !ele_road_) {
+    set_status(ErrorCode::XML_ROAD_ELEMENT_ERROR, "Input is null.");
+    return status();
+  }
+  Attributes().LinkElement().TypeElement();
+  return status();
+}
+
+opendrive::Status RoadXmlParser::ParseBody(
+    const tinyxml2::XMLElement* xml_road, element::Road* ele_road) {
+  xml_road_ = xml_road;
+  ele_road_ = ele_road;
+  if (!xml_road_ || !ele_road_) {
+    set_status(ErrorCode::XML_ROAD_ELEMENT_ERROR, "Input is null.");
+    return status();
+  }
+  PlanViewElement().LanesElement().GenerateRoad().BoundaryTables();
   return status();
 }
 
@@ -37,7 +92,7 @@ RoadXmlParser& RoadXmlParser::Attributes() {
       xml_road_, "name", ele_road_->mutable_attribute()->mutable_name());
   common::XmlQueryEnumAttribute(xml_road_, "rule",
                                 ele_road_->mutable_attribute()->mutable_rule(),
-                                ROAD_RULE_CHOICES);
+                                ROAD_RULE_TABLE);
   common::XmlQueryDoubleAttribute(xml_road_, "length", &length);
   ele_road_->mutable_attribute()->set_length(length);
   common::XmlQueryIntAttribute(xml_road_, "id", &id);
@@ -53,7 +108,7 @@ RoadXmlParser& RoadXmlParser::LinkElement() {
   if (!xml_link) {
     return *this;
   }
-  std::vector<std::string> xml_link_ments{"predecessor", "successor"};
+  const std::string xml_link_ments[] = {"predecessor", "successor"};
   for (const auto& xml_link_ment : xml_link_ments) {
     const tinyxml2::XMLElement* link_type_ele =
         xml_link->FirstChildElement(xml_link_ment.c_str());
@@ -69,16 +124,16 @@ RoadXmlParser& RoadXmlParser::LinkElement() {
         common::XmlQueryEnumAttribute(
             link_type_ele, "elementType",
             ele_road_->mutable_link()->mutable_predecessor()->mutable_type(),
-            ROAD_LINK_TYPE_CHOICES);
+            ROAD_LINK_TYPE_TABLE);
         common::XmlQueryEnumAttribute(link_type_ele, "contactPoint",
                                       ele_road_->mutable_link()
                                           ->mutable_predecessor()
                                           ->mutable_contact_point(),
-                                      CONTACT_POINT_TYPE_CHOICES);
+                                      CONTACT_POINT_TYPE_TABLE);
         common::XmlQueryEnumAttribute(
             link_type_ele, "elementDir",
             ele_road_->mutable_link()->mutable_predecessor()->mutable_dir(),
-            DIR_CHOICES);
+            DIR_TABLE);
       } else if ("successor" == xml_link_ment) {
         int id = ele_road_->mutable_link()->mutable_successor()->id();
         double s =
@@ -90,16 +145,16 @@ RoadXmlParser& RoadXmlParser::LinkElement() {
         common::XmlQueryEnumAttribute(
             link_type_ele, "elementType",
             ele_road_->mutable_link()->mutable_successor()->mutable_type(),
-            ROAD_LINK_TYPE_CHOICES);
+            ROAD_LINK_TYPE_TABLE);
         common::XmlQueryEnumAttribute(link_type_ele, "contactPoint",
                                       ele_road_->mutable_link()
                                           ->mutable_successor()
                                           ->mutable_contact_point(),
-                                      CONTACT_POINT_TYPE_CHOICES);
+                                      CONTACT_POINT_TYPE_TABLE);
         common::XmlQueryEnumAttribute(
             link_type_ele, "elementDir",
             ele_road_->mutable_link()->mutable_successor()->mutable_dir(),
-            DIR_CHOICES);
+            DIR_TABLE);
       }
     }
   }
@@ -111,13 +166,15 @@ RoadXmlParser& RoadXmlParser::TypeElement() {
   // 0~*
   const tinyxml2::XMLElement* curr_xml_type =
       xml_road_->FirstChildElement("type");
+  ele_road_->mutable_type_info()->reserve(
+      common::XmlSiblingElementCount(curr_xml_type));
   while (curr_xml_type) {
     element::RoadTypeInfo ele_road_type;
     double s = ele_road_type.start_position();
     common::XmlQueryDoubleAttribute(curr_xml_type, "s", &s);
     ele_road_type.set_start_position(s);
     common::XmlQueryEnumAttribute(
-        curr_xml_type, "type", ele_road_type.mutable_type(), ROAD_TYPE_CHOICES);
+        curr_xml_type, "type", ele_road_type.mutable_type(), ROAD_TYPE_TABLE);
     common::XmlQueryStringAttribute(curr_xml_type, "country",
                                     ele_road_type.mutable_country());
     const tinyxml2::XMLElement* speed_ele =
@@ -128,9 +185,9 @@ RoadXmlParser& RoadXmlParser::TypeElement() {
       ele_road_type.set_max_speed(max_speed);
       common::XmlQueryEnumAttribute(speed_ele, "unit",
                                     ele_road_type.mutable_speed_unit(),
-                                    SPEEDUNIT_CHOICES);
+                                    SPEEDUNIT_TABLE);
     }
-    ele_road_->mutable_type_info()->emplace_back(ele_road_type);
+    ele_road_->mutable_type_info()->emplace_back(std::move(ele_road_type));
     curr_xml_type = common::XmlNextSiblingElement(curr_xml_type);
   }
   return *this;
@@ -138,6 +195,7 @@ RoadXmlParser& RoadXmlParser::TypeElement() {
 
 RoadXmlParser& RoadXmlParser::PlanViewElement() {
   if (!IsValid()) return *this;
+  ScopedStageTimer timer(ParseStats::Stage::kPlanView);
   /// eq 1
   const tinyxml2::XMLElement* xml_planview =
       xml_road_->FirstChildElement("planView");
@@ -171,6 +229,8 @@ RoadXmlParser& RoadXmlParser::PlanViewElement() {
       element::GeometryParamPoly3::PRange::UNKNOWN;
   const tinyxml2::XMLElement* curr_ele_geometry =
       xml_planview->FirstChildElement("geometry");
+  ele_road_->mutable_plan_view()->mutable_geometrys()->reserve(
+      common::XmlSiblingElementCount(curr_ele_geometry));
   while (curr_ele_geometry) {
     element::Geometry::Ptr geometry_base_ptr;
     s = 0.;
@@ -189,8 +249,8 @@ RoadXmlParser& RoadXmlParser::PlanViewElement() {
         curr_ele_geometry->FirstChildElement("line");
     if (ele_geometry_type) {
       std::shared_ptr<element::GeometryLine> geometry_ptr =
-          std::make_shared<element::GeometryLine>(s, x, y, hdg, length,
-                                                  GeometryType::kLine);
+          element::AllocateGeometry<element::GeometryLine>(
+              s, x, y, hdg, length, GeometryType::kLine);
       geometry_base_ptr =
           std::dynamic_pointer_cast<element::Geometry>(geometry_ptr);
     }
@@ -200,8 +260,8 @@ RoadXmlParser& RoadXmlParser::PlanViewElement() {
       common::XmlQueryDoubleAttribute(ele_geometry_type, "curvature",
                                       &curvature);
       std::shared_ptr<element::GeometryArc> geometry_ptr =
-          std::make_shared<element::GeometryArc>(s, x, y, hdg, length,
-                                                 GeometryType::kArc, curvature);
+          element::AllocateGeometry<element::GeometryArc>(
+              s, x, y, hdg, length, GeometryType::kArc, curvature);
       geometry_base_ptr =
           std::dynamic_pointer_cast<element::Geometry>(geometry_ptr);
     }
@@ -213,9 +273,9 @@ RoadXmlParser& RoadXmlParser::PlanViewElement() {
                                       &curve_start);
       common::XmlQueryDoubleAttribute(ele_geometry_type, "curvEnd", &curve_end);
       std::shared_ptr<element::GeometrySpiral> geometry_ptr =
-          std::make_shared<element::GeometrySpiral>(s, x, y, hdg, length,
-                                                    GeometryType::kSpiral,
-                                                    curve_start, curve_end);
+          element::AllocateGeometry<element::GeometrySpiral>(
+              s, x, y, hdg, length, GeometryType::kSpiral, curve_start,
+              curve_end);
       geometry_base_ptr =
           std::dynamic_pointer_cast<element::Geometry>(geometry_ptr);
     }
@@ -231,7 +291,7 @@ RoadXmlParser& RoadXmlParser::PlanViewElement() {
       common::XmlQueryDoubleAttribute(ele_geometry_type, "d", &d);
 
       std::shared_ptr<element::GeometryPoly3> geometry_ptr =
-          std::make_shared<element::GeometryPoly3>(
+          element::AllocateGeometry<element::GeometryPoly3>(
               s, x, y, hdg, length, GeometryType::kPoly3, a, b, c, d);
       geometry_base_ptr =
           std::dynamic_pointer_cast<element::Geometry>(geometry_ptr);
@@ -255,16 +315,10 @@ RoadXmlParser& RoadXmlParser::PlanViewElement() {
       common::XmlQueryDoubleAttribute(ele_geometry_type, "bV", &bv);
       common::XmlQueryDoubleAttribute(ele_geometry_type, "cV", &cv);
       common::XmlQueryDoubleAttribute(ele_geometry_type, "dV", &dv);
-      common::XmlQueryEnumAttribute(
-          ele_geometry_type, "pRange", &p_range,
-          std::map<element::GeometryParamPoly3::PRange, std::string>{
-              std::make_pair(element::GeometryParamPoly3::PRange::ARCLENGTH,
-                             "arcLength"),
-              std::make_pair(element::GeometryParamPoly3::PRange::NORMALIZED,
-                             "normalized"),
-          });
+      common::XmlQueryEnumAttribute(ele_geometry_type, "pRange", &p_range,
+                                    P_RANGE_TABLE);
       std::shared_ptr<element::GeometryParamPoly3> geometry_ptr =
-          std::make_shared<element::GeometryParamPoly3>(
+          element::AllocateGeometry<element::GeometryParamPoly3>(
               s, x, y, hdg, length, GeometryType::kParamPoly3, au, bu, cu, du,
               av, bv, cv, dv, p_range);
       geometry_base_ptr =
@@ -276,7 +330,7 @@ RoadXmlParser& RoadXmlParser::PlanViewElement() {
       return *this;
     }
     ele_road_->mutable_plan_view()->mutable_geometrys()->emplace_back(
-        geometry_base_ptr);
+        std::move(geometry_base_ptr));
     curr_ele_geometry = common::XmlNextSiblingElement(curr_ele_geometry);
   }
   return *this;
@@ -284,6 +338,7 @@ RoadXmlParser& RoadXmlParser::PlanViewElement() {
 
 RoadXmlParser& RoadXmlParser::LanesElement() {
   if (!IsValid()) return *this;
+  ScopedStageTimer timer(ParseStats::Stage::kLanes);
   /// eq 1
   const tinyxml2::XMLElement* xml_lanes = xml_road_->FirstChildElement("lanes");
   if (!xml_lanes) {
@@ -295,6 +350,8 @@ RoadXmlParser& RoadXmlParser::LanesElement() {
   // lanes laneoffset
   // 0~*
   auto curr_xml_offset = xml_lanes->FirstChildElement("laneOffset");
+  ele_road_->mutable_lanes()->mutable_lane_offsets()->reserve(
+      common::XmlSiblingElementCount(curr_xml_offset));
   double s;
   double a;
   double b;
@@ -330,16 +387,17 @@ RoadXmlParser& RoadXmlParser::LanesElement() {
                "ROAD LANES SECTION ELEMENT IS NULL.");
     return *this;
   }
-  size_t section_idx = 0;
-  Status status{ErrorCode::OK, "ok"};
+  // 原地构造, 避免拷贝LaneSection
+  auto lane_sections = ele_road_->mutable_lanes()->mutable_lane_sections();
+  lane_sections->reserve(common::XmlSiblingElementCount(curr_xml_section));
   RoadLanesSectionXmlParser section_parser{this->opendrive_version()};
   while (curr_xml_section) {
-    element::LaneSection lane_section;
-    lane_section.set_id(section_idx++);
-    status = section_parser.Parse(curr_xml_section, &lane_section);
-    CheckStatus(status);
-    ele_road_->mutable_lanes()->mutable_lane_sections()->emplace_back(
-        lane_section);
+    lane_sections->emplace_back();
+    lane_sections->back().set_id(lane_sections->size() - 1);
+    if (!CheckStatus(
+            section_parser.Parse(curr_xml_section, &lane_sections->back()))) {
+      return *this;
+    }
     curr_xml_section = common::XmlNextSiblingElement(curr_xml_section);
   }
   return *this;
@@ -361,5 +419,12 @@ RoadXmlParser& RoadXmlParser::GenerateRoad() {
   return *this;
 }
 
+RoadXmlParser& RoadXmlParser::BoundaryTables() {
+  if (!IsValid() || !lane_boundary_tables_) return *this;
+  ScopedStageTimer timer(ParseStats::Stage::kLaneBoundary);
+  ele_road_->BuildLaneBoundaryTables();
+  return *this;
+}
+
 }  // namespace parser
 }  // namespace opendrive
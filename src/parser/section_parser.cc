@@ -1,6 +1,8 @@
 #include "opendrive-cpp/parser/section_parser.h"
 
 #include "opendrive-cpp/common/choices.h"
+#include "opendrive-cpp/common/parse_stats.h"
+#include "opendrive-cpp/common/trace.h"
 
 namespace opendrive {
 namespace parser {
@@ -11,6 +13,8 @@ RoadLanesSectionXmlParser::RoadLanesSectionXmlParser(const std::string& version)
 opendrive::Status RoadLanesSectionXmlParser::Parse(
     const tinyxml2::XMLElement* xml_section,
     element::LaneSection* ele_section) {
+  ScopedStageTimer timer(ParseStats::Stage::kLaneSection);
+  OPENDRIVE_TRACE_SCOPE("RoadLanesSectionXmlParser::Parse");
   xml_section_ = xml_section;
   ele_section_ = ele_section;
   if (!xml_section_ || !ele_section_) {
@@ -34,25 +38,25 @@ RoadLanesSectionXmlParser& RoadLanesSectionXmlParser::ParseAttributes() {
 
 RoadLanesSectionXmlParser& RoadLanesSectionXmlParser::ParseLanesEle() {
   if (!IsValid()) return *this;
-  std::vector<std::string> lanes_type{"left", "center", "right"};
-  for (const auto& type : lanes_type) {
+  const std::pair<const char*, element::LanesInfo*> lanes_infos[] = {
+      {"left", ele_section_->mutable_left()},
+      {"center", ele_section_->mutable_center()},
+      {"right", ele_section_->mutable_right()},
+  };
+  for (const auto& lanes_info : lanes_infos) {
     const tinyxml2::XMLElement* curr_xml_lanes =
-        xml_section_->FirstChildElement(type.c_str());
+        xml_section_->FirstChildElement(lanes_info.first);
     if (!curr_xml_lanes) {
       continue;
     }
     const tinyxml2::XMLElement* curr_xml_lane =
         curr_xml_lanes->FirstChildElement("lane");
+    // 原地构造, 避免拷贝Lane
+    auto lanes = lanes_info.second->mutable_lanes();
+    lanes->reserve(common::XmlSiblingElementCount(curr_xml_lane));
     while (curr_xml_lane) {
-      element::Lane lane;
-      this->ParseLaneEle(curr_xml_lane, lane);
-      if ("left" == type) {
-        ele_section_->mutable_left()->mutable_lanes()->emplace_back(lane);
-      } else if ("center" == type) {
-        ele_section_->mutable_center()->mutable_lanes()->emplace_back(lane);
-      } else if ("right" == type) {
-        ele_section_->mutable_right()->mutable_lanes()->emplace_back(lane);
-      }
+      lanes->emplace_back();
+      this->ParseLaneEle(curr_xml_lane, lanes->back());
       curr_xml_lane = common::XmlNextSiblingElement(curr_xml_lane);
     }
   }
@@ -89,10 +93,10 @@ RoadLanesSectionXmlParser& RoadLanesSectionXmlParser::ParseLaneAttributes(
   common::XmlQueryStringAttribute(xml_lane, "level", &lane_level);
   common::XmlQueryEnumAttribute(xml_lane, "type",
                                 ele_lane.mutable_attribute()->mutable_type(),
-                                LANE_TYPE_CHOICES);
+                                LANE_TYPE_TABLE);
   common::XmlQueryEnumAttribute(xml_lane, "level",
                                 ele_lane.mutable_attribute()->mutable_level(),
-                                BOOLEAN_CHOICES);
+                                BOOLEAN_TABLE);
   return *this;
 }
 
@@ -105,6 +109,8 @@ RoadLanesSectionXmlParser& RoadLanesSectionXmlParser::ParseLaneLinkEle(
     element::Id id = 0;
     const tinyxml2::XMLElement* curr_xml_lane_link_predecessor =
         xml_lane_link->FirstChildElement("predecessor");
+    ele_lane.mutable_link()->mutable_predecessors()->reserve(
+        common::XmlSiblingElementCount(curr_xml_lane_link_predecessor));
     while (curr_xml_lane_link_predecessor) {
       common::XmlQueryIntAttribute(curr_xml_lane_link_predecessor, "id", &id);
       ele_lane.mutable_link()->mutable_predecessors()->emplace_back(id);
@@ -113,6 +119,8 @@ RoadLanesSectionXmlParser& RoadLanesSectionXmlParser::ParseLaneLinkEle(
     }
     const tinyxml2::XMLElement* curr_xml_lane_link_successor =
         xml_lane_link->FirstChildElement("successor");
+    ele_lane.mutable_link()->mutable_successors()->reserve(
+        common::XmlSiblingElementCount(curr_xml_lane_link_successor));
     while (curr_xml_lane_link_successor) {
       common::XmlQueryIntAttribute(curr_xml_lane_link_successor, "id", &id);
       ele_lane.mutable_link()->mutable_successors()->emplace_back(id);
@@ -134,6 +142,8 @@ RoadLanesSectionXmlParser& RoadLanesSectionXmlParser::ParseLaneWidthEle(
   double b;
   double c;
   double d;
+  ele_lane.mutable_widths()->reserve(
+      common::XmlSiblingElementCount(curr_xml_width));
   while (curr_xml_width) {
     element::LaneWidth lane_width;
     s = lane_width.s();
@@ -168,6 +178,8 @@ RoadLanesSectionXmlParser& RoadLanesSectionXmlParser::ParseLaneBorderEle(
   double b;
   double c;
   double d;
+  ele_lane.mutable_borders()->reserve(
+      common::XmlSiblingElementCount(curr_xml_border));
   while (curr_xml_border) {
     element::LaneBorder lane_border;
     s = lane_border.s();
@@ -200,6 +212,8 @@ RoadLanesSectionXmlParser& RoadLanesSectionXmlParser::ParseLaneRoadMarkEle(
   double s;
   double width;
   double height;
+  ele_lane.mutable_road_marks()->reserve(
+      common::XmlSiblingElementCount(curr_xml_mark));
   while (curr_xml_mark) {
     element::RoadMark road_mark;
     s = road_mark.s();
@@ -214,17 +228,17 @@ RoadLanesSectionXmlParser& RoadLanesSectionXmlParser::ParseLaneRoadMarkEle(
     common::XmlQueryStringAttribute(curr_xml_mark, "material",
                                     road_mark.mutable_material());
     common::XmlQueryEnumAttribute(
-        curr_xml_mark, "type", road_mark.mutable_type(), ROADMARK_TYPE_CHOICES);
+        curr_xml_mark, "type", road_mark.mutable_type(), ROADMARK_TYPE_TABLE);
     common::XmlQueryEnumAttribute(curr_xml_mark, "color",
                                   road_mark.mutable_color(),
-                                  ROAD_MARK_COLOR_CHOICES);
+                                  ROAD_MARK_COLOR_TABLE);
     common::XmlQueryEnumAttribute(curr_xml_mark, "weight",
                                   road_mark.mutable_weight(),
-                                  ROAD_MARK_WEIGHT_CHOICES);
+                                  ROAD_MARK_WEIGHT_TABLE);
     common::XmlQueryEnumAttribute(curr_xml_mark, "laneChange",
                                   road_mark.mutable_lane_change(),
-                                  ROAD_MARK_LANE_CHANGE_CHOICES);
-    ele_lane.mutable_road_marks()->emplace_back(road_mark);
+                                  ROAD_MARK_LANE_CHANGE_TABLE);
+    ele_lane.mutable_road_marks()->emplace_back(std::move(road_mark));
     curr_xml_mark = common::XmlNextSiblingElement(curr_xml_mark);
   }
   common::VectorSortPoloy3(ele_lane.mutable_road_marks());
@@ -238,6 +252,8 @@ RoadLanesSectionXmlParser& RoadLanesSectionXmlParser::ParseLaneSpeedEle(
       xml_lane->FirstChildElement("speed");
   double s;
   float speed_max;
+  ele_lane.mutable_max_speeds()->reserve(
+      common::XmlSiblingElementCount(curr_xml_speed));
   while (curr_xml_speed) {
     element::LaneSpeed lane_speed;
     s = lane_speed.s();
@@ -247,7 +263,7 @@ RoadLanesSectionXmlParser& RoadLanesSectionXmlParser::ParseLaneSpeedEle(
     common::XmlQueryFloatAttribute(curr_xml_speed, "max", &speed_max);
     lane_speed.set_max(speed_max);
     common::XmlQueryEnumAttribute(curr_xml_speed, "unit",
-                                  lane_speed.mutable_unit(), SPEEDUNIT_CHOICES);
+                                  lane_speed.mutable_unit(), SPEEDUNIT_TABLE);
     ele_lane.mutable_max_speeds()->emplace_back(lane_speed);
     curr_xml_speed = common::XmlNextSiblingElement(curr_xml_speed);
   }
@@ -0,0 +1,442 @@
+#include "opendrive-cpp/parser/stream_parser.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "opendrive-cpp/common/hash.h"
+#include "opendrive-cpp/common/mapped_file.h"
+#include "opendrive-cpp/common/parse_stats.h"
+
+namespace opendrive {
+namespace parser {
+
+namespace {
+
+/// mmap 解析时每次扫描的窗口大小, 窗口之前的页面会被释放
+constexpr size_t kMappedWindowSize = 8 * 1024 * 1024;
+/// 非 mmap 解析时每次读取的块大小
+constexpr size_t kReadChunkSize = 1024 * 1024;
+
+size_t FindSequence(const char* data, size_t size, size_t from,
+                    const char* seq) {
+  const size_t n = std::strlen(seq);
+  while (from + n <= size) {
+    const void* p = std::memchr(data + from, seq[0], size - from - n + 1);
+    if (!p) return std::string::npos;
+    const size_t pos = static_cast<const char*>(p) - data;
+    if (0 == std::memcmp(data + pos, seq, n)) return pos;
+    from = pos + 1;
+  }
+  return std::string::npos;
+}
+
+bool IsNameEnd(char c) {
+  return ' ' == c || '\t' == c || '\r' == c || '\n' == c || '/' == c ||
+         '>' == c;
+}
+
+}  // namespace
+
+StreamXmlParser::StreamXmlParser(const ParseOptions& options)
+    : options_(options) {}
+
+void StreamXmlParser::set_road_callback(const RoadCallback& callback) {
+  road_callback_ = callback;
+}
+
+void StreamXmlParser::set_junction_callback(const JunctionCallback& callback) {
+  junction_callback_ = callback;
+}
+
+void StreamXmlParser::set_road_fragment_callback(
+    const RoadFragmentCallback& callback) {
+  road_fragment_callback_ = callback;
+}
+
+void StreamXmlParser::set_junction_fragment_callback(
+    const JunctionFragmentCallback& callback) {
+  junction_fragment_callback_ = callback;
+}
+
+opendrive::Status StreamXmlParser::Begin(element::Map::Ptr ele_map) {
+  set_status(ErrorCode::OK, "ok");
+  ele_map_ = ele_map;
+  buffer_.clear();
+  root_name_.clear();
+  fragment_name_.clear();
+  scan_pos_ = 0;
+  fragment_begin_ = 0;
+  depth_ = 0;
+  bytes_consumed_ = 0;
+  bytes_total_ = 0;
+  header_num_ = 0;
+  road_num_ = 0;
+  fragment_head_ = std::string::npos;
+  scan_road_head_ = false;
+  finished_ = false;
+  if (!ele_map_) {
+    set_status(ErrorCode::XML_ROOT_ELEMENT_ERROR, "Input is null.");
+  }
+  return status();
+}
+
+opendrive::Status StreamXmlParser::Feed(const char* data, size_t size) {
+  if (!IsValid()) return status();
+  if (finished_) {
+    bytes_consumed_ += size;
+    return status();
+  }
+  size_t keep = 0;
+  if (buffer_.empty()) {
+    /// 完整片段直接在输入上解析, 只缓存未完成的尾部
+    keep = Process(data, size);
+    buffer_.assign(data + keep, size - keep);
+  } else {
+    buffer_.append(data, size);
+    keep = Process(buffer_.data(), buffer_.size());
+    buffer_.erase(0, keep);
+  }
+  scan_pos_ -= keep;
+  if (depth_ >= 2) {
+    fragment_begin_ -= keep;
+  }
+  bytes_consumed_ += keep;
+  return status();
+}
+
+opendrive::Status StreamXmlParser::End() {
+  if (!IsValid()) return status();
+  if (!finished_) {
+    set_status(ErrorCode::XML_ROOT_ELEMENT_ERROR,
+               "UNEXPECTED END OF DOCUMENT.");
+  } else if (0 == header_num_) {
+    set_status(ErrorCode::XML_HEADER_ELEMENT_ERROR, "HEADER ELEMENT IS NULL.");
+  } else if (0 == road_num_) {
+    set_status(ErrorCode::XML_ROAD_ELEMENT_ERROR, "ROAD ELEMENT IS NULL.");
+  }
+  bytes_consumed_ += buffer_.size();
+  std::string().swap(buffer_);
+  fragment_doc_.Clear();
+  return status();
+}
+
+opendrive::Status StreamXmlParser::Parse(const char* data, size_t size,
+                                         element::Map::Ptr ele_map) {
+  if (!CheckStatus(Begin(ele_map))) return status();
+  bytes_total_ = size;
+  bytes_consumed_ = Process(data, size);
+  if (finished_) {
+    bytes_consumed_ = size;
+  }
+  return End();
+}
+
+opendrive::Status StreamXmlParser::ParseFile(const std::string& xml_file,
+                                             element::Map::Ptr ele_map) {
+  if (!CheckStatus(Begin(ele_map))) return status();
+  if (options_.use_mmap) {
+    common::MappedFile mapped_file;
+    if (!mapped_file.Open(xml_file)) {
+      set_status(ErrorCode::XML_ROAD_ELEMENT_ERROR, "Map Xml File Exection.");
+      return status();
+    }
+    mapped_file.Advise(common::MappedFile::Advice::kSequential);
+    const size_t size = mapped_file.size();
+    bytes_total_ = size;
+    size_t released = 0;
+    size_t limit = 0;
+    /// 输入连续, 逐窗口扩大扫描范围即可, 不需要复制
+    while (IsValid() && !finished_ && limit < size) {
+      limit = std::min(size, limit + kMappedWindowSize);
+      bytes_consumed_ = Process(mapped_file.data(), limit);
+      if (bytes_consumed_ - released >= kMappedWindowSize) {
+        mapped_file.Release(released, bytes_consumed_ - released);
+        released = bytes_consumed_;
+      }
+    }
+    if (finished_) {
+      bytes_consumed_ = size;
+    }
+    return End();
+  }
+  FILE* file = std::fopen(xml_file.c_str(), "rb");
+  if (!file) {
+    set_status(ErrorCode::XML_ROAD_ELEMENT_ERROR, "Parse Xml File Exection.");
+    return status();
+  }
+  std::vector<char> chunk(kReadChunkSize);
+  while (IsValid() && !finished_) {
+    const size_t n = std::fread(chunk.data(), 1, chunk.size(), file);
+    if (0 == n) break;
+    Feed(chunk.data(), n);
+  }
+  std::fclose(file);
+  return End();
+}
+
+size_t StreamXmlParser::Process(const char* data, size_t size) {
+  size_t pos = scan_pos_;
+  TagType type = TagType::kUnknown;
+  std::string name;
+  while (IsValid() && !finished_ && pos < size) {
+    const void* lt = std::memchr(data + pos, '<', size - pos);
+    if (!lt) {
+      pos = size;
+      break;
+    }
+    const size_t begin = static_cast<const char*>(lt) - data;
+    /// 片段内部只需要维护深度, 不需要元素名; 定位 road 头部时除外
+    const bool need_name = depth_ < 2 || (2 == depth_ && scan_road_head_);
+    const size_t end =
+        ScanTag(data, size, begin, &type, need_name ? &name : nullptr);
+    if (0 == end) {
+      pos = begin;
+      break;
+    }
+    pos = end;
+    if (TagType::kOther == type) continue;
+    if (0 == depth_) {
+      if (TagType::kStart == type) {
+        root_name_ = name;
+        depth_ = 1;
+      } else if (TagType::kEmpty == type) {
+        finished_ = true;
+      } else {
+        set_status(ErrorCode::XML_ROOT_ELEMENT_ERROR,
+                   "ROOT ELEMENT IS INVALID.");
+      }
+    } else if (1 == depth_) {
+      if (TagType::kStart == type) {
+        fragment_begin_ = begin;
+        fragment_name_ = name;
+        fragment_head_ = std::string::npos;
+        scan_road_head_ = road_fragment_callback_ && "road" == name;
+        depth_ = 2;
+      } else if (TagType::kEmpty == type) {
+        fragment_head_ = std::string::npos;
+        Dispatch(data + begin, end - begin, name);
+      } else if (name == root_name_) {
+        depth_ = 0;
+        finished_ = true;
+      } else {
+        set_status(ErrorCode::XML_ROOT_ELEMENT_ERROR,
+                   "MISMATCHED ROOT ELEMENT.");
+      }
+    } else if (TagType::kStart == type) {
+      if (scan_road_head_ && 2 == depth_) {
+        MarkRoadHead(begin, name);
+      }
+      depth_++;
+    } else if (TagType::kEmpty == type) {
+      if (scan_road_head_ && 2 == depth_) {
+        MarkRoadHead(begin, name);
+      }
+    } else if (TagType::kEnd == type) {
+      depth_--;
+      if (1 == depth_) {
+        Dispatch(data + fragment_begin_, end - fragment_begin_,
+                 fragment_name_);
+      }
+    }
+  }
+  scan_pos_ = pos;
+  return depth_ >= 2 ? fragment_begin_ : pos;
+}
+
+void StreamXmlParser::MarkRoadHead(size_t begin, const std::string& name) {
+  if ("planView" == name || "lanes" == name) {
+    fragment_head_ = begin - fragment_begin_;
+    scan_road_head_ = false;
+  }
+}
+
+size_t StreamXmlParser::ScanTag(const char* data, size_t size, size_t begin,
+                                TagType* type, std::string* name) const {
+  if (begin + 1 >= size) return 0;
+  const char c = data[begin + 1];
+  size_t end = std::string::npos;
+  if ('?' == c) {
+    *type = TagType::kOther;
+    end = FindSequence(data, size, begin + 2, "?>");
+    return std::string::npos == end ? 0 : end + 2;
+  }
+  if ('!' == c) {
+    *type = TagType::kOther;
+    const size_t avail = size - begin;
+    if (avail < 4) return 0;
+    if (0 == std::memcmp(data + begin, "<!--", 4)) {
+      end = FindSequence(data, size, begin + 4, "-->");
+      return std::string::npos == end ? 0 : end + 3;
+    }
+    if (avail < 9 && 0 == std::memcmp(data + begin, "<![CDATA[", avail)) {
+      return 0;
+    }
+    if (avail >= 9 && 0 == std::memcmp(data + begin, "<![CDATA[", 9)) {
+      end = FindSequence(data, size, begin + 9, "]]>");
+      return std::string::npos == end ? 0 : end + 3;
+    }
+    /// <!DOCTYPE ...[...]>
+    int bracket = 0;
+    for (size_t i = begin + 2; i < size; i++) {
+      if ('[' == data[i]) bracket++;
+      if (']' == data[i]) bracket--;
+      if ('>' == data[i] && bracket <= 0) return i + 1;
+    }
+    return 0;
+  }
+  size_t name_begin = begin + 1;
+  if ('/' == c) {
+    *type = TagType::kEnd;
+    name_begin++;
+    const void* gt = std::memchr(data + begin, '>', size - begin);
+    if (!gt) return 0;
+    end = static_cast<const char*>(gt) - data + 1;
+  } else {
+    /// 属性值中可能出现 '>'
+    char quote = 0;
+    for (size_t i = begin + 1; i < size; i++) {
+      const char ch = data[i];
+      if (quote) {
+        if (ch == quote) quote = 0;
+      } else if ('"' == ch || '\'' == ch) {
+        quote = ch;
+      } else if ('>' == ch) {
+        end = i + 1;
+        break;
+      }
+    }
+    if (std::string::npos == end) return 0;
+    *type = '/' == data[end - 2] ? TagType::kEmpty : TagType::kStart;
+  }
+  if (name) {
+    size_t name_end = name_begin;
+    while (name_end < end && !IsNameEnd(data[name_end])) name_end++;
+    name->assign(data + name_begin, name_end - name_begin);
+  }
+  return end;
+}
+
+bool StreamXmlParser::Cancelled() const {
+  return options_.cancel && options_.cancel->load(std::memory_order_relaxed);
+}
+
+void StreamXmlParser::ReportRoad() const {
+  if (!options_.progress) return;
+  options_.progress(
+      ParseProgress{road_num_, 0, bytes_consumed_, bytes_total_});
+}
+
+void StreamXmlParser::Dispatch(const char* data, size_t size,
+                               const std::string& name) {
+  if (IsValid() && Cancelled()) {
+    set_status(ErrorCode::PARSE_CANCELLED, "Cancelled.");
+  }
+  ErrorCode code = ErrorCode::OK;
+  if ("header" == name) {
+    code = ErrorCode::XML_HEADER_ELEMENT_ERROR;
+  } else if ("road" == name) {
+    code = ErrorCode::XML_ROAD_ELEMENT_ERROR;
+    if (road_fragment_callback_) {
+      /// 没有 <planView>/<lanes> 时头部即整个片段
+      const size_t head_size =
+          std::string::npos == fragment_head_ ? size : fragment_head_;
+      if (IsValid()) {
+        CheckStatus(road_fragment_callback_(data, size, head_size));
+      }
+      road_num_++;
+      ReportRoad();
+      return;
+    }
+  } else if ("junction" == name) {
+    code = ErrorCode::XML_JUNCTION_ELEMENT_ERROR;
+    if (junction_fragment_callback_) {
+      if (IsValid()) {
+        CheckStatus(junction_fragment_callback_(data, size));
+      }
+      return;
+    }
+  } else {
+    /// 暂不支持的元素(controller, station ...)
+    return;
+  }
+  fragment_fingerprint_ =
+      ErrorCode::XML_HEADER_ELEMENT_ERROR == code
+          ? 0
+          : common::Fingerprint(data, size);
+  {
+    ScopedStageTimer timer(ParseStats::Stage::kLoadXml);
+    fragment_doc_.Parse(data, size);
+  }
+  if (fragment_doc_.Error()) {
+    set_status(code, "Parse <" + name + "> Element Exception.");
+    return;
+  }
+  const tinyxml2::XMLElement* xml_fragment = fragment_doc_.RootElement();
+  if (ErrorCode::XML_HEADER_ELEMENT_ERROR == code) {
+    HeaderFragment(xml_fragment);
+  } else if (ErrorCode::XML_ROAD_ELEMENT_ERROR == code) {
+    RoadFragment(xml_fragment);
+  } else {
+    JunctionFragment(xml_fragment);
+  }
+}
+
+StreamXmlParser& StreamXmlParser::HeaderFragment(
+    const tinyxml2::XMLElement* xml_header) {
+  if (!IsValid()) return *this;
+  HeaderXmlParser header_parser;
+  if (CheckStatus(
+          header_parser.Parse(xml_header, ele_map_->mutable_header()))) {
+    this->set_opendrive_version(header_parser.opendrive_version());
+  }
+  header_num_++;
+  return *this;
+}
+
+StreamXmlParser& StreamXmlParser::RoadFragment(
+    const tinyxml2::XMLElement* xml_road) {
+  if (!IsValid()) return *this;
+  RoadXmlParser road_parser{this->opendrive_version()};
+  road_parser.set_lane_boundary_tables(options_.lane_boundary_tables);
+  if (road_callback_) {
+    element::Road ele_road;
+    ele_road.set_fingerprint(fragment_fingerprint_);
+    if (CheckStatus(road_parser.Parse(xml_road, &ele_road))) {
+      road_callback_(std::move(ele_road));
+    }
+  } else {
+    common::ScopedArena scope(ele_map_->arena());
+    ele_map_->mutable_roads()->emplace_back();
+    ele_map_->mutable_roads()->back().set_fingerprint(fragment_fingerprint_);
+    CheckStatus(
+        road_parser.Parse(xml_road, &ele_map_->mutable_roads()->back()));
+  }
+  road_num_++;
+  ReportRoad();
+  return *this;
+}
+
+StreamXmlParser& StreamXmlParser::JunctionFragment(
+    const tinyxml2::XMLElement* xml_junction) {
+  if (!IsValid()) return *this;
+  JunctionXmlParser junction_parser{this->opendrive_version()};
+  if (junction_callback_) {
+    element::Junction ele_junction;
+    ele_junction.set_fingerprint(fragment_fingerprint_);
+    if (CheckStatus(junction_parser.Parse(xml_junction, &ele_junction))) {
+      junction_callback_(std::move(ele_junction));
+    }
+  } else {
+    common::ScopedArena scope(ele_map_->arena());
+    ele_map_->mutable_junctions()->emplace_back();
+    ele_map_->mutable_junctions()->back().set_fingerprint(
+        fragment_fingerprint_);
+    CheckStatus(junction_parser.Parse(
+        xml_junction, &ele_map_->mutable_junctions()->back()));
+  }
+  return *this;
+}
+
+}  // namespace parser
+}  // namespace opendrive
@@ -17,14 +17,12 @@ bool XmlParser::IsValid() const { return ErrorCode::OK == status_.error_code; }
 opendrive::Status XmlParser::status() const { return status_; }
 
 void XmlParser::set_status(ErrorCode code, const std::string& msg) {
-  std::unique_lock<std::mutex> lock(mutex_);
   status_.error_code = code;
   status_.msg = msg;
 }
 
 bool XmlParser::CheckStatus(const Status& s) {
   if (ErrorCode::OK != s.error_code) {
-    std::unique_lock<std::mutex> lock(mutex_);
     status_.error_code = s.error_code;
     status_.msg = s.msg;
     return false;
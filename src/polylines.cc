@@ -0,0 +1,305 @@
+#include "opendrive-cpp/polylines.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+
+#include "opendrive-cpp/common/thread_pool.h"
+
+namespace opendrive {
+
+namespace {
+
+/// step 的整数倍恰好落在终点附近时不再重复采样
+constexpr double kStepEpsilon = 1e-9;
+/// 相邻点距离小于该值时 heading 取参考线方向
+constexpr double kMinSegmentLength = 1e-9;
+
+size_t SampleNum(double begin, double end, double step) {
+  if (!(end > begin)) return 1;
+  return static_cast<size_t>(std::ceil((end - begin) / step - kStepEpsilon)) +
+         1;
+}
+
+void FillSamples(double begin, double end, double step,
+                 std::vector<double>* road_s) {
+  const size_t n = SampleNum(begin, end, step);
+  road_s->resize(n);
+  for (size_t i = 0; i + 1 < n; i++) {
+    (*road_s)[i] = begin + i * step;
+  }
+  (*road_s)[n - 1] = std::max(begin, end);
+}
+
+/// 每个 section 的折线数
+size_t SectionLineNum(const element::LaneSection& section,
+                      const PolylineOptions& options) {
+  const size_t lanes =
+      section.left().lanes().size() + section.right().lanes().size();
+  size_t num = 0;
+  if (options.center_lines) {
+    num += lanes + section.center().lanes().size();
+  }
+  if (options.boundaries) {
+    num += 2 * lanes;
+  }
+  return num;
+}
+
+/// 每个线程复用的缓冲区
+struct Scratch {
+  std::vector<double> road_s;
+  std::vector<element::Point> reference;
+  /// 参考线的左法向, 所有偏移折线共用
+  std::vector<double> normal_x;
+  std::vector<double> normal_y;
+  std::vector<double> t;
+  element::LaneBoundaries boundaries;
+};
+
+class RoadWriter {
+ public:
+  RoadWriter(const element::Road& road, const PolylineOptions& options,
+             Scratch* scratch, MapPolylines::Line* lines,
+             PolylinePoint* points, size_t point_begin)
+      : road_(road),
+        options_(options),
+        scratch_(scratch),
+        lines_(lines),
+        points_(points),
+        point_begin_(point_begin) {}
+
+  void Write() {
+    if (options_.reference_lines) {
+      Sample(0, road_.attribute().length());
+      auto* line = NextLine(-1, 0, MapPolylines::Kind::kReference);
+      PolylinePoint* out = points_ + (line->begin - point_begin_);
+      const size_t n = scratch_->road_s.size();
+      for (size_t i = 0; i < n; i++) {
+        const auto& point = scratch_->reference[i];
+        out[i] = PolylinePoint{point.x(), point.y(), point.heading(),
+                               scratch_->road_s[i]};
+      }
+    }
+    for (const auto& section : road_.lanes().lane_sections()) {
+      if (0 == SectionLineNum(section, options_)) continue;
+      WriteSection(section);
+    }
+  }
+
+ private:
+  void Sample(double begin, double end) {
+    FillSamples(begin, end, options_.step, &scratch_->road_s);
+    scratch_->reference.resize(scratch_->road_s.size());
+    road_.GetReferencePoints(scratch_->road_s.data(),
+                             scratch_->road_s.size(),
+                             scratch_->reference.data());
+  }
+
+  MapPolylines::Line* NextLine(element::Id section_id, element::Id lane_id,
+                               MapPolylines::Kind kind) {
+    auto* line = lines_++;
+    line->road_id = road_.attribute().id();
+    line->section_id = section_id;
+    line->lane_id = lane_id;
+    line->kind = kind;
+    line->begin = point_begin_ + points_written_;
+    line->size = scratch_->road_s.size();
+    points_written_ += line->size;
+    return line;
+  }
+
+  void WriteSection(const element::LaneSection& section) {
+    Sample(section.start_position(), section.end_position());
+    const size_t n = scratch_->road_s.size();
+    scratch_->normal_x.resize(n);
+    scratch_->normal_y.resize(n);
+    for (size_t i = 0; i < n; i++) {
+      const double heading = scratch_->reference[i].heading();
+      scratch_->normal_x[i] = -std::sin(heading);
+      scratch_->normal_y[i] = std::cos(heading);
+    }
+    auto& boundaries = scratch_->boundaries;
+    section.GetLaneBoundaries(scratch_->road_s.data(), n,
+                              road_.lanes().lane_offsets(), &boundaries);
+    scratch_->t.resize(n);
+    double* t = scratch_->t.data();
+    WriteSide(section, section.left().lanes(), true);
+    if (options_.center_lines) {
+      for (const auto& lane : section.center().lanes()) {
+        for (size_t i = 0; i < n; i++) {
+          t[i] = boundaries.center(i);
+        }
+        WriteOffsetLine(section.id(), lane.attribute().id(),
+                        MapPolylines::Kind::kCenter);
+      }
+    }
+    WriteSide(section, section.right().lanes(), false);
+  }
+
+  void WriteSide(const element::LaneSection& section,
+                 const element::Vector<element::Lane>& lanes, bool left) {
+    if (lanes.empty()) return;
+    const auto& boundaries = scratch_->boundaries;
+    const size_t n = scratch_->road_s.size();
+    double* t = scratch_->t.data();
+    /// 各车道内侧车道的下标, 最内侧为 lanes.size()(中心车道)
+    const std::vector<size_t> order = element::LaneSection::LaneOrder(lanes);
+    std::vector<size_t> inner(lanes.size());
+    for (size_t k = 0; k < order.size(); k++) {
+      inner[order[k]] = 0 == k ? lanes.size() : order[k - 1];
+    }
+    auto outer_t = [&](size_t i, size_t j) {
+      return left ? boundaries.left(i, j) : boundaries.right(i, j);
+    };
+    auto inner_t = [&](size_t i, size_t j) {
+      return lanes.size() == inner[j] ? boundaries.center(i)
+                                      : outer_t(i, inner[j]);
+    };
+    for (size_t j = 0; j < lanes.size(); j++) {
+      const element::Id lane_id = lanes[j].attribute().id();
+      if (options_.center_lines) {
+        for (size_t i = 0; i < n; i++) {
+          t[i] = 0.5 * (inner_t(i, j) + outer_t(i, j));
+        }
+        WriteOffsetLine(section.id(), lane_id, MapPolylines::Kind::kCenter);
+      }
+      if (options_.boundaries) {
+        /// 左侧车道的左边界为外边界, 右侧车道的左边界为内边界
+        for (size_t i = 0; i < n; i++) {
+          t[i] = left ? outer_t(i, j) : inner_t(i, j);
+        }
+        WriteOffsetLine(section.id(), lane_id,
+                        MapPolylines::Kind::kLeftBoundary);
+        for (size_t i = 0; i < n; i++) {
+          t[i] = left ? inner_t(i, j) : outer_t(i, j);
+        }
+        WriteOffsetLine(section.id(), lane_id,
+                        MapPolylines::Kind::kRightBoundary);
+      }
+    }
+  }
+
+  /// 参考线沿法向偏移 scratch_->t
+  void WriteOffsetLine(element::Id section_id, element::Id lane_id,
+                       MapPolylines::Kind kind) {
+    auto* line = NextLine(section_id, lane_id, kind);
+    PolylinePoint* out = points_ + (line->begin - point_begin_);
+    const size_t n = line->size;
+    const double* t = scratch_->t.data();
+    const double* normal_x = scratch_->normal_x.data();
+    const double* normal_y = scratch_->normal_y.data();
+    for (size_t i = 0; i < n; i++) {
+      const auto& point = scratch_->reference[i];
+      out[i] = PolylinePoint{point.x() + t[i] * normal_x[i],
+                             point.y() + t[i] * normal_y[i], point.heading(),
+                             scratch_->road_s[i]};
+    }
+    if (n < 2) return;
+    for (size_t i = 0; i < n; i++) {
+      const auto& prev = out[0 == i ? 0 : i - 1];
+      const auto& next = out[i + 1 == n ? i : i + 1];
+      const double dx = next.x - prev.x;
+      const double dy = next.y - prev.y;
+      if (std::hypot(dx, dy) >= kMinSegmentLength) {
+        out[i].heading = std::atan2(dy, dx);
+      }
+    }
+  }
+
+  const element::Road& road_;
+  const PolylineOptions& options_;
+  Scratch* scratch_;
+  MapPolylines::Line* lines_;
+  PolylinePoint* points_;
+  const size_t point_begin_;
+  size_t points_written_ = 0;
+};
+
+}  // namespace
+
+void MapPolylines::Clear() {
+  std::vector<PolylinePoint>().swap(points_);
+  std::vector<Line>().swap(lines_);
+  thread_num_ = 0;
+  wall_ms_ = 0;
+  busy_ms_ = 0;
+}
+
+opendrive::Status GeneratePolylines(const element::Map& ele_map,
+                                    const PolylineOptions& options,
+                                    MapPolylines* polylines) {
+  if (!polylines) {
+    return Status{ErrorCode::INVALID_ARGUMENT, "Input is null."};
+  }
+  if (!(options.step > 0) || !std::isfinite(options.step)) {
+    return Status{ErrorCode::INVALID_ARGUMENT, "Invalid polyline step."};
+  }
+  const auto begin_time = std::chrono::steady_clock::now();
+  const auto& roads = ele_map.roads();
+
+  /// 每条 road 的折线与点在输出中的起始位置
+  std::vector<size_t> line_begin(roads.size() + 1, 0);
+  std::vector<size_t> point_begin(roads.size() + 1, 0);
+  for (size_t r = 0; r < roads.size(); r++) {
+    const auto& road = roads[r];
+    size_t lines = 0;
+    size_t points = 0;
+    if (!road.plan_view().geometrys().empty()) {
+      if (options.reference_lines) {
+        lines++;
+        points += SampleNum(0, road.attribute().length(), options.step);
+      }
+      for (const auto& section : road.lanes().lane_sections()) {
+        const size_t num = SectionLineNum(section, options);
+        lines += num;
+        points += num * SampleNum(section.start_position(),
+                                  section.end_position(), options.step);
+      }
+    }
+    line_begin[r + 1] = line_begin[r] + lines;
+    point_begin[r + 1] = point_begin[r] + points;
+  }
+  polylines->lines_.resize(line_begin.back());
+  polylines->points_.resize(point_begin.back());
+
+  std::atomic<uint64_t> busy_ns{0};
+  auto write_range = [&](size_t begin, size_t end) {
+    const auto start = std::chrono::steady_clock::now();
+    Scratch scratch;
+    for (size_t r = begin; r < end; r++) {
+      if (line_begin[r] == line_begin[r + 1]) continue;
+      RoadWriter(roads[r], options, &scratch,
+                 polylines->lines_.data() + line_begin[r],
+                 polylines->points_.data() + point_begin[r], point_begin[r])
+          .Write();
+    }
+    busy_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - start)
+                          .count(),
+                      std::memory_order_relaxed);
+  };
+  size_t thread_num = 1;
+  if (1 != options.thread_num && roads.size() > 1) {
+    common::ThreadPool thread_pool(std::min(
+        roads.size(), 0 == options.thread_num
+                          ? common::ThreadPool::HardwareConcurrency()
+                          : options.thread_num));
+    thread_num = thread_pool.size();
+    thread_pool.ParallelFor(roads.size(), write_range);
+  } else {
+    write_range(0, roads.size());
+  }
+
+  polylines->thread_num_ = thread_num;
+  polylines->busy_ms_ = busy_ns.load() / 1e6;
+  polylines->wall_ms_ =
+      std::chrono::duration<double, std::milli>(
+          std::chrono::steady_clock::now() - begin_time)
+          .count();
+  return Status{ErrorCode::OK, "ok"};
+}
+
+}  // namespace opendrive
@@ -0,0 +1,738 @@
+#include "opendrive-cpp/snapshot/map_image.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace opendrive {
+namespace snapshot {
+
+namespace {
+
+constexpr char kMagic[8] = {'O', 'D', 'R', 'I', 'M', 'A', 'G', 'E'};
+constexpr uint32_t kByteOrderMark = 0x01020304;
+constexpr size_t kAlignment = 8;
+
+/// 各表记录大小, 下标为 record::TableType
+constexpr size_t kRecordSizes[record::kTableNum] = {
+    sizeof(record::Road),         sizeof(record::IdIndex),
+    sizeof(record::Junction),     sizeof(record::IdIndex),
+    sizeof(record::RoadTypeInfo), sizeof(record::Geometry),
+    sizeof(record::LaneSection),  sizeof(record::Lane),
+    sizeof(record::Poly3),        sizeof(record::RoadMark),
+    sizeof(record::Speed),        sizeof(int32_t),
+    sizeof(record::Connection),   sizeof(record::LaneLink),
+    sizeof(char),
+};
+
+static_assert(std::is_trivially_copyable<record::Road>::value &&
+                  std::is_trivially_copyable<record::Junction>::value &&
+                  std::is_trivially_copyable<record::ImageHeader>::value,
+              "image records must be trivially copyable");
+static_assert(sizeof(element::Id) == sizeof(int32_t),
+              "element::Id must be 32 bits");
+
+class ImageBuilder {
+ public:
+  void Build(const element::Map& ele_map, std::string* data) {
+    strings_.push_back('\0');
+    record::ImageHeader image_header{};
+    std::memcpy(image_header.magic, kMagic, sizeof(kMagic));
+    image_header.version = kMapImageVersion;
+    image_header.byte_order = kByteOrderMark;
+    AddHeader(ele_map.header(), &image_header.header);
+    for (const auto& junction : ele_map.junctions()) {
+      AddJunction(junction);
+    }
+    for (const auto& road : ele_map.roads()) {
+      AddRoad(road);
+    }
+    auto road_index = MakeIndex(roads_);
+    auto junction_index = MakeIndex(junctions_);
+
+    data->assign(sizeof(image_header), '\0');
+    auto tables = image_header.tables;
+    Write(roads_, data, &tables[record::kRoads]);
+    Write(road_index, data, &tables[record::kRoadIndex]);
+    Write(junctions_, data, &tables[record::kJunctions]);
+    Write(junction_index, data, &tables[record::kJunctionIndex]);
+    Write(type_infos_, data, &tables[record::kTypeInfos]);
+    Write(geometrys_, data, &tables[record::kGeometrys]);
+    Write(lane_sections_, data, &tables[record::kLaneSections]);
+    Write(lanes_, data, &tables[record::kLanes]);
+    Write(poly3s_, data, &tables[record::kPoly3s]);
+    Write(road_marks_, data, &tables[record::kRoadMarks]);
+    Write(speeds_, data, &tables[record::kSpeeds]);
+    Write(ids_, data, &tables[record::kIds]);
+    Write(connections_, data, &tables[record::kConnections]);
+    Write(lane_links_, data, &tables[record::kLaneLinks]);
+    Write(strings_, data, &tables[record::kStrings]);
+    image_header.image_size = data->size();
+    std::memcpy(&(*data)[0], &image_header, sizeof(image_header));
+  }
+
+ private:
+  template <typename T>
+  static void Write(const std::vector<T>& table, std::string* data,
+                    record::Table* ret) {
+    data->resize((data->size() + kAlignment - 1) / kAlignment * kAlignment,
+                 '\0');
+    ret->offset = data->size();
+    ret->size = table.size();
+    data->append(reinterpret_cast<const char*>(table.data()),
+                 table.size() * sizeof(T));
+  }
+
+  template <typename T>
+  static std::vector<record::IdIndex> MakeIndex(const std::vector<T>& table) {
+    std::vector<record::IdIndex> index;
+    index.reserve(table.size());
+    for (size_t i = 0; i < table.size(); i++) {
+      index.push_back({table[i].id, static_cast<uint32_t>(i)});
+    }
+    std::stable_sort(index.begin(), index.end(),
+                     [](const record::IdIndex& a, const record::IdIndex& b) {
+                       return a.id < b.id;
+                     });
+    return index;
+  }
+
+  template <typename T>
+  static record::Range Begin(const std::vector<T>& table) {
+    return record::Range{static_cast<uint32_t>(table.size()), 0};
+  }
+
+  template <typename T>
+  static void End(const std::vector<T>& table, record::Range* range) {
+    range->size = static_cast<uint32_t>(table.size()) - range->begin;
+  }
+
+  record::Str AddString(const element::String& str) {
+    record::Str ret{static_cast<uint32_t>(strings_.size()),
+                    static_cast<uint32_t>(str.size())};
+    strings_.insert(strings_.end(), str.begin(), str.end());
+    strings_.push_back('\0');
+    return ret;
+  }
+
+  record::Range AddIds(const element::Ids& ids) {
+    auto range = Begin(ids_);
+    ids_.insert(ids_.end(), ids.begin(), ids.end());
+    End(ids_, &range);
+    return range;
+  }
+
+  template <typename T>
+  record::Range AddPoly3s(const element::Vector<T>& items) {
+    auto range = Begin(poly3s_);
+    for (const auto& item : items) {
+      poly3s_.push_back({item.s(), item.a(), item.b(), item.c(), item.d()});
+    }
+    End(poly3s_, &range);
+    return range;
+  }
+
+  void AddHeader(const element::Header& header, record::Header* ret) {
+    ret->rev_major = AddString(header.rev_major());
+    ret->rev_minor = AddString(header.rev_minor());
+    ret->version = AddString(header.version());
+    ret->name = AddString(header.name());
+    ret->date = AddString(header.date());
+    ret->vendor = AddString(header.vendor());
+    ret->north = header.north();
+    ret->south = header.south();
+    ret->west = header.west();
+    ret->east = header.east();
+  }
+
+  record::Lane MakeLane(const element::Lane& lane) {
+    record::Lane ret{};
+    ret.id = lane.attribute().id();
+    ret.type = static_cast<uint8_t>(lane.attribute().type());
+    ret.level = static_cast<uint8_t>(lane.attribute().level());
+    ret.predecessors = AddIds(lane.link().predecessors());
+    ret.successors = AddIds(lane.link().successors());
+    ret.widths = AddPoly3s(lane.widths());
+    ret.borders = AddPoly3s(lane.borders());
+    ret.road_marks = Begin(road_marks_);
+    for (const auto& road_mark : lane.road_marks()) {
+      record::RoadMark item{};
+      item.s = road_mark.s();
+      item.width = road_mark.width();
+      item.height = road_mark.height();
+      item.material = AddString(road_mark.material());
+      item.type = static_cast<uint8_t>(road_mark.type());
+      item.color = static_cast<uint8_t>(road_mark.color());
+      item.weight = static_cast<uint8_t>(road_mark.weight());
+      item.lane_change = static_cast<uint8_t>(road_mark.lane_change());
+      road_marks_.push_back(item);
+    }
+    End(road_marks_, &ret.road_marks);
+    ret.speeds = Begin(speeds_);
+    for (const auto& speed : lane.max_speeds()) {
+      record::Speed item{};
+      item.s = speed.s();
+      item.max = speed.max();
+      item.unit = static_cast<uint8_t>(speed.unit());
+      speeds_.push_back(item);
+    }
+    End(speeds_, &ret.speeds);
+    return ret;
+  }
+
+  record::Range AddLanes(const element::LanesInfo& lanes_info) {
+    auto range = Begin(lanes_);
+    for (const auto& lane : lanes_info.lanes()) {
+      /// MakeLane 只追加其他表, lanes_ 保持连续
+      const auto item = MakeLane(lane);
+      lanes_.push_back(item);
+    }
+    End(lanes_, &range);
+    return range;
+  }
+
+  static record::RoadLink MakeRoadLink(const element::RoadLinkInfo& info) {
+    record::RoadLink ret{};
+    ret.start_position = info.start_position();
+    ret.id = info.id();
+    ret.type = static_cast<uint8_t>(info.type());
+    ret.contact_point = static_cast<uint8_t>(info.contact_point());
+    ret.dir = static_cast<uint8_t>(info.dir());
+    return ret;
+  }
+
+  static record::Geometry MakeGeometry(const element::Geometry& geometry) {
+    record::Geometry ret{};
+    ret.s = geometry.s();
+    ret.x = geometry.x();
+    ret.y = geometry.y();
+    ret.hdg = geometry.hdg();
+    ret.length = geometry.length();
+    ret.type = static_cast<uint8_t>(geometry.type());
+    switch (geometry.type()) {
+      case GeometryType::kArc: {
+        const auto& arc = static_cast<const element::GeometryArc&>(geometry);
+        ret.params[0] = arc.curvature();
+        break;
+      }
+      case GeometryType::kSpiral: {
+        const auto& spiral =
+            static_cast<const element::GeometrySpiral&>(geometry);
+        ret.params[0] = spiral.curve_start();
+        ret.params[1] = spiral.curve_end();
+        break;
+      }
+      case GeometryType::kPoly3: {
+        const auto& poly3 =
+            static_cast<const element::GeometryPoly3&>(geometry);
+        ret.params[0] = poly3.a();
+        ret.params[1] = poly3.b();
+        ret.params[2] = poly3.c();
+        ret.params[3] = poly3.d();
+        break;
+      }
+      case GeometryType::kParamPoly3: {
+        const auto& param_poly3 =
+            static_cast<const element::GeometryParamPoly3&>(geometry);
+        ret.params[0] = param_poly3.au();
+        ret.params[1] = param_poly3.bu();
+        ret.params[2] = param_poly3.cu();
+        ret.params[3] = param_poly3.du();
+        ret.params[4] = param_poly3.av();
+        ret.params[5] = param_poly3.bv();
+        ret.params[6] = param_poly3.cv();
+        ret.params[7] = param_poly3.dv();
+        ret.p_range = static_cast<uint8_t>(param_poly3.p_range());
+        break;
+      }
+      default:
+        break;
+    }
+    return ret;
+  }
+
+  void AddRoad(const element::Road& road) {
+    record::Road ret{};
+    ret.length = road.attribute().length();
+    ret.name = AddString(road.attribute().name());
+    ret.id = road.attribute().id();
+    ret.junction_id = road.attribute().junction_id();
+    ret.rule = static_cast<uint8_t>(road.attribute().rule());
+    ret.predecessor = MakeRoadLink(road.link().predecessor());
+    ret.successor = MakeRoadLink(road.link().successor());
+    ret.type_info = Begin(type_infos_);
+    for (const auto& type_info : road.type_info()) {
+      record::RoadTypeInfo item{};
+      item.start_position = type_info.start_position();
+      item.country = AddString(type_info.country());
+      item.max_speed = type_info.max_speed();
+      item.type = static_cast<uint8_t>(type_info.type());
+      item.speed_unit = static_cast<uint8_t>(type_info.speed_unit());
+      type_infos_.push_back(item);
+    }
+    End(type_infos_, &ret.type_info);
+    ret.geometrys = Begin(geometrys_);
+    for (const auto& geometry : road.plan_view().geometrys()) {
+      geometrys_.push_back(MakeGeometry(*geometry));
+    }
+    End(geometrys_, &ret.geometrys);
+    ret.lane_offsets = AddPoly3s(road.lanes().lane_offsets());
+    ret.lane_sections = Begin(lane_sections_);
+    for (const auto& section : road.lanes().lane_sections()) {
+      record::LaneSection item{};
+      item.start_position = section.start_position();
+      item.end_position = section.end_position();
+      item.id = section.id();
+      item.left = AddLanes(section.left());
+      item.center = AddLanes(section.center());
+      item.right = AddLanes(section.right());
+      lane_sections_.push_back(item);
+    }
+    End(lane_sections_, &ret.lane_sections);
+    roads_.push_back(ret);
+  }
+
+  void AddJunction(const element::Junction& junction) {
+    const auto& attribute = junction.attribute();
+    record::Junction ret{};
+    ret.start_position = attribute.start_position();
+    ret.end_position = attribute.end_position();
+    ret.name = AddString(attribute.name());
+    ret.id = attribute.id();
+    ret.main_road = attribute.main_road();
+    ret.type = static_cast<uint8_t>(attribute.type());
+    ret.dir = static_cast<uint8_t>(attribute.dir());
+    ret.connections = Begin(connections_);
+    for (const auto& connection : junction.connections()) {
+      record::Connection item{};
+      item.id = connection.id();
+      item.incoming_road = connection.incoming_road();
+      item.connecting_road = connection.connecting_road();
+      item.linked_road = connection.linked_road();
+      item.type = static_cast<uint8_t>(connection.type());
+      item.contact_point = static_cast<uint8_t>(connection.contact_point());
+      item.lane_links = Begin(lane_links_);
+      for (const auto& lane_link : connection.lane_links()) {
+        lane_links_.push_back({lane_link.from(), lane_link.to()});
+      }
+      End(lane_links_, &item.lane_links);
+      connections_.push_back(item);
+    }
+    End(connections_, &ret.connections);
+    junctions_.push_back(ret);
+  }
+
+  std::vector<record::Road> roads_;
+  std::vector<record::Junction> junctions_;
+  std::vector<record::RoadTypeInfo> type_infos_;
+  std::vector<record::Geometry> geometrys_;
+  std::vector<record::LaneSection> lane_sections_;
+  std::vector<record::Lane> lanes_;
+  std::vector<record::Poly3> poly3s_;
+  std::vector<record::RoadMark> road_marks_;
+  std::vector<record::Speed> speeds_;
+  std::vector<int32_t> ids_;
+  std::vector<record::Connection> connections_;
+  std::vector<record::LaneLink> lane_links_;
+  std::vector<char> strings_;
+};
+
+template <typename View>
+ViewList<View> MakeViewList(const MapImage* image, record::TableType table,
+                            const record::Range& range) {
+  return ViewList<View>(
+      image, image->Slice<typename View::Record>(table, range), range.size);
+}
+
+template <typename T>
+RecordList<T> MakeRecordList(const MapImage* image, record::TableType table,
+                             const record::Range& range) {
+  return RecordList<T>(image->Slice<T>(table, range), range.size);
+}
+
+template <typename T>
+const T* Find(const MapImage* image, record::TableType index_table,
+              record::TableType table, size_t size, element::Id id) {
+  const auto index = image->Slice<record::IdIndex>(index_table, {0, 0});
+  const auto it = std::lower_bound(
+      index, index + size, id,
+      [](const record::IdIndex& a, element::Id b) { return a.id < b; });
+  if (it == index + size || it->id != id) {
+    return nullptr;
+  }
+  return image->Slice<T>(table, {it->index, 1});
+}
+
+}  // namespace
+
+/// ------------------------------ views ------------------------------
+
+element::Point GeometryView::GetPoint(double road_s) const {
+  const auto& r = *record_;
+  const auto type = static_cast<GeometryType>(r.type);
+  switch (type) {
+    case GeometryType::kLine:
+      return element::GeometryLine(r.s, r.x, r.y, r.hdg, r.length, type)
+          .GetPoint(road_s);
+    case GeometryType::kArc:
+      return element::GeometryArc(r.s, r.x, r.y, r.hdg, r.length, type,
+                                  r.params[0])
+          .GetPoint(road_s);
+    case GeometryType::kSpiral:
+      return element::GeometrySpiral(r.s, r.x, r.y, r.hdg, r.length, type,
+                                     r.params[0], r.params[1])
+          .GetPoint(road_s);
+    case GeometryType::kPoly3:
+      return element::GeometryPoly3(r.s, r.x, r.y, r.hdg, r.length, type,
+                                    r.params[0], r.params[1], r.params[2],
+                                    r.params[3])
+          .GetPoint(road_s);
+    case GeometryType::kParamPoly3:
+      return element::GeometryParamPoly3(
+                 r.s, r.x, r.y, r.hdg, r.length, type, r.params[0],
+                 r.params[1], r.params[2], r.params[3], r.params[4],
+                 r.params[5], r.params[6], r.params[7],
+                 static_cast<element::GeometryParamPoly3::PRange>(r.p_range))
+          .GetPoint(road_s);
+    default:
+      return element::Point();
+  }
+}
+
+element::Geometry::Ptr GeometryView::ToElement() const {
+  const auto& r = *record_;
+  const auto type = static_cast<GeometryType>(r.type);
+  switch (type) {
+    case GeometryType::kLine:
+      return element::AllocateGeometry<element::GeometryLine>(
+          r.s, r.x, r.y, r.hdg, r.length, type);
+    case GeometryType::kArc:
+      return element::AllocateGeometry<element::GeometryArc>(
+          r.s, r.x, r.y, r.hdg, r.length, type, r.params[0]);
+    case GeometryType::kSpiral:
+      return element::AllocateGeometry<element::GeometrySpiral>(
+          r.s, r.x, r.y, r.hdg, r.length, type, r.params[0], r.params[1]);
+    case GeometryType::kPoly3:
+      return element::AllocateGeometry<element::GeometryPoly3>(
+          r.s, r.x, r.y, r.hdg, r.length, type, r.params[0], r.params[1],
+          r.params[2], r.params[3]);
+    case GeometryType::kParamPoly3:
+      return element::AllocateGeometry<element::GeometryParamPoly3>(
+          r.s, r.x, r.y, r.hdg, r.length, type, r.params[0], r.params[1],
+          r.params[2], r.params[3], r.params[4], r.params[5], r.params[6],
+          r.params[7],
+          static_cast<element::GeometryParamPoly3::PRange>(r.p_range));
+    default:
+      return nullptr;
+  }
+}
+
+const char* RoadMarkView::material() const noexcept {
+  return image_->String(record_->material);
+}
+
+RecordList<int32_t> LaneView::predecessors() const {
+  return MakeRecordList<int32_t>(image_, record::kIds, record_->predecessors);
+}
+
+RecordList<int32_t> LaneView::successors() const {
+  return MakeRecordList<int32_t>(image_, record::kIds, record_->successors);
+}
+
+RecordList<record::Poly3> LaneView::widths() const {
+  return MakeRecordList<record::Poly3>(image_, record::kPoly3s,
+                                       record_->widths);
+}
+
+RecordList<record::Poly3> LaneView::borders() const {
+  return MakeRecordList<record::Poly3>(image_, record::kPoly3s,
+                                       record_->borders);
+}
+
+ViewList<RoadMarkView> LaneView::road_marks() const {
+  return MakeViewList<RoadMarkView>(image_, record::kRoadMarks,
+                                    record_->road_marks);
+}
+
+RecordList<record::Speed> LaneView::max_speeds() const {
+  return MakeRecordList<record::Speed>(image_, record::kSpeeds,
+                                       record_->speeds);
+}
+
+ViewList<LaneView> LaneSectionView::left() const {
+  return MakeViewList<LaneView>(image_, record::kLanes, record_->left);
+}
+
+ViewList<LaneView> LaneSectionView::center() const {
+  return MakeViewList<LaneView>(image_, record::kLanes, record_->center);
+}
+
+ViewList<LaneView> LaneSectionView::right() const {
+  return MakeViewList<LaneView>(image_, record::kLanes, record_->right);
+}
+
+const char* RoadTypeInfoView::country() const noexcept {
+  return image_->String(record_->country);
+}
+
+const char* RoadView::name() const noexcept {
+  return image_->String(record_->name);
+}
+
+ViewList<RoadTypeInfoView> RoadView::type_info() const {
+  return MakeViewList<RoadTypeInfoView>(image_, record::kTypeInfos,
+                                        record_->type_info);
+}
+
+ViewList<GeometryView> RoadView::geometrys() const {
+  return MakeViewList<GeometryView>(image_, record::kGeometrys,
+                                    record_->geometrys);
+}
+
+RecordList<record::Poly3> RoadView::lane_offsets() const {
+  return MakeRecordList<record::Poly3>(image_, record::kPoly3s,
+                                       record_->lane_offsets);
+}
+
+ViewList<LaneSectionView> RoadView::lane_sections() const {
+  return MakeViewList<LaneSectionView>(image_, record::kLaneSections,
+                                       record_->lane_sections);
+}
+
+RecordList<record::LaneLink> ConnectionView::lane_links() const {
+  return MakeRecordList<record::LaneLink>(image_, record::kLaneLinks,
+                                          record_->lane_links);
+}
+
+const char* JunctionView::name() const noexcept {
+  return image_->String(record_->name);
+}
+
+ViewList<ConnectionView> JunctionView::connections() const {
+  return MakeViewList<ConnectionView>(image_, record::kConnections,
+                                      record_->connections);
+}
+
+/// ------------------------------ image ------------------------------
+
+opendrive::Status MapImage::Attach(const std::string& file, bool verify) {
+  Detach();
+  if (!mapped_file_.Open(file)) {
+    return Status{ErrorCode::LOAD_DATA_ERROR, "Open Map Image Exection."};
+  }
+  mapped_file_.Advise(common::MappedFile::Advice::kRandom);
+  auto status = Attach(mapped_file_.data(), mapped_file_.size(), verify);
+  if (ErrorCode::OK != status.error_code) {
+    mapped_file_.Close();
+  }
+  return status;
+}
+
+opendrive::Status MapImage::Attach(const char* data, size_t size,
+                                   bool verify) {
+  if (data != mapped_file_.data()) {
+    Detach();
+  }
+  const auto image_header = reinterpret_cast<const record::ImageHeader*>(data);
+  if (!data || size < sizeof(record::ImageHeader) ||
+      0 != reinterpret_cast<uintptr_t>(data) % kAlignment ||
+      0 != std::memcmp(image_header->magic, kMagic, sizeof(kMagic))) {
+    return Status{ErrorCode::LOAD_DATA_ERROR, "Map Image Magic Mismatch."};
+  }
+  if (kMapImageVersion != image_header->version ||
+      kByteOrderMark != image_header->byte_order) {
+    return Status{ErrorCode::LOAD_DATA_ERROR,
+                  "Map Image Version Or Byte Order Mismatch."};
+  }
+  if (image_header->image_size != size) {
+    return Status{ErrorCode::LOAD_DATA_ERROR, "Map Image Size Mismatch."};
+  }
+  for (uint32_t i = 0; i < record::kTableNum; i++) {
+    const auto& table = image_header->tables[i];
+    if (0 != table.offset % kAlignment || table.offset > size ||
+        table.size > (size - table.offset) / kRecordSizes[i]) {
+      return Status{ErrorCode::LOAD_DATA_ERROR, "Map Image Table Mismatch."};
+    }
+  }
+  data_ = data;
+  size_ = size;
+  image_header_ = image_header;
+  if (verify && !Verify()) {
+    data_ = nullptr;
+    size_ = 0;
+    image_header_ = nullptr;
+    return Status{ErrorCode::LOAD_DATA_ERROR, "Map Image Is Corrupted."};
+  }
+  return Status{ErrorCode::OK, "ok"};
+}
+
+void MapImage::Detach() {
+  mapped_file_.Close();
+  data_ = nullptr;
+  size_ = 0;
+  image_header_ = nullptr;
+}
+
+bool MapImage::Verify() const {
+  const auto tables = image_header_->tables;
+  auto in_table = [tables](record::TableType table,
+                           const record::Range& range) {
+    return range.begin <= tables[table].size &&
+           range.size <= tables[table].size - range.begin;
+  };
+  const char* strings = data_ + tables[record::kStrings].offset;
+  const uint64_t strings_size = tables[record::kStrings].size;
+  auto valid_str = [strings, strings_size](const record::Str& str) {
+    return str.offset < strings_size &&
+           str.size < strings_size - str.offset &&
+           '\0' == strings[str.offset + str.size];
+  };
+  auto table = [tables](record::TableType type) {
+    return record::Range{0, static_cast<uint32_t>(tables[type].size)};
+  };
+  const auto& header = image_header_->header;
+  for (const auto& str : {header.rev_major, header.rev_minor, header.version,
+                          header.name, header.date, header.vendor}) {
+    if (!valid_str(str)) return false;
+  }
+  for (const auto& index : {record::kRoadIndex, record::kJunctionIndex}) {
+    const auto target =
+        record::kRoadIndex == index ? record::kRoads : record::kJunctions;
+    for (const auto& item :
+         MakeRecordList<record::IdIndex>(this, index, table(index))) {
+      if (item.index >= tables[target].size) return false;
+    }
+  }
+  for (const auto& road :
+       MakeRecordList<record::Road>(this, record::kRoads,
+                                    table(record::kRoads))) {
+    if (!valid_str(road.name) ||
+        !in_table(record::kTypeInfos, road.type_info) ||
+        !in_table(record::kGeometrys, road.geometrys) ||
+        !in_table(record::kPoly3s, road.lane_offsets) ||
+        !in_table(record::kLaneSections, road.lane_sections)) {
+      return false;
+    }
+  }
+  for (const auto& type_info : MakeRecordList<record::RoadTypeInfo>(
+           this, record::kTypeInfos, table(record::kTypeInfos))) {
+    if (!valid_str(type_info.country)) return false;
+  }
+  for (const auto& section : MakeRecordList<record::LaneSection>(
+           this, record::kLaneSections, table(record::kLaneSections))) {
+    if (!in_table(record::kLanes, section.left) ||
+        !in_table(record::kLanes, section.center) ||
+        !in_table(record::kLanes, section.right)) {
+      return false;
+    }
+  }
+  for (const auto& lane : MakeRecordList<record::Lane>(
+           this, record::kLanes, table(record::kLanes))) {
+    if (!in_table(record::kIds, lane.predecessors) ||
+        !in_table(record::kIds, lane.successors) ||
+        !in_table(record::kPoly3s, lane.widths) ||
+        !in_table(record::kPoly3s, lane.borders) ||
+        !in_table(record::kRoadMarks, lane.road_marks) ||
+        !in_table(record::kSpeeds, lane.speeds)) {
+      return false;
+    }
+  }
+  for (const auto& road_mark : MakeRecordList<record::RoadMark>(
+           this, record::kRoadMarks, table(record::kRoadMarks))) {
+    if (!valid_str(road_mark.material)) return false;
+  }
+  for (const auto& junction : MakeRecordList<record::Junction>(
+           this, record::kJunctions, table(record::kJunctions))) {
+    if (!valid_str(junction.name) ||
+        !in_table(record::kConnections, junction.connections)) {
+      return false;
+    }
+  }
+  for (const auto& connection : MakeRecordList<record::Connection>(
+           this, record::kConnections, table(record::kConnections))) {
+    if (!in_table(record::kLaneLinks, connection.lane_links)) return false;
+  }
+  return true;
+}
+
+const char* MapImage::rev_major() const noexcept {
+  return String(header().rev_major);
+}
+
+const char* MapImage::rev_minor() const noexcept {
+  return String(header().rev_minor);
+}
+
+const char* MapImage::version() const noexcept {
+  return String(header().version);
+}
+
+const char* MapImage::name() const noexcept { return String(header().name); }
+
+const char* MapImage::date() const noexcept { return String(header().date); }
+
+const char* MapImage::vendor() const noexcept {
+  return String(header().vendor);
+}
+
+ViewList<RoadView> MapImage::roads() const {
+  const auto size = image_header_->tables[record::kRoads].size;
+  return MakeViewList<RoadView>(this, record::kRoads,
+                                {0, static_cast<uint32_t>(size)});
+}
+
+ViewList<JunctionView> MapImage::junctions() const {
+  const auto size = image_header_->tables[record::kJunctions].size;
+  return MakeViewList<JunctionView>(this, record::kJunctions,
+                                    {0, static_cast<uint32_t>(size)});
+}
+
+RoadView MapImage::GetRoad(element::Id id) const {
+  const auto road = Find<record::Road>(
+      this, record::kRoadIndex, record::kRoads,
+      image_header_->tables[record::kRoadIndex].size, id);
+  return road ? RoadView(this, road) : RoadView();
+}
+
+JunctionView MapImage::GetJunction(element::Id id) const {
+  const auto junction = Find<record::Junction>(
+      this, record::kJunctionIndex, record::kJunctions,
+      image_header_->tables[record::kJunctionIndex].size, id);
+  return junction ? JunctionView(this, junction) : JunctionView();
+}
+
+opendrive::Status BuildMapImage(const element::Map& ele_map,
+                                std::string* data) {
+  if (!data) {
+    return Status{ErrorCode::SAVE_DATA_ERROR, "Input is null."};
+  }
+  ImageBuilder().Build(ele_map, data);
+  return Status{ErrorCode::OK, "ok"};
+}
+
+opendrive::Status SaveMapImage(const element::Map& ele_map,
+                               const std::string& file) {
+  std::string data;
+  auto status = BuildMapImage(ele_map, &data);
+  if (ErrorCode::OK != status.error_code) {
+    return status;
+  }
+  const std::string tmp_file = file + ".tmp";
+  FILE* fp = std::fopen(tmp_file.c_str(), "wb");
+  if (!fp) {
+    return Status{ErrorCode::SAVE_DATA_ERROR, "Open Map Image Exection."};
+  }
+  const size_t n = std::fwrite(data.data(), 1, data.size(), fp);
+  const bool closed = 0 == std::fclose(fp);
+  if (n != data.size() || !closed ||
+      0 != std::rename(tmp_file.c_str(), file.c_str())) {
+    std::remove(tmp_file.c_str());
+    return Status{ErrorCode::SAVE_DATA_ERROR, "Write Map Image Exection."};
+  }
+  return Status{ErrorCode::OK, "ok"};
+}
+
+}  // namespace snapshot
+}  // namespace opendrive
@@ -0,0 +1,603 @@
+#include "opendrive-cpp/snapshot/snapshot.h"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#include "opendrive-cpp/common/mapped_file.h"
+
+namespace opendrive {
+namespace snapshot {
+
+namespace {
+
+constexpr char kMagic[8] = {'O', 'D', 'R', 'S', 'N', 'A', 'P', '\0'};
+constexpr uint32_t kByteOrderMark = 0x01020304;
+constexpr size_t kHeaderSize = sizeof(kMagic) + 4 + 4 + 8;
+
+class Writer {
+ public:
+  explicit Writer(std::string* data) : data_(data) {}
+
+  template <typename T>
+  typename std::enable_if<std::is_arithmetic<T>::value>::type Put(T value) {
+    data_->append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  template <typename T>
+  typename std::enable_if<std::is_enum<T>::value>::type Put(T value) {
+    Put(static_cast<uint8_t>(value));
+  }
+
+  void Put(const element::String& value) {
+    PutSize(value.size());
+    data_->append(value.data(), value.size());
+  }
+
+  void PutSize(size_t size) { Put(static_cast<uint32_t>(size)); }
+
+ private:
+  std::string* data_;
+};
+
+class Reader {
+ public:
+  Reader(const char* data, size_t size) : data_(data), size_(size) {}
+
+  bool ok() const noexcept { return ok_; }
+  size_t pos() const noexcept { return pos_; }
+
+  template <typename T>
+  typename std::enable_if<std::is_arithmetic<T>::value, T>::type Get() {
+    T value = T();
+    if (!Require(sizeof(T))) return value;
+    std::memcpy(&value, data_ + pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return value;
+  }
+
+  template <typename T>
+  typename std::enable_if<std::is_enum<T>::value, T>::type Get() {
+    return static_cast<T>(Get<uint8_t>());
+  }
+
+  void GetString(element::String* value) {
+    const size_t size = GetSize(1);
+    if (!Require(size)) return;
+    value->assign(data_ + pos_, size);
+    pos_ += size;
+  }
+
+  /**
+   * @brief 读取容器长度
+   *
+   * @param min_item_size 单个元素的最小编码长度, 用于拒绝损坏的长度
+   */
+  size_t GetSize(size_t min_item_size) {
+    const size_t size = Get<uint32_t>();
+    if (ok_ && size * min_item_size > size_ - pos_) {
+      ok_ = false;
+      return 0;
+    }
+    return size;
+  }
+
+ private:
+  bool Require(size_t n) {
+    if (!ok_ || n > size_ - pos_) {
+      ok_ = false;
+      return false;
+    }
+    return true;
+  }
+  const char* data_;
+  size_t size_;
+  size_t pos_ = 0;
+  bool ok_ = true;
+};
+
+/// ------------------------------ write ------------------------------
+
+void WriteHeader(Writer& w, const element::Header& header) {
+  w.Put(header.rev_major());
+  w.Put(header.rev_minor());
+  w.Put(header.version());
+  w.Put(header.name());
+  w.Put(header.date());
+  w.Put(header.vendor());
+  w.Put(header.north());
+  w.Put(header.south());
+  w.Put(header.west());
+  w.Put(header.east());
+}
+
+void WriteGeometry(Writer& w, const element::Geometry& geometry) {
+  w.Put(geometry.type());
+  w.Put(geometry.s());
+  w.Put(geometry.x());
+  w.Put(geometry.y());
+  w.Put(geometry.hdg());
+  w.Put(geometry.length());
+  switch (geometry.type()) {
+    case GeometryType::kArc: {
+      const auto& arc = static_cast<const element::GeometryArc&>(geometry);
+      w.Put(arc.curvature());
+      break;
+    }
+    case GeometryType::kSpiral: {
+      const auto& spiral =
+          static_cast<const element::GeometrySpiral&>(geometry);
+      w.Put(spiral.curve_start());
+      w.Put(spiral.curve_end());
+      break;
+    }
+    case GeometryType::kPoly3: {
+      const auto& poly3 = static_cast<const element::GeometryPoly3&>(geometry);
+      w.Put(poly3.a());
+      w.Put(poly3.b());
+      w.Put(poly3.c());
+      w.Put(poly3.d());
+      break;
+    }
+    case GeometryType::kParamPoly3: {
+      const auto& param_poly3 =
+          static_cast<const element::GeometryParamPoly3&>(geometry);
+      w.Put(param_poly3.au());
+      w.Put(param_poly3.bu());
+      w.Put(param_poly3.cu());
+      w.Put(param_poly3.du());
+      w.Put(param_poly3.av());
+      w.Put(param_poly3.bv());
+      w.Put(param_poly3.cv());
+      w.Put(param_poly3.dv());
+      w.Put(param_poly3.p_range());
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+template <typename T>
+void WriteOffsetPoly3s(Writer& w, const element::Vector<T>& items) {
+  w.PutSize(items.size());
+  for (const auto& item : items) {
+    w.Put(item.s());
+    w.Put(item.a());
+    w.Put(item.b());
+    w.Put(item.c());
+    w.Put(item.d());
+  }
+}
+
+void WriteIds(Writer& w, const element::Ids& ids) {
+  w.PutSize(ids.size());
+  for (const auto id : ids) {
+    w.Put(id);
+  }
+}
+
+void WriteLane(Writer& w, const element::Lane& lane) {
+  w.Put(lane.attribute().id());
+  w.Put(lane.attribute().type());
+  w.Put(lane.attribute().level());
+  WriteIds(w, lane.link().predecessors());
+  WriteIds(w, lane.link().successors());
+  WriteOffsetPoly3s(w, lane.widths());
+  WriteOffsetPoly3s(w, lane.borders());
+  w.PutSize(lane.road_marks().size());
+  for (const auto& road_mark : lane.road_marks()) {
+    w.Put(road_mark.s());
+    w.Put(road_mark.type());
+    w.Put(road_mark.color());
+    w.Put(road_mark.weight());
+    w.Put(road_mark.lane_change());
+    w.Put(road_mark.width());
+    w.Put(road_mark.height());
+    w.Put(road_mark.material());
+  }
+  w.PutSize(lane.max_speeds().size());
+  for (const auto& speed : lane.max_speeds()) {
+    w.Put(speed.s());
+    w.Put(speed.max());
+    w.Put(speed.unit());
+  }
+}
+
+void WriteLanesInfo(Writer& w, const element::LanesInfo& lanes_info) {
+  w.PutSize(lanes_info.lanes().size());
+  for (const auto& lane : lanes_info.lanes()) {
+    WriteLane(w, lane);
+  }
+}
+
+void WriteRoadLinkInfo(Writer& w, const element::RoadLinkInfo& info) {
+  w.Put(info.id());
+  w.Put(info.start_position());
+  w.Put(info.type());
+  w.Put(info.contact_point());
+  w.Put(info.dir());
+}
+
+void WriteRoad(Writer& w, const element::Road& road) {
+  const auto& attribute = road.attribute();
+  w.Put(attribute.name());
+  w.Put(attribute.id());
+  w.Put(attribute.junction_id());
+  w.Put(attribute.length());
+  w.Put(attribute.rule());
+  WriteRoadLinkInfo(w, road.link().predecessor());
+  WriteRoadLinkInfo(w, road.link().successor());
+  w.PutSize(road.type_info().size());
+  for (const auto& type_info : road.type_info()) {
+    w.Put(type_info.start_position());
+    w.Put(type_info.type());
+    w.Put(type_info.country());
+    w.Put(type_info.max_speed());
+    w.Put(type_info.speed_unit());
+  }
+  w.PutSize(road.plan_view().geometrys().size());
+  for (const auto& geometry : road.plan_view().geometrys()) {
+    WriteGeometry(w, *geometry);
+  }
+  WriteOffsetPoly3s(w, road.lanes().lane_offsets());
+  w.PutSize(road.lanes().lane_sections().size());
+  for (const auto& section : road.lanes().lane_sections()) {
+    w.Put(section.id());
+    w.Put(section.start_position());
+    w.Put(section.end_position());
+    WriteLanesInfo(w, section.left());
+    WriteLanesInfo(w, section.center());
+    WriteLanesInfo(w, section.right());
+  }
+}
+
+void WriteJunction(Writer& w, const element::Junction& junction) {
+  const auto& attribute = junction.attribute();
+  w.Put(attribute.id());
+  w.Put(attribute.name());
+  w.Put(attribute.type());
+  w.Put(attribute.main_road());
+  w.Put(attribute.start_position());
+  w.Put(attribute.end_position());
+  w.Put(attribute.dir());
+  w.PutSize(junction.connections().size());
+  for (const auto& connection : junction.connections()) {
+    w.Put(connection.id());
+    w.Put(connection.type());
+    w.Put(connection.incoming_road());
+    w.Put(connection.connecting_road());
+    w.Put(connection.linked_road());
+    w.Put(connection.contact_point());
+    w.PutSize(connection.lane_links().size());
+    for (const auto& lane_link : connection.lane_links()) {
+      w.Put(lane_link.from());
+      w.Put(lane_link.to());
+    }
+  }
+}
+
+/// ------------------------------ read ------------------------------
+
+void ReadHeader(Reader& r, element::Header* header) {
+  r.GetString(header->mutable_rev_major());
+  r.GetString(header->mutable_rev_minor());
+  r.GetString(header->mutable_version());
+  r.GetString(header->mutable_name());
+  r.GetString(header->mutable_date());
+  r.GetString(header->mutable_vendor());
+  header->set_north(r.Get<double>());
+  header->set_south(r.Get<double>());
+  header->set_west(r.Get<double>());
+  header->set_east(r.Get<double>());
+}
+
+element::Geometry::Ptr ReadGeometry(Reader& r) {
+  const auto type = r.Get<GeometryType>();
+  const double s = r.Get<double>();
+  const double x = r.Get<double>();
+  const double y = r.Get<double>();
+  const double hdg = r.Get<double>();
+  const double length = r.Get<double>();
+  switch (type) {
+    case GeometryType::kLine:
+      return element::AllocateGeometry<element::GeometryLine>(s, x, y, hdg,
+                                                              length, type);
+    case GeometryType::kArc: {
+      const double curvature = r.Get<double>();
+      return element::AllocateGeometry<element::GeometryArc>(
+          s, x, y, hdg, length, type, curvature);
+    }
+    case GeometryType::kSpiral: {
+      const double curve_start = r.Get<double>();
+      const double curve_end = r.Get<double>();
+      return element::AllocateGeometry<element::GeometrySpiral>(
+          s, x, y, hdg, length, type, curve_start, curve_end);
+    }
+    case GeometryType::kPoly3: {
+      const double a = r.Get<double>();
+      const double b = r.Get<double>();
+      const double c = r.Get<double>();
+      const double d = r.Get<double>();
+      return element::AllocateGeometry<element::GeometryPoly3>(
+          s, x, y, hdg, length, type, a, b, c, d);
+    }
+    case GeometryType::kParamPoly3: {
+      double coefs[8];
+      for (auto& coef : coefs) {
+        coef = r.Get<double>();
+      }
+      const auto p_range = r.Get<element::GeometryParamPoly3::PRange>();
+      return element::AllocateGeometry<element::GeometryParamPoly3>(
+          s, x, y, hdg, length, type, coefs[0], coefs[1], coefs[2], coefs[3],
+          coefs[4], coefs[5], coefs[6], coefs[7], p_range);
+    }
+    default:
+      return nullptr;
+  }
+}
+
+template <typename T>
+void ReadOffsetPoly3s(Reader& r, element::Vector<T>* items) {
+  const size_t size = r.GetSize(5 * sizeof(double));
+  items->resize(size);
+  for (auto& item : *items) {
+    item.set_s(r.Get<double>());
+    item.set_a(r.Get<double>());
+    item.set_b(r.Get<double>());
+    item.set_c(r.Get<double>());
+    item.set_d(r.Get<double>());
+  }
+}
+
+void ReadIds(Reader& r, element::Ids* ids) {
+  const size_t size = r.GetSize(sizeof(element::Id));
+  ids->resize(size);
+  for (auto& id : *ids) {
+    id = r.Get<element::Id>();
+  }
+}
+
+void ReadLane(Reader& r, element::Lane* lane) {
+  lane->mutable_attribute()->set_id(r.Get<element::Id>());
+  lane->mutable_attribute()->set_type(r.Get<LaneType>());
+  lane->mutable_attribute()->set_level(r.Get<Boolean>());
+  ReadIds(r, lane->mutable_link()->mutable_predecessors());
+  ReadIds(r, lane->mutable_link()->mutable_successors());
+  ReadOffsetPoly3s(r, lane->mutable_widths());
+  ReadOffsetPoly3s(r, lane->mutable_borders());
+  lane->mutable_road_marks()->resize(r.GetSize(3 * sizeof(double)));
+  for (auto& road_mark : *lane->mutable_road_marks()) {
+    road_mark.set_s(r.Get<double>());
+    road_mark.set_type(r.Get<RoadMarkType>());
+    road_mark.set_color(r.Get<RoadMarkColor>());
+    road_mark.set_weight(r.Get<RoadMarkWeight>());
+    road_mark.set_lane_change(r.Get<RoadMarkLaneChange>());
+    road_mark.set_width(r.Get<double>());
+    road_mark.set_height(r.Get<double>());
+    r.GetString(road_mark.mutable_material());
+  }
+  lane->mutable_max_speeds()->resize(r.GetSize(sizeof(double)));
+  for (auto& speed : *lane->mutable_max_speeds()) {
+    speed.set_s(r.Get<double>());
+    speed.set_max(r.Get<float>());
+    speed.set_unit(r.Get<SpeedUnit>());
+  }
+}
+
+void ReadLanesInfo(Reader& r, element::LanesInfo* lanes_info) {
+  lanes_info->mutable_lanes()->resize(r.GetSize(sizeof(element::Id)));
+  for (auto& lane : *lanes_info->mutable_lanes()) {
+    ReadLane(r, &lane);
+  }
+}
+
+void ReadRoadLinkInfo(Reader& r, element::RoadLinkInfo* info) {
+  info->set_id(r.Get<element::Id>());
+  info->set_start_position(r.Get<double>());
+  info->set_type(r.Get<RoadLinkType>());
+  info->set_contact_point(r.Get<ContactPointType>());
+  info->set_dir(r.Get<Dir>());
+}
+
+bool ReadRoad(Reader& r, element::Road* road) {
+  auto attribute = road->mutable_attribute();
+  r.GetString(attribute->mutable_name());
+  attribute->set_id(r.Get<element::Id>());
+  attribute->set_junction_id(r.Get<element::Id>());
+  attribute->set_length(r.Get<double>());
+  attribute->set_rule(r.Get<RoadRule>());
+  ReadRoadLinkInfo(r, road->mutable_link()->mutable_predecessor());
+  ReadRoadLinkInfo(r, road->mutable_link()->mutable_successor());
+  road->mutable_type_info()->resize(r.GetSize(sizeof(double)));
+  for (auto& type_info : *road->mutable_type_info()) {
+    type_info.set_start_position(r.Get<double>());
+    type_info.set_type(r.Get<RoadType>());
+    r.GetString(type_info.mutable_country());
+    type_info.set_max_speed(r.Get<float>());
+    type_info.set_speed_unit(r.Get<SpeedUnit>());
+  }
+  const size_t geometry_size = r.GetSize(5 * sizeof(double));
+  auto geometrys = road->mutable_plan_view()->mutable_geometrys();
+  geometrys->reserve(geometry_size);
+  for (size_t i = 0; i < geometry_size && r.ok(); i++) {
+    auto geometry = ReadGeometry(r);
+    if (!geometry) return false;
+    geometrys->emplace_back(std::move(geometry));
+  }
+  ReadOffsetPoly3s(r, road->mutable_lanes()->mutable_lane_offsets());
+  auto sections = road->mutable_lanes()->mutable_lane_sections();
+  sections->resize(r.GetSize(2 * sizeof(double)));
+  for (auto& section : *sections) {
+    section.set_id(r.Get<element::Id>());
+    section.set_start_position(r.Get<double>());
+    section.set_end_position(r.Get<double>());
+    ReadLanesInfo(r, section.mutable_left());
+    ReadLanesInfo(r, section.mutable_center());
+    ReadLanesInfo(r, section.mutable_right());
+    if (!r.ok()) return false;
+  }
+  return r.ok();
+}
+
+void ReadJunction(Reader& r, element::Junction* junction) {
+  auto attribute = junction->mutable_attribute();
+  attribute->set_id(r.Get<element::Id>());
+  r.GetString(attribute->mutable_name());
+  attribute->set_type(r.Get<JunctionType>());
+  attribute->set_main_road(r.Get<element::Id>());
+  attribute->set_start_position(r.Get<double>());
+  attribute->set_end_position(r.Get<double>());
+  attribute->set_dir(r.Get<Dir>());
+  junction->mutable_connections()->resize(r.GetSize(4 * sizeof(element::Id)));
+  for (auto& connection : *junction->mutable_connections()) {
+    connection.set_id(r.Get<element::Id>());
+    connection.set_type(r.Get<JunctionConnectionType>());
+    connection.set_incoming_road(r.Get<element::Id>());
+    connection.set_connecting_road(r.Get<element::Id>());
+    connection.set_linked_road(r.Get<element::Id>());
+    connection.set_contact_point(r.Get<ContactPointType>());
+    connection.mutable_lane_links()->resize(
+        r.GetSize(2 * sizeof(element::Id)));
+    for (auto& lane_link : *connection.mutable_lane_links()) {
+      lane_link.set_from(r.Get<element::Id>());
+      lane_link.set_to(r.Get<element::Id>());
+    }
+  }
+}
+
+}  // namespace
+
+opendrive::Status SerializeMap(const element::Map& ele_map,
+                               std::string* data) {
+  if (!data) {
+    return Status{ErrorCode::SAVE_DATA_ERROR, "Input is null."};
+  }
+  data->clear();
+  Writer w(data);
+  data->append(kMagic, sizeof(kMagic));
+  w.Put(kSnapshotVersion);
+  w.Put(kByteOrderMark);
+  w.Put(static_cast<uint64_t>(0));  // payload size, 最后回填
+  WriteHeader(w, ele_map.header());
+  w.PutSize(ele_map.junctions().size());
+  for (const auto& junction : ele_map.junctions()) {
+    WriteJunction(w, junction);
+  }
+  w.PutSize(ele_map.roads().size());
+  for (const auto& road : ele_map.roads()) {
+    WriteRoad(w, road);
+  }
+  const uint64_t payload_size = data->size() - kHeaderSize;
+  std::memcpy(&(*data)[kHeaderSize - sizeof(payload_size)], &payload_size,
+              sizeof(payload_size));
+  return Status{ErrorCode::OK, "ok"};
+}
+
+opendrive::Status SerializeHeader(const element::Header& header,
+                                  std::string* data) {
+  if (!data) {
+    return Status{ErrorCode::SAVE_DATA_ERROR, "Input is null."};
+  }
+  data->clear();
+  Writer w(data);
+  WriteHeader(w, header);
+  return Status{ErrorCode::OK, "ok"};
+}
+
+opendrive::Status SerializeRoad(const element::Road& road, std::string* data) {
+  if (!data) {
+    return Status{ErrorCode::SAVE_DATA_ERROR, "Input is null."};
+  }
+  data->clear();
+  Writer w(data);
+  WriteRoad(w, road);
+  return Status{ErrorCode::OK, "ok"};
+}
+
+opendrive::Status SerializeJunction(const element::Junction& junction,
+                                    std::string* data) {
+  if (!data) {
+    return Status{ErrorCode::SAVE_DATA_ERROR, "Input is null."};
+  }
+  data->clear();
+  Writer w(data);
+  WriteJunction(w, junction);
+  return Status{ErrorCode::OK, "ok"};
+}
+
+opendrive::Status DeserializeMap(const char* data, size_t size,
+                                 element::Map::Ptr ele_map) {
+  if (!data || !ele_map) {
+    return Status{ErrorCode::LOAD_DATA_ERROR, "Input is null."};
+  }
+  if (size < kHeaderSize || 0 != std::memcmp(data, kMagic, sizeof(kMagic))) {
+    return Status{ErrorCode::LOAD_DATA_ERROR, "Snapshot Magic Mismatch."};
+  }
+  Reader r(data + sizeof(kMagic), size - sizeof(kMagic));
+  const uint32_t version = r.Get<uint32_t>();
+  if (kSnapshotVersion != version) {
+    return Status{ErrorCode::LOAD_DATA_ERROR,
+                  "Snapshot Version " + std::to_string(version) +
+                      " Is Not Supported."};
+  }
+  if (kByteOrderMark != r.Get<uint32_t>()) {
+    return Status{ErrorCode::LOAD_DATA_ERROR, "Snapshot Byte Order Mismatch."};
+  }
+  const uint64_t payload_size = r.Get<uint64_t>();
+  if (payload_size != size - kHeaderSize) {
+    return Status{ErrorCode::LOAD_DATA_ERROR, "Snapshot Size Mismatch."};
+  }
+  common::ScopedArena scope(ele_map->arena());
+  *ele_map = element::Map();
+  ReadHeader(r, ele_map->mutable_header());
+  ele_map->mutable_junctions()->resize(r.GetSize(4 * sizeof(element::Id)));
+  for (auto& junction : *ele_map->mutable_junctions()) {
+    ReadJunction(r, &junction);
+    if (!r.ok()) break;
+  }
+  ele_map->mutable_roads()->resize(r.GetSize(4 * sizeof(element::Id)));
+  for (auto& road : *ele_map->mutable_roads()) {
+    if (!ReadRoad(r, &road)) break;
+  }
+  if (!r.ok()) {
+    return Status{ErrorCode::LOAD_DATA_ERROR, "Snapshot Data Is Corrupted."};
+  }
+  return Status{ErrorCode::OK, "ok"};
+}
+
+opendrive::Status SaveMap(const element::Map& ele_map,
+                          const std::string& file) {
+  std::string data;
+  auto status = SerializeMap(ele_map, &data);
+  if (ErrorCode::OK != status.error_code) {
+    return status;
+  }
+  FILE* fp = std::fopen(file.c_str(), "wb");
+  if (!fp) {
+    return Status{ErrorCode::SAVE_DATA_ERROR, "Open Snapshot File Exection."};
+  }
+  const size_t n = std::fwrite(data.data(), 1, data.size(), fp);
+  const bool closed = 0 == std::fclose(fp);
+  if (n != data.size() || !closed) {
+    return Status{ErrorCode::SAVE_DATA_ERROR, "Write Snapshot File Exection."};
+  }
+  return Status{ErrorCode::OK, "ok"};
+}
+
+opendrive::Status LoadMap(const std::string& file, element::Map::Ptr ele_map,
+                          size_t* bytes_read) {
+  common::MappedFile mapped_file;
+  if (!mapped_file.Open(file)) {
+    return Status{ErrorCode::LOAD_DATA_ERROR, "Open Snapshot File Exection."};
+  }
+  mapped_file.Advise(common::MappedFile::Advice::kSequential);
+  if (bytes_read) {
+    *bytes_read = mapped_file.size();
+  }
+  return DeserializeMap(mapped_file.data(), mapped_file.size(), ele_map);
+}
+
+}  // namespace snapshot
+}  // namespace opendrive
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "opendrive-cpp/common/arena.h"
+#include "opendrive-cpp/geometry/element.h"
+#include "opendrive-cpp/opendrive.h"
+#include "opendrive-cpp/snapshot/snapshot.h"
+
+using namespace opendrive;
+
+class TestArena : public testing::Test {
+ public:
+  static void SetUpTestCase();     // 在第一个case之前执行
+  static void TearDownTestCase();  // 在最后一个case之后执行
+  void SetUp() override;           // 在每个case之前执行
+  void TearDown() override;        // 在每个case之后执行
+
+  /// 检查整棵元素树都在 arena 中
+  static void ExpectInArena(const element::Map& ele_map, common::Arena* arena) {
+    ASSERT_EQ(arena, ele_map.arena());
+    ASSERT_EQ(arena, ele_map.junctions().get_allocator().arena());
+    ASSERT_EQ(arena, ele_map.header().name().get_allocator().arena());
+    for (const auto& road : ele_map.roads()) {
+      ASSERT_EQ(arena, road.attribute().name().get_allocator().arena());
+      ASSERT_EQ(arena, road.plan_view().geometrys().get_allocator().arena());
+      for (const auto& section : road.lanes().lane_sections()) {
+        for (const auto* info :
+             {&section.left(), &section.center(), &section.right()}) {
+          ASSERT_EQ(arena, info->lanes().get_allocator().arena());
+          for (const auto& lane : info->lanes()) {
+            ASSERT_EQ(arena, lane.widths().get_allocator().arena());
+            ASSERT_EQ(arena, lane.road_marks().get_allocator().arena());
+          }
+        }
+      }
+    }
+  }
+};
+
+void TestArena::SetUpTestCase() {}
+void TestArena::TearDownTestCase() {}
+void TestArena::TearDown() {}
+void TestArena::SetUp() {}
+
+TEST_F(TestArena, TestAllocate) {
+  common::Arena arena(1024);
+  ASSERT_EQ(0, arena.bytes_reserved());
+  void* p1 = arena.Allocate(3, 1);
+  void* p2 = arena.Allocate(8, 8);
+  void* p3 = arena.Allocate(64, 64);
+  ASSERT_NE(p1, p2);
+  ASSERT_EQ(0, reinterpret_cast<uintptr_t>(p2) % 8);
+  ASSERT_EQ(0, reinterpret_cast<uintptr_t>(p3) % 64);
+  // 大块单独申请
+  void* big = arena.Allocate(1 << 20, 16);
+  ASSERT_NE(nullptr, big);
+  ASSERT_GE(arena.bytes_reserved(), static_cast<size_t>(1 << 20));
+  arena.Release();
+  ASSERT_EQ(0, arena.bytes_reserved());
+  ASSERT_NE(nullptr, arena.Allocate(16, 8));
+}
+
+TEST_F(TestArena, TestConcurrentAllocate) {
+  common::Arena arena(1024);
+  std::vector<std::thread> threads;
+  std::vector<std::vector<int*>> ptrs(4);
+  for (size_t t = 0; t < ptrs.size(); t++) {
+    threads.emplace_back([&arena, &ptrs, t]() {
+      for (int i = 0; i < 10000; i++) {
+        int* p = static_cast<int*>(arena.Allocate(sizeof(int), alignof(int)));
+        *p = static_cast<int>(t) * 10000 + i;
+        ptrs[t].push_back(p);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  for (size_t t = 0; t < ptrs.size(); t++) {
+    for (int i = 0; i < 10000; i++) {
+      ASSERT_EQ(static_cast<int>(t) * 10000 + i, *ptrs[t][i]);
+    }
+  }
+}
+
+TEST_F(TestArena, TestAllocator) {
+  common::Arena arena;
+  element::Vector<int> heap_vec{1, 2, 3};
+  ASSERT_EQ(nullptr, heap_vec.get_allocator().arena());
+  {
+    common::ScopedArena scope(&arena);
+    element::Vector<int> vec{1, 2, 3};
+    element::String str(64, 'x');
+    ASSERT_EQ(&arena, vec.get_allocator().arena());
+    ASSERT_EQ(&arena, str.get_allocator().arena());
+    // 拷贝跟随当前作用域, 移动跟随源容器
+    element::Vector<int> copy = heap_vec;
+    ASSERT_EQ(&arena, copy.get_allocator().arena());
+    element::Vector<int> moved = std::move(heap_vec);
+    ASSERT_EQ(nullptr, moved.get_allocator().arena());
+    {
+      common::ScopedArena heap_scope(nullptr);
+      ASSERT_EQ(nullptr, common::Arena::Current());
+    }
+    ASSERT_EQ(&arena, common::Arena::Current());
+  }
+  ASSERT_EQ(nullptr, common::Arena::Current());
+}
+
+TEST_F(TestArena, TestParseMap) {
+  const std::string file = "./tests/data/only-unittest.xodr";
+  auto expect = std::make_shared<element::Map>();
+  ASSERT_EQ(ErrorCode::OK, Parser().ParseMap(file, expect).error_code);
+  ASSERT_EQ(nullptr, expect->arena());
+  std::string expect_data;
+  snapshot::SerializeMap(*expect, &expect_data);
+
+  for (size_t thread_num : {1, 4}) {
+    common::Arena arena;
+    ParseOptions options;
+    options.thread_num = thread_num;
+    auto ele_map = element::Map::Create(&arena);
+    ASSERT_EQ(ErrorCode::OK,
+              Parser(options).ParseMap(file, ele_map).error_code);
+    ExpectInArena(*ele_map, &arena);
+    ASSERT_GT(arena.bytes_reserved(), 0);
+    std::string data;
+    snapshot::SerializeMap(*ele_map, &data);
+    ASSERT_EQ(expect_data, data);
+
+    // 作用域外拷贝出的元素在堆上
+    element::Road road = ele_map->roads().front();
+    ASSERT_EQ(nullptr, road.lanes().lane_sections().get_allocator().arena());
+    ele_map.reset();
+  }
+}
+
+TEST_F(TestArena, TestLoadSnapshot) {
+  auto expect = std::make_shared<element::Map>();
+  ASSERT_EQ(ErrorCode::OK,
+            Parser()
+                .ParseMap("./tests/data/UC_Simple-X-Junction.xodr", expect)
+                .error_code);
+  std::string data;
+  snapshot::SerializeMap(*expect, &data);
+  common::Arena arena;
+  auto ele_map = element::Map::Create(&arena);
+  ASSERT_EQ(ErrorCode::OK,
+            snapshot::DeserializeMap(data.data(), data.size(), ele_map)
+                .error_code);
+  ExpectInArena(*ele_map, &arena);
+}
+
+/// 元素的字符串与容器可以直接与 std::string/std::vector 互相转换
+TEST_F(TestArena, TestStdTypes) {
+  common::Arena arena;
+  for (common::Arena* map_arena : {static_cast<common::Arena*>(nullptr),
+                                   &arena}) {
+    auto ele_map = element::Map::Create(map_arena);
+    ASSERT_EQ(ErrorCode::OK,
+              Parser()
+                  .ParseMap("./tests/data/UC_Simple-X-Junction.xodr", ele_map)
+                  .error_code);
+    const element::Road& road = ele_map->roads().front();
+    std::string name = road.attribute().name();
+    ASSERT_EQ(name, road.attribute().name());
+    ASSERT_TRUE(road.attribute().name() == name);
+    ASSERT_FALSE(road.attribute().name() != name.c_str());
+    std::vector<element::Geometry::Ptr> geometrys =
+        road.plan_view().geometrys();
+    ASSERT_EQ(road.plan_view().geometrys().size(), geometrys.size());
+    ASSERT_EQ(road.plan_view().geometrys().front(), geometrys.front());
+
+    element::Road copy;
+    copy.mutable_attribute()->set_name(std::string("renamed"));
+    copy.mutable_plan_view()->set_geometrys(geometrys);
+    ASSERT_EQ("renamed", copy.attribute().name());
+    ASSERT_EQ(geometrys.size(), copy.plan_view().geometrys().size());
+    const std::vector<element::Id> ids = element::Ids{1, 2};
+    ASSERT_EQ(element::Ids(ids), (element::Ids{1, 2}));
+  }
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
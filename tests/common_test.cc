@@ -3,8 +3,16 @@
 #include <gtest/gtest.h>
 #include <tinyxml2.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <map>
+#include <random>
 #include <memory>
 #include <string>
 #include <utility>
@@ -61,6 +69,127 @@ TEST_F(TestCommon, TestFormatChoices) {
             common::FormatChoices(opendrive::LANE_TYPE_CHOICES, type));
 }
 
+template <typename T>
+static void ExpectSameChoices(const std::map<T, std::string>& choices,
+                              const ChoiceTable<T>& table) {
+  ASSERT_EQ(choices.size(), table.size());
+  for (const auto& choice : choices) {
+    T value;
+    ASSERT_TRUE(table.Find(choice.second.c_str(), &value)) << choice.second;
+    ASSERT_EQ(choice.first, value);
+    ASSERT_TRUE(table.Find(common::StrToUpper(choice.second).c_str(), &value));
+    ASSERT_EQ(choice.first, value);
+  }
+}
+
+TEST_F(TestCommon, TestChoiceTable) {
+  ExpectSameChoices(BOOLEAN_CHOICES, BOOLEAN_TABLE);
+  ExpectSameChoices(GEOMETRY_TYPE_CHOICES, GEOMETRY_TYPE_TABLE);
+  ExpectSameChoices(LANE_TYPE_CHOICES, LANE_TYPE_TABLE);
+  ExpectSameChoices(ROADMARK_TYPE_CHOICES, ROADMARK_TYPE_TABLE);
+  ExpectSameChoices(ROAD_MARK_COLOR_CHOICES, ROAD_MARK_COLOR_TABLE);
+  ExpectSameChoices(ROAD_MARK_WEIGHT_CHOICES, ROAD_MARK_WEIGHT_TABLE);
+  ExpectSameChoices(ROAD_MARK_LANE_CHANGE_CHOICES,
+                    ROAD_MARK_LANE_CHANGE_TABLE);
+  ExpectSameChoices(ROAD_RULE_CHOICES, ROAD_RULE_TABLE);
+  ExpectSameChoices(ROAD_TYPE_CHOICES, ROAD_TYPE_TABLE);
+  ExpectSameChoices(ROAD_LINK_TYPE_CHOICES, ROAD_LINK_TYPE_TABLE);
+  ExpectSameChoices(SPEEDUNIT_CHOICES, SPEEDUNIT_TABLE);
+  ExpectSameChoices(LANE_DIRECTION_CHOICES, LANE_DIRECTION_TABLE);
+  ExpectSameChoices(JUNCTION_TYPE_CHOICES, JUNCTION_TYPE_TABLE);
+  ExpectSameChoices(JUNCTION_CONNECTION_TYPE_CHOICES,
+                    JUNCTION_CONNECTION_TYPE_TABLE);
+  ExpectSameChoices(CONTACT_POINT_TYPE_CHOICES, CONTACT_POINT_TYPE_TABLE);
+  ExpectSameChoices(DIR_CHOICES, DIR_TABLE);
+
+  LaneType type = LaneType::kNone;
+  ASSERT_TRUE(LANE_TYPE_TABLE.Find("onRamp", &type));
+  ASSERT_EQ(LaneType::kOnramp, type);
+  ASSERT_FALSE(LANE_TYPE_TABLE.Find("onRam", &type));
+  ASSERT_FALSE(LANE_TYPE_TABLE.Find("onRamps", &type));
+  ASSERT_FALSE(LANE_TYPE_TABLE.Find("", &type));
+  ASSERT_EQ(LaneType::kOnramp, type);
+
+  tinyxml2::XMLDocument doc;
+  doc.Parse("<lane type=\"DRIVING\" level=\"yes\"/>");
+  ASSERT_EQ(tinyxml2::XML_SUCCESS,
+            common::XmlQueryEnumAttribute(doc.RootElement(), "type", &type,
+                                          LANE_TYPE_TABLE));
+  ASSERT_EQ(LaneType::kDriving, type);
+  Boolean level = Boolean::kUnknown;
+  ASSERT_EQ(tinyxml2::XML_ERROR_PARSING_TEXT,
+            common::XmlQueryEnumAttribute(doc.RootElement(), "level", &level,
+                                          BOOLEAN_TABLE));
+  ASSERT_EQ(tinyxml2::XML_NO_ATTRIBUTE,
+            common::XmlQueryEnumAttribute(doc.RootElement(), "id", &level,
+                                          BOOLEAN_TABLE));
+  ASSERT_EQ(Boolean::kUnknown, level);
+}
+
+/// 与 "C" locale 下的 strtod 逐位比较
+static void ExpectSameDouble(const char* str) {
+  double expect = std::strtod(str, nullptr);
+  double actual = 0;
+  ASSERT_TRUE(common::ParseDouble(str, &actual)) << str;
+  ASSERT_EQ(0, std::memcmp(&expect, &actual, sizeof(double))) << str;
+  float expect_f = std::strtof(str, nullptr);
+  float actual_f = 0;
+  ASSERT_TRUE(common::ParseFloat(str, &actual_f)) << str;
+  ASSERT_EQ(0, std::memcmp(&expect_f, &actual_f, sizeof(float))) << str;
+}
+
+TEST_F(TestCommon, TestNumeric) {
+  for (const char* str :
+       {"0", "-0", "+0.0", "1", "-1.5", "12.345", "0.1", ".5", "5.",
+        "3.1415926535897931", "-2.2250738585072014e-308", "4.9e-324",
+        "1.7976931348623157e308", "1e22", "1e23", "123456789012345678901234",
+        "0.000000000000000000000000000001", "9007199254740993", "  7.25",
+        "7.25abc", "1e", "1e+", "2E-3", "6.02214076e+23", "inf", "-nan"}) {
+    ExpectSameDouble(str);
+  }
+  std::mt19937_64 rng(7);
+  std::uniform_real_distribution<double> dist(-1e4, 1e4);
+  char buffer[64];
+  for (int i = 0; i < 20000; i++) {
+    const double v = dist(rng);
+    const char* formats[] = {"%.17g", "%.15g", "%.6f", "%.3e"};
+    std::snprintf(buffer, sizeof(buffer), formats[i % 4], v);
+    ExpectSameDouble(buffer);
+  }
+
+  double d = 1;
+  ASSERT_FALSE(common::ParseDouble("", &d));
+  ASSERT_FALSE(common::ParseDouble("abc", &d));
+  ASSERT_FALSE(common::ParseDouble("-.", &d));
+  ASSERT_EQ(1, d);
+
+  int n = 0;
+  ASSERT_TRUE(common::ParseInt("-42", &n));
+  ASSERT_EQ(-42, n);
+  ASSERT_TRUE(common::ParseInt(" 17 ", &n));
+  ASSERT_EQ(17, n);
+  ASSERT_TRUE(common::ParseInt("-2147483648", &n));
+  ASSERT_EQ(INT_MIN, n);
+  ASSERT_TRUE(common::ParseInt("0x1A", &n));
+  ASSERT_EQ(26, n);
+  ASSERT_FALSE(common::ParseInt("2147483648", &n));
+  ASSERT_FALSE(common::ParseInt("x", &n));
+  ASSERT_EQ(26, n);
+
+  /// 小数点为 ',' 的 locale 下结果不变
+  for (const char* locale : {"de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8"}) {
+    if (!std::setlocale(LC_NUMERIC, locale)) continue;
+    ASSERT_TRUE(common::ParseDouble("1.5", &d));
+    ASSERT_EQ(1.5, d);
+    ASSERT_TRUE(common::ParseDouble("1.00000000000000000000000001e-400", &d));
+    ASSERT_EQ(0, d);
+    ASSERT_TRUE(common::ParseDouble("0.1000000000000000000000000001", &d));
+    ASSERT_EQ(0.1, d);
+    std::setlocale(LC_NUMERIC, "C");
+    break;
+  }
+}
+
 TEST_F(TestCommon, TestVectorSort) {
   std::vector<element::LaneOffset> lane_offsets;
   element::LaneOffset l1, l2, l3, l4, l5;
@@ -156,6 +285,76 @@ TEST_F(TestCommon, TestLeftPtr) {
   ASSERT_EQ(4, ret);
 }
 
+TEST_F(TestCommon, TestGtPtr) {
+  std::vector<element::Geometry::Ptr> geometrys;
+  ASSERT_EQ(-1, common::GetGtPtrPoloy3(geometrys, 11));
+  for (double s : {11., 13., 15., 18., 19.}) {
+    geometrys.emplace_back(std::make_shared<element::GeometryLine>(
+        s, 2, 3, 4, 5, GeometryType::kLine));
+  }
+  ASSERT_EQ(-1, common::GetGtPtrPoloy3(geometrys, 10));
+  ASSERT_EQ(0, common::GetGtPtrPoloy3(geometrys, 11));
+  ASSERT_EQ(1, common::GetGtPtrPoloy3(geometrys, 15));
+  ASSERT_EQ(3, common::GetGtPtrPoloy3(geometrys, 19));
+  ASSERT_EQ(4, common::GetGtPtrPoloy3(geometrys, 100));
+}
+
+/// 二分查找与游标的结果与原先从尾部向前的线性查找一致
+TEST_F(TestCommon, TestPoloy3Cursor) {
+  auto linear_ge = [](const std::vector<element::LaneOffset>& items,
+                      double target) {
+    if (items.empty() || target < items.at(0).s()) return -1;
+    for (int i = items.size() - 1; i >= 0; i--) {
+      if (target >= items.at(i).s()) return i;
+    }
+    return -1;
+  };
+  auto linear_gt = [](const std::vector<element::LaneOffset>& items,
+                      double target) {
+    if (items.empty() || target < items.at(0).s()) return -1;
+    for (int i = items.size() - 1; i >= 0; i--) {
+      if (target > items.at(i).s()) return i;
+    }
+    return 0;
+  };
+  std::mt19937_64 rng(5);
+  std::uniform_int_distribution<int> gap(0, 3);
+  for (size_t size : {0, 1, 2, 3, 7, 64, 257}) {
+    /// 整数 s, 包含重复值(长度为 0 的分段)
+    std::vector<element::LaneOffset> items(size);
+    double s = 10;
+    for (auto& item : items) {
+      item.set_s(s);
+      s += gap(rng);
+    }
+    std::vector<double> targets;
+    for (double target = 8; target <= s + 2; target += 0.5) {
+      targets.emplace_back(target);
+    }
+    const std::vector<double> ascending = targets;
+    std::reverse(targets.begin(), targets.end());
+    const std::vector<double> descending = targets;
+    std::shuffle(targets.begin(), targets.end(), rng);
+    targets.emplace_back(std::nan(""));
+    targets.emplace_back(-std::numeric_limits<double>::infinity());
+    targets.emplace_back(std::numeric_limits<double>::infinity());
+    for (const auto& order : {ascending, descending, targets}) {
+      auto ge_cursor = common::MakePoloy3Cursor(items);
+      auto gt_cursor = common::MakePoloy3Cursor(items);
+      for (double target : order) {
+        const int ge = linear_ge(items, target);
+        const int gt = linear_gt(items, target);
+        ASSERT_EQ(ge, common::GetGeValuePoloy3(items, target))
+            << size << " " << target;
+        ASSERT_EQ(gt, common::GetGtValuePoloy3(items, target))
+            << size << " " << target;
+        ASSERT_EQ(ge, ge_cursor.Ge(target)) << size << " " << target;
+        ASSERT_EQ(gt, gt_cursor.Gt(target)) << size << " " << target;
+      }
+    }
+  }
+}
+
 TEST_F(TestCommon, TestStr) {
   std::string a = "abc";
   std::string b = "ABC";
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "opendrive-cpp/common/geometry_kernels.h"
+#include "opendrive-cpp/geometry/element.h"
+
+using namespace opendrive;
+
+class TestGeometryKernels : public testing::Test {
+ public:
+  static void SetUpTestCase();     // 在第一个case之前执行
+  static void TearDownTestCase();  // 在最后一个case之后执行
+  void SetUp() override;           // 在每个case之前执行
+  void TearDown() override;        // 在每个case之后执行
+
+  static std::vector<common::SimdLevel> Levels() {
+    std::vector<common::SimdLevel> levels{common::SimdLevel::kScalar};
+    for (auto level : {common::SimdLevel::kSse2, common::SimdLevel::kAvx2}) {
+      if (level <= common::SupportedSimdLevel()) levels.emplace_back(level);
+    }
+    return levels;
+  }
+
+  /// 各指令集的批量结果与 GetPoint 一致
+  static void ExpectMatch(const element::Geometry& geometry) {
+    std::vector<double> road_s;
+    /// 包含 geometry 之外的 s, 个数不是向量宽度的整数倍
+    for (double ds = -2; ds <= geometry.length() + 2;
+         ds += geometry.length() / 97) {
+      road_s.emplace_back(geometry.s() + ds);
+    }
+    for (auto level : Levels()) {
+      common::SetSimdLevel(level);
+      std::vector<element::Point> points(road_s.size());
+      geometry.GetPoints(road_s.data(), road_s.size(), points.data());
+      for (size_t i = 0; i < road_s.size(); i++) {
+        const auto expect = geometry.GetPoint(road_s.at(i));
+        ASSERT_NEAR(expect.x(), points.at(i).x(),
+                    common::kKernelPositionTolerance)
+            << common::SimdLevelName(level) << " s=" << road_s.at(i);
+        ASSERT_NEAR(expect.y(), points.at(i).y(),
+                    common::kKernelPositionTolerance)
+            << common::SimdLevelName(level) << " s=" << road_s.at(i);
+        ASSERT_NEAR(expect.heading(), points.at(i).heading(),
+                    common::kKernelHeadingTolerance)
+            << common::SimdLevelName(level) << " s=" << road_s.at(i);
+      }
+    }
+    common::SetSimdLevel(common::SupportedSimdLevel());
+  }
+};
+
+void TestGeometryKernels::SetUpTestCase() {}
+void TestGeometryKernels::TearDownTestCase() {}
+void TestGeometryKernels::TearDown() {}
+void TestGeometryKernels::SetUp() {}
+
+TEST_F(TestGeometryKernels, TestSimdLevel) {
+  const auto supported = common::SupportedSimdLevel();
+  ASSERT_EQ(supported, common::GetSimdLevel());
+  common::SetSimdLevel(common::SimdLevel::kScalar);
+  ASSERT_EQ(common::SimdLevel::kScalar, common::GetSimdLevel());
+  common::SetSimdLevel(common::SimdLevel::kAvx2);
+  ASSERT_EQ(supported, common::GetSimdLevel());
+  ASSERT_STREQ("scalar", common::SimdLevelName(common::SimdLevel::kScalar));
+}
+
+TEST_F(TestGeometryKernels, TestLine) {
+  for (double hdg : {0., 1.2, -2.9, 3.14159, 100.}) {
+    ExpectMatch(element::GeometryLine(12.5, 1e4, -3e4, hdg, 87.3,
+                                      GeometryType::kLine));
+  }
+}
+
+TEST_F(TestGeometryKernels, TestArc) {
+  std::mt19937_64 rng(7);
+  std::uniform_real_distribution<double> hdg(-7, 7);
+  /// 覆盖 sin/cos 的四个象限与小曲率
+  for (double curvature : {0.5, -0.5, 0.05, -0.013, 1e-3, 1e-5, -1e-6}) {
+    for (int i = 0; i < 8; i++) {
+      ExpectMatch(element::GeometryArc(3.0, -1234.5, 678.9, hdg(rng),
+                                       0.5 == std::fabs(curvature) ? 40 : 150,
+                                       GeometryType::kArc, curvature));
+    }
+  }
+}
+
+TEST_F(TestGeometryKernels, TestPoly3) {
+  std::mt19937_64 rng(11);
+  std::uniform_real_distribution<double> coef(-1, 1);
+  for (int i = 0; i < 32; i++) {
+    /// tangent 覆盖 atan 的三个约简区间
+    const double scale = std::pow(10., i % 4 - 2);
+    ExpectMatch(element::GeometryPoly3(
+        0.7, 250., -80., coef(rng) * 3, 60, GeometryType::kPoly3, coef(rng),
+        coef(rng) * scale * 10, coef(rng) * scale, coef(rng) * scale * 0.01));
+  }
+}
+
+TEST_F(TestGeometryKernels, TestParamPoly3) {
+  std::mt19937_64 rng(13);
+  std::uniform_real_distribution<double> coef(-1, 1);
+  using PRange = element::GeometryParamPoly3::PRange;
+  for (auto range : {PRange::ARCLENGTH, PRange::NORMALIZED, PRange::UNKNOWN}) {
+    for (int i = 0; i < 16; i++) {
+      const double scale = PRange::NORMALIZED == range ? 30. : 1.;
+      /// 切线方向覆盖四个象限
+      ExpectMatch(element::GeometryParamPoly3(
+          5., 10., 20., coef(rng) * 3, 30, GeometryType::kParamPoly3, 0,
+          coef(rng) * scale, coef(rng) * scale * 0.1,
+          coef(rng) * scale * 0.01, 0, coef(rng) * scale,
+          coef(rng) * scale * 0.1, coef(rng) * scale * 0.01, range));
+    }
+  }
+  /// 切线为 0
+  ExpectMatch(element::GeometryParamPoly3(0., 0., 0., 0.3, 10,
+                                          GeometryType::kParamPoly3, 0, 0, 0,
+                                          0, 0, 0, 0, 0, PRange::ARCLENGTH));
+}
+
+TEST_F(TestGeometryKernels, TestSpiral) {
+  std::mt19937_64 rng(17);
+  std::uniform_real_distribution<double> hdg(-7, 7);
+  /// 覆盖 Fresnel 积分的两个区间与曲率过零
+  for (const auto& curve : std::vector<std::pair<double, double>>{
+           {0, 0.1}, {0.1, 0}, {-0.05, 0.08}, {0.01, 0.012}, {0.3, -0.3}}) {
+    for (int i = 0; i < 4; i++) {
+      ExpectMatch(element::GeometrySpiral(4.0, 321.5, -87.6, hdg(rng), 60,
+                                          GeometryType::kSpiral, curve.first,
+                                          curve.second));
+    }
+  }
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,305 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "opendrive-cpp/common/geometry_kernels.h"
+#include "opendrive-cpp/geometry/element.h"
+#include "opendrive-cpp/opendrive.h"
+
+using namespace opendrive;
+
+class TestGeometrySpiral : public testing::Test {
+ public:
+  static void SetUpTestCase();     // 在第一个case之前执行
+  static void TearDownTestCase();  // 在最后一个case之后执行
+  void SetUp() override;           // 在每个case之前执行
+  void TearDown() override;        // 在每个case之后执行
+
+  /// 对 heading 数值积分(Simpson, long double)得到的参考点
+  static element::Point Integrate(const element::GeometrySpiral& spiral,
+                                  double ds) {
+    const long double k0 = spiral.curve_start();
+    const long double k_dot =
+        (static_cast<long double>(spiral.curve_end()) - k0) / spiral.length();
+    auto heading = [&](long double u) {
+      return spiral.hdg() + u * (k0 + 0.5L * k_dot * u);
+    };
+    const int n = 4096;
+    const long double h = static_cast<long double>(ds) / n;
+    long double x = 0;
+    long double y = 0;
+    for (int i = 0; i <= n; i++) {
+      const long double w = (0 == i || n == i) ? 1 : (i % 2 ? 4 : 2);
+      x += w * std::cos(heading(i * h));
+      y += w * std::sin(heading(i * h));
+    }
+    return element::Point(static_cast<double>(spiral.x() + x * h / 3),
+                          static_cast<double>(spiral.y() + y * h / 3), 0,
+                          static_cast<double>(heading(ds)));
+  }
+};
+
+void TestGeometrySpiral::SetUpTestCase() {}
+void TestGeometrySpiral::TearDownTestCase() {}
+void TestGeometrySpiral::TearDown() {}
+void TestGeometrySpiral::SetUp() {}
+
+TEST_F(TestGeometrySpiral, TestAccuracy) {
+  /// {length, curve_start, curve_end}
+  const std::vector<std::array<double, 3>> params = {
+      {2.0833333333333330, 0, -8.3333333333333329e-02},
+      {30, 0, 0.05},
+      {30, 0.05, 0},
+      {80, -0.02, 0.03},
+      {120, 0.01, 0.0125},
+      {200, -1e-3, -2e-3},
+      {5, 0.2, 0.3},
+  };
+  for (const auto& param : params) {
+    const element::GeometrySpiral spiral(10, 100, -50, 0.7, param[0],
+                                         GeometryType::kSpiral, param[1],
+                                         param[2]);
+    ASSERT_FALSE(spiral.degenerate());
+    for (double ds = 0; ds <= param[0]; ds += param[0] / 50) {
+      const auto expect = Integrate(spiral, ds);
+      const auto point = spiral.GetPoint(spiral.s() + ds);
+      ASSERT_NEAR(expect.x(), point.x(), 1e-9)
+          << param[1] << "->" << param[2] << " ds=" << ds;
+      ASSERT_NEAR(expect.y(), point.y(), 1e-9)
+          << param[1] << "->" << param[2] << " ds=" << ds;
+      ASSERT_NEAR(expect.heading(), point.heading(), 1e-12)
+          << param[1] << "->" << param[2] << " ds=" << ds;
+    }
+    const auto start = spiral.GetPoint(spiral.s());
+    ASSERT_DOUBLE_EQ(spiral.x(), start.x());
+    ASSERT_DOUBLE_EQ(spiral.y(), start.y());
+    ASSERT_DOUBLE_EQ(spiral.hdg(), start.heading());
+  }
+}
+
+TEST_F(TestGeometrySpiral, TestDegenerate) {
+  const element::GeometrySpiral arc(10, 100, -50, 0.7, 40,
+                                    GeometryType::kSpiral, 0.02, 0.02);
+  const element::GeometryArc expect_arc(10, 100, -50, 0.7, 40,
+                                        GeometryType::kArc, 0.02);
+  const element::GeometrySpiral line(10, 100, -50, 0.7, 40,
+                                     GeometryType::kSpiral, 0, 0);
+  const element::GeometryLine expect_line(10, 100, -50, 0.7, 40,
+                                          GeometryType::kLine);
+  ASSERT_TRUE(arc.degenerate());
+  ASSERT_TRUE(line.degenerate());
+  std::vector<double> road_s;
+  for (double s = 10; s <= 50; s += 0.7) {
+    road_s.emplace_back(s);
+  }
+  std::vector<element::Point> points(road_s.size());
+  for (const auto& item :
+       {std::make_pair<const element::Geometry*, const element::Geometry*>(
+            &arc, &expect_arc),
+        std::make_pair<const element::Geometry*, const element::Geometry*>(
+            &line, &expect_line)}) {
+    item.first->GetPoints(road_s.data(), road_s.size(), points.data());
+    for (size_t i = 0; i < road_s.size(); i++) {
+      const auto expect = item.second->GetPoint(road_s.at(i));
+      const auto point = item.first->GetPoint(road_s.at(i));
+      ASSERT_NEAR(expect.x(), point.x(), 1e-9);
+      ASSERT_NEAR(expect.y(), point.y(), 1e-9);
+      ASSERT_NEAR(expect.heading(), point.heading(), 1e-12);
+      ASSERT_NEAR(expect.x(), points.at(i).x(), 1e-9);
+      ASSERT_NEAR(expect.y(), points.at(i).y(), 1e-9);
+      ASSERT_NEAR(expect.heading(), points.at(i).heading(), 1e-12);
+    }
+  }
+
+  /// length 为 0 时 curve_dot 不是有限值
+  const element::GeometrySpiral empty(10, 100, -50, 0.7, 0,
+                                      GeometryType::kSpiral, 0.01, 0.02);
+  ASSERT_TRUE(empty.degenerate());
+  const auto point = empty.GetPoint(10);
+  ASSERT_DOUBLE_EQ(100, point.x());
+  ASSERT_DOUBLE_EQ(-50, point.y());
+  ASSERT_DOUBLE_EQ(0.7, point.heading());
+}
+
+/// 曲率几乎不变时 curve_start / curve_dot 很大, 按圆弧展开计算
+TEST_F(TestGeometrySpiral, TestNearArc) {
+  /// {length, curve_start, curve_end - curve_start}
+  const std::vector<std::array<double, 3>> params = {
+      {100, 0.01, 1e-9},   {100, 0.01, 1e-10}, {100, 0.01, 1e-11},
+      {100, 0.01, 1e-12},  {100, 0.01, 1e-14}, {100, 0.01, -1e-9},
+      {100, -0.01, 1e-6},  {100, 0.1, 1e-7},   {100, 0.01, 3.9e-4},
+      {100, 0, 1e-10},     {100, 1e-7, 1e-5},  {0.5, 0.02, 0.06},
+  };
+  for (const auto& param : params) {
+    const element::GeometrySpiral spiral(10, 100, -50, 0.7, param[0],
+                                         GeometryType::kSpiral, param[1],
+                                         param[1] + param[2]);
+    ASSERT_TRUE(spiral.degenerate()) << param[1] << "+" << param[2];
+    std::vector<double> road_s;
+    for (double ds = 0; ds <= param[0]; ds += param[0] / 50) {
+      road_s.emplace_back(spiral.s() + ds);
+    }
+    std::vector<element::Point> points(road_s.size());
+    spiral.GetPoints(road_s.data(), road_s.size(), points.data());
+    for (size_t i = 0; i < road_s.size(); i++) {
+      const auto expect = Integrate(spiral, road_s.at(i) - spiral.s());
+      const auto point = spiral.GetPoint(road_s.at(i));
+      ASSERT_NEAR(expect.x(), point.x(), 1e-9)
+          << param[1] << "+" << param[2] << " s=" << road_s.at(i);
+      ASSERT_NEAR(expect.y(), point.y(), 1e-9)
+          << param[1] << "+" << param[2] << " s=" << road_s.at(i);
+      ASSERT_NEAR(expect.heading(), point.heading(), 1e-12)
+          << param[1] << "+" << param[2] << " s=" << road_s.at(i);
+      ASSERT_DOUBLE_EQ(point.x(), points.at(i).x());
+      ASSERT_DOUBLE_EQ(point.y(), points.at(i).y());
+      ASSERT_DOUBLE_EQ(point.heading(), points.at(i).heading());
+    }
+  }
+
+  /// 两种算法在阈值附近一致
+  for (double curve_dot : {3.9e-6, 4.1e-6}) {
+    const element::GeometrySpiral spiral(10, 100, -50, 0.7, 100,
+                                         GeometryType::kSpiral, 0.01,
+                                         0.01 + curve_dot * 100);
+    ASSERT_EQ(curve_dot < 4e-6, spiral.degenerate());
+    for (double ds = 0; ds <= 100; ds += 2) {
+      const auto expect = Integrate(spiral, ds);
+      const auto point = spiral.GetPoint(spiral.s() + ds);
+      ASSERT_NEAR(expect.x(), point.x(), 1e-9) << curve_dot;
+      ASSERT_NEAR(expect.y(), point.y(), 1e-9) << curve_dot;
+    }
+  }
+}
+
+TEST_F(TestGeometrySpiral, TestGetPoints) {
+  const element::GeometrySpiral spiral(10, 100, -50, 0.7, 80,
+                                       GeometryType::kSpiral, -0.02, 0.03);
+  std::vector<double> road_s;
+  for (double s = 8; s <= 92; s += 0.37) {
+    road_s.emplace_back(s);
+  }
+  std::vector<element::Point> points(road_s.size());
+  spiral.GetPoints(road_s.data(), road_s.size(), points.data());
+  for (size_t i = 0; i < road_s.size(); i++) {
+    const auto expect = spiral.GetPoint(road_s.at(i));
+    ASSERT_NEAR(expect.x(), points.at(i).x(),
+                common::kKernelPositionTolerance);
+    ASSERT_NEAR(expect.y(), points.at(i).y(),
+                common::kKernelPositionTolerance);
+    ASSERT_NEAR(expect.heading(), points.at(i).heading(),
+                common::kKernelHeadingTolerance);
+  }
+}
+
+/// 各指令集的 odrSpiralBatch 与 odrSpiral 一致
+TEST_F(TestGeometrySpiral, TestSpiralBatch) {
+  std::mt19937_64 rng(23);
+  std::vector<double> s;
+  std::vector<double> cdots;
+  for (double cdot : {1e-8, 1e-6, 1e-4, 1e-2, 1., 30.}) {
+    cdots.emplace_back(cdot);
+    cdots.emplace_back(-cdot);
+  }
+  for (const double cdot : cdots) {
+    const double a = std::sqrt(M_PI / std::fabs(cdot));
+    /// Fresnel 积分自变量覆盖 0, 区间边界 1.6, 大参数区间与 x > 36974,
+    /// |s| <= 1e6
+    std::uniform_real_distribution<double> arg(-60, 60);
+    s = {0., -0., 1.6 * a, -1.6 * a, std::nextafter(1.6, 0.) * a};
+    for (double arg_max : {36974., 4e4}) {
+      if (arg_max * a <= 1e6) s.emplace_back(arg_max * a);
+    }
+    for (int i = 0; i < 200; i++) {
+      s.emplace_back(arg(rng) * a);
+      s.emplace_back(arg(rng) * a * 0.05);
+    }
+    for (auto level : {common::SimdLevel::kScalar, common::SimdLevel::kSse2,
+                       common::SimdLevel::kAvx2}) {
+      common::SetSimdLevel(level);
+      std::vector<double> x(s.size());
+      std::vector<double> y(s.size());
+      std::vector<double> t(s.size());
+      odrSpiralBatch(s.data(), s.size(), cdot, x.data(), y.data(), t.data());
+      for (size_t i = 0; i < s.size(); i++) {
+        double expect_x;
+        double expect_y;
+        double expect_t;
+        odrSpiral(s.at(i), cdot, &expect_x, &expect_y, &expect_t);
+        ASSERT_NEAR(expect_x, x.at(i), 1e-9)
+            << common::SimdLevelName(level) << " cdot=" << cdot
+            << " s=" << s.at(i);
+        ASSERT_NEAR(expect_y, y.at(i), 1e-9)
+            << common::SimdLevelName(level) << " cdot=" << cdot
+            << " s=" << s.at(i);
+        ASSERT_DOUBLE_EQ(expect_t, t.at(i));
+      }
+    }
+  }
+  common::SetSimdLevel(common::SupportedSimdLevel());
+}
+
+TEST_F(TestGeometrySpiral, TestFresnelIntegrals) {
+  std::vector<double> x{0, 1e-300, 1.6, -1.6, std::nextafter(1.6, 0.), 36974,
+                        36975, 1e300};
+  for (double v = -200; v <= 200; v += 0.0137) {
+    x.emplace_back(v);
+  }
+  for (double v = 200; v < 36974; v *= 1.01) {
+    x.emplace_back(v);
+  }
+  for (auto level : {common::SimdLevel::kScalar, common::SimdLevel::kSse2,
+                     common::SimdLevel::kAvx2}) {
+    common::SetSimdLevel(level);
+    std::vector<double> s(x.size());
+    std::vector<double> c(x.size());
+    common::FresnelIntegrals(x.data(), x.size(), s.data(), c.data());
+    for (size_t i = 0; i < x.size(); i++) {
+      double expect_s;
+      double expect_c;
+      odrFresnel(x.at(i), &expect_s, &expect_c);
+      /// 逐个计算时 pi/2 * x^2 的舍入误差
+      const double tolerance = 1e-15 + 1e-16 * std::fabs(x.at(i));
+      ASSERT_NEAR(expect_s, s.at(i), tolerance)
+          << common::SimdLevelName(level) << " x=" << x.at(i);
+      ASSERT_NEAR(expect_c, c.at(i), tolerance)
+          << common::SimdLevelName(level) << " x=" << x.at(i);
+    }
+  }
+  common::SetSimdLevel(common::SupportedSimdLevel());
+}
+
+/// 螺旋线终点与下一个 geometry 的起点重合
+TEST_F(TestGeometrySpiral, TestContinuity) {
+  auto ele_map = std::make_shared<element::Map>();
+  Parser parser;
+  ASSERT_EQ(ErrorCode::OK,
+            parser.ParseMap("./tests/data/UC_Simple-X-Junction.xodr", ele_map)
+                .error_code);
+  size_t checked = 0;
+  for (const auto& road : ele_map->roads()) {
+    const auto& geometrys = road.plan_view().geometrys();
+    for (size_t i = 0; i + 1 < geometrys.size(); i++) {
+      if (GeometryType::kSpiral != geometrys.at(i)->type()) continue;
+      const auto& next = geometrys.at(i + 1);
+      const auto end = geometrys.at(i)->GetPoint(next->s());
+      ASSERT_NEAR(next->x(), end.x(), 1e-6) << road.attribute().id();
+      ASSERT_NEAR(next->y(), end.y(), 1e-6) << road.attribute().id();
+      ASSERT_NEAR(0, std::remainder(next->hdg() - end.heading(), 2 * M_PI),
+                  1e-9)
+          << road.attribute().id();
+      checked++;
+    }
+  }
+  ASSERT_GT(checked, 0);
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "opendrive-cpp/geometry/element.h"
+#include "opendrive-cpp/lazy_map.h"
+#include "opendrive-cpp/opendrive.h"
+#include "opendrive-cpp/snapshot/snapshot.h"
+
+using namespace opendrive;
+
+class TestLazyMap : public testing::Test {
+ public:
+  static void SetUpTestCase();     // 在第一个case之前执行
+  static void TearDownTestCase();  // 在最后一个case之后执行
+  void SetUp() override;           // 在每个case之前执行
+  void TearDown() override;        // 在每个case之后执行
+
+  static std::string ReadFile(const std::string& file) {
+    std::ifstream in(file, std::ios::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+  }
+
+  static element::Map::Ptr ParseDom(const std::string& file) {
+    opendrive::Parser parser;
+    auto ele_map = std::make_shared<opendrive::element::Map>();
+    auto ret = parser.ParseMap(file, ele_map);
+    assert(opendrive::ErrorCode::OK == ret.error_code);
+    return ele_map;
+  }
+
+  /// 访问所有 road 后组装成 element::Map
+  static element::Map::Ptr Materialize(const LazyMap& lazy_map) {
+    auto ele_map = std::make_shared<element::Map>();
+    ele_map->set_header(lazy_map.header());
+    ele_map->set_junctions(lazy_map.junctions());
+    for (auto id : lazy_map.road_ids()) {
+      const element::Road* road = lazy_map.GetRoad(id);
+      if (!road) return nullptr;
+      ele_map->mutable_roads()->emplace_back(*road);
+    }
+    return ele_map;
+  }
+
+  static std::string Serialize(const element::Map& ele_map) {
+    std::string data;
+    snapshot::SerializeMap(ele_map, &data);
+    return data;
+  }
+
+  static const std::vector<std::string> kFiles;
+};
+
+const std::vector<std::string> TestLazyMap::kFiles = {
+    "./tests/data/only-unittest.xodr",
+    "./tests/data/case1.xodr",
+    "./tests/data/Ex_Simple-LaneOffset.xodr",
+    "./tests/data/UC_Simple-X-Junction.xodr",
+};
+
+void TestLazyMap::SetUpTestCase() {}
+void TestLazyMap::TearDownTestCase() {}
+void TestLazyMap::TearDown() {}
+void TestLazyMap::SetUp() {}
+
+TEST_F(TestLazyMap, TestLoad) {
+  for (const auto& file : kFiles) {
+    auto expect = ParseDom(file);
+    Parser parser;
+    auto lazy_map = std::make_shared<LazyMap>();
+    auto ret = parser.ParseLazyMap(file, lazy_map);
+    ASSERT_EQ(ErrorCode::OK, ret.error_code) << file << ": " << ret.msg;
+    ASSERT_EQ(expect->roads().size(), lazy_map->road_size());
+    ASSERT_EQ(0, lazy_map->loaded_road_size());
+    ASSERT_EQ(expect->junctions().size(), lazy_map->junctions().size());
+    for (const auto& road : expect->roads()) {
+      const auto id = road.attribute().id();
+      const element::Road* head = lazy_map->PeekRoad(id);
+      ASSERT_TRUE(head != nullptr);
+      ASSERT_FALSE(lazy_map->IsRoadLoaded(id));
+      ASSERT_EQ(road.attribute().name(), head->attribute().name());
+      ASSERT_DOUBLE_EQ(road.attribute().length(), head->attribute().length());
+      ASSERT_EQ(road.link().successor().id(), head->link().successor().id());
+      ASSERT_EQ(road.type_info().size(), head->type_info().size());
+      ASSERT_TRUE(head->plan_view().geometrys().empty());
+    }
+    auto actual = Materialize(*lazy_map);
+    ASSERT_TRUE(actual != nullptr) << file;
+    ASSERT_EQ(lazy_map->road_size(), lazy_map->loaded_road_size());
+    ASSERT_EQ(Serialize(*expect), Serialize(*actual)) << file;
+  }
+}
+
+TEST_F(TestLazyMap, TestLoadData) {
+  const std::string file = "./tests/data/UC_Simple-X-Junction.xodr";
+  auto expect = ParseDom(file);
+  common::Arena arena;
+  LazyMap lazy_map(&arena);
+  auto ret = lazy_map.LoadData(ReadFile(file));
+  ASSERT_EQ(ErrorCode::OK, ret.error_code) << ret.msg;
+  const auto id = expect->roads().back().attribute().id();
+  const element::Road* road = lazy_map.GetRoad(id);
+  ASSERT_TRUE(road != nullptr);
+  ASSERT_EQ(1, lazy_map.loaded_road_size());
+  ASSERT_EQ(&arena, road->lanes().lane_sections().get_allocator().arena());
+  ASSERT_EQ(expect->roads().back().lanes().lane_sections().size(),
+            road->lanes().lane_sections().size());
+  ASSERT_EQ(road, lazy_map.GetRoad(id));
+  ASSERT_EQ(1, lazy_map.loaded_road_size());
+}
+
+TEST_F(TestLazyMap, TestConcurrentAccess) {
+  const std::string file = "./tests/data/UC_Simple-X-Junction.xodr";
+  auto expect = ParseDom(file);
+  LazyMap lazy_map;
+  ASSERT_EQ(ErrorCode::OK, lazy_map.Load(file).error_code);
+  const element::Ids ids = lazy_map.road_ids();
+  std::vector<std::vector<const element::Road*>> results(8);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < results.size(); t++) {
+    threads.emplace_back([&, t]() {
+      for (size_t i = 0; i < ids.size(); i++) {
+        /// 各线程以不同顺序访问
+        const auto id = ids.at((i + t) % ids.size());
+        results[t].push_back(lazy_map.GetRoad(id));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  ASSERT_EQ(ids.size(), lazy_map.loaded_road_size());
+  for (size_t t = 0; t < results.size(); t++) {
+    for (size_t i = 0; i < ids.size(); i++) {
+      const auto id = ids.at((i + t) % ids.size());
+      ASSERT_EQ(lazy_map.GetRoad(id), results[t][i]);
+    }
+  }
+  ASSERT_EQ(Serialize(*expect), Serialize(*Materialize(lazy_map)));
+}
+
+TEST_F(TestLazyMap, TestLoadRegion) {
+  const std::string file = "./tests/data/UC_Simple-X-Junction.xodr";
+  auto expect = ParseDom(file);
+  LazyMap probe;
+  ASSERT_EQ(ErrorCode::OK, probe.Load(file).error_code);
+  element::Box extent;
+  for (const auto& road : expect->roads()) {
+    const element::Box bound = probe.RoadBound(road.attribute().id());
+    ASSERT_FALSE(bound.empty());
+    /// 参考线上的点都在包围盒内
+    for (const auto& geometry : road.plan_view().geometrys()) {
+      for (double ds = 0; ds <= geometry->length(); ds += 0.5) {
+        const element::Point point = geometry->GetPoint(geometry->s() + ds);
+        ASSERT_TRUE(bound.Intersects(
+            element::Box(point.x(), point.y(), point.x(), point.y())));
+      }
+    }
+    extent.Extend(bound.min_x(), bound.min_y(), 0);
+    extent.Extend(bound.max_x(), bound.max_y(), 0);
+  }
+  ASSERT_FALSE(probe.RoadBound(-100).Intersects(extent));
+
+  /// 左下角的小区域, 之后扩大到整张地图
+  const element::Box corner(
+      extent.min_x(), extent.min_y(),
+      extent.min_x() + (extent.max_x() - extent.min_x()) / 10,
+      extent.min_y() + (extent.max_y() - extent.min_y()) / 10);
+  Parser parser;
+  auto lazy_map = std::make_shared<LazyMap>();
+  auto ret = parser.ParseMap(file, element::Boxes{corner}, lazy_map);
+  ASSERT_EQ(ErrorCode::OK, ret.error_code) << ret.msg;
+  const element::Ids in_corner = lazy_map->RoadsInRegion({corner});
+  ASSERT_FALSE(in_corner.empty());
+  ASSERT_LT(in_corner.size(), lazy_map->road_size());
+  ASSERT_EQ(in_corner.size(), lazy_map->loaded_road_size());
+  for (auto id : lazy_map->road_ids()) {
+    const bool inside = lazy_map->RoadBound(id).Intersects(corner);
+    ASSERT_EQ(inside, lazy_map->IsRoadLoaded(id));
+    ASSERT_EQ(inside,
+              !lazy_map->PeekRoad(id)->plan_view().geometrys().empty());
+  }
+  ASSERT_EQ(lazy_map->road_size(), lazy_map->map().roads().size());
+
+  ASSERT_EQ(ErrorCode::OK, lazy_map->LoadRegion({extent}).error_code);
+  ASSERT_EQ(lazy_map->road_size(), lazy_map->loaded_road_size());
+  ASSERT_EQ(Serialize(*expect), Serialize(lazy_map->map()));
+
+  /// 区域外
+  ret = parser.ParseMap(
+      file, element::Boxes{element::Box(1e6, 1e6, 1e6 + 1, 1e6 + 1)},
+      lazy_map);
+  ASSERT_EQ(ErrorCode::OK, ret.error_code);
+  ASSERT_EQ(0, lazy_map->loaded_road_size());
+}
+
+TEST_F(TestLazyMap, TestError) {
+  LazyMap lazy_map;
+  auto ret = lazy_map.Load("./tests/data/not-exist.xodr");
+  ASSERT_EQ(ErrorCode::XML_ROAD_ELEMENT_ERROR, ret.error_code);
+
+  /// 缺少 <planView>, 与 ParseMap 一样在加载时报错
+  const std::string header =
+      "<?xml version=\"1.0\"?><OpenDRIVE>"
+      "<header revMajor=\"1\" revMinor=\"4\"/>";
+  ret = lazy_map.LoadData(header +
+                          "<road id=\"1\" length=\"10\"/></OpenDRIVE>");
+  ASSERT_EQ(ErrorCode::XML_ROAD_PLANVIEW_ELEMENT_ERROR, ret.error_code);
+
+  /// <lanes> 内部的错误在访问时报告
+  ret = lazy_map.LoadData(
+      header +
+      "<road id=\"1\" length=\"10\"><link><successor elementType=\"road\" "
+      "elementId=\"2\"/></link><planView><geometry s=\"0\" x=\"0\" y=\"0\" "
+      "hdg=\"0\" length=\"10\"><line/></geometry></planView><lanes>"
+      "</lanes></road></OpenDRIVE>");
+  ASSERT_EQ(ErrorCode::OK, ret.error_code) << ret.msg;
+  ASSERT_EQ(2, lazy_map.PeekRoad(1)->link().successor().id());
+  opendrive::Status status;
+  ASSERT_TRUE(nullptr == lazy_map.GetRoad(1, &status));
+  ASSERT_EQ(ErrorCode::XML_LANES_SECTION_ELEMENT_ERROR, status.error_code);
+  ASSERT_TRUE(nullptr == lazy_map.GetRoad(2, &status));
+  ASSERT_EQ(ErrorCode::XML_ROAD_ELEMENT_ERROR, status.error_code);
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "opendrive-cpp/geometry/element.h"
+#include "opendrive-cpp/opendrive.h"
+#include "opendrive-cpp/snapshot/map_image.h"
+
+using namespace opendrive;
+
+class TestMapImage : public testing::Test {
+ public:
+  static void SetUpTestCase();     // 在第一个case之前执行
+  static void TearDownTestCase();  // 在最后一个case之后执行
+  void SetUp() override;           // 在每个case之前执行
+  void TearDown() override;        // 在每个case之后执行
+
+  static element::Map::Ptr ParseDom(const std::string& file) {
+    opendrive::Parser parser;
+    auto ele_map = std::make_shared<opendrive::element::Map>();
+    auto ret = parser.ParseMap(file, ele_map);
+    assert(opendrive::ErrorCode::OK == ret.error_code);
+    return ele_map;
+  }
+
+  static void ExpectSameLanes(const element::LanesInfo& expect,
+                              const snapshot::ViewList<snapshot::LaneView>&
+                                  actual) {
+    ASSERT_EQ(expect.lanes().size(), actual.size());
+    for (size_t i = 0; i < actual.size(); i++) {
+      const auto& expect_lane = expect.lanes().at(i);
+      const auto actual_lane = actual[i];
+      ASSERT_EQ(expect_lane.attribute().id(), actual_lane.id());
+      ASSERT_EQ(expect_lane.attribute().type(), actual_lane.type());
+      ASSERT_EQ(expect_lane.link().predecessors().size(),
+                actual_lane.predecessors().size());
+      ASSERT_EQ(expect_lane.link().successors().size(),
+                actual_lane.successors().size());
+      ASSERT_EQ(expect_lane.widths().size(), actual_lane.widths().size());
+      for (size_t j = 0; j < expect_lane.widths().size(); j++) {
+        ASSERT_DOUBLE_EQ(expect_lane.widths().at(j).a(),
+                         actual_lane.widths()[j].a);
+        ASSERT_DOUBLE_EQ(expect_lane.widths().at(j).s(),
+                         actual_lane.widths()[j].s);
+      }
+      ASSERT_EQ(expect_lane.road_marks().size(),
+                actual_lane.road_marks().size());
+      for (size_t j = 0; j < expect_lane.road_marks().size(); j++) {
+        ASSERT_EQ(expect_lane.road_marks().at(j).type(),
+                  actual_lane.road_marks()[j].type());
+        ASSERT_STREQ(expect_lane.road_marks().at(j).material().c_str(),
+                     actual_lane.road_marks()[j].material());
+      }
+    }
+  }
+
+  static void ExpectSameMap(const element::Map& expect,
+                            const snapshot::MapImage& actual) {
+    ASSERT_STREQ(expect.header().name().c_str(), actual.name());
+    ASSERT_STREQ(expect.header().rev_minor().c_str(), actual.rev_minor());
+    ASSERT_DOUBLE_EQ(expect.header().north(), actual.header().north);
+    ASSERT_EQ(expect.roads().size(), actual.roads().size());
+    size_t i = 0;
+    for (const auto actual_road : actual.roads()) {
+      const auto& expect_road = expect.roads().at(i++);
+      ASSERT_EQ(expect_road.attribute().id(), actual_road.id());
+      ASSERT_EQ(expect_road.attribute().junction_id(),
+                actual_road.junction_id());
+      ASSERT_STREQ(expect_road.attribute().name().c_str(), actual_road.name());
+      ASSERT_DOUBLE_EQ(expect_road.attribute().length(),
+                       actual_road.length());
+      ASSERT_EQ(expect_road.link().predecessor().id(),
+                actual_road.predecessor().id);
+      ASSERT_EQ(expect_road.type_info().size(),
+                actual_road.type_info().size());
+      const auto& expect_geometrys = expect_road.plan_view().geometrys();
+      const auto actual_geometrys = actual_road.geometrys();
+      ASSERT_EQ(expect_geometrys.size(), actual_geometrys.size());
+      for (size_t j = 0; j < expect_geometrys.size(); j++) {
+        const auto& expect_geometry = expect_geometrys.at(j);
+        const auto actual_geometry = actual_geometrys[j];
+        ASSERT_EQ(expect_geometry->type(), actual_geometry.type());
+        for (const double ratio : {0.0, 0.3, 1.0}) {
+          const double s =
+              expect_geometry->s() + expect_geometry->length() * ratio;
+          const auto expect_point = expect_geometry->GetPoint(s);
+          const auto actual_point = actual_geometry.GetPoint(s);
+          ASSERT_DOUBLE_EQ(expect_point.x(), actual_point.x());
+          ASSERT_DOUBLE_EQ(expect_point.y(), actual_point.y());
+          ASSERT_DOUBLE_EQ(expect_point.heading(), actual_point.heading());
+        }
+      }
+      ASSERT_EQ(expect_road.lanes().lane_offsets().size(),
+                actual_road.lane_offsets().size());
+      const auto& expect_sections = expect_road.lanes().lane_sections();
+      const auto actual_sections = actual_road.lane_sections();
+      ASSERT_EQ(expect_sections.size(), actual_sections.size());
+      for (size_t j = 0; j < expect_sections.size(); j++) {
+        ASSERT_DOUBLE_EQ(expect_sections.at(j).start_position(),
+                         actual_sections[j].start_position());
+        ASSERT_DOUBLE_EQ(expect_sections.at(j).end_position(),
+                         actual_sections[j].end_position());
+        ExpectSameLanes(expect_sections.at(j).left(),
+                        actual_sections[j].left());
+        ExpectSameLanes(expect_sections.at(j).center(),
+                        actual_sections[j].center());
+        ExpectSameLanes(expect_sections.at(j).right(),
+                        actual_sections[j].right());
+      }
+    }
+    ASSERT_EQ(expect.junctions().size(), actual.junctions().size());
+    for (const auto& expect_junction : expect.junctions()) {
+      const auto actual_junction =
+          actual.GetJunction(expect_junction.attribute().id());
+      ASSERT_TRUE(actual_junction.valid());
+      ASSERT_STREQ(expect_junction.attribute().name().c_str(),
+                   actual_junction.name());
+      ASSERT_EQ(expect_junction.connections().size(),
+                actual_junction.connections().size());
+      for (size_t j = 0; j < expect_junction.connections().size(); j++) {
+        const auto& expect_connection = expect_junction.connections().at(j);
+        const auto actual_connection = actual_junction.connections()[j];
+        ASSERT_EQ(expect_connection.incoming_road(),
+                  actual_connection.incoming_road());
+        ASSERT_EQ(expect_connection.connecting_road(),
+                  actual_connection.connecting_road());
+        ASSERT_EQ(expect_connection.lane_links().size(),
+                  actual_connection.lane_links().size());
+      }
+    }
+  }
+};
+
+void TestMapImage::SetUpTestCase() {}
+void TestMapImage::TearDownTestCase() {}
+void TestMapImage::TearDown() {}
+void TestMapImage::SetUp() {}
+
+TEST_F(TestMapImage, TestBuildAttach) {
+  for (const auto& file : {"./tests/data/only-unittest.xodr",
+                           "./tests/data/Ex_Simple-LaneOffset.xodr",
+                           "./tests/data/UC_Simple-X-Junction.xodr"}) {
+    auto ele_map = ParseDom(file);
+    std::string data;
+    auto ret = snapshot::BuildMapImage(*ele_map, &data);
+    ASSERT_EQ(opendrive::ErrorCode::OK, ret.error_code);
+    snapshot::MapImage image;
+    ret = image.Attach(data.data(), data.size());
+    ASSERT_EQ(opendrive::ErrorCode::OK, ret.error_code) << file;
+    ExpectSameMap(*ele_map, image);
+  }
+}
+
+TEST_F(TestMapImage, TestSaveAttachFile) {
+  const std::string file = "./map_image_test.odrimg";
+  auto ele_map = ParseDom("./tests/data/UC_Simple-X-Junction.xodr");
+  auto ret = snapshot::SaveMapImage(*ele_map, file);
+  ASSERT_EQ(opendrive::ErrorCode::OK, ret.error_code);
+
+  snapshot::MapImage image;
+  ret = image.Attach(file);
+  std::remove(file.c_str());  // 已映射, 删除文件不影响读取
+  ASSERT_EQ(opendrive::ErrorCode::OK, ret.error_code);
+  ASSERT_TRUE(image.IsAttached());
+  ExpectSameMap(*ele_map, image);
+
+  const auto& expect_road = ele_map->roads().back();
+  const auto road = image.GetRoad(expect_road.attribute().id());
+  ASSERT_TRUE(road.valid());
+  ASSERT_EQ(expect_road.attribute().id(), road.id());
+  ASSERT_FALSE(image.GetRoad(-100).valid());
+  ASSERT_FALSE(image.GetJunction(-100).valid());
+
+  auto geometry = road.geometrys()[0].ToElement();
+  ASSERT_TRUE(geometry != nullptr);
+  ASSERT_DOUBLE_EQ(expect_road.plan_view().geometrys().front()->x(),
+                   geometry->x());
+
+  image.Detach();
+  ASSERT_FALSE(image.IsAttached());
+}
+
+TEST_F(TestMapImage, TestInvalidImage) {
+  auto ele_map = ParseDom("./tests/data/UC_Simple-X-Junction.xodr");
+  std::string data;
+  snapshot::BuildMapImage(*ele_map, &data);
+  snapshot::MapImage image;
+
+  std::string bad = data;
+  bad[0] = 'X';
+  auto ret = image.Attach(bad.data(), bad.size());
+  ASSERT_EQ(opendrive::ErrorCode::LOAD_DATA_ERROR, ret.error_code);
+
+  ret = image.Attach(data.data(), data.size() - 8);
+  ASSERT_EQ(opendrive::ErrorCode::LOAD_DATA_ERROR, ret.error_code);
+
+  // 破坏第一条 road 的 geometry 范围
+  bad = data;
+  const auto image_header =
+      reinterpret_cast<const snapshot::record::ImageHeader*>(bad.data());
+  const size_t offset = image_header->tables[snapshot::record::kRoads].offset +
+                        offsetof(snapshot::record::Road, geometrys);
+  const snapshot::record::Range range{0xffffff, 1};
+  std::memcpy(&bad[offset], &range, sizeof(range));
+  ret = image.Attach(bad.data(), bad.size());
+  ASSERT_EQ(opendrive::ErrorCode::LOAD_DATA_ERROR, ret.error_code);
+  ASSERT_FALSE(image.IsAttached());
+
+  ret = image.Attach("./tests/data/not-exist.odrimg");
+  ASSERT_EQ(opendrive::ErrorCode::LOAD_DATA_ERROR, ret.error_code);
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
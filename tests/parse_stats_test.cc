@@ -0,0 +1,224 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "opendrive-cpp/common/arena.h"
+#include "opendrive-cpp/common/parse_stats.h"
+#include "opendrive-cpp/geometry/element.h"
+#include "opendrive-cpp/opendrive.h"
+
+using namespace opendrive;
+
+class TestParseStats : public testing::Test {
+ public:
+  static void SetUpTestCase();     // 在第一个case之前执行
+  static void TearDownTestCase();  // 在最后一个case之后执行
+  void SetUp() override;           // 在每个case之前执行
+  void TearDown() override;        // 在每个case之后执行
+
+  static std::string ReadFile(const std::string& file) {
+    std::ifstream in(file, std::ios::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+  }
+
+  /// 按 Map 的内容核对计数
+  static void ExpectCounts(const element::Map& ele_map,
+                           const ParseStats& stats) {
+    uint64_t geometries[ParseStats::kGeometryTypeNum] = {};
+    uint64_t sections = 0;
+    uint64_t lanes = 0;
+    uint64_t widths = 0;
+    uint64_t road_marks = 0;
+    for (const auto& road : ele_map.roads()) {
+      for (const auto& geometry : road.plan_view().geometrys()) {
+        geometries[static_cast<size_t>(geometry->type())]++;
+      }
+      for (const auto& section : road.lanes().lane_sections()) {
+        sections++;
+        for (const auto* info :
+             {&section.left(), &section.center(), &section.right()}) {
+          lanes += info->lanes().size();
+          for (const auto& lane : info->lanes()) {
+            widths += lane.widths().size();
+            road_marks += lane.road_marks().size();
+          }
+        }
+      }
+    }
+    uint64_t connections = 0;
+    for (const auto& junction : ele_map.junctions()) {
+      connections += junction.connections().size();
+    }
+    using Counter = ParseStats::Counter;
+    EXPECT_EQ(ele_map.roads().size(), stats.count(Counter::kRoads));
+    EXPECT_EQ(ele_map.junctions().size(), stats.count(Counter::kJunctions));
+    EXPECT_EQ(connections, stats.count(Counter::kConnections));
+    EXPECT_EQ(sections, stats.count(Counter::kLaneSections));
+    EXPECT_EQ(lanes, stats.count(Counter::kLanes));
+    EXPECT_EQ(widths, stats.count(Counter::kWidths));
+    EXPECT_EQ(road_marks, stats.count(Counter::kRoadMarks));
+    uint64_t geometry_num = 0;
+    for (size_t i = 0; i < ParseStats::kGeometryTypeNum; i++) {
+      EXPECT_EQ(geometries[i],
+                stats.geometry_count(static_cast<GeometryType>(i)));
+      geometry_num += geometries[i];
+    }
+    EXPECT_EQ(geometry_num, stats.count(Counter::kGeometries));
+    EXPECT_EQ(ele_map.roads().size(),
+              stats.stage_calls(ParseStats::Stage::kRoad));
+    EXPECT_EQ(sections, stats.stage_calls(ParseStats::Stage::kLaneSection));
+    EXPECT_EQ(1, stats.stage_calls(ParseStats::Stage::kHeader));
+  }
+
+  static const std::vector<std::string> kFiles;
+};
+
+const std::vector<std::string> TestParseStats::kFiles = {
+    "./tests/data/only-unittest.xodr",
+    "./tests/data/UC_Simple-X-Junction.xodr",
+};
+
+void TestParseStats::SetUpTestCase() {}
+void TestParseStats::TearDownTestCase() {}
+void TestParseStats::TearDown() {}
+void TestParseStats::SetUp() {}
+
+TEST_F(TestParseStats, TestParseMap) {
+  for (const auto& file : kFiles) {
+    for (size_t thread_num : {1, 4}) {
+      ParseStats stats;
+      ParseOptions options;
+      options.thread_num = thread_num;
+      options.stats = &stats;
+      Parser parser(options);
+      auto ele_map = std::make_shared<element::Map>();
+      auto ret = parser.ParseMap(file, ele_map);
+      ASSERT_EQ(ErrorCode::OK, ret.error_code);
+      ExpectCounts(*ele_map, stats);
+      ASSERT_EQ(ReadFile(file).size(), stats.bytes_processed());
+      ASSERT_EQ(1, stats.stage_calls(ParseStats::Stage::kLoadXml));
+      ASSERT_GT(stats.stage_ms(ParseStats::Stage::kRoad), 0);
+      ASSERT_GE(stats.stage_ms(ParseStats::Stage::kRoad),
+                stats.stage_ms(ParseStats::Stage::kLanes));
+      ASSERT_EQ(0, stats.arena_bytes());
+
+      /// 每次 ParseMap 前清零
+      ele_map = std::make_shared<element::Map>();
+      ret = parser.ParseMap(file, ele_map);
+      ASSERT_EQ(ErrorCode::OK, ret.error_code);
+      ExpectCounts(*ele_map, stats);
+      ASSERT_FALSE(stats.ToString().empty());
+    }
+  }
+}
+
+TEST_F(TestParseStats, TestStream) {
+  const std::string file = "./tests/data/UC_Simple-X-Junction.xodr";
+  const std::string data = ReadFile(file);
+  ParseStats stats;
+  ParseOptions options;
+  options.stats = &stats;
+  Parser parser(options);
+  common::Arena arena;
+  auto ele_map = element::Map::Create(&arena);
+  auto ret = parser.ParseMapStream(file, ele_map);
+  ASSERT_EQ(ErrorCode::OK, ret.error_code);
+  ExpectCounts(*ele_map, stats);
+  ASSERT_EQ(data.size(), stats.bytes_processed());
+  ASSERT_EQ(arena.bytes_reserved(), stats.arena_bytes());
+  /// header, junction, road 各一个片段 DOM
+  ASSERT_EQ(1 + ele_map->junctions().size() + ele_map->roads().size(),
+            stats.stage_calls(ParseStats::Stage::kLoadXml));
+
+  ele_map = std::make_shared<element::Map>();
+  ret = parser.ParseMap(data.data(), data.size(), ele_map);
+  ASSERT_EQ(ErrorCode::OK, ret.error_code);
+  ExpectCounts(*ele_map, stats);
+  ASSERT_EQ(data.size(), stats.bytes_processed());
+}
+
+/// 只统计区间内新增的驻留内存, 不是进程生命周期的峰值
+TEST_F(TestParseStats, TestRssDelta) {
+  constexpr size_t kBytes = 64 * 1024 * 1024;
+  ParseStats stats;
+  stats.MarkRssBegin();
+  std::vector<char> block(kBytes, 1);
+  stats.UpdateRssDelta();
+  EXPECT_GE(stats.rss_delta_bytes(), static_cast<int64_t>(kBytes / 2));
+
+  std::vector<char>().swap(block);
+  stats.MarkRssBegin();
+  stats.UpdateRssDelta();
+  EXPECT_LT(stats.rss_delta_bytes(), static_cast<int64_t>(kBytes / 2));
+  stats.Reset();
+  EXPECT_EQ(0, stats.rss_delta_bytes());
+}
+
+TEST_F(TestParseStats, TestDisabled) {
+  ParseStats stats;
+  {
+    ScopedParseStats scope(&stats);
+    ASSERT_EQ(&stats, ParseStats::Current());
+    ScopedStageTimer timer(ParseStats::Stage::kHeader);
+  }
+  ASSERT_EQ(nullptr, ParseStats::Current());
+  ASSERT_EQ(1, stats.stage_calls(ParseStats::Stage::kHeader));
+
+  /// 未设置 ParseOptions::stats 时不记录
+  stats.Reset();
+  ScopedStageTimer timer(ParseStats::Stage::kHeader);
+  Parser parser;
+  auto ele_map = std::make_shared<element::Map>();
+  ASSERT_EQ(ErrorCode::OK,
+            parser.ParseMap(kFiles.front(), ele_map).error_code);
+  ASSERT_EQ(0, stats.count(ParseStats::Counter::kRoads));
+  ASSERT_EQ(0, stats.stage_calls(ParseStats::Stage::kHeader));
+}
+
+TEST_F(TestParseStats, TestLaneBoundaryTables) {
+  ParseStats stats;
+  ParseOptions options;
+  options.stats = &stats;
+  options.lane_boundary_tables = true;
+  Parser parser(options);
+  common::Arena arena;
+  auto ele_map = element::Map::Create(&arena);
+  ASSERT_EQ(ErrorCode::OK, parser.ParseMap(kFiles.back(), ele_map).error_code);
+  ExpectCounts(*ele_map, stats);
+  uint64_t segments = 0;
+  uint64_t bytes = 0;
+  for (const auto& road : ele_map->roads()) {
+    for (const auto& section : road.lanes().lane_sections()) {
+      const auto& table = section.boundary_table();
+      segments += table.segment_num();
+      bytes += table.bytes();
+      /// 与元素树分配在同一个 arena 中
+      ASSERT_EQ(&arena, table.starts().get_allocator().arena());
+    }
+  }
+  using Counter = ParseStats::Counter;
+  ASSERT_GT(segments, 0);
+  ASSERT_EQ(segments, stats.count(Counter::kBoundarySegments));
+  ASSERT_EQ(bytes, stats.count(Counter::kBoundaryBytes));
+  ASSERT_EQ(ele_map->roads().size(),
+            stats.stage_calls(ParseStats::Stage::kLaneBoundary));
+  ASSERT_EQ(arena.bytes_reserved(), stats.arena_bytes());
+
+  options.lane_boundary_tables = false;
+  ele_map = std::make_shared<element::Map>();
+  ASSERT_EQ(ErrorCode::OK,
+            Parser(options).ParseMap(kFiles.back(), ele_map).error_code);
+  ASSERT_EQ(0, stats.count(Counter::kBoundarySegments));
+  ASSERT_EQ(0, stats.stage_calls(ParseStats::Stage::kLaneBoundary));
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "opendrive-cpp/geometry/element.h"
+#include "opendrive-cpp/opendrive.h"
+
+using namespace opendrive;
+
+class TestParseTask : public testing::Test {
+ public:
+  static void SetUpTestCase();     // 在第一个case之前执行
+  static void TearDownTestCase();  // 在最后一个case之后执行
+  void SetUp() override;           // 在每个case之前执行
+  void TearDown() override;        // 在每个case之后执行
+
+  static std::string Fingerprint(const element::Map& ele_map) {
+    std::string data;
+    snapshot::SerializeMap(ele_map, &data);
+    return data;
+  }
+
+  static const std::string kFile;
+};
+
+const std::string TestParseTask::kFile =
+    "./tests/data/UC_Simple-X-Junction.xodr";
+
+void TestParseTask::SetUpTestCase() {}
+void TestParseTask::TearDownTestCase() {}
+void TestParseTask::TearDown() {}
+void TestParseTask::SetUp() {}
+
+TEST_F(TestParseTask, TestProgress) {
+  for (size_t thread_num : {1, 4}) {
+    std::vector<ParseProgress> reports;
+    ParseOptions options;
+    options.thread_num = thread_num;
+    options.progress = [&reports](const ParseProgress& progress) {
+      reports.emplace_back(progress);
+    };
+    Parser parser(options);
+    auto ele_map = std::make_shared<element::Map>();
+    ASSERT_EQ(ErrorCode::OK, parser.ParseMap(kFile, ele_map).error_code);
+    /// 开始时报告一次, 串行时之后每条 road 一次(少于 100 条);
+    /// 并行时较小的进度可能被跳过, 但保持单调
+    if (1 == thread_num) {
+      ASSERT_EQ(ele_map->roads().size() + 1, reports.size());
+    }
+    ASSERT_EQ(0, reports.front().roads_parsed);
+    ASSERT_EQ(ele_map->roads().size(), reports.back().roads_parsed);
+    for (size_t i = 0; i < reports.size(); i++) {
+      if (i > 0) {
+        ASSERT_GT(reports.at(i).roads_parsed, reports.at(i - 1).roads_parsed);
+      }
+      ASSERT_EQ(ele_map->roads().size(), reports.at(i).roads_total);
+      ASSERT_GT(reports.at(i).bytes_total, 0);
+      ASSERT_EQ(reports.at(i).bytes_total, reports.at(i).bytes_consumed);
+    }
+  }
+}
+
+TEST_F(TestParseTask, TestCancel) {
+  /// 第 3 条 road 之后取消, 已解析的元素被清空
+  std::atomic<bool> cancel{false};
+  ParseOptions options;
+  options.cancel = &cancel;
+  options.progress = [&cancel](const ParseProgress& progress) {
+    if (3 == progress.roads_parsed) cancel = true;
+  };
+  Parser parser(options);
+  auto ele_map = std::make_shared<element::Map>();
+  auto ret = parser.ParseMap(kFile, ele_map);
+  ASSERT_EQ(ErrorCode::PARSE_CANCELLED, ret.error_code);
+  ASSERT_TRUE(ele_map->roads().empty());
+  ASSERT_TRUE(ele_map->junctions().empty());
+
+  /// 已取消的批量解析不再加载文件
+  std::vector<element::Map::Ptr> ele_maps;
+  auto statuses = parser.ParseMaps({kFile, kFile}, &ele_maps);
+  ASSERT_EQ(2, statuses.size());
+  for (const auto& status : statuses) {
+    ASSERT_EQ(ErrorCode::PARSE_CANCELLED, status.error_code);
+  }
+}
+
+TEST_F(TestParseTask, TestAsync) {
+  auto expect_map = std::make_shared<element::Map>();
+  ASSERT_EQ(ErrorCode::OK, Parser().ParseMap(kFile, expect_map).error_code);
+
+  ParseTask::Ptr task;
+  auto ele_map = std::make_shared<element::Map>();
+  {
+    ParseOptions options;
+    options.thread_num = 2;
+    /// Parser 可以先于 task 析构
+    task = Parser(options).ParseMapAsync(kFile, ele_map);
+  }
+  ASSERT_EQ(ErrorCode::OK, task->Wait().error_code);
+  ASSERT_TRUE(task->ready());
+  ASSERT_TRUE(task->WaitFor(std::chrono::milliseconds(1)));
+  ASSERT_EQ(expect_map->roads().size(), task->progress().roads_total);
+  ASSERT_EQ(expect_map->roads().size(), task->progress().roads_parsed);
+  ASSERT_EQ(Fingerprint(*expect_map), Fingerprint(*ele_map));
+}
+
+TEST_F(TestParseTask, TestAsyncCancel) {
+  /// 第一条 road 之后停住, 直到调用 Cancel
+  std::atomic<bool> resume{false};
+  ParseOptions options;
+  options.progress = [&resume](const ParseProgress& progress) {
+    while (1 == progress.roads_parsed && !resume) {
+      std::this_thread::yield();
+    }
+  };
+  auto ele_map = std::make_shared<element::Map>();
+  auto task = Parser(options).ParseMapAsync(kFile, ele_map);
+  while (task->progress().roads_parsed < 1) {
+    std::this_thread::yield();
+  }
+  ASSERT_FALSE(task->ready());
+  task->Cancel();
+  ASSERT_TRUE(task->cancelled());
+  resume = true;
+  ASSERT_EQ(ErrorCode::PARSE_CANCELLED, task->Wait().error_code);
+  ASSERT_EQ(1, task->progress().roads_parsed);
+  ASSERT_TRUE(ele_map->roads().empty());
+
+  /// 析构时取消并等待线程退出
+  resume = false;
+  ele_map = std::make_shared<element::Map>();
+  task = Parser(options).ParseMapAsync(kFile, ele_map);
+  while (task->progress().roads_parsed < 1) {
+    std::this_thread::yield();
+  }
+  std::thread release([&resume]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    resume = true;
+  });
+  task.reset();
+  release.join();
+  ASSERT_TRUE(ele_map->roads().empty());
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,7 +1,14 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <cassert>
+#include <cstring>
+#include <fstream>
 #include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "opendrive-cpp/geometry/element.h"
 #include "opendrive-cpp/opendrive.h"
@@ -36,6 +43,20 @@ class TestMapParser : public testing::Test {
     return instance;
   }
 
+  static std::string ReadFile(const std::string& file) {
+    std::ifstream in(file, std::ios::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+  }
+
+  /// 所有字段都参与快照编码, 快照一致即两个 Map 一致
+  static std::string Fingerprint(const opendrive::element::Map& ele_map) {
+    std::string data;
+    opendrive::snapshot::SerializeMap(ele_map, &data);
+    return data;
+  }
+
   static std::string xml_file_path;
 };
 
@@ -61,6 +82,278 @@ TEST_F(TestMapParser, TestMapFile) {
   ASSERT_TRUE(opendrive::ErrorCode::OK == ret.error_code);
 }
 
+TEST_F(TestMapParser, TestMapFileMmap) {
+  opendrive::ParseOptions options;
+  options.use_mmap = true;
+  opendrive::Parser parser(options);
+  auto ele_map = std::make_shared<opendrive::element::Map>();
+  auto ret = parser.ParseMap(xml_file_path, ele_map);
+  ASSERT_TRUE(opendrive::ErrorCode::OK == ret.error_code);
+  auto expect_map = std::make_shared<opendrive::element::Map>();
+  ret = GetParser()->ParseMap(xml_file_path, expect_map);
+  ASSERT_TRUE(opendrive::ErrorCode::OK == ret.error_code);
+  ASSERT_EQ(Fingerprint(*expect_map), Fingerprint(*ele_map));
+  ASSERT_EQ("zhichun Rd", ele_map->header().name());
+  ASSERT_EQ(GetParser()->GetOpenDriveVersion(), parser.GetOpenDriveVersion());
+
+  ret = parser.ParseMap("./tests/data/not-exist.xodr", ele_map);
+  ASSERT_TRUE(opendrive::ErrorCode::OK != ret.error_code);
+
+  /// 流式解析时按 road 报告进度, 取消后清空地图
+  std::atomic<bool> cancel{false};
+  std::vector<opendrive::ParseProgress> reports;
+  options.cancel = &cancel;
+  options.progress = [&](const opendrive::ParseProgress& progress) {
+    reports.emplace_back(progress);
+    if (2 == progress.roads_parsed) cancel = true;
+  };
+  ele_map = std::make_shared<opendrive::element::Map>();
+  ret = opendrive::Parser(options).ParseMap(xml_file_path, ele_map);
+  ASSERT_EQ(opendrive::ErrorCode::PARSE_CANCELLED, ret.error_code);
+  ASSERT_TRUE(ele_map->roads().empty());
+  ASSERT_EQ(2, reports.size());
+  ASSERT_EQ(ReadFile(xml_file_path).size(), reports.back().bytes_total);
+}
+
+TEST_F(TestMapParser, TestMapParallel) {
+  const std::vector<std::string> files{"./tests/data/only-unittest.xodr",
+                                       "./tests/data/UC_Simple-X-Junction.xodr"};
+  for (const auto& file : files) {
+    opendrive::Parser serial_parser;
+    auto serial_map = std::make_shared<opendrive::element::Map>();
+    auto ret = serial_parser.ParseMap(file, serial_map);
+    ASSERT_EQ(opendrive::ErrorCode::OK, ret.error_code);
+
+    opendrive::ParseOptions options;
+    options.thread_num = 4;
+    opendrive::Parser parallel_parser(options);
+    auto parallel_map = std::make_shared<opendrive::element::Map>();
+    ret = parallel_parser.ParseMap(file, parallel_map);
+    ASSERT_EQ(opendrive::ErrorCode::OK, ret.error_code);
+
+    ASSERT_EQ(serial_map->roads().size(), parallel_map->roads().size());
+    for (size_t i = 0; i < serial_map->roads().size(); i++) {
+      const auto& serial_road = serial_map->roads().at(i);
+      const auto& parallel_road = parallel_map->roads().at(i);
+      ASSERT_EQ(serial_road.attribute().id(), parallel_road.attribute().id());
+      ASSERT_EQ(serial_road.plan_view().geometrys().size(),
+                parallel_road.plan_view().geometrys().size());
+      ASSERT_EQ(serial_road.lanes().lane_sections().size(),
+                parallel_road.lanes().lane_sections().size());
+    }
+    ASSERT_EQ(serial_map->junctions().size(), parallel_map->junctions().size());
+    for (size_t i = 0; i < serial_map->junctions().size(); i++) {
+      ASSERT_EQ(serial_map->junctions().at(i).attribute().id(),
+                parallel_map->junctions().at(i).attribute().id());
+      ASSERT_EQ(serial_map->junctions().at(i).connections().size(),
+                parallel_map->junctions().at(i).connections().size());
+    }
+  }
+}
+
+TEST_F(TestMapParser, TestMapParallelError) {
+  /// road 2 缺少 <planView>, road 3 缺少 <lanes>, 返回文档顺序的第一个错误
+  const char* xml =
+      "<OpenDRIVE><header revMajor=\"1\" revMinor=\"4\"/>"
+      "<road id=\"1\" length=\"1\"><planView><geometry s=\"0\" x=\"0\" "
+      "y=\"0\" hdg=\"0\" length=\"1\"><line/></geometry></planView>"
+      "<lanes><laneSection s=\"0\"><center><lane id=\"0\"/></center>"
+      "</laneSection></lanes></road>"
+      "<road id=\"2\" length=\"1\"><lanes/></road>"
+      "<road id=\"3\" length=\"1\"><planView><geometry s=\"0\" x=\"0\" "
+      "y=\"0\" hdg=\"0\" length=\"1\"><line/></geometry></planView>"
+      "</road>"
+      "</OpenDRIVE>";
+  tinyxml2::XMLDocument doc;
+  ASSERT_EQ(tinyxml2::XML_SUCCESS, doc.Parse(xml));
+  opendrive::ParseOptions options;
+  options.thread_num = 3;
+  opendrive::Parser parser(options);
+  auto ele_map = std::make_shared<opendrive::element::Map>();
+  auto ret = parser.ParseMap(doc.RootElement(), ele_map);
+  ASSERT_EQ(opendrive::ErrorCode::XML_ROAD_PLANVIEW_ELEMENT_ERROR,
+            ret.error_code);
+  ASSERT_EQ(3, ele_map->roads().size());
+  ASSERT_EQ(1, ele_map->roads().at(0).attribute().id());
+}
+
+TEST_F(TestMapParser, TestMapBuffer) {
+  const std::string data = ReadFile(xml_file_path);
+  auto ele_map = std::make_shared<opendrive::element::Map>();
+  auto ret = GetParser()->ParseMap(data.data(), data.size(), ele_map);
+  ASSERT_TRUE(opendrive::ErrorCode::OK == ret.error_code);
+  auto expect_map = std::make_shared<opendrive::element::Map>();
+  ret = GetParser()->ParseMap(xml_file_path, expect_map);
+  ASSERT_TRUE(opendrive::ErrorCode::OK == ret.error_code);
+  ASSERT_EQ(Fingerprint(*expect_map), Fingerprint(*ele_map));
+
+  ret = GetParser()->ParseMap(data.data(), data.size() / 2, ele_map);
+  ASSERT_TRUE(opendrive::ErrorCode::OK != ret.error_code);
+}
+
+TEST_F(TestMapParser, TestMapCompressedStream) {
+  if (!opendrive::common::InflateStream::Supported()) return;
+  const std::string file = "./tests/data/UC_Simple-X-Junction.xodr";
+  const std::string compressed = ReadFile(file + ".gz");
+  auto expect_map = std::make_shared<opendrive::element::Map>();
+  auto ret = GetParser()->ParseMap(file, expect_map);
+  ASSERT_TRUE(opendrive::ErrorCode::OK == ret.error_code);
+  const std::string version = GetParser()->GetOpenDriveVersion();
+  ASSERT_FALSE(version.empty());
+
+  /// 压缩的内存数据
+  auto ele_map = std::make_shared<opendrive::element::Map>();
+  {
+    opendrive::Parser parser;
+    ret = parser.ParseMap(compressed.data(), compressed.size(), ele_map);
+    ASSERT_TRUE(opendrive::ErrorCode::OK == ret.error_code);
+    ASSERT_EQ(Fingerprint(*expect_map), Fingerprint(*ele_map));
+    ASSERT_EQ(version, parser.GetOpenDriveVersion());
+  }
+
+  /// 数据源每次只返回少量字节, 串行与流水线两种方式
+  for (size_t thread_num : {1, 2}) {
+    for (size_t step : {1, 7, 4096}) {
+      opendrive::ParseOptions options;
+      options.thread_num = thread_num;
+      opendrive::Parser parser(options);
+      size_t pos = 0;
+      auto reader = [&compressed, &pos, step](char* buf, size_t size) {
+        size = std::min(std::min(size, step), compressed.size() - pos);
+        std::memcpy(buf, compressed.data() + pos, size);
+        pos += size;
+        return static_cast<long>(size);
+      };
+      ele_map = std::make_shared<opendrive::element::Map>();
+      ret = parser.ParseMap(reader, ele_map);
+      ASSERT_TRUE(opendrive::ErrorCode::OK == ret.error_code) << ret.msg;
+      ASSERT_EQ(Fingerprint(*expect_map), Fingerprint(*ele_map));
+      ASSERT_EQ(version, parser.GetOpenDriveVersion());
+    }
+  }
+
+  /// 串联的 gzip member
+  const std::string multi =
+      ReadFile("./tests/data/UC_Simple-X-Junction.multi.xodr.gz");
+  ele_map = std::make_shared<opendrive::element::Map>();
+  ret = GetParser()->ParseMap(multi.data(), multi.size(), ele_map);
+  ASSERT_TRUE(opendrive::ErrorCode::OK == ret.error_code) << ret.msg;
+  ASSERT_EQ(Fingerprint(*expect_map), Fingerprint(*ele_map));
+
+  /// 未压缩的数据源原样透传
+  const std::string xml = ReadFile(file);
+  {
+    size_t pos = 0;
+    auto reader = [&xml, &pos](char* buf, size_t size) {
+      size = std::min(size, xml.size() - pos);
+      std::memcpy(buf, xml.data() + pos, size);
+      pos += size;
+      return static_cast<long>(size);
+    };
+    ele_map = std::make_shared<opendrive::element::Map>();
+    ret = GetParser()->ParseMap(reader, ele_map);
+    ASSERT_TRUE(opendrive::ErrorCode::OK == ret.error_code);
+    ASSERT_EQ(Fingerprint(*expect_map), Fingerprint(*ele_map));
+  }
+
+  /// 截断与读取错误
+  ret = GetParser()->ParseMap(compressed.data(), compressed.size() / 2,
+                              ele_map);
+  ASSERT_EQ(opendrive::ErrorCode::LOAD_DATA_ERROR, ret.error_code);
+  ret = GetParser()->ParseMap(
+      [](char*, size_t) -> long { return -1; }, ele_map);
+  ASSERT_EQ(opendrive::ErrorCode::LOAD_DATA_ERROR, ret.error_code);
+}
+
+TEST_F(TestMapParser, TestMapReuse) {
+  /// 出错后同一个 Parser 仍然可以解析其它地图
+  opendrive::Parser parser;
+  auto ele_map = std::make_shared<opendrive::element::Map>();
+  tinyxml2::XMLDocument doc;
+  ASSERT_EQ(tinyxml2::XML_SUCCESS,
+            doc.Parse("<OpenDRIVE><header revMajor=\"1\" revMinor=\"4\"/>"
+                      "</OpenDRIVE>"));
+  auto ret = parser.ParseMap(doc.RootElement(), ele_map);
+  ASSERT_EQ(opendrive::ErrorCode::XML_ROAD_ELEMENT_ERROR, ret.error_code);
+  ele_map = std::make_shared<opendrive::element::Map>();
+  ret = parser.ParseMap(xml_file_path, ele_map);
+  ASSERT_EQ(opendrive::ErrorCode::OK, ret.error_code);
+  ASSERT_FALSE(parser.GetOpenDriveVersion().empty());
+}
+
+TEST_F(TestMapParser, TestMapConcurrent) {
+  const std::vector<std::string> files{"./tests/data/only-unittest.xodr",
+                                       "./tests/data/UC_Simple-X-Junction.xodr",
+                                       "./tests/data/Ex_Simple-LaneOffset.xodr"};
+  std::vector<std::string> expects;
+  for (const auto& file : files) {
+    auto ele_map = std::make_shared<opendrive::element::Map>();
+    ASSERT_EQ(opendrive::ErrorCode::OK,
+              GetParser()->ParseMap(file, ele_map).error_code);
+    expects.emplace_back(Fingerprint(*ele_map));
+  }
+  /// 多个线程共享同一个 Parser
+  for (size_t thread_num : {1, 2}) {
+    opendrive::ParseOptions options;
+    options.thread_num = thread_num;
+    const opendrive::Parser parser(options);
+    std::vector<std::string> results(files.size() * 4);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < results.size(); i++) {
+      threads.emplace_back([&, i]() {
+        auto ele_map = std::make_shared<opendrive::element::Map>();
+        auto ret = parser.ParseMap(files.at(i % files.size()), ele_map);
+        if (opendrive::ErrorCode::OK == ret.error_code) {
+          results.at(i) = Fingerprint(*ele_map);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (size_t i = 0; i < results.size(); i++) {
+      ASSERT_EQ(expects.at(i % files.size()), results.at(i));
+    }
+  }
+}
+
+TEST_F(TestMapParser, TestParseMaps) {
+  const std::vector<std::string> files{
+      "./tests/data/only-unittest.xodr",
+      "./tests/data/UC_Simple-X-Junction.xodr", "./tests/data/not-exist.xodr",
+      "./tests/data/Ex_Simple-LaneOffset.xodr"};
+  for (size_t thread_num : {1, 3}) {
+    opendrive::ParseStats stats;
+    opendrive::ParseOptions options;
+    options.thread_num = thread_num;
+    options.stats = &stats;
+    opendrive::Parser parser(options);
+    std::vector<opendrive::element::Map::Ptr> ele_maps;
+    auto statuses = parser.ParseMaps(files, &ele_maps);
+    ASSERT_EQ(files.size(), statuses.size());
+    ASSERT_EQ(files.size(), ele_maps.size());
+    size_t roads = 0;
+    for (size_t i = 0; i < files.size(); i++) {
+      ASSERT_TRUE(ele_maps.at(i));
+      if (2 == i) {
+        ASSERT_NE(opendrive::ErrorCode::OK, statuses.at(i).error_code);
+        continue;
+      }
+      ASSERT_EQ(opendrive::ErrorCode::OK, statuses.at(i).error_code);
+      auto expect_map = std::make_shared<opendrive::element::Map>();
+      ASSERT_EQ(opendrive::ErrorCode::OK,
+                GetParser()->ParseMap(files.at(i), expect_map).error_code);
+      ASSERT_EQ(Fingerprint(*expect_map), Fingerprint(*ele_maps.at(i)));
+      roads += ele_maps.at(i)->roads().size();
+    }
+    /// 统计为所有文件之和
+    ASSERT_EQ(roads, stats.count(opendrive::ParseStats::Counter::kRoads));
+    ASSERT_EQ(ReadFile(files.at(0)).size() + ReadFile(files.at(1)).size() +
+                  ReadFile(files.at(3)).size(),
+              stats.bytes_processed());
+  }
+}
+
 int main(int argc, char* argv[]) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -1,8 +1,12 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstdlib>
 #include <memory>
 #include <set>
+#include <vector>
 
 #include "opendrive-cpp/geometry/element.h"
 #include "opendrive-cpp/opendrive.h"
@@ -181,6 +185,282 @@ TEST_F(TestRoadLanesParser, TestRoadLanes) {
   ASSERT_DOUBLE_EQ(4.0000000000000000e+0, lane_section1_roadmarks21.height());
 }
 
+namespace {
+
+/// 逐条车道调用 Lane::GetLaneWidth 的参考实现, lane_offsets 线性查找
+double NaiveBoundary(const element::LaneSection& section,
+                     const element::LaneOffsets& lane_offsets,
+                     const element::Vector<element::Lane>& lanes, size_t j,
+                     double road_s, double sign) {
+  double center = 0;
+  for (int i = static_cast<int>(lane_offsets.size()) - 1; i >= 0; i--) {
+    if (road_s >= lane_offsets.at(i).s()) {
+      center = lane_offsets.at(i).GetOffsetValue(road_s);
+      break;
+    }
+  }
+  const double ds = road_s - section.start_position();
+  const int id = std::abs(lanes.at(j).attribute().id());
+  double t = center;
+  for (int inner = 1; inner <= id; inner++) {
+    for (const auto& lane : lanes) {
+      if (std::abs(lane.attribute().id()) != inner) continue;
+      if (!lane.widths().empty()) {
+        t += sign * lane.GetLaneWidth(ds);
+      } else if (!lane.borders().empty() &&
+                 std::max(0., ds) >= lane.borders().front().s()) {
+        t = center + sign * lane.GetLaneWidth(ds);
+      }
+    }
+  }
+  return t;
+}
+
+}  // namespace
+
+TEST_F(TestRoadLanesParser, TestLaneBoundaries) {
+  size_t checked = 0;
+  for (const char* file : {"./tests/data/only-unittest.xodr",
+                           "./tests/data/Ex_Simple-LaneOffset.xodr",
+                           "./tests/data/UC_Simple-X-Junction.xodr"}) {
+    auto ele_map = std::make_shared<element::Map>();
+    Parser parser;
+    ASSERT_EQ(ErrorCode::OK, parser.ParseMap(file, ele_map).error_code);
+    for (const auto& road : ele_map->roads()) {
+      const auto& lane_offsets = road.lanes().lane_offsets();
+      for (const auto& section : road.lanes().lane_sections()) {
+        std::vector<double> road_s;
+        for (double s = section.start_position(); s <= section.end_position();
+             s += 0.37) {
+          road_s.emplace_back(s);
+        }
+        road_s.emplace_back(section.end_position());
+        element::LaneBoundaries boundaries;
+        section.GetLaneBoundaries(road_s.data(), road_s.size(), lane_offsets,
+                                  &boundaries);
+        ASSERT_EQ(road_s.size(), boundaries.size());
+        ASSERT_EQ(section.left().lanes().size(), boundaries.left_num());
+        ASSERT_EQ(section.right().lanes().size(), boundaries.right_num());
+        element::LaneBoundaries single;
+        for (size_t i = 0; i < road_s.size(); i++) {
+          section.GetLaneBoundaries(road_s.at(i), lane_offsets, &single);
+          ASSERT_DOUBLE_EQ(road_s.at(i), boundaries.road_s(i));
+          ASSERT_DOUBLE_EQ(single.center(0), boundaries.center(i));
+          for (size_t j = 0; j < boundaries.left_num(); j++) {
+            ASSERT_DOUBLE_EQ(single.left(0, j), boundaries.left(i, j));
+            ASSERT_NEAR(NaiveBoundary(section, lane_offsets,
+                                      section.left().lanes(), j, road_s.at(i),
+                                      1.),
+                        boundaries.left(i, j), 1e-9)
+                << file << " road " << road.attribute().id() << " s "
+                << road_s.at(i);
+            checked++;
+          }
+          for (size_t j = 0; j < boundaries.right_num(); j++) {
+            ASSERT_DOUBLE_EQ(single.right(0, j), boundaries.right(i, j));
+            ASSERT_NEAR(NaiveBoundary(section, lane_offsets,
+                                      section.right().lanes(), j,
+                                      road_s.at(i), -1.),
+                        boundaries.right(i, j), 1e-9)
+                << file << " road " << road.attribute().id() << " s "
+                << road_s.at(i);
+            checked++;
+          }
+        }
+      }
+    }
+  }
+  ASSERT_GT(checked, 0);
+}
+
+/// 只有 <border> 的车道: 外边界为中心车道加上 border 值
+TEST_F(TestRoadLanesParser, TestLaneBoundariesBorder) {
+  element::LaneOffset lane_offset;
+  lane_offset.set_s(0);
+  lane_offset.set_a(0.5);
+  element::LaneOffsets lane_offsets{lane_offset};
+
+  element::LaneWidth width;
+  width.set_a(3);
+  element::LaneBorder border;
+  border.set_s(2);
+  border.set_a(7.5);
+  border.set_b(0.1);
+  element::Lane lane1;
+  lane1.mutable_attribute()->set_id(1);
+  lane1.mutable_widths()->emplace_back(width);
+  element::Lane lane2;
+  lane2.mutable_attribute()->set_id(2);
+  lane2.mutable_borders()->emplace_back(border);
+  element::Lane lane3;
+  lane3.mutable_attribute()->set_id(3);
+  lane3.mutable_widths()->emplace_back(width);
+
+  element::LaneSection section;
+  section.set_start_position(10);
+  section.set_end_position(30);
+  /// 乱序, 结果下标与 lanes 一致
+  section.mutable_left()->mutable_lanes()->emplace_back(lane3);
+  section.mutable_left()->mutable_lanes()->emplace_back(lane1);
+  section.mutable_left()->mutable_lanes()->emplace_back(lane2);
+
+  ASSERT_DOUBLE_EQ(7.5 + 0.1 * 3, lane2.GetLaneWidth(5));
+  element::LaneBoundaries boundaries;
+  section.GetLaneBoundaries(15, lane_offsets, &boundaries);
+  ASSERT_EQ(3, boundaries.left_num());
+  ASSERT_EQ(0, boundaries.right_num());
+  ASSERT_DOUBLE_EQ(0.5, boundaries.center(0));
+  ASSERT_DOUBLE_EQ(0.5 + 3, boundaries.left(0, 1));
+  ASSERT_DOUBLE_EQ(0.5 + 7.5 + 0.1 * 3, boundaries.left(0, 2));
+  ASSERT_DOUBLE_EQ(0.5 + 7.5 + 0.1 * 3 + 3, boundaries.left(0, 0));
+  /// border 起点之前沿用内侧车道的外边界
+  section.GetLaneBoundaries(11, lane_offsets, &boundaries);
+  ASSERT_DOUBLE_EQ(0.5 + 3, boundaries.left(0, 2));
+  ASSERT_DOUBLE_EQ(0.5 + 3 + 3, boundaries.left(0, 0));
+}
+
+/// boundary_table() 查表与逐条车道累加一致
+TEST_F(TestRoadLanesParser, TestLaneBoundaryTable) {
+  size_t checked = 0;
+  for (const char* file : {"./tests/data/only-unittest.xodr",
+                           "./tests/data/Ex_Simple-LaneOffset.xodr",
+                           "./tests/data/UC_Simple-X-Junction.xodr"}) {
+    ParseOptions options;
+    options.lane_boundary_tables = true;
+    Parser parser(options);
+    auto ele_map = std::make_shared<element::Map>();
+    ASSERT_EQ(ErrorCode::OK, parser.ParseMap(file, ele_map).error_code);
+    for (const auto& road : ele_map->roads()) {
+      const auto& lane_offsets = road.lanes().lane_offsets();
+      for (const auto& section : road.lanes().lane_sections()) {
+        const auto& table = section.boundary_table();
+        ASSERT_FALSE(table.empty());
+        ASSERT_DOUBLE_EQ(section.start_position(), table.starts().front());
+        ASSERT_TRUE(std::is_sorted(table.starts().begin(),
+                                   table.starts().end()));
+        ASSERT_EQ(section.left().lanes().size(), table.left_num());
+        ASSERT_EQ(section.right().lanes().size(), table.right_num());
+        ASSERT_GT(table.bytes(), 0);
+        element::LaneSection plain = section;
+        plain.ClearBoundaryTable();
+        ASSERT_TRUE(plain.boundary_table().empty());
+
+        /// 避开断点: 表在不连续的 <width> 断点处取新记录
+        std::vector<double> road_s;
+        for (double s = section.start_position() + 0.013;
+             s < section.end_position(); s += 0.37) {
+          road_s.emplace_back(s);
+        }
+        element::LaneBoundaries expect;
+        element::LaneBoundaries boundaries;
+        plain.GetLaneBoundaries(road_s.data(), road_s.size(), lane_offsets,
+                                &expect);
+        section.GetLaneBoundaries(road_s.data(), road_s.size(),
+                                  lane_offsets, &boundaries);
+        for (size_t i = 0; i < road_s.size(); i++) {
+          const double s = road_s.at(i);
+          auto near = [](double a, double b) {
+            return std::fabs(a - b) <= 1e-9 * std::max(1., std::fabs(a));
+          };
+          ASSERT_TRUE(near(expect.center(i), boundaries.center(i)))
+              << file << " road " << road.attribute().id() << " s " << s;
+          ASSERT_DOUBLE_EQ(boundaries.center(i), table.center(s));
+          for (size_t j = 0; j < table.left_num(); j++) {
+            ASSERT_TRUE(near(expect.left(i, j), boundaries.left(i, j)))
+                << file << " road " << road.attribute().id() << " s " << s
+                << " " << expect.left(i, j) << " " << boundaries.left(i, j);
+            ASSERT_DOUBLE_EQ(boundaries.left(i, j), table.left(j, s));
+            checked++;
+          }
+          for (size_t j = 0; j < table.right_num(); j++) {
+            ASSERT_TRUE(near(expect.right(i, j), boundaries.right(i, j)))
+                << file << " road " << road.attribute().id() << " s " << s
+                << " " << expect.right(i, j) << " " << boundaries.right(i, j);
+            ASSERT_DOUBLE_EQ(boundaries.right(i, j), table.right(j, s));
+            checked++;
+          }
+        }
+      }
+    }
+  }
+  ASSERT_GT(checked, 0);
+
+  /// 默认不构建
+  Parser parser;
+  auto ele_map = std::make_shared<element::Map>();
+  ASSERT_EQ(ErrorCode::OK,
+            parser.ParseMap("./tests/data/only-unittest.xodr", ele_map)
+                .error_code);
+  for (const auto& road : ele_map->roads()) {
+    for (const auto& section : road.lanes().lane_sections()) {
+      ASSERT_TRUE(section.boundary_table().empty());
+    }
+  }
+}
+
+TEST_F(TestRoadLanesParser, TestLaneBoundaryTableBreaks) {
+  element::LaneOffsets lane_offsets(3);
+  lane_offsets[0].set_a(0.5);
+  lane_offsets[1].set_s(14);
+  lane_offsets[1].set_a(0.5);
+  lane_offsets[1].set_b(0.2);
+  lane_offsets[1].set_c(-0.01);
+  /// 下一个 section
+  lane_offsets[2].set_s(30);
+  lane_offsets[2].set_a(1);
+  element::LaneWidths widths(3);
+  widths[0].set_a(3);
+  widths[0].set_c(0.02);
+  /// 与前一条记录不连续
+  widths[1].set_s(6);
+  widths[1].set_a(3.5);
+  widths[1].set_d(-0.001);
+  /// 超出 section 终点
+  widths[2].set_s(25);
+  widths[2].set_a(4);
+  element::LaneBorder border;
+  border.set_s(2);
+  border.set_a(7.5);
+  border.set_b(0.1);
+  element::Lane lane1;
+  lane1.mutable_attribute()->set_id(-1);
+  lane1.set_widths(widths);
+  element::Lane lane2;
+  lane2.mutable_attribute()->set_id(-2);
+  lane2.mutable_borders()->emplace_back(border);
+
+  element::LaneSection section;
+  section.set_start_position(10);
+  section.set_end_position(30);
+  section.mutable_right()->mutable_lanes()->emplace_back(lane1);
+  section.mutable_right()->mutable_lanes()->emplace_back(lane2);
+  section.BuildBoundaryTable(lane_offsets);
+  const auto& table = section.boundary_table();
+  /// 10, 12(border), 14(laneOffset), 16(width), 不含终点 30 之后的记录
+  ASSERT_EQ(4, table.segment_num());
+  ASSERT_DOUBLE_EQ(16, table.starts().back());
+  ASSERT_EQ(3, table.boundary_num());
+  ASSERT_EQ(0, table.Segment(5));
+  ASSERT_EQ(1, table.Segment(12));
+  ASSERT_EQ(2, table.Segment(15.9, 3));
+  ASSERT_EQ(3, table.Segment(100, 1));
+
+  element::LaneSection plain = section;
+  plain.ClearBoundaryTable();
+  for (double s = 10; s < 30; s += 0.25) {
+    element::LaneBoundaries expect;
+    plain.GetLaneBoundaries(s, lane_offsets, &expect);
+    ASSERT_NEAR(expect.center(0), table.center(s), 1e-12) << s;
+    if (16 == s) {
+      /// 不连续处表取新记录
+      ASSERT_NEAR(0.5 + 0.2 * 2 - 0.01 * 4 - 3.5, table.right(0, s), 1e-12);
+      continue;
+    }
+    ASSERT_NEAR(expect.right(0, 0), table.right(0, s), 1e-12) << s;
+    ASSERT_NEAR(expect.right(0, 1), table.right(1, s), 1e-12) << s;
+  }
+}
+
 int main(int argc, char* argv[]) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
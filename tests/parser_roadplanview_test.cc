@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cassert>
 #include <memory>
 #include <set>
+#include <string>
+#include <vector>
 
 #include "opendrive-cpp/geometry/element.h"
 #include "opendrive-cpp/opendrive.h"
@@ -119,6 +122,56 @@ TEST_F(TestRoadPlanViewParser, TestRoadPlanView) {
   ASSERT_DOUBLE_EQ(-6.1084906856370778e-04, geometry_info5->dv());
 }
 
+TEST_F(TestRoadPlanViewParser, TestReferencePoints) {
+  for (const std::string file : {"./tests/data/only-unittest.xodr",
+                                 "./tests/data/UC_Simple-X-Junction.xodr"}) {
+    auto ele_map = std::make_shared<opendrive::element::Map>();
+    ASSERT_EQ(opendrive::ErrorCode::OK,
+              GetParser()->ParseMap(file, ele_map).error_code);
+    for (const auto& road : ele_map->roads()) {
+      const auto& geometrys = road.plan_view().geometrys();
+      /// 包含 road 之外的 s 与 geometry 的边界
+      std::vector<double> road_s{-1.};
+      for (const auto& geometry : geometrys) {
+        road_s.emplace_back(geometry->s());
+        road_s.emplace_back(geometry->s() + geometry->length() / 3);
+      }
+      const double length = road.attribute().length();
+      for (double s = 0; s <= length; s += 0.37) {
+        road_s.emplace_back(s);
+      }
+      road_s.emplace_back(length + 1);
+      std::sort(road_s.begin(), road_s.end());
+      /// 升序与倒序
+      for (int pass = 0; pass < 2; pass++) {
+        if (1 == pass) std::reverse(road_s.begin(), road_s.end());
+        std::vector<opendrive::element::Point> points(road_s.size());
+        ASSERT_TRUE(road.GetReferencePoints(road_s.data(), road_s.size(),
+                                            points.data()));
+        size_t index = 0;
+        for (size_t i = 0; i < road_s.size(); i++) {
+          index = 0;
+          while (index + 1 < geometrys.size() &&
+                 geometrys.at(index + 1)->s() <= road_s.at(i)) {
+            index++;
+          }
+          const auto expect = geometrys.at(index)->GetPoint(road_s.at(i));
+          ASSERT_NEAR(expect.x(), points.at(i).x(),
+                      opendrive::common::kKernelPositionTolerance);
+          ASSERT_NEAR(expect.y(), points.at(i).y(),
+                      opendrive::common::kKernelPositionTolerance);
+          ASSERT_NEAR(expect.heading(), points.at(i).heading(),
+                      opendrive::common::kKernelHeadingTolerance);
+        }
+      }
+    }
+  }
+  opendrive::element::Road empty_road;
+  double road_s = 0;
+  opendrive::element::Point point;
+  ASSERT_FALSE(empty_road.GetReferencePoints(&road_s, 1, &point));
+}
+
 int main(int argc, char* argv[]) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#include <cassert>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "opendrive-cpp/geometry/element.h"
+#include "opendrive-cpp/opendrive.h"
+#include "opendrive-cpp/parser/stream_parser.h"
+
+using namespace opendrive;
+
+class TestStreamParser : public testing::Test {
+ public:
+  static void SetUpTestCase();     // 在第一个case之前执行
+  static void TearDownTestCase();  // 在最后一个case之后执行
+  void SetUp() override;           // 在每个case之前执行
+  void TearDown() override;        // 在每个case之后执行
+
+  static std::string ReadFile(const std::string& file) {
+    std::ifstream in(file, std::ios::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+  }
+
+  static element::Map::Ptr ParseDom(const std::string& file) {
+    opendrive::Parser parser;
+    auto ele_map = std::make_shared<opendrive::element::Map>();
+    auto ret = parser.ParseMap(file, ele_map);
+    assert(opendrive::ErrorCode::OK == ret.error_code);
+    return ele_map;
+  }
+
+  static void ExpectSameMap(const element::Map& expect,
+                            const element::Map& actual) {
+    ASSERT_EQ(expect.header().name(), actual.header().name());
+    ASSERT_EQ(expect.header().rev_minor(), actual.header().rev_minor());
+    ASSERT_DOUBLE_EQ(expect.header().north(), actual.header().north());
+    ASSERT_EQ(expect.roads().size(), actual.roads().size());
+    for (size_t i = 0; i < expect.roads().size(); i++) {
+      const auto& expect_road = expect.roads().at(i);
+      const auto& actual_road = actual.roads().at(i);
+      ASSERT_EQ(expect_road.attribute().id(), actual_road.attribute().id());
+      ASSERT_DOUBLE_EQ(expect_road.attribute().length(),
+                       actual_road.attribute().length());
+      ASSERT_EQ(expect_road.plan_view().geometrys().size(),
+                actual_road.plan_view().geometrys().size());
+      ASSERT_EQ(expect_road.lanes().lane_sections().size(),
+                actual_road.lanes().lane_sections().size());
+      for (size_t j = 0; j < expect_road.lanes().lane_sections().size(); j++) {
+        const auto& expect_section = expect_road.lanes().lane_sections().at(j);
+        const auto& actual_section = actual_road.lanes().lane_sections().at(j);
+        ASSERT_DOUBLE_EQ(expect_section.end_position(),
+                         actual_section.end_position());
+        ASSERT_EQ(expect_section.left().lanes().size(),
+                  actual_section.left().lanes().size());
+        ASSERT_EQ(expect_section.right().lanes().size(),
+                  actual_section.right().lanes().size());
+      }
+    }
+    ASSERT_EQ(expect.junctions().size(), actual.junctions().size());
+    for (size_t i = 0; i < expect.junctions().size(); i++) {
+      ASSERT_EQ(expect.junctions().at(i).attribute().id(),
+                actual.junctions().at(i).attribute().id());
+      ASSERT_EQ(expect.junctions().at(i).connections().size(),
+                actual.junctions().at(i).connections().size());
+    }
+  }
+
+  static std::vector<std::string> files;
+};
+
+std::vector<std::string> TestStreamParser::files{
+    "./tests/data/only-unittest.xodr", "./tests/data/UC_Simple-X-Junction.xodr",
+    "./tests/data/Ex_Simple-LaneOffset.xodr"};
+
+void TestStreamParser::SetUpTestCase() {}
+void TestStreamParser::TearDownTestCase() {}
+void TestStreamParser::TearDown() {}
+void TestStreamParser::SetUp() {}
+
+TEST_F(TestStreamParser, TestStreamFile) {
+  for (const auto& file : files) {
+    auto expect_map = ParseDom(file);
+    for (bool use_mmap : {false, true}) {
+      opendrive::ParseOptions options;
+      options.use_mmap = use_mmap;
+      opendrive::Parser parser(options);
+      auto ele_map = std::make_shared<opendrive::element::Map>();
+      auto ret = parser.ParseMapStream(file, ele_map);
+      ASSERT_EQ(opendrive::ErrorCode::OK, ret.error_code) << ret.msg;
+      ExpectSameMap(*expect_map, *ele_map);
+      ASSERT_FALSE(parser.GetOpenDriveVersion().empty()) << file;
+    }
+  }
+}
+
+TEST_F(TestStreamParser, TestStreamFeed) {
+  for (const auto& file : files) {
+    auto expect_map = ParseDom(file);
+    const std::string content = ReadFile(file);
+    for (size_t chunk : {1, 7, 4096}) {
+      parser::StreamXmlParser stream_parser;
+      auto ele_map = std::make_shared<opendrive::element::Map>();
+      auto ret = stream_parser.Begin(ele_map);
+      for (size_t i = 0; i < content.size(); i += chunk) {
+        ret = stream_parser.Feed(content.data() + i,
+                                 std::min(chunk, content.size() - i));
+        ASSERT_EQ(opendrive::ErrorCode::OK, ret.error_code) << ret.msg;
+      }
+      ret = stream_parser.End();
+      ASSERT_EQ(opendrive::ErrorCode::OK, ret.error_code) << ret.msg;
+      ASSERT_EQ(content.size(), stream_parser.bytes_consumed());
+      ExpectSameMap(*expect_map, *ele_map);
+    }
+  }
+}
+
+TEST_F(TestStreamParser, TestStreamCallback) {
+  const std::string file = "./tests/data/UC_Simple-X-Junction.xodr";
+  auto expect_map = ParseDom(file);
+  std::vector<element::Id> road_ids;
+  opendrive::Parser parser;
+  auto ele_map = std::make_shared<opendrive::element::Map>();
+  auto ret = parser.ParseMapStream(file, ele_map, [&](element::Road&& road) {
+    road_ids.emplace_back(road.attribute().id());
+  });
+  ASSERT_EQ(opendrive::ErrorCode::OK, ret.error_code);
+  ASSERT_TRUE(ele_map->roads().empty());
+  ASSERT_EQ(expect_map->junctions().size(), ele_map->junctions().size());
+  ASSERT_EQ(expect_map->roads().size(), road_ids.size());
+  for (size_t i = 0; i < road_ids.size(); i++) {
+    ASSERT_EQ(expect_map->roads().at(i).attribute().id(), road_ids.at(i));
+  }
+}
+
+TEST_F(TestStreamParser, TestStreamError) {
+  const std::string content = ReadFile("./tests/data/only-unittest.xodr");
+  parser::StreamXmlParser stream_parser;
+  auto ele_map = std::make_shared<opendrive::element::Map>();
+  /// 截断的文档
+  auto ret =
+      stream_parser.Parse(content.data(), content.size() / 2, ele_map);
+  ASSERT_EQ(opendrive::ErrorCode::XML_ROOT_ELEMENT_ERROR, ret.error_code);
+
+  /// 没有 <road>
+  const std::string no_road =
+      "<?xml version=\"1.0\"?><OpenDRIVE><!-- <road> -->"
+      "<header revMajor=\"1\" revMinor=\"4\"/></OpenDRIVE>";
+  ele_map = std::make_shared<opendrive::element::Map>();
+  ret = stream_parser.Parse(no_road.data(), no_road.size(), ele_map);
+  ASSERT_EQ(opendrive::ErrorCode::XML_ROAD_ELEMENT_ERROR, ret.error_code);
+  ASSERT_EQ("4", ele_map->header().rev_minor());
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
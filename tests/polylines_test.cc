@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "opendrive-cpp/opendrive.h"
+#include "opendrive-cpp/polylines.h"
+
+using namespace opendrive;
+
+class TestPolylines : public testing::Test {
+ public:
+  static void SetUpTestCase();     // 在第一个case之前执行
+  static void TearDownTestCase();  // 在最后一个case之后执行
+  void SetUp() override;           // 在每个case之前执行
+  void TearDown() override;        // 在每个case之后执行
+
+  static element::Map::Ptr Parse(const std::string& file,
+                                 bool lane_boundary_tables = false) {
+    ParseOptions options;
+    options.lane_boundary_tables = lane_boundary_tables;
+    auto ele_map = std::make_shared<element::Map>();
+    EXPECT_EQ(ErrorCode::OK,
+              Parser(options).ParseMap(file, ele_map).error_code);
+    return ele_map;
+  }
+
+  static element::Point ReferencePoint(const element::Road& road, double s) {
+    element::Point point;
+    EXPECT_TRUE(road.GetReferencePoints(&s, 1, &point));
+    return point;
+  }
+
+  using Key = std::tuple<element::Id, element::Id, element::Id,
+                         MapPolylines::Kind>;
+  static std::map<Key, const MapPolylines::Line*> Index(
+      const MapPolylines& polylines) {
+    std::map<Key, const MapPolylines::Line*> index;
+    for (const auto& line : polylines.lines()) {
+      index[Key(line.road_id, line.section_id, line.lane_id, line.kind)] =
+          &line;
+    }
+    return index;
+  }
+};
+
+void TestPolylines::SetUpTestCase() {}
+void TestPolylines::TearDownTestCase() {}
+void TestPolylines::TearDown() {}
+void TestPolylines::SetUp() {}
+
+TEST_F(TestPolylines, TestGenerate) {
+  for (const char* file : {"./tests/data/UC_Simple-X-Junction.xodr",
+                           "./tests/data/Ex_Simple-LaneOffset.xodr"}) {
+    auto ele_map = Parse(file);
+    PolylineOptions options;
+    options.step = 0.7;
+    MapPolylines polylines;
+    ASSERT_EQ(ErrorCode::OK,
+              GeneratePolylines(*ele_map, options, &polylines).error_code);
+    ASSERT_EQ(1, polylines.thread_num());
+    ASSERT_GT(polylines.points_per_core_second(), 0);
+
+    /// 折线首尾相接覆盖整个缓冲区
+    size_t next = 0;
+    for (const auto& line : polylines.lines()) {
+      ASSERT_EQ(next, line.begin);
+      ASSERT_GT(line.size, 0);
+      next += line.size;
+    }
+    ASSERT_EQ(polylines.points().size(), next);
+
+    auto index = Index(polylines);
+    ASSERT_EQ(polylines.lines().size(), index.size());
+    size_t lines = 0;
+    for (const auto& road : ele_map->roads()) {
+      const element::Id road_id = road.attribute().id();
+      const auto* reference =
+          index.at(Key(road_id, -1, 0, MapPolylines::Kind::kReference));
+      const auto* points = polylines.line_points(*reference);
+      ASSERT_DOUBLE_EQ(0, points[0].s);
+      ASSERT_DOUBLE_EQ(road.attribute().length(),
+                       points[reference->size - 1].s);
+      for (size_t i = 0; i < reference->size; i++) {
+        const auto expect = ReferencePoint(road, points[i].s);
+        ASSERT_NEAR(expect.x(), points[i].x, 1e-9);
+        ASSERT_NEAR(expect.y(), points[i].y, 1e-9);
+        if (i > 0) {
+          ASSERT_LE(points[i].s - points[i - 1].s, options.step + 1e-9);
+          ASSERT_GT(points[i].s, points[i - 1].s);
+        }
+      }
+      lines++;
+
+      for (const auto& section : road.lanes().lane_sections()) {
+        const auto* center = index.at(Key(road_id, section.id(), 0,
+                                          MapPolylines::Kind::kCenter));
+        const auto* center_points = polylines.line_points(*center);
+        ASSERT_DOUBLE_EQ(section.start_position(), center_points[0].s);
+        ASSERT_DOUBLE_EQ(section.end_position(),
+                         center_points[center->size - 1].s);
+        element::LaneBoundaries boundaries;
+        for (size_t i = 0; i < center->size; i++) {
+          /// 中心车道到参考线的距离为 laneOffset
+          const double s = center_points[i].s;
+          section.GetLaneBoundaries(s, road.lanes().lane_offsets(),
+                                    &boundaries);
+          const auto expect = ReferencePoint(road, s);
+          ASSERT_NEAR(std::fabs(boundaries.center(0)),
+                      std::hypot(expect.x() - center_points[i].x,
+                                 expect.y() - center_points[i].y),
+                      1e-9);
+        }
+        lines++;
+        for (const auto* info : {&section.left(), &section.right()}) {
+          for (const auto& lane : info->lanes()) {
+            const element::Id id = lane.attribute().id();
+            using Kind = MapPolylines::Kind;
+            const auto* lane_center =
+                index.at(Key(road_id, section.id(), id, Kind::kCenter));
+            const auto* left =
+                index.at(Key(road_id, section.id(), id, Kind::kLeftBoundary));
+            const auto* right =
+                index.at(Key(road_id, section.id(), id, Kind::kRightBoundary));
+            lines += 3;
+            /// 内边界与内侧车道的外边界(或中心车道)重合
+            const int inner_id = id > 0 ? id - 1 : id + 1;
+            const auto* inner = id > 0 ? right : left;
+            const auto* expect_inner =
+                0 == inner_id
+                    ? center
+                    : index.at(Key(road_id, section.id(), inner_id,
+                                   id > 0 ? Kind::kLeftBoundary
+                                          : Kind::kRightBoundary));
+            ASSERT_EQ(0, std::memcmp(polylines.line_points(*expect_inner),
+                                     polylines.line_points(*inner),
+                                     inner->size * sizeof(PolylinePoint)));
+            for (size_t i = 0; i < lane_center->size; i++) {
+              const auto& l = polylines.line_points(*left)[i];
+              const auto& r = polylines.line_points(*right)[i];
+              const auto& c = polylines.line_points(*lane_center)[i];
+              ASSERT_NEAR(0.5 * (l.x + r.x), c.x, 1e-9);
+              ASSERT_NEAR(0.5 * (l.y + r.y), c.y, 1e-9);
+              ASSERT_DOUBLE_EQ(c.s, l.s);
+            }
+          }
+        }
+      }
+    }
+    ASSERT_EQ(lines, polylines.lines().size());
+  }
+}
+
+/// 结果与线程数及是否使用车道边界表无关
+TEST_F(TestPolylines, TestParallel) {
+  const std::string file = "./tests/data/UC_Simple-X-Junction.xodr";
+  auto ele_map = Parse(file);
+  MapPolylines expect;
+  PolylineOptions options;
+  ASSERT_EQ(ErrorCode::OK,
+            GeneratePolylines(*ele_map, options, &expect).error_code);
+  for (size_t thread_num : {0, 2, 4}) {
+    options.thread_num = thread_num;
+    MapPolylines polylines;
+    ASSERT_EQ(ErrorCode::OK,
+              GeneratePolylines(*ele_map, options, &polylines).error_code);
+    ASSERT_GE(polylines.thread_num(), 1);
+    ASSERT_EQ(expect.points().size(), polylines.points().size());
+    ASSERT_EQ(0, std::memcmp(expect.points().data(), polylines.points().data(),
+                             expect.points().size() * sizeof(PolylinePoint)));
+    ASSERT_EQ(expect.lines().size(), polylines.lines().size());
+  }
+
+  auto table_map = Parse(file, true);
+  MapPolylines polylines;
+  ASSERT_EQ(ErrorCode::OK,
+            GeneratePolylines(*table_map, options, &polylines).error_code);
+  ASSERT_EQ(expect.points().size(), polylines.points().size());
+  for (size_t i = 0; i < expect.points().size(); i++) {
+    ASSERT_NEAR(expect.points()[i].x, polylines.points()[i].x, 1e-9);
+    ASSERT_NEAR(expect.points()[i].y, polylines.points()[i].y, 1e-9);
+  }
+}
+
+TEST_F(TestPolylines, TestOptions) {
+  auto ele_map = Parse("./tests/data/UC_Simple-X-Junction.xodr");
+  PolylineOptions options;
+  options.reference_lines = false;
+  options.boundaries = false;
+  MapPolylines polylines;
+  ASSERT_EQ(ErrorCode::OK,
+            GeneratePolylines(*ele_map, options, &polylines).error_code);
+  ASSERT_FALSE(polylines.lines().empty());
+  for (const auto& line : polylines.lines()) {
+    ASSERT_EQ(MapPolylines::Kind::kCenter, line.kind);
+  }
+
+  for (double step : {0., -0.5, std::nan(""), HUGE_VAL}) {
+    options.step = step;
+    ASSERT_EQ(ErrorCode::INVALID_ARGUMENT,
+              GeneratePolylines(*ele_map, options, &polylines).error_code)
+        << step;
+  }
+  options.step = 1;
+  ASSERT_EQ(ErrorCode::INVALID_ARGUMENT,
+            GeneratePolylines(*ele_map, options, nullptr).error_code);
+
+  polylines.Clear();
+  ASSERT_TRUE(polylines.points().empty());
+  ASSERT_TRUE(polylines.lines().empty());
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,348 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "opendrive-cpp/common/arena.h"
+#include "opendrive-cpp/geometry/element.h"
+#include "opendrive-cpp/opendrive.h"
+#include "opendrive-cpp/snapshot/snapshot.h"
+
+using namespace opendrive;
+
+class TestReload : public testing::Test {
+ public:
+  static void SetUpTestCase();     // 在第一个case之前执行
+  static void TearDownTestCase();  // 在最后一个case之后执行
+  void SetUp() override;           // 在每个case之前执行
+  void TearDown() override;        // 在每个case之后执行
+
+  static std::string ReadFile(const std::string& file) {
+    std::ifstream in(file, std::ios::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+  }
+
+  static std::string Serialize(const element::Map& ele_map) {
+    std::string data;
+    snapshot::SerializeMap(ele_map, &data);
+    return data;
+  }
+
+  static std::string Road(int id, double length) {
+    std::ostringstream ss;
+    ss << "<road id=\"" << id << "\" length=\"" << length << "\">"
+       << "<planView><geometry s=\"0\" x=\"0\" y=\"0\" hdg=\"0\" length=\""
+       << length << "\"><line/></geometry></planView>"
+       << "<lanes><laneSection s=\"0\"><center><lane id=\"0\"/></center>"
+       << "</laneSection></lanes></road>";
+    return ss.str();
+  }
+
+  static std::string Junction(int id, int connecting_road) {
+    std::ostringstream ss;
+    ss << "<junction id=\"" << id << "\"><connection id=\"0\" "
+       << "incomingRoad=\"1\" connectingRoad=\"" << connecting_road
+       << "\" contactPoint=\"start\"/></junction>";
+    return ss.str();
+  }
+
+  static std::string Document(const std::string& body,
+                              const std::string& rev_minor = "4") {
+    return "<OpenDRIVE><header revMajor=\"1\" revMinor=\"" + rev_minor +
+           "\" name=\"reload\"/>" + body + "</OpenDRIVE>";
+  }
+
+  static element::Map::Ptr ParseData(const std::string& data) {
+    opendrive::Parser parser;
+    auto ele_map = std::make_shared<element::Map>();
+    auto ret = parser.ParseMap(data.data(), data.size(), ele_map);
+    EXPECT_EQ(ErrorCode::OK, ret.error_code);
+    return ele_map;
+  }
+};
+
+void TestReload::SetUpTestCase() {}
+void TestReload::TearDownTestCase() {}
+void TestReload::TearDown() {}
+void TestReload::SetUp() {}
+
+TEST_F(TestReload, TestUnchanged) {
+  const std::string file = "./tests/data/UC_Simple-X-Junction.xodr";
+  const auto expect_map = ParseData(ReadFile(file));
+  {
+    opendrive::Parser parser;
+    auto ele_map = std::make_shared<element::Map>();
+    parser::MapDiff diff;
+    /// 空 Map 重新加载: 全部为新增
+    auto ret = parser.ReloadMap(file, ele_map, &diff);
+    ASSERT_EQ(ErrorCode::OK, ret.error_code) << ret.msg;
+    ASSERT_TRUE(diff.header_changed);
+    ASSERT_EQ(expect_map->roads().size(), diff.added_roads.size());
+    ASSERT_EQ(expect_map->junctions().size(), diff.added_junctions.size());
+    ASSERT_EQ(Serialize(*expect_map), Serialize(*ele_map));
+    ASSERT_FALSE(parser.GetOpenDriveVersion().empty());
+
+    ret = parser.ReloadMap(file, ele_map, &diff);
+    ASSERT_EQ(ErrorCode::OK, ret.error_code) << ret.msg;
+    ASSERT_TRUE(diff.empty());
+    ASSERT_EQ(expect_map->roads().size(), diff.reused_roads);
+    ASSERT_EQ(expect_map->junctions().size(), diff.reused_junctions);
+    ASSERT_EQ(Serialize(*expect_map), Serialize(*ele_map));
+  }
+
+  /// 流式解析同样记录指纹
+  opendrive::Parser parser;
+  auto ele_map = std::make_shared<element::Map>();
+  auto ret = parser.ParseMapStream(file, ele_map);
+  ASSERT_EQ(ErrorCode::OK, ret.error_code);
+  parser::MapDiff diff;
+  ret = parser.ReloadMap(file, ele_map, &diff);
+  ASSERT_EQ(ErrorCode::OK, ret.error_code);
+  ASSERT_TRUE(diff.empty());
+  ASSERT_EQ(expect_map->roads().size(), diff.reused_roads);
+}
+
+TEST_F(TestReload, TestChanged) {
+  const std::string v1 = Document(Road(1, 10) + Road(2, 20) + Road(3, 30) +
+                                  Junction(100, 2) + Junction(101, 3));
+  const std::string v2 = Document(Road(1, 10) + Road(2, 25) + Road(4, 40) +
+                                  Junction(100, 2) + Junction(101, 4) +
+                                  Junction(102, 1));
+  opendrive::Parser parser;
+  auto ele_map = std::make_shared<element::Map>();
+  auto ret = parser.ReloadMap(v1.data(), v1.size(), ele_map);
+  ASSERT_EQ(ErrorCode::OK, ret.error_code) << ret.msg;
+
+  parser::MapDiff diff;
+  ret = parser.ReloadMap(v2.data(), v2.size(), ele_map, &diff);
+  ASSERT_EQ(ErrorCode::OK, ret.error_code) << ret.msg;
+  ASSERT_FALSE(diff.header_changed);
+  ASSERT_EQ(element::Ids{4}, diff.added_roads);
+  ASSERT_EQ(element::Ids{3}, diff.removed_roads);
+  ASSERT_EQ(element::Ids{2}, diff.modified_roads);
+  ASSERT_EQ(1, diff.reused_roads);
+  ASSERT_EQ(element::Ids{102}, diff.added_junctions);
+  ASSERT_TRUE(diff.removed_junctions.empty());
+  ASSERT_EQ(element::Ids{101}, diff.modified_junctions);
+  ASSERT_EQ(1, diff.reused_junctions);
+  ASSERT_EQ(Serialize(*ParseData(v2)), Serialize(*ele_map));
+
+  /// 版本变化时全部重新解析
+  const std::string v3 = Document(Road(1, 10) + Road(2, 25) + Road(4, 40) +
+                                      Junction(100, 2) + Junction(101, 4) +
+                                      Junction(102, 1),
+                                  "6");
+  ret = parser.ReloadMap(v3.data(), v3.size(), ele_map, &diff);
+  ASSERT_EQ(ErrorCode::OK, ret.error_code) << ret.msg;
+  ASSERT_TRUE(diff.header_changed);
+  ASSERT_EQ(0, diff.reused_roads);
+  ASSERT_EQ(0, diff.reused_junctions);
+  ASSERT_EQ(Serialize(*ParseData(v3)), Serialize(*ele_map));
+}
+
+/// arena 地图在两个 arena 之间交替重新加载, 内存不随次数增长
+TEST_F(TestReload, TestArena) {
+  const std::string file = "./tests/data/UC_Simple-X-Junction.xodr";
+  const auto expect = Serialize(*ParseData(ReadFile(file)));
+  const std::string v1 = Document(Road(1, 10) + Road(2, 20) +
+                                  Junction(100, 2));
+  const std::string v2 = Document(Road(1, 10) + Road(2, 25) +
+                                  Junction(100, 2));
+  common::Arena arenas[2];
+  opendrive::Parser parser;
+  auto ele_map = element::Map::Create(&arenas[0]);
+  parser::MapDiff diff;
+
+  /// 原地重新加载会使 arena 持续增长
+  auto ret = parser.ReloadMap(file, ele_map, &diff);
+  ASSERT_EQ(ErrorCode::INVALID_ARGUMENT, ret.error_code);
+  ASSERT_TRUE(ele_map->roads().empty());
+  ret = parser.ReloadMap(file, &arenas[0], &ele_map, &diff);
+  ASSERT_EQ(ErrorCode::INVALID_ARGUMENT, ret.error_code);
+
+  size_t bytes = 0;
+  for (size_t i = 0; i < 20; i++) {
+    common::Arena* next_arena = &arenas[(i + 1) % 2];
+    ret = parser.ReloadMap(file, next_arena, &ele_map, &diff);
+    ASSERT_EQ(ErrorCode::OK, ret.error_code) << ret.msg;
+    ASSERT_EQ(next_arena, ele_map->arena());
+    ASSERT_EQ(expect, Serialize(*ele_map));
+    if (i > 0) {
+      ASSERT_TRUE(diff.empty());
+      ASSERT_EQ(ele_map->roads().size(), diff.reused_roads);
+    }
+    /// 新地图不再引用旧 arena
+    arenas[i % 2].Release();
+    ASSERT_EQ(0, arenas[i % 2].bytes_reserved());
+    ASSERT_EQ(expect, Serialize(*ele_map));
+    if (0 == i) bytes = next_arena->bytes_reserved();
+    ASSERT_LE(next_arena->bytes_reserved(), bytes) << i;
+  }
+
+  /// 修改的 road 重新解析, 其余复制; 失败时地图与 arena 均保持不变
+  for (size_t i = 0; i < 4; i++) {
+    const std::string& data = i % 2 ? v2 : v1;
+    common::Arena* next_arena = &arenas[(i + 1) % 2];
+    ret = parser.ReloadMap(data.data(), data.size(), next_arena, &ele_map,
+                           &diff);
+    ASSERT_EQ(ErrorCode::OK, ret.error_code) << ret.msg;
+    arenas[i % 2].Release();
+    ASSERT_EQ(Serialize(*ParseData(data)), Serialize(*ele_map));
+    if (i > 0) {
+      ASSERT_EQ(element::Ids{2}, diff.modified_roads);
+      ASSERT_EQ(1, diff.reused_roads);
+    }
+  }
+  const std::string before = Serialize(*ele_map);
+  ret = parser.ReloadMap(v1.data(), v1.size() / 2, &arenas[1], &ele_map,
+                         &diff);
+  ASSERT_NE(ErrorCode::OK, ret.error_code);
+  ASSERT_EQ(&arenas[0], ele_map->arena());
+  ASSERT_EQ(before, Serialize(*ele_map));
+
+  /// 堆地图迁移到 arena
+  ele_map = std::make_shared<element::Map>();
+  arenas[0].Release();
+  ret = parser.ReloadMap(v1.data(), v1.size(), ele_map, &diff);
+  ASSERT_EQ(ErrorCode::OK, ret.error_code);
+  ret = parser.ReloadMap(v1.data(), v1.size(), &arenas[0], &ele_map, &diff);
+  ASSERT_EQ(ErrorCode::OK, ret.error_code);
+  ASSERT_EQ(&arenas[0], ele_map->arena());
+  ASSERT_EQ(2, diff.reused_roads);
+  ele_map.reset();
+}
+
+/// 重新解析与复用的 road 都按 lane_boundary_tables 构建车道边界表
+TEST_F(TestReload, TestLaneBoundaryTables) {
+  const std::string file = "./tests/data/UC_Simple-X-Junction.xodr";
+  const std::string data = ReadFile(file);
+  auto all_tables = [](const element::Map& ele_map, bool built) {
+    for (const auto& road : ele_map.roads()) {
+      for (const auto& section : road.lanes().lane_sections()) {
+        if (built == section.boundary_table().empty()) return false;
+      }
+    }
+    return !ele_map.roads().empty();
+  };
+  ParseOptions options;
+  options.lane_boundary_tables = true;
+  opendrive::Parser parser(options);
+  opendrive::Parser plain_parser;
+
+  /// 旧地图没有车道边界表
+  auto ele_map = std::make_shared<element::Map>();
+  auto ret = plain_parser.ReloadMap(data.data(), data.size(), ele_map);
+  ASSERT_EQ(ErrorCode::OK, ret.error_code);
+  ASSERT_TRUE(all_tables(*ele_map, false));
+  parser::MapDiff diff;
+  ret = parser.ReloadMap(data.data(), data.size(), ele_map, &diff);
+  ASSERT_EQ(ErrorCode::OK, ret.error_code);
+  ASSERT_EQ(ele_map->roads().size(), diff.reused_roads);
+  ASSERT_TRUE(all_tables(*ele_map, true));
+
+  /// 部分 road 变化
+  const std::string v1 = Document(Road(1, 10) + Road(2, 20));
+  const std::string v2 = Document(Road(1, 10) + Road(2, 25) + Road(3, 30));
+  ele_map = std::make_shared<element::Map>();
+  ret = parser.ReloadMap(v1.data(), v1.size(), ele_map, &diff);
+  ASSERT_EQ(ErrorCode::OK, ret.error_code);
+  ret = parser.ReloadMap(v2.data(), v2.size(), ele_map, &diff);
+  ASSERT_EQ(ErrorCode::OK, ret.error_code);
+  ASSERT_EQ(1, diff.reused_roads);
+  ASSERT_TRUE(all_tables(*ele_map, true));
+
+  /// 复制到新 arena 的表同样可用
+  common::Arena arena;
+  ret = parser.ReloadMap(v2.data(), v2.size(), &arena, &ele_map, &diff);
+  ASSERT_EQ(ErrorCode::OK, ret.error_code);
+  ASSERT_EQ(3, diff.reused_roads);
+  ASSERT_TRUE(all_tables(*ele_map, true));
+
+  ret = plain_parser.ReloadMap(v2.data(), v2.size(), nullptr, &ele_map,
+                               &diff);
+  ASSERT_EQ(ErrorCode::OK, ret.error_code);
+  ASSERT_TRUE(all_tables(*ele_map, false));
+}
+
+/// 取消时地图保持不变
+TEST_F(TestReload, TestCancel) {
+  const std::string v1 = Document(Road(1, 10) + Road(2, 20));
+  const std::string v2 = Document(Road(1, 10) + Road(2, 25));
+  opendrive::Parser plain_parser;
+  auto ele_map = std::make_shared<element::Map>();
+  auto ret = plain_parser.ReloadMap(v1.data(), v1.size(), ele_map);
+  ASSERT_EQ(ErrorCode::OK, ret.error_code);
+  const std::string expect = Serialize(*ele_map);
+
+  std::atomic<bool> cancel{true};
+  ParseOptions options;
+  options.cancel = &cancel;
+  opendrive::Parser parser(options);
+  ret = parser.ReloadMap(v2.data(), v2.size(), ele_map);
+  ASSERT_EQ(ErrorCode::PARSE_CANCELLED, ret.error_code);
+  ASSERT_EQ(expect, Serialize(*ele_map));
+}
+
+TEST_F(TestReload, TestWithoutFingerprint) {
+  const std::string file = "./tests/data/only-unittest.xodr";
+  const std::string data = ReadFile(file);
+  /// DOM 解析的 Map 没有指纹, 按内容比较
+  auto ele_map = ParseData(data);
+  const std::string expect = Serialize(*ele_map);
+  opendrive::Parser parser;
+  parser::MapDiff diff;
+  auto ret = parser.ReloadMap(data.data(), data.size(), ele_map, &diff);
+  ASSERT_EQ(ErrorCode::OK, ret.error_code) << ret.msg;
+  ASSERT_TRUE(diff.empty());
+  ASSERT_EQ(0, diff.reused_roads);
+  ASSERT_EQ(expect, Serialize(*ele_map));
+
+  ret = parser.ReloadMap(data.data(), data.size(), ele_map, &diff);
+  ASSERT_EQ(ErrorCode::OK, ret.error_code) << ret.msg;
+  ASSERT_TRUE(diff.empty());
+  ASSERT_EQ(ele_map->roads().size(), diff.reused_roads);
+  ASSERT_EQ(expect, Serialize(*ele_map));
+}
+
+TEST_F(TestReload, TestError) {
+  const std::string v1 = Document(Road(1, 10) + Road(2, 20) +
+                                  Junction(100, 2));
+  opendrive::Parser parser;
+  auto ele_map = std::make_shared<element::Map>();
+  auto ret = parser.ReloadMap(v1.data(), v1.size(), ele_map);
+  ASSERT_EQ(ErrorCode::OK, ret.error_code);
+  const std::string expect = Serialize(*ele_map);
+
+  /// road 1 未变化已被移入新 Map, road 2 缺少 <planView>: 失败后原样恢复
+  const std::string v2 = Document(
+      Road(1, 10) + "<road id=\"2\" length=\"1\"><lanes/></road>" +
+      Junction(100, 2));
+  parser::MapDiff diff;
+  ret = parser.ReloadMap(v2.data(), v2.size(), ele_map, &diff);
+  ASSERT_EQ(ErrorCode::XML_ROAD_PLANVIEW_ELEMENT_ERROR, ret.error_code);
+  ASSERT_TRUE(diff.empty());
+  ASSERT_EQ(expect, Serialize(*ele_map));
+
+  ret = parser.ReloadMap(v1.data(), v1.size() / 2, ele_map, &diff);
+  ASSERT_NE(ErrorCode::OK, ret.error_code);
+  ASSERT_EQ(expect, Serialize(*ele_map));
+  ret = parser.ReloadMap(v1.data(), v1.size(), ele_map, &diff);
+  ASSERT_EQ(ErrorCode::OK, ret.error_code);
+  ASSERT_EQ(2, diff.reused_roads);
+
+  ret = parser.ReloadMap("./tests/data/not-exist.xodr", ele_map, &diff);
+  ASSERT_NE(ErrorCode::OK, ret.error_code);
+  ret = parser.ReloadMap(v1.data(), v1.size(), nullptr, &diff);
+  ASSERT_NE(ErrorCode::OK, ret.error_code);
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
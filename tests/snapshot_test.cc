@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include <cassert>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "opendrive-cpp/geometry/element.h"
+#include "opendrive-cpp/opendrive.h"
+#include "opendrive-cpp/snapshot/snapshot.h"
+
+using namespace opendrive;
+
+class TestSnapshot : public testing::Test {
+ public:
+  static void SetUpTestCase();     // 在第一个case之前执行
+  static void TearDownTestCase();  // 在最后一个case之后执行
+  void SetUp() override;           // 在每个case之前执行
+  void TearDown() override;        // 在每个case之后执行
+
+  static element::Map::Ptr ParseDom(const std::string& file) {
+    opendrive::Parser parser;
+    auto ele_map = std::make_shared<opendrive::element::Map>();
+    auto ret = parser.ParseMap(file, ele_map);
+    assert(opendrive::ErrorCode::OK == ret.error_code);
+    return ele_map;
+  }
+
+  static const std::vector<std::string> kFiles;
+};
+
+const std::vector<std::string> TestSnapshot::kFiles = {
+    "./tests/data/only-unittest.xodr",
+    "./tests/data/case1.xodr",
+    "./tests/data/case2.xodr",
+    "./tests/data/case3.xodr",
+    "./tests/data/Ex_Simple-LaneOffset.xodr",
+    "./tests/data/UC_Simple-X-Junction.xodr",
+};
+
+void TestSnapshot::SetUpTestCase() {}
+void TestSnapshot::TearDownTestCase() {}
+void TestSnapshot::TearDown() {}
+void TestSnapshot::SetUp() {}
+
+TEST_F(TestSnapshot, TestRoundTrip) {
+  for (const auto& file : kFiles) {
+    auto expect = ParseDom(file);
+    std::string data;
+    auto ret = snapshot::SerializeMap(*expect, &data);
+    ASSERT_EQ(opendrive::ErrorCode::OK, ret.error_code);
+
+    auto actual = std::make_shared<element::Map>();
+    ret = snapshot::DeserializeMap(data.data(), data.size(), actual);
+    ASSERT_EQ(opendrive::ErrorCode::OK, ret.error_code) << file;
+
+    // 所有字段都参与编码, 再次序列化字节一致即说明往返无损
+    std::string data2;
+    snapshot::SerializeMap(*actual, &data2);
+    ASSERT_EQ(data, data2) << file;
+
+    ASSERT_EQ(expect->header().name(), actual->header().name());
+    ASSERT_EQ(expect->roads().size(), actual->roads().size());
+    ASSERT_EQ(expect->junctions().size(), actual->junctions().size());
+    for (size_t i = 0; i < expect->roads().size(); i++) {
+      const auto& expect_geometrys =
+          expect->roads().at(i).plan_view().geometrys();
+      const auto& actual_geometrys =
+          actual->roads().at(i).plan_view().geometrys();
+      ASSERT_EQ(expect_geometrys.size(), actual_geometrys.size());
+      for (size_t j = 0; j < expect_geometrys.size(); j++) {
+        const auto& expect_geometry = expect_geometrys.at(j);
+        const auto& actual_geometry = actual_geometrys.at(j);
+        ASSERT_EQ(expect_geometry->type(), actual_geometry->type());
+        const double s =
+            expect_geometry->s() + expect_geometry->length() * 0.5;
+        const auto expect_point = expect_geometry->GetPoint(s);
+        const auto actual_point = actual_geometry->GetPoint(s);
+        ASSERT_DOUBLE_EQ(expect_point.x(), actual_point.x());
+        ASSERT_DOUBLE_EQ(expect_point.y(), actual_point.y());
+        ASSERT_DOUBLE_EQ(expect_point.heading(), actual_point.heading());
+      }
+    }
+  }
+}
+
+TEST_F(TestSnapshot, TestSaveLoad) {
+  const std::string file = "./snapshot_test.odrsnap";
+  auto expect = ParseDom("./tests/data/UC_Simple-X-Junction.xodr");
+  auto ret = snapshot::SaveMap(*expect, file);
+  ASSERT_EQ(opendrive::ErrorCode::OK, ret.error_code);
+
+  auto actual = std::make_shared<element::Map>();
+  size_t bytes_read = 0;
+  ret = snapshot::LoadMap(file, actual, &bytes_read);
+  std::remove(file.c_str());
+  ASSERT_EQ(opendrive::ErrorCode::OK, ret.error_code);
+  ASSERT_GT(bytes_read, 0);
+
+  std::string expect_data;
+  std::string actual_data;
+  snapshot::SerializeMap(*expect, &expect_data);
+  snapshot::SerializeMap(*actual, &actual_data);
+  ASSERT_EQ(expect_data.size(), bytes_read);
+  ASSERT_EQ(expect_data, actual_data);
+
+  const auto& connection = actual->junctions().front().connections().front();
+  const auto& expect_connection =
+      expect->junctions().front().connections().front();
+  ASSERT_EQ(expect_connection.incoming_road(), connection.incoming_road());
+  ASSERT_EQ(expect_connection.lane_links().size(),
+            connection.lane_links().size());
+}
+
+TEST_F(TestSnapshot, TestInvalidData) {
+  auto ele_map = ParseDom("./tests/data/case1.xodr");
+  std::string data;
+  snapshot::SerializeMap(*ele_map, &data);
+  auto actual = std::make_shared<element::Map>();
+
+  // magic
+  std::string bad = data;
+  bad[0] = 'X';
+  auto ret = snapshot::DeserializeMap(bad.data(), bad.size(), actual);
+  ASSERT_EQ(opendrive::ErrorCode::LOAD_DATA_ERROR, ret.error_code);
+
+  // version
+  bad = data;
+  bad[8] = static_cast<char>(snapshot::kSnapshotVersion + 1);
+  ret = snapshot::DeserializeMap(bad.data(), bad.size(), actual);
+  ASSERT_EQ(opendrive::ErrorCode::LOAD_DATA_ERROR, ret.error_code);
+
+  // 截断
+  for (size_t size : {size_t(0), size_t(10), data.size() / 2,
+                      data.size() - 1}) {
+    ret = snapshot::DeserializeMap(data.data(), size, actual);
+    ASSERT_EQ(opendrive::ErrorCode::LOAD_DATA_ERROR, ret.error_code);
+  }
+
+  // 截断后修正 payload size, 由读取边界检查拒绝
+  bad = data.substr(0, data.size() - 3);
+  const uint64_t payload_size = bad.size() - 24;
+  bad.replace(16, sizeof(payload_size),
+              reinterpret_cast<const char*>(&payload_size),
+              sizeof(payload_size));
+  ret = snapshot::DeserializeMap(bad.data(), bad.size(), actual);
+  ASSERT_EQ(opendrive::ErrorCode::LOAD_DATA_ERROR, ret.error_code);
+
+  ret = snapshot::LoadMap("./tests/data/not-exist.odrsnap", actual);
+  ASSERT_EQ(opendrive::ErrorCode::LOAD_DATA_ERROR, ret.error_code);
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
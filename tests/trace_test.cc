@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "opendrive-cpp/common/trace.h"
+#include "opendrive-cpp/geometry/element.h"
+#include "opendrive-cpp/opendrive.h"
+
+using namespace opendrive;
+
+class TestTrace : public testing::Test {
+ public:
+  static void SetUpTestCase();     // 在第一个case之前执行
+  static void TearDownTestCase();  // 在最后一个case之后执行
+  void SetUp() override;           // 在每个case之前执行
+  void TearDown() override;        // 在每个case之后执行
+
+  static size_t CountOf(const std::string& text, const std::string& pattern) {
+    size_t num = 0;
+    for (size_t pos = text.find(pattern); std::string::npos != pos;
+         pos = text.find(pattern, pos + pattern.size())) {
+      num++;
+    }
+    return num;
+  }
+};
+
+void TestTrace::SetUpTestCase() {}
+void TestTrace::TearDownTestCase() {}
+void TestTrace::TearDown() {}
+void TestTrace::SetUp() {}
+
+TEST_F(TestTrace, TestSink) {
+  common::TraceSink sink;
+  ASSERT_EQ(nullptr, common::TraceSink::Current());
+  {
+    common::ScopedTraceSink scope(&sink);
+    ASSERT_EQ(&sink, common::TraceSink::Current());
+    common::ScopedTraceEvent outer("outer");
+    std::thread worker([&sink]() {
+      /// 线程之间不继承 sink
+      ASSERT_EQ(nullptr, common::TraceSink::Current());
+      common::ScopedTraceSink worker_scope(&sink);
+      common::ScopedTraceEvent inner("inner", 7);
+    });
+    worker.join();
+  }
+  ASSERT_EQ(nullptr, common::TraceSink::Current());
+  ASSERT_EQ(4, sink.event_size());
+
+  const std::string json = sink.ToJson();
+  ASSERT_EQ(0, json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+  ASSERT_EQ(2, CountOf(json, "\"ph\":\"B\""));
+  ASSERT_EQ(2, CountOf(json, "\"ph\":\"E\""));
+  ASSERT_EQ(2, CountOf(json, "\"name\":\"inner\""));
+  ASSERT_EQ(1, CountOf(json, "\"args\":{\"id\":7}"));
+  ASSERT_EQ(4, CountOf(json, "\"tid\":"));
+  ASSERT_NE(std::string::npos, json.find("]}"));
+
+  const std::string file = "./trace_test.json";
+  ASSERT_TRUE(sink.Save(file));
+  std::ifstream in(file, std::ios::binary);
+  std::stringstream ss;
+  ss << in.rdbuf();
+  ASSERT_EQ(json, ss.str());
+  std::remove(file.c_str());
+
+  sink.Clear();
+  ASSERT_EQ(0, sink.event_size());
+  /// Clear 后线程缓存的缓冲区失效
+  sink.Begin("again");
+  sink.End("again");
+  ASSERT_EQ(2, sink.event_size());
+}
+
+TEST_F(TestTrace, TestParseMap) {
+  const std::string file = "./tests/data/UC_Simple-X-Junction.xodr";
+  for (size_t thread_num : {1, 4}) {
+    common::TraceSink sink;
+    ParseOptions options;
+    options.thread_num = thread_num;
+    options.trace = &sink;
+    Parser parser(options);
+    auto ele_map = std::make_shared<element::Map>();
+    auto ret = parser.ParseMap(file, ele_map);
+    ASSERT_EQ(ErrorCode::OK, ret.error_code);
+    ASSERT_EQ(nullptr, common::TraceSink::Current());
+    if (!common::TraceSink::Supported()) {
+      /// 未编译埋点时不产生事件
+      ASSERT_EQ(0, sink.event_size());
+      continue;
+    }
+    size_t sections = 0;
+    for (const auto& road : ele_map->roads()) {
+      sections += road.lanes().lane_sections().size();
+    }
+    const std::string json = sink.ToJson();
+    ASSERT_EQ(2 * (1 + ele_map->roads().size() + sections), sink.event_size());
+    ASSERT_EQ(2, CountOf(json, "\"name\":\"MapXmlParser::Parse\""));
+    ASSERT_EQ(2 * ele_map->roads().size(),
+              CountOf(json, "\"name\":\"RoadXmlParser::Parse\""));
+    ASSERT_EQ(2 * sections,
+              CountOf(json, "\"name\":\"RoadLanesSectionXmlParser::Parse\""));
+    for (const auto& road : ele_map->roads()) {
+      ASSERT_EQ(1, CountOf(json, "\"args\":{\"id\":" +
+                                     std::to_string(road.attribute().id()) +
+                                     "}"));
+    }
+  }
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}